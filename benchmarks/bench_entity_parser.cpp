@@ -0,0 +1,131 @@
+/**
+ * @file bench_entity_parser.cpp
+ * @brief Table-driven entity parsing versus the hand-written switch it replaced
+ *
+ * Both benchmarks walk the same in-memory DXF text (Design Pit, then the
+ * generated meshes) with one tokenizer and differ only in how each 3DFACE's
+ * groups are stored.
+ */
+
+#include "bench_fixtures.h"
+#include "DXFEntityParser.h"
+#include <string>
+
+using namespace DXFProcessor;
+
+namespace {
+
+    // The per-code switch used by DXFReader before the dispatch table
+    bool parse3DFaceSwitch(DXFTokenizer& tokenizer, DXFGroup& group, Triangle& triangle,
+                           std::string_view& layerName) {
+        Point3D vertices[3];
+        bool hasVertex[3] = {false, false, false};
+        layerName = "0";
+        
+        while (true) {
+            if (!tokenizer.next(group)) {
+                group.valid = false;
+                break;
+            }
+            if (!group.valid) {
+                continue;
+            }
+            if (group.code == 0) {
+                break;
+            }
+            
+            double coordinate;
+            switch (group.code) {
+                case 8:
+                    layerName = group.value;
+                    break;
+                case 10: case 11: case 12: {
+                    int vertexIndex = group.code - 10;
+                    if (DXFTokenizer::parseDouble(group.value, coordinate)) {
+                        vertices[vertexIndex].x = coordinate;
+                        hasVertex[vertexIndex] = true;
+                    }
+                    break;
+                }
+                case 20: case 21: case 22: {
+                    int vertexIndex = group.code - 20;
+                    if (DXFTokenizer::parseDouble(group.value, coordinate)) {
+                        vertices[vertexIndex].y = coordinate;
+                    }
+                    break;
+                }
+                case 30: case 31: case 32: {
+                    int vertexIndex = group.code - 30;
+                    if (DXFTokenizer::parseDouble(group.value, coordinate)) {
+                        vertices[vertexIndex].z = coordinate;
+                    }
+                    break;
+                }
+            }
+        }
+        
+        if (hasVertex[0] && hasVertex[1] && hasVertex[2]) {
+            triangle = Triangle(vertices[0], vertices[1], vertices[2]);
+            return true;
+        }
+        return false;
+    }
+
+    // Runs 'parseFace' on every 3DFACE in the buffer, returning the number parsed
+    template <typename ParseFace>
+    size_t walkFaces(std::string_view bytes, ParseFace parseFace) {
+        DXFTokenizer tokenizer(bytes);
+        DXFGroup group;
+        size_t faces = 0;
+        bool haveGroup = tokenizer.next(group);
+        while (haveGroup) {
+            if (group.valid && group.code == 0 && group.value == "3DFACE") {
+                faces += parseFace(tokenizer, group) ? 1 : 0;
+                haveGroup = group.valid;
+                continue;
+            }
+            haveGroup = tokenizer.next(group);
+        }
+        return faces;
+    }
+
+}
+
+static void BM_EntityParser_DispatchTable(benchmark::State& state) {
+    const std::string& bytes = bench::inputDXF(state.range(0));
+    size_t faces = 0;
+
+    for (auto _ : state) {
+        faces = walkFaces(bytes, [](DXFTokenizer& tokenizer, DXFGroup& group) {
+            EntityParser<Face3DEntity>::Record face;
+            bool parsed = EntityParser<Face3DEntity>::parse(tokenizer, group, face);
+            Triangle triangle(face.vertex(0), face.vertex(1), face.vertex(2));
+            benchmark::DoNotOptimize(triangle);
+            std::string_view layerName = face.layer();
+            benchmark::DoNotOptimize(layerName);
+            return parsed;
+        });
+    }
+
+    bench::reportThroughput(state, bytes.size(), faces);
+}
+BENCHMARK(BM_EntityParser_DispatchTable)->Apply(bench::dxfInputs)->Unit(benchmark::kMillisecond);
+
+static void BM_EntityParser_Switch(benchmark::State& state) {
+    const std::string& bytes = bench::inputDXF(state.range(0));
+    size_t faces = 0;
+
+    for (auto _ : state) {
+        faces = walkFaces(bytes, [](DXFTokenizer& tokenizer, DXFGroup& group) {
+            Triangle triangle;
+            std::string_view layerName;
+            bool parsed = parse3DFaceSwitch(tokenizer, group, triangle, layerName);
+            benchmark::DoNotOptimize(triangle);
+            benchmark::DoNotOptimize(layerName);
+            return parsed;
+        });
+    }
+
+    bench::reportThroughput(state, bytes.size(), faces);
+}
+BENCHMARK(BM_EntityParser_Switch)->Apply(bench::dxfInputs)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,216 @@
+#pragma once
+
+/**
+ * @file bench_fixtures.h
+ * @brief Shared inputs and throughput reporting for the dxf_bench suite
+ *
+ * Inputs are data/Design Pit.dxf and generated pit-shaped TIN meshes of
+ * 1e4 to 1e8 triangles, each built once and cached for the whole run:
+ * DXF text comes from DXFGenerator, in-memory meshes from a lighter grid
+ * built directly into MeshData (also in a shuffled order, for passes whose
+ * speed depends on memory locality).
+ * Generated sizes above DXF_BENCH_MAX_TRIANGLES (environment variable,
+ * default 1e5) are not registered, so a default run stays short; set it to
+ * 100000000 for the full scale sweep (about 8 GB of mesh at 1e8).
+ */
+
+#include <benchmark/benchmark.h>
+#include "DXFGenerator.h"
+#include "MeshData.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace DXFProcessor {
+namespace bench {
+
+    /// data/Design Pit.dxf, the real survey used throughout the suite
+    inline std::string designPitPath() {
+        return std::string(MAIN_DATA_DIR) + "/Design Pit.dxf";
+    }
+
+    /// Raw bytes of data/Design Pit.dxf
+    inline const std::string& designPit() {
+        static const std::string contents = [] {
+            std::ifstream file(designPitPath(), std::ios::binary);
+            if (!file.is_open()) {
+                throw std::runtime_error("Cannot open Design Pit.dxf");
+            }
+            std::ostringstream buffer;
+            buffer << file.rdbuf();
+            return buffer.str();
+        }();
+        return contents;
+    }
+
+    /// Largest generated fixture to register (DXF_BENCH_MAX_TRIANGLES, default 1e5)
+    inline std::int64_t maxGeneratedTriangles() {
+        static const std::int64_t limit = [] {
+            const char* value = std::getenv("DXF_BENCH_MAX_TRIANGLES");
+            long long parsed = value != nullptr ? std::atoll(value) : 0;
+            return parsed > 0 ? static_cast<std::int64_t>(parsed) : std::int64_t(100000);
+        }();
+        return limit;
+    }
+
+    /// Registers triangle counts 1e4, 1e5, ... 1e8, skipping those above maxGeneratedTriangles()
+    inline void triangleCounts(benchmark::internal::Benchmark* benchmark) {
+        benchmark->ArgName("triangles");
+        for (std::int64_t count = 10000; count <= 100000000 && count <= maxGeneratedTriangles(); count *= 10) {
+            benchmark->Arg(count);
+        }
+    }
+
+    /// Registers Design Pit (argument 0) followed by the generated triangle counts
+    inline void dxfInputs(benchmark::internal::Benchmark* benchmark) {
+        benchmark->Arg(0);
+        triangleCounts(benchmark);
+    }
+
+    /**
+     * @brief Deterministic open-pit surface of roughly 'triangles' triangles
+     *
+     * A square grid whose height falls in benches toward the centre, with a
+     * little hash-based roughness; two triangles per cell, one layer per bench.
+     * Built once per size and shared; benchmarks may only drop its cached aggregates.
+     */
+    inline MeshData& generatedMesh(std::int64_t triangles) {
+        static std::map<std::int64_t, std::unique_ptr<MeshData>> cache;
+        auto& slot = cache[triangles];
+        if (slot) {
+            return *slot;
+        }
+        
+        const size_t side = static_cast<size_t>(std::ceil(std::sqrt(triangles / 2.0))) + 1;
+        const double spacing = 2.0;
+        const double half = (side - 1) * spacing / 2.0;
+        auto height = [&](size_t i, size_t j) {
+            double x = i * spacing - half;
+            double y = j * spacing - half;
+            double radius = std::sqrt(x * x + y * y) / half;
+            std::uint32_t hash = static_cast<std::uint32_t>(i * 73856093u ^ j * 19349663u);
+            hash = (hash ^ (hash >> 13)) * 0x5bd1e995u;
+            double roughness = ((hash >> 8) & 0xFFFF) / 65535.0 - 0.5;
+            return 300.0 + 120.0 * std::floor(std::min(radius, 1.0) * 12.0) / 12.0 + roughness;
+        };
+        
+        slot = std::make_unique<MeshData>();
+        MeshData& mesh = *slot;
+        mesh.reserve(static_cast<size_t>(triangles));
+        for (size_t j = 0; j + 1 < side && mesh.getTriangleCount() < static_cast<size_t>(triangles); ++j) {
+            for (size_t i = 0; i + 1 < side && mesh.getTriangleCount() < static_cast<size_t>(triangles); ++i) {
+                Point3D a(i * spacing - half, j * spacing - half, height(i, j));
+                Point3D b((i + 1) * spacing - half, j * spacing - half, height(i + 1, j));
+                Point3D c(i * spacing - half, (j + 1) * spacing - half, height(i, j + 1));
+                Point3D d((i + 1) * spacing - half, (j + 1) * spacing - half, height(i + 1, j + 1));
+                LayerId layer = mesh.internLayer("Bench " + std::to_string(static_cast<int>((a.z - 300.0) / 10.0)));
+                mesh.addTriangle(Triangle(a, b, c), layer);
+                mesh.addTriangle(Triangle(b, d, c), layer);
+            }
+        }
+        return mesh;
+    }
+
+    /**
+     * @brief The generated mesh of 'triangles' triangles in a fixed random order
+     *
+     * Stands in for CAD export order, which jumps around the drawing.
+     * Built once per size and shared like generatedMesh.
+     */
+    inline const MeshData& shuffledMesh(std::int64_t triangles) {
+        static std::map<std::int64_t, std::unique_ptr<MeshData>> cache;
+        auto& slot = cache[triangles];
+        if (!slot) {
+            const MeshData& grid = generatedMesh(triangles);
+            std::vector<std::uint32_t> order(grid.getTriangleCount());
+            std::iota(order.begin(), order.end(), 0u);
+            std::shuffle(order.begin(), order.end(), std::mt19937(42));
+            slot = std::make_unique<MeshData>(grid);
+            slot->permute(order);
+        }
+        return *slot;
+    }
+
+    /// DXFGenerator's pit surface of 'triangles' faces as ASCII DXF text (default seed)
+    inline const std::string& generatedDXF(std::int64_t triangles) {
+        static std::map<std::int64_t, std::string> cache;
+        std::string& text = cache[triangles];
+        if (text.empty()) {
+            GeneratorOptions options;
+            options.faceCount = static_cast<size_t>(triangles);
+            text = DXFGenerator(options).generate();
+        }
+        return text;
+    }
+
+    /// Paths of the generated DXF files, deleted when the run exits (several GB at 1e8)
+    struct GeneratedFiles {
+        std::map<std::int64_t, std::string> paths;
+        
+        ~GeneratedFiles() {
+            for (const auto& entry : paths) {
+                std::error_code error;
+                std::filesystem::remove(entry.second, error);
+            }
+        }
+    };
+
+    /// The generated DXF written once to the temp directory, for benchmarks that read files
+    inline std::string generatedDXFPath(std::int64_t triangles) {
+        static GeneratedFiles cache;
+        std::string& path = cache.paths[triangles];
+        if (path.empty()) {
+            path = (std::filesystem::temp_directory_path() /
+                    ("dxf_bench_" + std::to_string(triangles) + ".dxf")).string();
+            std::ofstream file(path, std::ios::binary);
+            const std::string& text = generatedDXF(triangles);
+            file.write(text.data(), static_cast<std::streamsize>(text.size()));
+        }
+        return path;
+    }
+
+    /// DXF text for a benchmark argument: 0 selects Design Pit, anything else a generated mesh
+    inline const std::string& inputDXF(std::int64_t triangles) {
+        return triangles == 0 ? designPit() : generatedDXF(triangles);
+    }
+
+    /// File path for a benchmark argument, as inputDXF
+    inline std::string inputDXFPath(std::int64_t triangles) {
+        return triangles == 0 ? designPitPath() : generatedDXFPath(triangles);
+    }
+
+    /**
+     * @brief Reports throughput as rate counters "MB" and "triangles" (per second)
+     *
+     * Sets the standard bytes/items rates too, so --benchmark_format=json
+     * carries bytes_per_second and items_per_second for tooling.
+     */
+    inline void reportThroughput(benchmark::State& state, std::uint64_t bytesPerIteration,
+                                 std::uint64_t trianglesPerIteration) {
+        const double iterations = static_cast<double>(state.iterations());
+        if (bytesPerIteration > 0) {
+            state.SetBytesProcessed(static_cast<std::int64_t>(iterations * bytesPerIteration));
+            state.counters["MB"] = benchmark::Counter(iterations * bytesPerIteration / 1e6,
+                                                      benchmark::Counter::kIsRate);
+        }
+        if (trianglesPerIteration > 0) {
+            state.SetItemsProcessed(static_cast<std::int64_t>(iterations * trianglesPerIteration));
+            state.counters["triangles"] = benchmark::Counter(iterations * trianglesPerIteration,
+                                                             benchmark::Counter::kIsRate);
+        }
+    }
+
+} // namespace bench
+} // namespace DXFProcessor
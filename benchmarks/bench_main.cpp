@@ -0,0 +1,8 @@
+/**
+ * @file bench_main.cpp
+ * @brief Main entry point for the DXF Processor microbenchmarks
+ */
+
+#include <benchmark/benchmark.h>
+
+BENCHMARK_MAIN();
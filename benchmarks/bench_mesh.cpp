@@ -0,0 +1,79 @@
+/**
+ * @file bench_mesh.cpp
+ * @brief Mesh aggregates and full summaries over the generated meshes
+ *
+ * These run on already-built MeshData, so they measure the in-memory
+ * passes only; triangles/s is the figure to compare across sizes. The
+ * mesh's cached aggregates are dropped before every iteration so the full
+ * pass is timed, except in BM_MeshSummarizer_Repeated.
+ */
+
+#include "bench_fixtures.h"
+#include "MeshSummarizer.h"
+
+using namespace DXFProcessor;
+
+static void BM_MeshData_BoundingBox(benchmark::State& state) {
+    MeshData& mesh = bench::generatedMesh(state.range(0));
+    
+    for (auto _ : state) {
+        mesh.invalidateAggregates();
+        BoundingBox box = mesh.getBoundingBox();
+        benchmark::DoNotOptimize(box);
+    }
+    
+    bench::reportThroughput(state, mesh.getTriangleCount() * sizeof(Triangle), mesh.getTriangleCount());
+}
+BENCHMARK(BM_MeshData_BoundingBox)->Apply(bench::triangleCounts)->Unit(benchmark::kMillisecond);
+
+static void BM_MeshData_SurfaceArea(benchmark::State& state) {
+    MeshData& mesh = bench::generatedMesh(state.range(0));
+    
+    for (auto _ : state) {
+        mesh.invalidateAggregates();
+        double area = mesh.getTotalSurfaceArea();
+        benchmark::DoNotOptimize(area);
+    }
+    
+    bench::reportThroughput(state, mesh.getTriangleCount() * sizeof(Triangle), mesh.getTriangleCount());
+}
+BENCHMARK(BM_MeshData_SurfaceArea)->Apply(bench::triangleCounts)->Unit(benchmark::kMillisecond);
+
+static void BM_MeshSummarizer(benchmark::State& state, const char* type, bool compact) {
+    MeshData mesh = bench::generatedMesh(state.range(0));
+    if (compact && !mesh.compact()) {
+        state.SkipWithError("mesh does not fit float32 storage");
+        return;
+    }
+    auto summarizer = MeshSummarizerFactory::create(type);
+    
+    for (auto _ : state) {
+        mesh.invalidateAggregates();
+        MeshSummary summary = summarizer->summarize(mesh);
+        benchmark::DoNotOptimize(summary.totalSurfaceArea);
+    }
+    
+    const size_t triangleBytes = compact ? sizeof(CompactTriangle) : sizeof(Triangle);
+    bench::reportThroughput(state, mesh.getTriangleCount() * triangleBytes, mesh.getTriangleCount());
+}
+BENCHMARK_CAPTURE(BM_MeshSummarizer, Basic, "basic", false)->Apply(bench::triangleCounts)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_MeshSummarizer, Detailed, "detailed", false)->Apply(bench::triangleCounts)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_MeshSummarizer, BasicCompact, "basic", true)->Apply(bench::triangleCounts)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_MeshSummarizer, DetailedCompact, "detailed", true)->Apply(bench::triangleCounts)->Unit(benchmark::kMillisecond);
+
+/// A basic and a detailed summary of the same unchanged mesh: one aggregate pass serves both
+static void BM_MeshSummarizer_Repeated(benchmark::State& state) {
+    MeshData& mesh = bench::generatedMesh(state.range(0));
+    auto basic = MeshSummarizerFactory::create("basic");
+    auto detailed = MeshSummarizerFactory::create("detailed");
+    
+    for (auto _ : state) {
+        MeshSummary first = basic->summarize(mesh);
+        MeshSummary second = detailed->summarize(mesh);
+        benchmark::DoNotOptimize(first.totalSurfaceArea);
+        benchmark::DoNotOptimize(second.totalSurfaceArea);
+    }
+    
+    bench::reportThroughput(state, mesh.getTriangleCount() * sizeof(Triangle), mesh.getTriangleCount());
+}
+BENCHMARK(BM_MeshSummarizer_Repeated)->Apply(bench::triangleCounts)->Unit(benchmark::kMillisecond);
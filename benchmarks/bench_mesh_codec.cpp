@@ -0,0 +1,43 @@
+/**
+ * @file bench_mesh_codec.cpp
+ * @brief Encoding and decoding of the .dxm mesh format over the generated meshes
+ *
+ * Throughput counts the decoded MeshData bytes (72 per triangle), the
+ * figure to compare with parsing the same mesh from DXF text.
+ */
+
+#include "bench_fixtures.h"
+#include "MeshCodec.h"
+
+using namespace DXFProcessor;
+
+static void BM_MeshCodec_Encode(benchmark::State& state) {
+    const MeshData& mesh = bench::generatedMesh(state.range(0));
+    MeshCodec codec;
+    size_t encodedBytes = 0;
+    
+    for (auto _ : state) {
+        std::string bytes = codec.encode(mesh);
+        encodedBytes = bytes.size();
+        benchmark::DoNotOptimize(bytes.data());
+    }
+    
+    state.counters["bytes/triangle"] = static_cast<double>(encodedBytes) / mesh.getTriangleCount();
+    bench::reportThroughput(state, mesh.getTriangleCount() * sizeof(Triangle), mesh.getTriangleCount());
+}
+BENCHMARK(BM_MeshCodec_Encode)->Apply(bench::triangleCounts)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_MeshCodec_Decode(benchmark::State& state) {
+    const MeshData& mesh = bench::generatedMesh(state.range(0));
+    MeshCodec codec;
+    const std::string bytes = codec.encode(mesh);
+    
+    for (auto _ : state) {
+        auto decoded = codec.decode(bytes);
+        benchmark::DoNotOptimize(decoded.get());
+    }
+    
+    state.counters["bytes/triangle"] = static_cast<double>(bytes.size()) / mesh.getTriangleCount();
+    bench::reportThroughput(state, mesh.getTriangleCount() * sizeof(Triangle), mesh.getTriangleCount());
+}
+BENCHMARK(BM_MeshCodec_Decode)->Apply(bench::triangleCounts)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,54 @@
+/**
+ * @file bench_mesh_components.cpp
+ * @brief Connected component labeling over the generated meshes
+ *
+ * The topology is built once outside the loop, so these time only the
+ * union-find passes; the generated pit surface is a single component.
+ */
+
+#include "bench_fixtures.h"
+#include "MeshComponents.h"
+
+using namespace DXFProcessor;
+
+static void BM_MeshComponents_Label(benchmark::State& state) {
+    const MeshTopology topology(bench::generatedMesh(state.range(0)));
+    size_t components = 0;
+    
+    for (auto _ : state) {
+        ComponentLabels labels = ComponentLabeler().label(topology);
+        components = labels.count;
+        benchmark::DoNotOptimize(labels.componentOf.data());
+    }
+    
+    state.counters["components"] = static_cast<double>(components);
+    bench::reportThroughput(state, 0, topology.getTriangleCount());
+}
+BENCHMARK(BM_MeshComponents_Label)->Apply(bench::triangleCounts)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_MeshComponents_LabelSingleThread(benchmark::State& state) {
+    const MeshTopology topology(bench::generatedMesh(state.range(0)));
+    ComponentOptions options;
+    options.threadCount = 1;
+    
+    for (auto _ : state) {
+        ComponentLabels labels = ComponentLabeler(options).label(topology);
+        benchmark::DoNotOptimize(labels.componentOf.data());
+    }
+    
+    bench::reportThroughput(state, 0, topology.getTriangleCount());
+}
+BENCHMARK(BM_MeshComponents_LabelSingleThread)->Apply(bench::triangleCounts)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_MeshComponents_Summarize(benchmark::State& state) {
+    const MeshData& mesh = bench::generatedMesh(state.range(0));
+    const ComponentLabels labels = ComponentLabeler().label(mesh);
+    
+    for (auto _ : state) {
+        std::vector<ComponentSummary> components = ComponentLabeler::summarize(mesh, labels);
+        benchmark::DoNotOptimize(components.data());
+    }
+    
+    bench::reportThroughput(state, mesh.getTriangleCount() * sizeof(Triangle), mesh.getTriangleCount());
+}
+BENCHMARK(BM_MeshComponents_Summarize)->Apply(bench::triangleCounts)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,86 @@
+/**
+ * @file bench_mesh_topology.cpp
+ * @brief Corner table construction and traversal over the generated meshes
+ *
+ * The generated grid lists triangles row by row, so building from it is
+ * the spatially coherent case. The shuffled and reordered cases build from
+ * the same grid in random order (as CAD exports list faces) and after
+ * SpatialOrder has put it back on a Hilbert curve, which is what
+ * --spatial-order buys the topology-based passes. The one-ring benchmark
+ * walks every vertex of the finished table.
+ */
+
+#include "bench_fixtures.h"
+#include "MeshTopology.h"
+#include "SpatialOrder.h"
+
+using namespace DXFProcessor;
+
+static void BM_MeshTopology_Build(benchmark::State& state) {
+    const MeshData& mesh = bench::generatedMesh(state.range(0));
+    size_t vertices = 0;
+    
+    for (auto _ : state) {
+        MeshTopology topology(mesh);
+        vertices = topology.getVertexCount();
+        benchmark::DoNotOptimize(vertices);
+    }
+    
+    state.counters["vertices"] = static_cast<double>(vertices);
+    bench::reportThroughput(state, mesh.getTriangleCount() * sizeof(Triangle), mesh.getTriangleCount());
+}
+BENCHMARK(BM_MeshTopology_Build)->Apply(bench::triangleCounts)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_MeshTopology_BuildSingleThread(benchmark::State& state) {
+    const MeshData& mesh = bench::generatedMesh(state.range(0));
+    MeshTopologyOptions options;
+    options.threadCount = 1;
+    
+    for (auto _ : state) {
+        MeshTopology topology(mesh, options);
+        benchmark::DoNotOptimize(topology.getVertexCount());
+    }
+    
+    bench::reportThroughput(state, mesh.getTriangleCount() * sizeof(Triangle), mesh.getTriangleCount());
+}
+BENCHMARK(BM_MeshTopology_BuildSingleThread)->Apply(bench::triangleCounts)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_MeshTopology_BuildShuffled(benchmark::State& state) {
+    const MeshData& mesh = bench::shuffledMesh(state.range(0));
+    
+    for (auto _ : state) {
+        MeshTopology topology(mesh);
+        benchmark::DoNotOptimize(topology.getVertexCount());
+    }
+    
+    bench::reportThroughput(state, mesh.getTriangleCount() * sizeof(Triangle), mesh.getTriangleCount());
+}
+BENCHMARK(BM_MeshTopology_BuildShuffled)->Apply(bench::triangleCounts)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_MeshTopology_BuildReordered(benchmark::State& state) {
+    MeshData mesh = bench::shuffledMesh(state.range(0));
+    SpatialOrder().reorder(mesh);
+    
+    for (auto _ : state) {
+        MeshTopology topology(mesh);
+        benchmark::DoNotOptimize(topology.getVertexCount());
+    }
+    
+    bench::reportThroughput(state, mesh.getTriangleCount() * sizeof(Triangle), mesh.getTriangleCount());
+}
+BENCHMARK(BM_MeshTopology_BuildReordered)->Apply(bench::triangleCounts)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_MeshTopology_OneRing(benchmark::State& state) {
+    const MeshTopology topology(bench::generatedMesh(state.range(0)));
+    
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (MeshTopology::Index v = 0; v < topology.getVertexCount(); ++v) {
+            topology.forEachRingVertex(v, [&sum](MeshTopology::Index u) { sum += u; });
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    
+    bench::reportThroughput(state, 0, topology.getTriangleCount());
+}
+BENCHMARK(BM_MeshTopology_OneRing)->Apply(bench::triangleCounts)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,84 @@
+/**
+ * @file bench_reader.cpp
+ * @brief End-to-end 3DFACE parsing: in-memory ranges, file reads and the pipeline
+ *
+ * BM_ParseFaceRange builds a MeshData from in-memory text; the file
+ * benchmarks add mapping the file (warm in the page cache after the first
+ * iteration). The split reader uses a 1 MB range size so that the generated
+ * inputs are actually cut into ranges; on one core it measures the split
+ * and merge overhead rather than a speed-up.
+ */
+
+#include "bench_fixtures.h"
+#include "DXFEntityParser.h"
+#include "DXFPipeline.h"
+#include "DXFReader.h"
+#include "MeshSummarizer.h"
+#include "ThreadPool.h"
+
+using namespace DXFProcessor;
+
+static void BM_ParseFaceRange(benchmark::State& state) {
+    const std::string& bytes = bench::inputDXF(state.range(0));
+    size_t faces = 0;
+    
+    for (auto _ : state) {
+        MeshData mesh;
+        bool inEntitiesSection = false;
+        faces = parseFaceRange(bytes, inEntitiesSection, mesh);
+        benchmark::DoNotOptimize(mesh);
+    }
+    
+    bench::reportThroughput(state, bytes.size(), faces);
+}
+BENCHMARK(BM_ParseFaceRange)->Apply(bench::dxfInputs)->Unit(benchmark::kMillisecond);
+
+static void BM_DXFReader_ReadFile(benchmark::State& state) {
+    const std::string path = bench::inputDXFPath(state.range(0));
+    const size_t bytes = bench::inputDXF(state.range(0)).size();
+    auto reader = DXFReaderFactory::createReader();
+    size_t faces = 0;
+    
+    for (auto _ : state) {
+        auto mesh = reader->readFile(path);
+        faces = mesh->getTriangleCount();
+        benchmark::DoNotOptimize(mesh.get());
+    }
+    
+    bench::reportThroughput(state, bytes, faces);
+}
+BENCHMARK(BM_DXFReader_ReadFile)->Apply(bench::dxfInputs)->Unit(benchmark::kMillisecond);
+
+static void BM_DXFReader_Split(benchmark::State& state) {
+    const std::string path = bench::inputDXFPath(state.range(0));
+    const size_t bytes = bench::inputDXF(state.range(0)).size();
+    ThreadPool pool;
+    auto reader = DXFReaderFactory::createReader();
+    reader->setThreadPool(&pool, 1024 * 1024);
+    size_t faces = 0;
+    
+    for (auto _ : state) {
+        auto mesh = reader->readFile(path);
+        faces = mesh->getTriangleCount();
+        benchmark::DoNotOptimize(mesh.get());
+    }
+    
+    bench::reportThroughput(state, bytes, faces);
+    state.counters["threads"] = static_cast<double>(pool.size());
+}
+BENCHMARK(BM_DXFReader_Split)->Apply(bench::dxfInputs)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_DXFPipeline(benchmark::State& state) {
+    const std::string path = bench::inputDXFPath(state.range(0));
+    auto summarizer = MeshSummarizerFactory::create("basic");
+    DXFPipeline pipeline;
+    PipelineResult result;
+    
+    for (auto _ : state) {
+        result = pipeline.run(path, *summarizer);
+        benchmark::DoNotOptimize(result.summary.triangleCount);
+    }
+    
+    bench::reportThroughput(state, result.bytesRead, result.entityCount);
+}
+BENCHMARK(BM_DXFPipeline)->Apply(bench::dxfInputs)->Unit(benchmark::kMillisecond)->UseRealTime();
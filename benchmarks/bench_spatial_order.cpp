@@ -0,0 +1,79 @@
+/**
+ * @file bench_spatial_order.cpp
+ * @brief Space-filling-curve reordering of shuffled generated meshes
+ *
+ * The generated grid is shuffled once per size to stand in for CAD export
+ * order; each iteration reorders a fresh copy. BM_SpatialOrder_Locality
+ * reports the mean centroid step between consecutive triangles before and
+ * after reordering (a grid walked cell by cell steps about 1 unit).
+ */
+
+#include "bench_fixtures.h"
+#include "SpatialOrder.h"
+#include <algorithm>
+
+using namespace DXFProcessor;
+
+namespace {
+
+    double meanStep(const MeshData& mesh) {
+        double length = 0.0;
+        for (size_t i = 1; i < mesh.getTriangleCount(); ++i) {
+            length += (mesh.getTriangle(i).center() - mesh.getTriangle(i - 1).center()).magnitude();
+        }
+        return length / std::max<size_t>(1, mesh.getTriangleCount() - 1);
+    }
+
+    void reorderBenchmark(benchmark::State& state, SpaceFillingCurve curve, size_t threadCount) {
+        const MeshData& shuffled = bench::shuffledMesh(state.range(0));
+        SpatialOrderOptions options;
+        options.curve = curve;
+        options.threadCount = threadCount;
+        SpatialOrder order(options);
+        
+        for (auto _ : state) {
+            state.PauseTiming();
+            MeshData mesh = shuffled;
+            state.ResumeTiming();
+            TrianglePermutation fileOrder = order.reorder(mesh);
+            benchmark::DoNotOptimize(fileOrder.size());
+        }
+        
+        bench::reportThroughput(state, shuffled.getTriangleCount() * sizeof(Triangle), shuffled.getTriangleCount());
+    }
+
+}
+
+static void BM_SpatialOrder_Hilbert(benchmark::State& state) {
+    reorderBenchmark(state, SpaceFillingCurve::Hilbert, 0);
+}
+BENCHMARK(BM_SpatialOrder_Hilbert)->Apply(bench::triangleCounts)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_SpatialOrder_HilbertSingleThread(benchmark::State& state) {
+    reorderBenchmark(state, SpaceFillingCurve::Hilbert, 1);
+}
+BENCHMARK(BM_SpatialOrder_HilbertSingleThread)->Apply(bench::triangleCounts)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_SpatialOrder_Morton(benchmark::State& state) {
+    reorderBenchmark(state, SpaceFillingCurve::Morton, 0);
+}
+BENCHMARK(BM_SpatialOrder_Morton)->Apply(bench::triangleCounts)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_SpatialOrder_Locality(benchmark::State& state) {
+    const MeshData& shuffled = bench::shuffledMesh(state.range(0));
+    MeshData hilbert = shuffled;
+    SpatialOrder().reorder(hilbert);
+    double before = 0.0;
+    double after = 0.0;
+
+    for (auto _ : state) {
+        before = meanStep(shuffled);
+        after = meanStep(hilbert);
+        benchmark::DoNotOptimize(after);
+    }
+
+    state.counters["step_shuffled"] = before;
+    state.counters["step_hilbert"] = after;
+    bench::reportThroughput(state, 0, 2 * shuffled.getTriangleCount());
+}
+BENCHMARK(BM_SpatialOrder_Locality)->Apply(bench::triangleCounts)->Unit(benchmark::kMillisecond)->UseRealTime();
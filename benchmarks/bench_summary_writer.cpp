@@ -0,0 +1,191 @@
+/**
+ * @file bench_summary_writer.cpp
+ * @brief Summaries per second: OutputBuffer formatting versus the ostringstream writer
+ *
+ * Both benchmarks format the same pretty-printed JSON summary (custom fields
+ * and a per-layer table) into memory; file I/O is left out so the numbers
+ * reflect formatting cost only. BM_SummaryWriter_Format covers every
+ * output format with the current writer.
+ */
+
+#include <benchmark/benchmark.h>
+#include "SummaryWriter.h"
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+
+using namespace DXFProcessor;
+
+namespace {
+
+    MeshSummary makeSummary() {
+        MeshSummary summary;
+        summary.triangleCount = 2929;
+        summary.totalSurfaceArea = 141519.88587813257;
+        summary.boundingBox.min = Point3D(-773.0, 668.71875, 196.739013671875);
+        summary.boundingBox.max = Point3D(-296.0, 1001.21875, 381.0);
+        summary.centroid = Point3D(-514.8155419690203, 819.8336532854855, 307.451017975482);
+        
+        const char* names[] = {"mesh_density", "average_triangle_area", "bounding_box_volume",
+                               "width", "height", "depth", "volume_estimate", "min_triangle_area"};
+        double value = 0.123456789;
+        for (const char* name : names) {
+            summary.customFields.set(name, value);
+            value *= 37.0;
+        }
+        
+        for (int i = 0; i < 8; ++i) {
+            GroupSummary layer;
+            layer.name = "Bench " + std::to_string(i);
+            layer.triangleCount = 300 + i;
+            layer.totalSurfaceArea = 17689.98 + i;
+            layer.boundingBox = summary.boundingBox;
+            layer.centroid = summary.centroid;
+            summary.layers.push_back(layer);
+        }
+        return summary;
+    }
+
+    // Custom fields as the old map<string,string> stored them: std::to_string text
+    std::map<std::string, std::string> legacyCustomFields(const MeshSummary& summary) {
+        std::map<std::string, std::string> fields;
+        for (const auto& [key, value] : summary.customFields) {
+            fields[std::string(key.name())] = std::to_string(std::get<double>(value));
+        }
+        return fields;
+    }
+
+    // The ostringstream JSON writer used before OutputBuffer
+    std::string legacyFormatAsJSON(const MeshSummary& summary,
+                                   const std::map<std::string, std::string>& customFields) {
+        std::ostringstream json;
+        
+        json << "{\n";
+        json << "  \"triangle_count\": " << summary.triangleCount << ",\n";
+        json << "  \"total_surface_area\": " << std::fixed << std::setprecision(6)
+             << summary.totalSurfaceArea << ",\n";
+        
+        json << "  \"bounding_box\": {\n";
+        json << "    \"min\": {\n";
+        json << "      \"x\": " << summary.boundingBox.min.x << ",\n";
+        json << "      \"y\": " << summary.boundingBox.min.y << ",\n";
+        json << "      \"z\": " << summary.boundingBox.min.z << "\n";
+        json << "    },\n";
+        json << "    \"max\": {\n";
+        json << "      \"x\": " << summary.boundingBox.max.x << ",\n";
+        json << "      \"y\": " << summary.boundingBox.max.y << ",\n";
+        json << "      \"z\": " << summary.boundingBox.max.z << "\n";
+        json << "    },\n";
+        json << "    \"size\": {\n";
+        Point3D size = summary.boundingBox.size();
+        json << "      \"width\": " << size.x << ",\n";
+        json << "      \"height\": " << size.y << ",\n";
+        json << "      \"depth\": " << size.z << "\n";
+        json << "    }\n";
+        json << "  },\n";
+        
+        json << "  \"centroid\": {\n";
+        json << "    \"x\": " << summary.centroid.x << ",\n";
+        json << "    \"y\": " << summary.centroid.y << ",\n";
+        json << "    \"z\": " << summary.centroid.z << "\n";
+        json << "  }";
+        
+        if (!customFields.empty()) {
+            json << ",\n  \"custom_fields\": {\n";
+            size_t count = 0;
+            for (const auto& [key, value] : customFields) {
+                json << "    \"" << key << "\": ";
+                try {
+                    double numValue = std::stod(value);
+                    json << std::fixed << std::setprecision(6) << numValue;
+                } catch (const std::exception&) {
+                    json << "\"" << value << "\"";
+                }
+                if (++count < customFields.size()) {
+                    json << ",";
+                }
+                json << "\n";
+            }
+            json << "  }";
+        }
+        
+        if (!summary.layers.empty()) {
+            json << ",\n  \"layers\": [\n";
+            for (size_t i = 0; i < summary.layers.size(); ++i) {
+                const GroupSummary& layer = summary.layers[i];
+                json << "    {\"name\": \"" << layer.name << "\""
+                     << ", \"triangle_count\": " << layer.triangleCount
+                     << ", \"total_surface_area\": " << layer.totalSurfaceArea
+                     << ", \"bounding_box\": {\"min\": {\"x\": " << layer.boundingBox.min.x
+                     << ", \"y\": " << layer.boundingBox.min.y << ", \"z\": " << layer.boundingBox.min.z
+                     << "}, \"max\": {\"x\": " << layer.boundingBox.max.x
+                     << ", \"y\": " << layer.boundingBox.max.y << ", \"z\": " << layer.boundingBox.max.z
+                     << "}}, \"centroid\": {\"x\": " << layer.centroid.x
+                     << ", \"y\": " << layer.centroid.y << ", \"z\": " << layer.centroid.z << "}}";
+                json << (i + 1 < summary.layers.size() ? ",\n" : "\n");
+            }
+            json << "  ]";
+        }
+        
+        json << "\n}";
+        return json.str();
+    }
+
+}
+
+static void BM_SummaryWriter_OutputBuffer(benchmark::State& state) {
+    const MeshSummary summary = makeSummary();
+    SummaryWriter writer(SummaryWriter::OutputFormat::JSON, ".");
+    writer.setIncludeTimestamp(false);
+    OutputBuffer out;
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        out.clear();
+        writer.format(summary, out);
+        bytes += out.size();
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_SummaryWriter_OutputBuffer);
+
+static void BM_SummaryWriter_Ostringstream(benchmark::State& state) {
+    const MeshSummary summary = makeSummary();
+    const auto customFields = legacyCustomFields(summary);
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        std::string json = legacyFormatAsJSON(summary, customFields);
+        bytes += json.size();
+        benchmark::DoNotOptimize(json.data());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_SummaryWriter_Ostringstream);
+
+static void BM_SummaryWriter_Format(benchmark::State& state, SummaryWriter::OutputFormat format) {
+    const MeshSummary summary = makeSummary();
+    SummaryWriter writer(format, ".");
+    writer.setIncludeTimestamp(false);
+    OutputBuffer out;
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        out.clear();
+        writer.format(summary, out);
+        bytes += out.size();
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK_CAPTURE(BM_SummaryWriter_Format, JSON, SummaryWriter::OutputFormat::JSON);
+BENCHMARK_CAPTURE(BM_SummaryWriter_Format, Text, SummaryWriter::OutputFormat::TEXT);
+BENCHMARK_CAPTURE(BM_SummaryWriter_Format, CSV, SummaryWriter::OutputFormat::CSV);
@@ -0,0 +1,108 @@
+/**
+ * @file bench_tokenizer.cpp
+ * @brief Line splitting and number conversion, the two costs under every parser
+ *
+ * The tokenizer benchmark only splits code/value pairs; the conversion
+ * benchmarks convert every coordinate value of the same input, isolated
+ * from tokenizing by collecting the values first.
+ */
+
+#include "bench_fixtures.h"
+#include "DXFTokenizer.h"
+#include <string_view>
+#include <vector>
+
+using namespace DXFProcessor;
+
+namespace {
+
+    // Values of the vertex coordinate groups (10-33) in the input
+    std::vector<std::string_view> coordinateValues(std::string_view bytes) {
+        std::vector<std::string_view> values;
+        DXFTokenizer tokenizer(bytes);
+        DXFGroup group;
+        while (tokenizer.next(group)) {
+            if (group.valid && group.code >= 10 && group.code <= 33) {
+                values.push_back(group.value);
+            }
+        }
+        return values;
+    }
+
+    size_t totalBytes(const std::vector<std::string_view>& values) {
+        size_t bytes = 0;
+        for (std::string_view value : values) {
+            bytes += value.size();
+        }
+        return bytes;
+    }
+
+}
+
+static void BM_Tokenizer_Groups(benchmark::State& state) {
+    const std::string& bytes = bench::inputDXF(state.range(0));
+    size_t groups = 0;
+
+    for (auto _ : state) {
+        DXFTokenizer tokenizer(bytes);
+        DXFGroup group;
+        groups = 0;
+        while (tokenizer.next(group)) {
+            benchmark::DoNotOptimize(group.value.data());
+            ++groups;
+        }
+    }
+
+    bench::reportThroughput(state, bytes.size(), 0);
+    state.counters["groups/s"] = benchmark::Counter(static_cast<double>(state.iterations() * groups),
+                                                    benchmark::Counter::kIsRate);
+    state.SetLabel(DXFTokenizer::implementationName());
+}
+BENCHMARK(BM_Tokenizer_Groups)->Apply(bench::dxfInputs)->Unit(benchmark::kMillisecond);
+
+static void BM_Tokenizer_ParseDouble(benchmark::State& state) {
+    const std::vector<std::string_view> values = coordinateValues(bench::inputDXF(state.range(0)));
+
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (std::string_view value : values) {
+            double coordinate;
+            if (DXFTokenizer::parseDouble(value, coordinate)) {
+                sum += coordinate;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    bench::reportThroughput(state, totalBytes(values), 0);
+    state.counters["values/s"] = benchmark::Counter(static_cast<double>(state.iterations() * values.size()),
+                                                    benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Tokenizer_ParseDouble)->Apply(bench::dxfInputs)->Unit(benchmark::kMillisecond);
+
+static void BM_Tokenizer_ParseInt(benchmark::State& state) {
+    const std::string& bytes = bench::inputDXF(state.range(0));
+    std::vector<std::string_view> codes;
+    DXFTokenizer tokenizer(bytes);
+    std::string_view code;
+    std::string_view value;
+    while (tokenizer.nextLine(code) && tokenizer.nextLine(value)) {
+        codes.push_back(code);
+    }
+
+    for (auto _ : state) {
+        long sum = 0;
+        for (std::string_view text : codes) {
+            int parsed;
+            if (DXFTokenizer::parseInt(text, parsed)) {
+                sum += parsed;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    bench::reportThroughput(state, totalBytes(codes), 0);
+    state.counters["values/s"] = benchmark::Counter(static_cast<double>(state.iterations() * codes.size()),
+                                                    benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Tokenizer_ParseInt)->Apply(bench::dxfInputs)->Unit(benchmark::kMillisecond);
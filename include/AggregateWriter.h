@@ -0,0 +1,119 @@
+#pragma once
+
+#include "MPSCQueue.h"
+#include "OutputBuffer.h"
+#include "SummaryWriter.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace DXFProcessor {
+
+    /**
+     * @brief Appends one summary row per input file to a single CSV or NDJSON file
+     *
+     * The alternative to SummaryWriter::writeToFile for large batches: instead
+     * of one small file per input, every summary becomes one row of a shared
+     * table. Rows are formatted on the calling thread and handed to a
+     * background writer thread through a lock-free queue, so callers never
+     * wait on file I/O or on each other.
+     *
+     * The columns are fixed when the writer is created: source, status,
+     * error, triangle count, surface area, bounding box, centroid, then one
+     * column per metric name. By default these are the metrics of every built-in
+     * summarizer, so rows from basic and detailed summaries line up. A metric
+     * a summary doesn't have is written as an empty CSV cell or JSON null;
+     * metrics outside the column set are not written.
+     *
+     * Rows appear in the order append() is called, not in input order.
+     *
+     * Usage:
+     * @code
+     * AggregateWriter table("results/batch_summary.csv", AggregateWriter::Format::CSV);
+     * table.append("site_01.dxf", summary);   // from any thread
+     * table.appendFailure("site_02.dxf", "No 3D faces found");
+     * table.close();                          // flushes and reports I/O errors
+     * @endcode
+     */
+    class AggregateWriter {
+    public:
+        enum class Format {
+            CSV,     ///< Header line, then one comma-separated row per input
+            NDJSON   ///< One JSON object per line
+        };
+        
+        /**
+         * @brief Creates the output file and starts the writer thread
+         * @param path Output file, replaced if it exists
+         * @param format Row format
+         * @param metricColumns Metric names to write, in column order
+         * @throws SummaryWriterException if the file cannot be created
+         */
+        AggregateWriter(const std::filesystem::path& path, Format format,
+                        std::vector<std::string> metricColumns = MeshSummarizerFactory::metricNames());
+        
+        /// Flushes remaining rows; errors are only reported by close()
+        ~AggregateWriter();
+        
+        AggregateWriter(const AggregateWriter&) = delete;
+        AggregateWriter& operator=(const AggregateWriter&) = delete;
+        
+        /**
+         * @brief Queues the row of a successfully summarized input
+         * @param source Input file name written in the source column
+         */
+        void append(const std::string& source, const MeshSummary& summary);
+        
+        /// Queues a row for an input that failed; numeric columns are left empty
+        void appendFailure(const std::string& source, const std::string& error);
+        
+        /**
+         * @brief Writes all queued rows, stops the writer thread and closes the file
+         * @throws SummaryWriterException if any write failed
+         */
+        void close();
+        
+        /// Rows queued so far
+        size_t rowCount() const { return rowCount_.load(std::memory_order_relaxed); }
+        
+        std::string path() const { return path_.string(); }
+        const std::vector<std::string>& columns() const { return columns_; }
+        
+        /**
+         * @brief Parses a format name
+         * @param name "csv" or "ndjson"
+         * @throws SummaryWriterException for other names
+         */
+        static Format parseFormat(const std::string& name);
+        
+        /// ".csv" or ".ndjson"
+        static std::string fileExtension(Format format);
+
+    private:
+        void enqueue(OutputBuffer& row);
+        void formatRow(OutputBuffer& out, const std::string& source, const MeshSummary* summary,
+                       const std::string& error) const;
+        void writerLoop();
+        
+        std::filesystem::path path_;
+        Format format_;
+        std::vector<std::string> columns_;
+        std::vector<MetricKey> metricKeys_;
+        
+        std::FILE* file_ = nullptr;
+        MPSCQueue<std::string> queue_;
+        std::atomic<size_t> rowCount_{0};
+        std::atomic<bool> writerSleeping_{false};
+        std::atomic<bool> closing_{false};
+        bool writeFailed_ = false;  ///< Written by the writer thread, read after join
+        std::mutex wakeMutex_;
+        std::condition_variable wakeUp_;
+        std::thread writer_;
+    };
+
+} // namespace DXFProcessor
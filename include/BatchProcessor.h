@@ -0,0 +1,151 @@
+#pragma once
+
+#include "DXFReader.h"
+#include "MeshPasses.h"
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace DXFProcessor {
+
+    class AggregateWriter;
+
+    /**
+     * @brief Exception thrown when a batch cannot be started
+     *
+     * Failures of individual files are recorded in BatchFileResult instead.
+     */
+    class BatchException : public std::runtime_error {
+    public:
+        explicit BatchException(const std::string& message)
+            : std::runtime_error("Batch Error: " + message) {}
+    };
+
+    /**
+     * @brief Settings shared by every file of a batch
+     */
+    struct BatchOptions {
+        std::string outputDir = ".";
+        std::string outputFormat = "json";
+        std::string summarizerType = "basic";
+        bool includeTimestamp = true;
+        bool prettyPrint = true;
+        bool groupByLayer = false;
+        size_t threadCount = 0;                              ///< Pool size; 0 = one per hardware thread
+        size_t splitBytes = DXFReader::DEFAULT_SPLIT_BYTES;  ///< Files this large are parsed in parallel ranges
+        std::string indexName = "batch_index";               ///< Combined index is written as <indexName>.json
+        std::string aggregateFormat;                         ///< "csv" or "ndjson": one table instead of a file per input
+        std::string aggregateName = "batch_summary";         ///< Base name of the aggregate table
+        
+        /**
+         * Repair and analysis passes run on every mesh before it is summarized.
+         * Their threadCount and threadPool are ignored: the passes of a large
+         * file split their work across the batch's own pool, where idle
+         * workers pick it up.
+         */
+        MeshPassOptions passes;
+    };
+
+    /**
+     * @brief Outcome of one file of a batch
+     */
+    struct BatchFileResult {
+        std::string inputPath;
+        bool success = false;
+        std::string outputPath;    ///< Summary file written (success only)
+        std::string error;         ///< Exception message (failure only)
+        std::uintmax_t fileSize = 0;
+        size_t triangleCount = 0;
+        double totalSurfaceArea = 0.0;
+        double seconds = 0.0;      ///< Wall time of read, passes, summarize and write
+    };
+
+    /**
+     * @brief Outcome of a whole batch, with files in input order
+     */
+    struct BatchResult {
+        std::vector<BatchFileResult> files;
+        std::string indexPath;     ///< Combined index file
+        std::string aggregatePath; ///< Aggregate table, if BatchOptions::aggregateFormat was set
+        double seconds = 0.0;
+        
+        size_t succeeded() const;
+        size_t failed() const { return files.size() - succeeded(); }
+    };
+
+    /**
+     * @brief Summarizes many DXF files in one process on a work-stealing pool
+     *
+     * Each file is one read -> passes -> summarize -> write job on a ThreadPool
+     * sized to the machine, with the passes of BatchOptions::passes. Files of
+     * at least BatchOptions::splitBytes are also parsed in parallel ranges on
+     * the same pool, and the passes of large meshes split their work there
+     * too, so one huge file doesn't leave the other workers idle at the end
+     * of a batch. Each summary is
+     * written under the input file's stem (made unique with a numeric suffix
+     * when two inputs share one); a failing file is recorded with its
+     * error and the batch carries on. When all jobs are done a combined JSON
+     * index of every file's outcome is written to the output directory.
+     *
+     * With BatchOptions::aggregateFormat set, summaries are appended as rows
+     * of a single AggregateWriter table instead, so a batch of thousands of
+     * inputs produces two files rather than thousands.
+     *
+     * Usage:
+     * @code
+     * BatchProcessor batch(options);
+     * BatchResult result = batch.run("surveys/site_*.dxf");
+     * std::cout << result.failed() << " files failed, see " << result.indexPath << "\n";
+     * @endcode
+     */
+    class BatchProcessor {
+    public:
+        explicit BatchProcessor(BatchOptions options) : options_(std::move(options)) {}
+        
+        /**
+         * @brief Expands a directory or a file-name glob into DXF file paths
+         *
+         * A directory yields every *.dxf file directly inside it (extension
+         * matched case-insensitively). Otherwise the last path component is a
+         * pattern with '*' and '?' wildcards matched within its directory.
+         *
+         * @param pattern Directory or glob, e.g. "nightly/" or "nightly/site_*.dxf"
+         * @return Sorted list of matching regular files
+         * @throws BatchException if the directory doesn't exist or nothing matches
+         */
+        static std::vector<std::string> expandInputs(const std::string& pattern);
+        
+        /**
+         * @brief Processes every file matched by a directory or glob
+         * @throws BatchException if no files match or the index or table can't be written
+         */
+        BatchResult run(const std::string& pattern);
+        
+        /**
+         * @brief Processes the given files
+         * @throws BatchException if the index or table can't be written
+         */
+        BatchResult run(const std::vector<std::string>& files);
+        
+        /**
+         * @brief Sets a callback invoked after each file completes
+         *
+         * Calls are serialized but come from worker threads, in completion order.
+         */
+        void setFileCallback(std::function<void(const BatchFileResult&)> callback) {
+            fileCallback_ = std::move(callback);
+        }
+
+    private:
+        BatchFileResult processFile(const std::string& inputPath, const std::string& baseName,
+                                    ThreadPool& pool, AggregateWriter* table) const;
+        std::string writeIndex(const BatchResult& result) const;
+        
+        BatchOptions options_;
+        std::function<void(const BatchFileResult&)> fileCallback_;
+    };
+
+} // namespace DXFProcessor
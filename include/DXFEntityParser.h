@@ -0,0 +1,347 @@
+#pragma once
+
+#include "MeshData.h"
+#include "DXFIndex.h"
+#include "DXFTokenizer.h"
+#include "Profiler.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace DXFProcessor {
+
+    /// Highest group code defined by the DXF reference (1071: 32-bit integer xdata)
+    inline constexpr int MAX_GROUP_CODE = 1071;
+
+    /**
+     * @brief Field slots of an entity with a fixed number of points
+     *
+     * Slot 3*i+axis holds the X/Y/Z value of vertex i, followed by layer,
+     * handle, color and flags. Codes the entity doesn't use go to a scratch
+     * slot, so storing a group never needs a branch.
+     */
+    template <std::size_t Vertices>
+    struct EntityLayout {
+        static_assert(Vertices >= 1 && Vertices <= 9, "DXF point codes cover at most 9 vertices");
+        
+        static constexpr std::uint8_t LAYER = static_cast<std::uint8_t>(3 * Vertices);
+        static constexpr std::uint8_t HANDLE = LAYER + 1;
+        static constexpr std::uint8_t COLOR = LAYER + 2;
+        static constexpr std::uint8_t FLAGS = LAYER + 3;
+        static constexpr std::uint8_t IGNORE = LAYER + 4;
+        static constexpr std::size_t SLOTS = IGNORE + 1;
+        
+        static constexpr std::uint8_t coordinate(std::size_t vertex, std::size_t axis) {
+            return static_cast<std::uint8_t>(3 * vertex + axis);
+        }
+        
+        /// Presence bits of the X slots of the first 'count' vertices
+        static constexpr std::uint64_t vertexMask(std::size_t count) {
+            std::uint64_t mask = 0;
+            for (std::size_t vertex = 0; vertex < count; ++vertex) {
+                mask |= std::uint64_t(1) << coordinate(vertex, 0);
+            }
+            return mask;
+        }
+    };
+
+    using GroupCodeTable = std::array<std::uint8_t, MAX_GROUP_CODE + 1>;
+
+    /**
+     * @brief Builds the group code to field slot table for an entity layout
+     *
+     * Point codes 10+i, 20+i and 30+i map to vertex i's X, Y and Z; code 8 is
+     * the layer, 5 the handle, 62 the color and 70 the flags. Everything else
+     * maps to the scratch slot.
+     */
+    template <std::size_t Vertices>
+    constexpr GroupCodeTable makeGroupCodeTable() {
+        using Layout = EntityLayout<Vertices>;
+        GroupCodeTable table{};
+        for (auto& slot : table) {
+            slot = Layout::IGNORE;
+        }
+        for (std::size_t vertex = 0; vertex < Vertices; ++vertex) {
+            for (std::size_t axis = 0; axis < 3; ++axis) {
+                table[10 * (axis + 1) + vertex] = Layout::coordinate(vertex, axis);
+            }
+        }
+        table[5] = Layout::HANDLE;
+        table[8] = Layout::LAYER;
+        table[62] = Layout::COLOR;
+        table[70] = Layout::FLAGS;
+        return table;
+    }
+
+    /// Tag types for the entity parsers
+    struct Face3DEntity {};
+    struct LineEntity {};
+
+    /**
+     * @brief Per-entity parameters for EntityParser
+     *
+     * A specialization provides the entity name, the number of points it
+     * stores and how many of them must be present for the entity to be
+     * usable. Adding an entity type is a new specialization; the parse loop
+     * is shared.
+     */
+    template <typename Entity>
+    struct EntityTraits;
+
+    template <>
+    struct EntityTraits<Face3DEntity> {
+        static constexpr std::string_view NAME = "3DFACE";
+        static constexpr std::size_t VERTICES = 4;
+        static constexpr std::size_t REQUIRED_VERTICES = 3;
+    };
+
+    template <>
+    struct EntityTraits<LineEntity> {
+        static constexpr std::string_view NAME = "LINE";
+        static constexpr std::size_t VERTICES = 2;
+        static constexpr std::size_t REQUIRED_VERTICES = 2;
+    };
+
+    /**
+     * @brief Raw field values of one parsed entity
+     *
+     * Values are kept as views into the tokenizer's buffer and converted on
+     * access, so coordinates the caller never reads are never parsed. The
+     * exceptions are the X coordinates EntityParser::parse checks; those are
+     * kept and reused by vertex(). The record is only valid as long as the
+     * buffer is.
+     */
+    template <std::size_t Vertices>
+    struct EntityRecord {
+        using Layout = EntityLayout<Vertices>;
+        
+        std::string_view fields[Layout::SLOTS];  ///< Only meaningful where the presence bit is set
+        std::uint64_t present = 0;              ///< Bit per slot that received a value
+        double checkedX[Vertices] = {};         ///< X coordinates converted by parse(), where checked has their bit
+        std::uint8_t checked = 0;               ///< Bit per vertex whose X is in checkedX
+        mutable std::size_t conversions = 0;    ///< Values converted from text through this record, for the profiler
+        
+        bool has(std::uint8_t slot) const { return (present >> slot) & 1u; }
+        
+        /// true if the vertex's X coordinate group was present and numeric
+        bool hasVertex(std::size_t index) const {
+            double x;
+            return ((checked >> index) & 1u) || coordinate(index, 0, x);
+        }
+        
+        /**
+         * @brief Converts the vertex's X and keeps it for vertex()
+         * @return true if the X group was present and numeric
+         */
+        bool checkVertex(std::size_t index) {
+            if (!coordinate(index, 0, checkedX[index])) {
+                return false;
+            }
+            checked |= static_cast<std::uint8_t>(1u << index);
+            return true;
+        }
+        
+        /**
+         * @brief Converts one coordinate
+         * @param value Receives the coordinate, or 0.0 if it is absent or unparseable
+         * @return true if the group was present and numeric
+         */
+        bool coordinate(std::size_t vertex, std::size_t axis, double& value) const {
+            std::uint8_t slot = Layout::coordinate(vertex, axis);
+            if (has(slot)) {
+                ++conversions;
+                if (DXFTokenizer::parseDouble(fields[slot], value)) {
+                    return true;
+                }
+            }
+            value = 0.0;
+            return false;
+        }
+        
+        /// Vertex position; a missing or unparseable Y or Z reads as 0.0
+        Point3D vertex(std::size_t index) const {
+            Point3D point;
+            if ((checked >> index) & 1u) {
+                point.x = checkedX[index];
+            } else {
+                coordinate(index, 0, point.x);
+            }
+            coordinate(index, 1, point.y);
+            coordinate(index, 2, point.z);
+            return point;
+        }
+        
+        /// Layer name, "0" when the entity has no layer group
+        std::string_view layer() const { return has(Layout::LAYER) ? fields[Layout::LAYER] : "0"; }
+        
+        std::string_view handle() const { return has(Layout::HANDLE) ? fields[Layout::HANDLE] : std::string_view(); }
+        
+        /// ACI color number, 256 (BYLAYER) when absent
+        int color() const { return integer(Layout::COLOR, 256); }
+        
+        int flags() const { return integer(Layout::FLAGS, 0); }
+
+    private:
+        int integer(std::uint8_t slot, int fallback) const {
+            if (!has(slot)) {
+                return fallback;
+            }
+            ++conversions;
+            int value;
+            return DXFTokenizer::parseInt(fields[slot], value) ? value : fallback;
+        }
+    };
+
+    /**
+     * @brief Table-driven parser for one DXF entity type
+     *
+     * Every group code is looked up in a constexpr table generated from
+     * EntityTraits<Entity>; the inner loop stores the value view in the slot
+     * the table names and sets its presence bit, with no per-code switch.
+     *
+     * Usage:
+     * @code
+     * EntityParser<Face3DEntity>::Record face;
+     * if (EntityParser<Face3DEntity>::parse(tokenizer, group, face)) {
+     *     Triangle triangle(face.vertex(0), face.vertex(1), face.vertex(2));
+     * }
+     * @endcode
+     */
+    template <typename Entity>
+    class EntityParser {
+    public:
+        using Traits = EntityTraits<Entity>;
+        using Layout = EntityLayout<Traits::VERTICES>;
+        using Record = EntityRecord<Traits::VERTICES>;
+        
+        static constexpr GroupCodeTable TABLE = makeGroupCodeTable<Traits::VERTICES>();
+        
+        /**
+         * @brief Consumes the groups of one entity
+         *
+         * @param tokenizer Tokenizer positioned just after the entity's "0 / NAME" pair
+         * @param group Receives the pair that ended the entity (next code 0); valid
+         *              is false if the end of the buffer was reached
+         * @param record Receives the entity's fields
+         * @return true if the X coordinate of every required vertex was present and
+         *         numeric; a face whose X fails to parse is dropped, not placed at 0
+         */
+        static bool parse(DXFTokenizer& tokenizer, DXFGroup& group, Record& record) {
+            record.present = 0;
+            record.checked = 0;
+            
+            while (true) {
+                if (!tokenizer.next(group)) {
+                    group.valid = false;
+                    break;
+                }
+                if (!group.valid) {
+                    continue;  // Not a valid code, skip the line
+                }
+                if (group.code == 0) {
+                    break;  // Next entity found
+                }
+                
+                std::uint8_t slot = static_cast<unsigned>(group.code) <= static_cast<unsigned>(MAX_GROUP_CODE)
+                    ? TABLE[static_cast<std::size_t>(group.code)] : Layout::IGNORE;
+                record.fields[slot] = group.value;
+                record.present |= std::uint64_t(1) << slot;
+            }
+            
+            if ((record.present & REQUIRED_MASK) != REQUIRED_MASK) {
+                return false;
+            }
+            for (std::size_t vertex = 0; vertex < Traits::REQUIRED_VERTICES; ++vertex) {
+                if (!record.checkVertex(vertex)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    private:
+        static constexpr std::uint64_t REQUIRED_MASK = Layout::vertexMask(Traits::REQUIRED_VERTICES);
+    };
+
+    /**
+     * @brief Parses the 3DFACE entities of one byte range of a DXF file into a mesh
+     * 
+     * Tracks SECTION/ENDSEC groups so only faces inside ENTITIES are kept.
+     * A range that doesn't start at the beginning of the file must start on a
+     * code-0 group, with inEntitiesSection saying whether that group lies
+     * inside the ENTITIES section.
+     * 
+     * If an index is given, the sections and faces met in the range are
+     * recorded in it as they are parsed, so a sidecar costs no second scan.
+     * A section closed in this range but opened before it is recorded with
+     * only its end (see DXFIndex::append).
+     * 
+     * @param text Byte range to parse
+     * @param inEntitiesSection In: section state at the start of the range; out: state at its end
+     * @param meshData Receives the triangles (first three vertices) tagged with their layers
+     * @param index If set, receives the range's sections and faces, tagged with meshData's layer ids
+     * @param textOffset File offset of text, added to the offsets recorded in index
+     * @return Number of faces added to meshData
+     */
+    inline size_t parseFaceRange(std::string_view text, bool& inEntitiesSection, MeshData& meshData,
+                                 DXFIndex* index = nullptr, std::uint64_t textOffset = 0) {
+        DXFTokenizer tokenizer(text);
+        DXFGroup group;
+        EntityParser<Face3DEntity>::Record face;
+        size_t faceCount = 0;
+        
+        bool haveGroup = tokenizer.next(group);
+        while (haveGroup) {
+            if (group.valid && group.code == 0) {
+                if (group.value == "SECTION") {
+                    if (index != nullptr) {
+                        index->sections.emplace_back();
+                        index->sections.back().begin = textOffset + group.offset;
+                    }
+                    haveGroup = tokenizer.next(group);
+                    if (haveGroup && group.valid && group.code == 2) {
+                        inEntitiesSection = (group.value == "ENTITIES");
+                        if (index != nullptr) {
+                            index->sections.back().name = std::string(group.value);
+                        }
+                        haveGroup = tokenizer.next(group);
+                    }
+                    continue;
+                } else if (group.value == "ENDSEC") {
+                    inEntitiesSection = false;
+                    if (index != nullptr) {
+                        if (index->sections.empty() || index->sections.back().end != 0) {
+                            index->sections.emplace_back();  // Opened before this range
+                        }
+                        index->sections.back().end = textOffset + tokenizer.position();
+                    }
+                } else if (inEntitiesSection && group.value == "3DFACE") {
+                    const size_t faceBegin = group.offset;
+                    // Leaves the entity's terminating code-0 group in 'group'
+                    bool parsed = EntityParser<Face3DEntity>::parse(tokenizer, group, face);
+                    haveGroup = group.valid && group.code == 0;
+                    if (parsed) {
+                        Triangle triangle(face.vertex(0), face.vertex(1), face.vertex(2));
+                        LayerId layer = meshData.internLayer(face.layer());
+                        meshData.addTriangle(triangle, layer);
+                        ++faceCount;
+                        if (index != nullptr) {
+                            const size_t faceEnd = haveGroup ? group.offset : tokenizer.position();
+                            index->addFace(textOffset + faceBegin, textOffset + faceEnd, layer, triangle);
+                        }
+                    }
+                    continue;
+                }
+            }
+            haveGroup = tokenizer.next(group);
+        }
+        
+        // Counted once per range: every group code and every value the face records converted
+        DXF_PROFILE_COUNT(Lines, tokenizer.lineCount());
+        DXF_PROFILE_COUNT(Entities, faceCount);
+        DXF_PROFILE_COUNT(NumericConversions, tokenizer.codeCount() + face.conversions);
+        return faceCount;
+    }
+
+} // namespace DXFProcessor
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+namespace DXFProcessor {
+
+    class OutputBuffer;
+
+    /**
+     * @brief Exception thrown for invalid generator options or failed writes
+     */
+    class GeneratorException : public std::runtime_error {
+    public:
+        explicit GeneratorException(const std::string& message)
+            : std::runtime_error("Generator Error: " + message) {}
+    };
+
+    /**
+     * @brief Shape and encoding of a generated surface
+     */
+    struct GeneratorOptions {
+        size_t faceCount = 100000;   ///< 3DFACE entities to write
+        size_t layerCount = 6;       ///< Depth bands, written as layers PIT_01, PIT_02, ...
+        bool quads = false;          ///< One four-corner face per grid cell instead of two triangles
+        double noise = 0.25;         ///< Peak vertical roughness added to every grid vertex
+        double cellSize = 2.0;       ///< Grid spacing in drawing units (metres)
+        bool crlf = false;           ///< CRLF line endings (ASCII only), as AutoCAD writes on Windows
+        bool binary = false;         ///< Binary DXF instead of ASCII
+        std::uint64_t seed = 1;      ///< Noise seed; equal options give byte-identical files
+        size_t threadCount = 0;      ///< Formatting threads; 0 = one per hardware thread
+    };
+
+    /**
+     * @brief Size and timing of one generated file
+     */
+    struct GeneratorResult {
+        size_t faceCount = 0;
+        std::uintmax_t bytesWritten = 0;
+        double seconds = 0.0;
+    };
+
+    /**
+     * @brief Writes synthetic open-pit TIN surfaces as DXF, for scale testing
+     *
+     * The surface is a regular grid draped over an elliptical pit: a gently
+     * tilted natural surface, twelve benches of batter face and berm, and a
+     * flat floor, roughened by hash noise. Faces are emitted row by row in
+     * blocks of FACES_PER_BLOCK; blocks are formatted in parallel on a
+     * thread pool and written in order, two waves in flight, so memory stays
+     * bounded however many faces are requested.
+     *
+     * Every vertex is a pure function of its grid position and the seed, so
+     * the output does not depend on the thread count or the machine (number
+     * formatting uses std::to_chars). Coordinates are rounded to millimetres
+     * and placed at mine-grid magnitudes (easting 512000, northing 7004000).
+     *
+     * Binary output follows the R13+ layout: the 22-byte sentinel, then
+     * 2-byte little-endian group codes with NUL-terminated strings, 8-byte
+     * doubles and 2-byte integers. DXFReader reads ASCII DXF only.
+     *
+     * @code
+     * GeneratorOptions options;
+     * options.faceCount = 100'000'000;
+     * options.seed = 42;
+     * GeneratorResult result = DXFGenerator(options).write("pit_100m.dxf");
+     * @endcode
+     */
+    class DXFGenerator {
+    public:
+        /// @throws GeneratorException if an option is out of range
+        explicit DXFGenerator(GeneratorOptions options = GeneratorOptions());
+        
+        /**
+         * @brief Generates the surface into a file, replacing it
+         * @throws GeneratorException if the file cannot be created or written
+         */
+        GeneratorResult write(const std::filesystem::path& path) const;
+        
+        /// Generates the whole file in memory; meant for small fixtures
+        std::string generate() const;
+        
+        const GeneratorOptions& options() const { return options_; }
+        
+        /// Faces formatted per task
+        static constexpr size_t FACES_PER_BLOCK = 16384;
+        
+        /// First line of every binary DXF file, including its trailing NUL
+        static constexpr char BINARY_SENTINEL[] = "AutoCAD Binary DXF\r\n\x1a";
+        static constexpr size_t BINARY_SENTINEL_SIZE = 22;
+
+    private:
+        template <typename Sink>
+        GeneratorResult run(Sink&& sink) const;
+        
+        void formatHeader(OutputBuffer& out) const;
+        void formatFaces(size_t firstFace, size_t count, OutputBuffer& out) const;
+        void formatFooter(OutputBuffer& out) const;
+        
+        GeneratorOptions options_;
+        size_t columns_ = 0;   ///< Grid cells per row
+        size_t rows_ = 0;
+    };
+
+} // namespace DXFProcessor
@@ -0,0 +1,212 @@
+#pragma once
+
+#include "MeshData.h"
+#include "MappedFile.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <stdexcept>
+
+namespace DXFProcessor {
+
+    /**
+     * @brief Exception thrown by index building, loading and queries
+     */
+    class DXFIndexException : public std::runtime_error {
+    public:
+        explicit DXFIndexException(const std::string& message)
+            : std::runtime_error("DXF Index Error: " + message) {}
+    };
+
+    /**
+     * @brief Byte range of one DXF section (HEADER, TABLES, ENTITIES, ...)
+     */
+    struct DXFSectionRange {
+        std::string name;
+        std::uint64_t begin = 0;  ///< Offset of the "0 / SECTION" code line
+        std::uint64_t end = 0;    ///< Offset just past the "0 / ENDSEC" value line
+    };
+
+    /**
+     * @brief Location and XY footprint of one 3DFACE entity
+     * 
+     * Stored verbatim in the sidecar file, so the layout is fixed at 32 bytes.
+     * The float bounds are rounded outward so window tests never miss a face.
+     */
+    struct DXFIndexEntry {
+        std::uint64_t offset;  ///< Offset of the entity's "0 / 3DFACE" code line
+        std::uint32_t length;  ///< Bytes up to the next entity's code line
+        LayerId layer;         ///< Index into DXFIndex::layerNames
+        std::uint16_t reserved;
+        float minX, minY, maxX, maxY;
+    };
+
+    static_assert(sizeof(DXFIndexEntry) == 32, "DXFIndexEntry must stay 32 bytes for the sidecar format");
+
+    /**
+     * @brief Selection of entities for an indexed read
+     * 
+     * An empty layer list selects all layers; a query without a window selects
+     * the whole drawing.
+     */
+    struct DXFIndexQuery {
+        std::vector<std::string> layers;
+        bool hasWindow = false;
+        double minX = 0.0, minY = 0.0, maxX = 0.0, maxY = 0.0;
+        
+        static DXFIndexQuery window(double minX, double minY, double maxX, double maxY) {
+            DXFIndexQuery query;
+            query.hasWindow = true;
+            query.minX = minX;
+            query.minY = minY;
+            query.maxX = maxX;
+            query.maxY = maxY;
+            return query;
+        }
+    };
+
+    /**
+     * @brief Compact random-access index of a DXF file
+     * 
+     * Records section offsets plus, for every 3DFACE, its byte offset, layer and
+     * XY bounding box. The index is saved next to the DXF file as a binary
+     * sidecar (`<file>.dxfidx`) so later runs can seek straight to the entities
+     * a query needs instead of scanning from the start.
+     */
+    class DXFIndex {
+    public:
+        static constexpr std::uint32_t FORMAT_VERSION = 2;
+        
+        /// Bytes hashed at each end of the DXF file to tell edited files from the indexed one
+        static constexpr size_t STAMP_BYTES = 64 * 1024;
+        
+        std::uint64_t sourceSize = 0;      ///< Size of the indexed DXF file
+        std::int64_t sourceModified = 0;   ///< Last write time of the indexed file, in file clock ticks
+        std::uint64_t sourceHash = 0;      ///< Hash of the first and last STAMP_BYTES of the indexed file
+        std::vector<DXFSectionRange> sections;
+        std::vector<std::string> layerNames{"0"};
+        std::vector<DXFIndexEntry> faces;
+        
+        /**
+         * @brief Builds an index by scanning a mapped DXF file once
+         * @param file Mapped DXF file
+         * @return Index of all sections and 3DFACE entities
+         */
+        static DXFIndex build(const MappedFile& file);
+        
+        /**
+         * @brief Builds an index for the DXF file at the given path
+         * @param dxfPath DXF file to scan
+         * @return Index of all sections and 3DFACE entities
+         * @throws DXFIndexException if the file cannot be mapped
+         */
+        static DXFIndex build(const std::string& dxfPath);
+        
+        /**
+         * @brief Loads a sidecar index from disk
+         * 
+         * Counts, layer ids and offsets are checked against the sidecar's size
+         * and the recorded source size, so a corrupt sidecar is rejected here
+         * rather than indexing out of bounds later.
+         * 
+         * @param indexPath Path of the .dxfidx file
+         * @throws DXFIndexException if the file is missing, truncated, inconsistent or of another version
+         */
+        static DXFIndex load(const std::string& indexPath);
+        
+        /**
+         * @brief Writes the index as a binary sidecar file
+         * @param indexPath Destination path
+         * @throws DXFIndexException if the file cannot be written
+         */
+        void save(const std::string& indexPath) const;
+        
+        /**
+         * @brief Default sidecar location for a DXF file
+         * @return dxfPath with ".dxfidx" appended
+         */
+        static std::string sidecarPath(const std::string& dxfPath) {
+            return dxfPath + ".dxfidx";
+        }
+        
+        /**
+         * @brief Selects the faces matching a query
+         * @return Indices into faces, in file order
+         */
+        std::vector<size_t> select(const DXFIndexQuery& query) const;
+        
+        const DXFSectionRange* findSection(const std::string& name) const;
+        
+        /// Appends the entry of a face spanning [begin, end), with its XY bounds rounded outward
+        void addFace(std::uint64_t begin, std::uint64_t end, LayerId layer,
+                     double minX, double minY, double maxX, double maxY);
+        
+        /// Appends the entry of a parsed triangle spanning [begin, end)
+        void addFace(std::uint64_t begin, std::uint64_t end, LayerId layer, const Triangle& triangle);
+        
+        /**
+         * @brief Appends what another index recorded for a later byte range of the same file
+         * 
+         * The part's face layers are mapped through layerMap; its layer names
+         * are ignored. A leading part section with no begin offset or name
+         * only supplies the end of this index's last, still open section.
+         */
+        void append(DXFIndex&& part, const std::vector<LayerId>& layerMap);
+        
+        /// Records the size, modification time and end hashes of the indexed file
+        void stampSource(const MappedFile& file);
+        
+        /**
+         * @brief Tells whether the index still describes a DXF file
+         * 
+         * Size, modification time and the hash of both ends must all match,
+         * so an edit that keeps the byte count still invalidates the index.
+         */
+        bool matchesSource(const MappedFile& file) const;
+    };
+
+    /**
+     * @brief Reads subsets of a large DXF file through its sidecar index
+     * 
+     * The DXF file is memory-mapped with a random-access hint and only the
+     * entities selected by the index are parsed, so a window or layer query
+     * touches just the pages holding those entities.
+     * 
+     * Usage:
+     * @code
+     * DXFIndexedReader reader("survey.dxf");
+     * auto window = reader.read(DXFIndexQuery::window(-700, 700, -600, 800));
+     * @endcode
+     */
+    class DXFIndexedReader {
+    public:
+        /**
+         * @brief Opens a DXF file and its sidecar index
+         * 
+         * Loads `<file>.dxfidx` when present and still matching the file (see
+         * DXFIndex::matchesSource); otherwise builds the index and, if
+         * writeSidecar is set, saves it. A sidecar that cannot be written is
+         * skipped and the index is kept in memory only.
+         * 
+         * @param dxfPath DXF file to open
+         * @param writeSidecar Save a freshly built index next to the DXF file
+         * @throws DXFIndexException if the file cannot be mapped
+         */
+        explicit DXFIndexedReader(const std::string& dxfPath, bool writeSidecar = true);
+        
+        /**
+         * @brief Parses only the entities selected by the query
+         * @param query Layer and/or XY window selection
+         * @return Mesh with the selected triangles, tagged with their layers
+         */
+        std::unique_ptr<MeshData> read(const DXFIndexQuery& query) const;
+        
+        const DXFIndex& index() const { return index_; }
+
+    private:
+        MappedFile file_;
+        DXFIndex index_;
+    };
+
+} // namespace DXFProcessor
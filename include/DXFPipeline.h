@@ -0,0 +1,93 @@
+#pragma once
+
+#include "MeshData.h"
+#include "MeshSummarizer.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace DXFProcessor {
+
+    /**
+     * @brief Tuning knobs of DXFPipeline
+     */
+    struct PipelineOptions {
+        size_t chunkBytes = 1 << 20;  ///< Bytes read per I/O call; chunks are cut on code-0 groups
+        size_t queueDepth = 4;        ///< Chunks and triangle batches in flight between two stages
+    };
+
+    /**
+     * @brief Where one pipeline stage spent its time
+     *
+     * busySeconds is the stage's own work. inputWaitSeconds is time starved
+     * for input from the previous stage; outputWaitSeconds is back-pressure,
+     * time blocked because the next stage had not yet released a buffer.
+     * The stage with the most busy time and the least waiting is the bottleneck.
+     */
+    struct PipelineStageStats {
+        std::string name;
+        size_t items = 0;             ///< Chunks or batches the stage handled
+        double busySeconds = 0.0;
+        double inputWaitSeconds = 0.0;
+        double outputWaitSeconds = 0.0;
+        size_t inputWaits = 0;        ///< Times the stage found its input queue empty
+        size_t outputWaits = 0;       ///< Times the stage found its output queue full
+    };
+
+    /**
+     * @brief Summary and stage statistics of one pipelined read
+     */
+    struct PipelineResult {
+        MeshSummary summary;
+        size_t entityCount = 0;       ///< 3DFACE entities parsed
+        size_t bytesRead = 0;
+        double seconds = 0.0;         ///< Wall time from open to summary
+        std::vector<PipelineStageStats> stages;  ///< read, parse, accumulate
+    };
+
+    /**
+     * @brief Streams a DXF file through concurrent read, parse and accumulate stages
+     *
+     * An alternative to DXFReader::readFile followed by summarize() that
+     * never holds the whole file or mesh in memory:
+     * - read: a thread fread()s fixed-size chunks, each cut before its last
+     *   code-0 group so no entity straddles two chunks;
+     * - parse: a second thread tokenizes each chunk and parses its 3DFACE
+     *   entities into a batch of triangles;
+     * - accumulate: the calling thread folds each batch into running totals
+     *   and per-layer accumulators, then builds the summary.
+     *
+     * Stages are connected by bounded SPSC queues. Chunk buffers and triangle
+     * batches are recycled through return queues, so memory stays bounded by
+     * queueDepth and a slow stage holds back the ones before it.
+     *
+     * Summarizers that are not streamable (see MeshSummarizer::isStreamable)
+     * get the whole mesh: batches are collected and summarize() runs at the end.
+     *
+     * Usage:
+     * @code
+     * DXFPipeline pipeline;
+     * auto summarizer = MeshSummarizerFactory::create("basic");
+     * PipelineResult result = pipeline.run("site.dxf", *summarizer);
+     * @endcode
+     */
+    class DXFPipeline {
+    public:
+        explicit DXFPipeline(PipelineOptions options = PipelineOptions());
+        
+        /**
+         * @brief Reads, parses and summarizes a DXF file
+         * @param filePath DXF file to read
+         * @param summarizer Summarizer whose settings (e.g. group by layer) apply
+         * @return Summary plus per-stage timing and queue wait counters
+         * @throws DXFReaderException if the file can't be read or has no 3D faces
+         */
+        PipelineResult run(const std::string& filePath, MeshSummarizer& summarizer);
+        
+        const PipelineOptions& options() const { return options_; }
+
+    private:
+        PipelineOptions options_;
+    };
+
+} // namespace DXFProcessor
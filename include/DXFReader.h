@@ -1,13 +1,22 @@
 #pragma once
 
 #include "MeshData.h"
+#include "ReadProgress.h"
 #include <string>
+#include <string_view>
 #include <memory>
+#include <memory_resource>
 #include <stdexcept>
 #include <functional>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 
 namespace DXFProcessor {
 
+    class ThreadPool;
+    class DXFIndex;
+
     /**
      * @brief Exception thrown by DXF reading operations
      * 
@@ -20,6 +29,40 @@ namespace DXFProcessor {
             : std::runtime_error("DXF Reader Error: " + message) {}
     };
 
+    /**
+     * @brief Thrown when a read stops because its CancellationToken was set
+     * 
+     * Derives from DXFReaderException so existing handlers still catch it;
+     * catch it first to tell a user's cancel apart from a failed read.
+     */
+    class DXFReadCancelledException : public DXFReaderException {
+    public:
+        DXFReadCancelledException() : DXFReaderException("Read cancelled") {}
+    };
+
+    /**
+     * @brief Drawing metadata taken from the HEADER section of a DXF file
+     * 
+     * Values are copied verbatim from header variables ($ACADVER, $INSUNITS,
+     * $EXTMIN, $EXTMAX); nothing is recomputed from the entities. The entity
+     * count is an estimate derived from the file size.
+     */
+    struct DXFHeaderInfo {
+        std::string acadVersion;          ///< $ACADVER, e.g. "AC1027" for AutoCAD 2013
+        int insUnits = 0;                 ///< $INSUNITS code (0 = unitless)
+        bool hasExtents = false;          ///< true if both $EXTMIN and $EXTMAX were present
+        BoundingBox extents;              ///< Drawing extents from $EXTMIN/$EXTMAX
+        std::uintmax_t fileSize = 0;      ///< Size of the DXF file in bytes
+        std::uintmax_t headerBytes = 0;   ///< Bytes read up to the end of the HEADER section
+        size_t estimatedEntityCount = 0;  ///< Rough entity count from file size
+        
+        /**
+         * @brief Human-readable name of the $INSUNITS code
+         * @return Unit name such as "meters", or "unknown" for unrecognised codes
+         */
+        std::string unitsName() const;
+    };
+
     /**
      * @brief High-performance DXF file parser for extracting 3D mesh data
      * 
@@ -28,15 +71,20 @@ namespace DXFProcessor {
      * 
      * Key features:
      * - Handles large DXF files (tested with 2900+ entities)
-     * - Progress reporting for long-running operations
+     * - Byte-based progress and cooperative cancellation, checked per chunk
      * - Cross-platform compatibility (Windows, Linux, macOS)
-     * - Memory-efficient line-based parsing
+     * - Memory-mapped input with a SIMD block tokenizer (no per-line strings)
+     * - Per-parse scratch from an arena owned by the reader, released in one
+     *   shot after each read; reuse a reader across files to reuse its arena
      * - Comprehensive error handling
      * 
      * Usage:
      * @code
      * auto reader = std::make_unique<DXFReader>();
-     * reader->setProgressCallback([](double p) { std::cout << (p*100) << "%\n"; });
+     * ReadProgress progress;        // Polled by a UI thread
+     * CancellationToken cancel;     // cancel.cancel() from any thread stops the read
+     * reader->setProgress(&progress);
+     * reader->setCancellationToken(&cancel);
      * auto meshData = reader->readFile("model.dxf");
      * std::cout << "Found " << meshData->getTriangleCount() << " triangles\n";
      * @endcode
@@ -58,11 +106,29 @@ namespace DXFProcessor {
          */
         std::unique_ptr<MeshData> readFile(const std::string& filePath);
         
+        /**
+         * @brief Reads only the HEADER section of a DXF file
+         * 
+         * Stops at the HEADER section's ENDSEC without touching the entities,
+         * so the cost is independent of the drawing size. Suitable for building
+         * catalog indexes of many files.
+         * 
+         * @param filePath Path to the DXF file
+         * @return Header variables and an entity count estimate
+         * @throws DXFReaderException if the file doesn't exist or has no HEADER section
+         */
+        DXFHeaderInfo readHeader(const std::string& filePath);
+        
+        /// Average size of an ASCII 3DFACE entity, used for entity count estimates
+        static constexpr std::uintmax_t ESTIMATED_BYTES_PER_ENTITY = 260;
+        
         /**
          * @brief Sets callback function for progress reporting
          * 
-         * The callback receives progress values from 0.0 (start) to 1.0 (complete)
-         * and is called periodically during parsing operations.
+         * The callback receives the share of bytes consumed, from 0.0 to 1.0,
+         * on the reading thread once per PROGRESS_CHUNK_BYTES chunk (per
+         * range when parsing in parallel), and 1.0 at the end. Prefer
+         * setProgress for a UI that can poll.
          * 
          * @param callback Function to call with progress updates (0.0 to 1.0)
          */
@@ -70,13 +136,83 @@ namespace DXFProcessor {
             progressCallback_ = callback;
         }
         
+        /**
+         * @brief Publishes bytes consumed to a ReadProgress another thread can poll
+         * 
+         * The counters are restarted with the file size when a read opens its
+         * file, advanced after every parsed chunk and completed at the end.
+         * 
+         * @param progress Progress to update (not owned), or nullptr
+         */
+        void setProgress(ReadProgress* progress) { progress_ = progress; }
+        
+        /**
+         * @brief Makes reads stop early once the token is cancelled
+         * 
+         * The token is checked before each chunk of PROGRESS_CHUNK_BYTES (and
+         * by every range task when parsing in parallel). A cancelled read
+         * releases its mapping and partial mesh during unwinding and throws
+         * DXFReadCancelledException; no index is written.
+         * 
+         * @param token Token to check (not owned), or nullptr
+         */
+        void setCancellationToken(const CancellationToken* token) { cancellation_ = token; }
+        
+        /// Bytes parsed between progress updates and cancellation checks
+        static constexpr size_t PROGRESS_CHUNK_BYTES = 1024 * 1024;
+        
+        /**
+         * @brief Enables writing a random-access sidecar index after each read
+         * 
+         * When enabled, readFile also writes `<file>.dxfidx` (see DXFIndex),
+         * which DXFIndexedReader uses to re-read layers or spatial windows
+         * without scanning the whole file. The entries are recorded while
+         * the entities are parsed, not by a second scan.
+         * 
+         * @param enable true to write the sidecar index
+         */
+        void setWriteIndex(bool enable) { writeIndex_ = enable; }
+        
+        /**
+         * @brief Converts each mesh read to float32 local-origin storage
+         * 
+         * After parsing, readFile calls MeshData::compact(), which keeps
+         * the mesh in double precision if any coordinate would move by more
+         * than MeshData::COMPACT_TOLERANCE.
+         * 
+         * @param enable true to return compact meshes where possible
+         */
+        void setCompactStorage(bool enable) { compactStorage_ = enable; }
+        
+        /**
+         * @brief Parses large files in parallel on a thread pool
+         * 
+         * Files of at least splitBytes are cut into ranges of about that size
+         * at entity boundaries, and the ranges are parsed as tasks on the pool.
+         * The resulting mesh is identical to a sequential read. Smaller files,
+         * and every file when pool is nullptr, are parsed on the calling thread.
+         * 
+         * @param pool Pool to run range tasks on (not owned), or nullptr
+         * @param splitBytes Minimum file size to split, and the target range size
+         */
+        void setThreadPool(ThreadPool* pool, size_t splitBytes = DEFAULT_SPLIT_BYTES) {
+            threadPool_ = pool;
+            splitBytes_ = splitBytes > 0 ? splitBytes : DEFAULT_SPLIT_BYTES;
+        }
+        
+        /// Default range size for parallel parsing
+        static constexpr size_t DEFAULT_SPLIT_BYTES = 16 * 1024 * 1024;
+        
+        /// Scratch bytes kept inside the reader; a parse needing more spills to the heap
+        static constexpr size_t SCRATCH_ARENA_BYTES = 16 * 1024;
+        
         /**
          * @brief Gets the number of entities processed in the last parsing operation
          * 
          * @return Number of 3DFACE entities successfully parsed
          */
         size_t getLastEntityCount() const { return lastEntityCount_; }
-        
+
     protected:
         /**
          * @brief Internal parsing implementation (can be overridden in derived classes)
@@ -85,30 +221,26 @@ namespace DXFProcessor {
          * @return Parsed mesh data
          */
         virtual std::unique_ptr<MeshData> parseFile(const std::string& filePath);
-        
+
     private:
-        /**
-         * @brief Represents a DXF code-value pair
-         * 
-         * DXF files consist of alternating code and value lines.
-         * Codes indicate the type of data, values contain the actual data.
-         */
-        struct DXFCode {
-            int code;           ///< DXF group code (e.g., 10 for X coordinate)
-            std::string value;  ///< Associated value
-        };
-        
-        bool readNextCode(std::ifstream& file, DXFCode& code);
-        bool parse3DFace(std::ifstream& file, Triangle& triangle);
-        bool parse3DFaceSimple(std::ifstream& file, Triangle& triangle);
-        bool parse3DFaceStreamlined(std::ifstream& file, Triangle& triangle);
-        bool parse3DFaceFromLines(const std::vector<std::string>& lines, size_t& index, Triangle& triangle);
-        Point3D parsePoint(std::ifstream& file, int xCode, int yCode, int zCode);
-        
+        void parseSplit(std::string_view text, MeshData& meshData, DXFIndex* index);
+        size_t parseChunked(std::string_view text, std::uint64_t textOffset, bool& inEntitiesSection,
+                            MeshData& meshData, DXFIndex* index, const std::function<void(size_t)>& onChunk);
+        void throwIfCancelled() const;
         void reportProgress(double progress);
         
         std::function<void(double)> progressCallback_;
+        ReadProgress* progress_ = nullptr;
+        const CancellationToken* cancellation_ = nullptr;
         size_t lastEntityCount_ = 0;
+        bool writeIndex_ = false;
+        bool compactStorage_ = false;
+        ThreadPool* threadPool_ = nullptr;
+        size_t splitBytes_ = DEFAULT_SPLIT_BYTES;
+        
+        // Arena for allocations that die with the parse; only the reading thread allocates from it
+        alignas(std::max_align_t) std::array<std::byte, SCRATCH_ARENA_BYTES> scratchBuffer_;
+        std::pmr::monotonic_buffer_resource scratch_{scratchBuffer_.data(), scratchBuffer_.size()};
     };
 
     /**
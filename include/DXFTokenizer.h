@@ -0,0 +1,210 @@
+#pragma once
+
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+#include <charconv>
+#include <system_error>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace DXFProcessor {
+
+    /**
+     * @brief One DXF group: an integer code and a view of its value line
+     * 
+     * The value view points into the tokenizer's buffer and is valid for as
+     * long as that buffer is.
+     */
+    struct DXFGroup {
+        int code = 0;            ///< DXF group code (e.g. 10 for X coordinate)
+        std::string_view value;  ///< Trimmed value line (or the raw line if !valid)
+        size_t offset = 0;       ///< Byte offset of the code line
+        bool valid = false;      ///< false if the code line was not an integer
+    };
+
+    /**
+     * @brief Block-based tokenizer producing DXF (code, value) pairs from memory
+     * 
+     * The input is classified 64 bytes at a time into a newline bit mask and a
+     * blank (space/tab) bit mask using AVX2 or SSE2 when available, with a
+     * portable scalar fallback. Newline bits of a 4 KB chunk are flattened into
+     * an offset list, so cutting a line is a list pop plus one bit scan for the
+     * leading blanks instead of a byte-at-a-time search. Handles both LF and
+     * CRLF line endings.
+     * 
+     * Invalid code lines are reported with valid == false and consume a single
+     * line, so callers resynchronise on the next line just like the old
+     * line-array parser did.
+     * 
+     * Usage:
+     * @code
+     * DXFTokenizer tokenizer(bytes);
+     * DXFGroup group;
+     * while (tokenizer.next(group)) {
+     *     if (group.valid && group.code == 0 && group.value == "3DFACE") { ... }
+     * }
+     * @endcode
+     */
+    class DXFTokenizer {
+    public:
+        static constexpr size_t BLOCK_SIZE = 64;
+        static constexpr size_t CHUNK_SIZE = 4096;
+        
+        explicit DXFTokenizer(std::string_view buffer, size_t begin = 0)
+            : buffer_(buffer), pos_(begin) {
+            loadChunk(begin);
+        }
+        
+        /**
+         * @brief Reads the next code-value pair
+         * @param group Receives the pair
+         * @return false at end of buffer (including a trailing code without value)
+         */
+        bool next(DXFGroup& group) {
+            group.offset = pos_;
+            std::string_view codeLine;
+            if (!nextLine(codeLine)) {
+                return false;
+            }
+            
+            group.valid = parseInt(codeLine, group.code);
+            ++codeCount_;
+            if (!group.valid) {
+                group.value = codeLine;
+                return true;
+            }
+            return nextLine(group.value);
+        }
+        
+        /**
+         * @brief Reads the next trimmed line
+         * @param line Receives the line without leading blanks or trailing blanks/CR
+         * @return false at end of buffer
+         */
+        bool nextLine(std::string_view& line) {
+            const size_t size = buffer_.size();
+            if (pos_ >= size) {
+                return false;
+            }
+            if (pos_ >= chunkEnd_) {
+                loadChunk(pos_);
+            }
+            
+            // Skip leading blanks with one bit scan of the block's blank mask
+            size_t relative = pos_ - chunkStart_;
+            uint64_t nonBlank = ~blankMasks_[relative / BLOCK_SIZE] >> (relative % BLOCK_SIZE);
+            if (nonBlank != 0) {
+                pos_ += countTrailingZeros(nonBlank);
+            } else {
+                skipBlanksSlow();
+            }
+            size_t start = pos_ < size ? pos_ : size;
+            
+            // Pop the next newline offset; lines crossing the chunk end take the slow path
+            size_t newline;
+            if (newlineIndex_ < newlineCount_ && chunkStart_ + newlineOffsets_[newlineIndex_] >= start) {
+                newline = chunkStart_ + newlineOffsets_[newlineIndex_++];
+            } else {
+                newline = findNewlineSlow(start);
+            }
+            
+            size_t end = newline;
+            const char* data = buffer_.data();
+            while (end > start && isTrailingBlank(data[end - 1])) {
+                --end;
+            }
+            line = std::string_view(data + start, end - start);
+            pos_ = newline + 1;
+            ++lineCount_;
+            return true;
+        }
+        
+        /// Offset of the next unread byte
+        size_t position() const { return pos_ < buffer_.size() ? pos_ : buffer_.size(); }
+        
+        /// Number of lines consumed so far
+        size_t lineCount() const { return lineCount_; }
+        
+        /// Number of group code lines converted by next() so far, valid or not
+        size_t codeCount() const { return codeCount_; }
+        
+        std::string_view buffer() const { return buffer_; }
+        
+        /**
+         * @brief Parses a whole string_view as a decimal integer
+         * @return true if the entire view is an optionally signed integer
+         */
+        static bool parseInt(std::string_view text, int& value) {
+            // Group codes are at most four digits; keep the hot path off from_chars
+            if (!text.empty() && text.size() <= 4 && text.front() >= '0' && text.front() <= '9') {
+                int result = 0;
+                for (char c : text) {
+                    if (c < '0' || c > '9') {
+                        return false;
+                    }
+                    result = result * 10 + (c - '0');
+                }
+                value = result;
+                return true;
+            }
+            if (!text.empty() && text.front() == '+') {
+                text.remove_prefix(1);
+            }
+            auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+            return result.ec == std::errc() && result.ptr == text.data() + text.size() && !text.empty();
+        }
+        
+        /**
+         * @brief Parses a floating point value (leading '+' accepted)
+         * @return true if a number was parsed from the start of the view
+         */
+        static bool parseDouble(std::string_view text, double& value) {
+            if (!text.empty() && text.front() == '+') {
+                text.remove_prefix(1);
+            }
+            auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+            return result.ec == std::errc();
+        }
+        
+        /**
+         * @brief Name of the block classifier selected for this CPU
+         * @return "AVX2", "SSE2" or "scalar"
+         */
+        static const char* implementationName();
+        
+    private:
+        void loadChunk(size_t from);
+        void skipBlanksSlow();
+        size_t findNewlineSlow(size_t from);
+        
+        static bool isTrailingBlank(char c) {
+            return c == '\r' || c == ' ' || c == '\t';
+        }
+        
+        static unsigned countTrailingZeros(uint64_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long index;
+            _BitScanForward64(&index, mask);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+        }
+        
+        std::string_view buffer_;
+        size_t pos_ = 0;
+        size_t lineCount_ = 0;
+        size_t codeCount_ = 0;
+        
+        size_t chunkStart_ = 0;   ///< Offset of the classified chunk (64-byte aligned)
+        size_t chunkEnd_ = 0;     ///< End of the classified chunk
+        size_t newlineCount_ = 0;
+        size_t newlineIndex_ = 0;
+        uint16_t newlineOffsets_[CHUNK_SIZE];               ///< Newline offsets relative to chunkStart_
+        uint64_t blankMasks_[CHUNK_SIZE / BLOCK_SIZE + 1];  ///< Blank bits per block (+1 sentinel)
+    };
+
+} // namespace DXFProcessor
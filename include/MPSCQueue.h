@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+namespace DXFProcessor {
+
+    /**
+     * @brief Unbounded lock-free multi-producer single-consumer queue
+     *
+     * Intrusive linked list with a stub node (Vyukov's MPSC queue). push() is
+     * one allocation and one atomic exchange, so producers never wait on each
+     * other or on the consumer; tryPop() must only be called from a single
+     * consumer thread at a time.
+     *
+     * A push that is half done (exchange made, link not yet stored) is not
+     * visible to tryPop() until it completes, so the consumer may briefly see
+     * the queue as empty while a producer is mid-push.
+     */
+    template <typename T>
+    class MPSCQueue {
+    public:
+        MPSCQueue() : head_(&stub_), tail_(&stub_) {}
+        
+        ~MPSCQueue() {
+            T discarded;
+            while (tryPop(discarded)) {
+            }
+            if (tail_ != &stub_) {
+                delete tail_;
+            }
+        }
+        
+        MPSCQueue(const MPSCQueue&) = delete;
+        MPSCQueue& operator=(const MPSCQueue&) = delete;
+        
+        /// Appends a value; safe to call from any number of threads
+        void push(T value) {
+            Node* node = new Node(std::move(value));
+            Node* previous = head_.exchange(node, std::memory_order_acq_rel);
+            previous->next.store(node, std::memory_order_release);
+        }
+        
+        /**
+         * @brief Removes the oldest value (consumer thread only)
+         * @return false if no completed push is pending
+         */
+        bool tryPop(T& value) {
+            Node* tail = tail_;
+            Node* next = tail->next.load(std::memory_order_acquire);
+            if (next == nullptr) {
+                return false;
+            }
+            value = std::move(next->value);
+            tail_ = next;
+            if (tail != &stub_) {
+                delete tail;
+            }
+            return true;
+        }
+
+    private:
+        struct Node {
+            Node() = default;
+            explicit Node(T v) : value(std::move(v)) {}
+            
+            std::atomic<Node*> next{nullptr};
+            T value{};
+        };
+        
+        std::atomic<Node*> head_;  ///< Most recently pushed node (producers)
+        Node* tail_;               ///< Last consumed node, whose next is the oldest value (consumer)
+        Node stub_;
+    };
+
+} // namespace DXFProcessor
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+#include <stdexcept>
+
+namespace DXFProcessor {
+
+    /**
+     * @brief Exception thrown when a file cannot be memory-mapped
+     */
+    class MappedFileException : public std::runtime_error {
+    public:
+        explicit MappedFileException(const std::string& message)
+            : std::runtime_error("Mapped File Error: " + message) {}
+    };
+
+    /**
+     * @brief Read-only memory mapping of a whole file
+     * 
+     * Wraps mmap (POSIX) or MapViewOfFile (Windows) so that large DXF files can
+     * be accessed by byte offset without reading them into memory. Only the
+     * pages actually touched are loaded by the operating system.
+     * 
+     * Usage:
+     * @code
+     * MappedFile file("model.dxf");
+     * std::string_view bytes = file.view();
+     * @endcode
+     */
+    class MappedFile {
+    public:
+        /**
+         * @brief Access pattern hint passed to the operating system
+         */
+        enum class AccessHint {
+            Sequential,  ///< Whole-file scans (aggressive read-ahead)
+            Random       ///< Scattered reads by offset (minimal read-ahead)
+        };
+        
+        MappedFile() = default;
+        
+        /**
+         * @brief Maps the given file read-only
+         * @param filePath File to map
+         * @param hint Expected access pattern
+         * @throws MappedFileException if the file cannot be opened or mapped
+         */
+        explicit MappedFile(const std::string& filePath, AccessHint hint = AccessHint::Sequential);
+        ~MappedFile();
+        
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        
+        const char* data() const { return data_; }
+        size_t size() const { return size_; }
+        const std::string& path() const { return path_; }
+        
+        std::string_view view() const { return std::string_view(data_, size_); }
+        
+        /**
+         * @brief Unmaps the file; the object can be reused by move-assignment
+         */
+        void close();
+        
+    private:
+        std::string path_;
+        const char* data_ = nullptr;
+        size_t size_ = 0;
+        
+#ifdef _WIN32
+        void* fileHandle_ = nullptr;
+        void* mappingHandle_ = nullptr;
+#else
+        int fd_ = -1;
+#endif
+    };
+
+} // namespace DXFProcessor
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "MeshData.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace DXFProcessor {
+
+    class ThreadPool;
+
+    /// Why a triangle was flagged by MeshCleaner
+    enum class TriangleDefect : std::uint8_t {
+        None = 0,
+        Degenerate,  ///< Area or shape quality at or under the thresholds (zero-area slivers, repeated vertices)
+        Duplicate    ///< Same vertices as an earlier triangle, in any order
+    };
+
+    struct CleanupOptions {
+        /// Triangles with this area or less are degenerate; 0 flags only exactly flat ones
+        double minArea = 0.0;
+        
+        /**
+         * Triangles whose shape quality 4√3·area / (sum of squared edge
+         * lengths) is below this are degenerate. Quality is 1 for an
+         * equilateral triangle and falls towards 0 as it becomes a sliver;
+         * the default only catches needles a million times longer than wide.
+         */
+        double minQuality = 1e-6;
+        
+        /// Grid step, in drawing units, on which vertices are compared for duplicates
+        double precision = 1e-6;
+        size_t threadCount = 0;  ///< Threads for the inspection; 0 = one per hardware thread
+        ThreadPool* threadPool = nullptr;  ///< Shared pool to run on (not owned); replaces threadCount when set
+    };
+
+    /**
+     * @brief Flags of every triangle and how many of each kind
+     */
+    struct CleanupReport {
+        std::vector<TriangleDefect> defects;  ///< Parallel to the inspected triangles; empty after clean()
+        size_t degenerateTriangles = 0;
+        size_t duplicateTriangles = 0;        ///< Not counting the first copy, which is kept
+        size_t removedTriangles = 0;          ///< Set by clean()
+    };
+
+    /**
+     * @brief Finds degenerate and duplicate triangles, and optionally removes them
+     *
+     * CAD exports carry zero-area slivers and faces exported twice, which
+     * drag down the minimum triangle area, inflate the small-triangle count
+     * and double-count volume. One parallel pass over ranges of triangles
+     * measures each one against CleanupOptions and hashes its three
+     * vertices, quantized to CleanupOptions::precision and sorted, so the
+     * key ignores vertex order and winding. The (hash, index) keys are then
+     * radix sorted; within each run of equal hashes the quantized vertices
+     * are compared exactly, so a hash collision never flags a triangle, and
+     * every copy after the lowest-index one is a duplicate. A degenerate
+     * triangle is reported only as degenerate.
+     *
+     * @code
+     * CleanupReport report = MeshCleaner().clean(*meshData);
+     * std::cout << report.removedTriangles << " faces removed\n";
+     * @endcode
+     */
+    class MeshCleaner {
+    public:
+        explicit MeshCleaner(CleanupOptions options = CleanupOptions());
+        
+        /**
+         * @brief Flags every triangle without changing the mesh
+         * @throws std::invalid_argument if CleanupOptions::precision is not positive
+         */
+        CleanupReport inspect(const MeshData& meshData) const;
+        
+        /**
+         * @brief Inspects the mesh and removes every flagged triangle
+         *
+         * Removal compacts the mesh in place (MeshData::removeTriangles),
+         * keeping the order of the remaining triangles.
+         */
+        CleanupReport clean(MeshData& meshData) const;
+        
+        const CleanupOptions& options() const { return options_; }
+
+    private:
+        CleanupOptions options_;
+    };
+
+} // namespace DXFProcessor
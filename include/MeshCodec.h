@@ -0,0 +1,104 @@
+#pragma once
+
+#include "MeshData.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace DXFProcessor {
+
+    /**
+     * @brief Exception thrown for invalid codec options, unwritable files and corrupt input
+     */
+    class MeshCodecException : public std::runtime_error {
+    public:
+        explicit MeshCodecException(const std::string& message)
+            : std::runtime_error("Mesh Codec Error: " + message) {}
+    };
+
+    /**
+     * @brief Precision and layout of an encoded mesh
+     */
+    struct MeshCodecOptions {
+        double precision = 0.001;          ///< Quantization step in drawing units (1 mm for metre drawings)
+        size_t trianglesPerBlock = 65536;  ///< Triangles per independently decodable block
+        size_t threadCount = 0;            ///< Encode/decode threads; 0 = one per hardware thread
+    };
+
+    /**
+     * @brief Compressed binary serialization of MeshData (".dxm" files)
+     *
+     * Encoding is lossy by at most precision / 2 per coordinate:
+     * - every coordinate is quantized to an integer number of 'precision'
+     *   steps from the bounding box minimum;
+     * - triangles are sorted by the Morton code of their quantized centroid,
+     *   so neighbours in the file are neighbours in space, and cut into
+     *   blocks of trianglesPerBlock;
+     * - each block lists its distinct vertices in first-use order as
+     *   zigzag varint deltas from the previous vertex, then three varint
+     *   vertex references per triangle (0 = the next new vertex, k = the
+     *   k-th vertex before it), then run-length encoded layer ids.
+     *
+     * Blocks share nothing but the header's layer table, so they are encoded
+     * and decoded in parallel, each straight into its slice of the mesh.
+     * Triangle order is not preserved; layers are. Typical TIN surfaces
+     * take 6 to 8 bytes per triangle, against about 200 in DXF text.
+     *
+     * File layout (little-endian):
+     * @code
+     * "DXFMESH\0"  u32 version  u32 blockCount  f64 precision  f64 origin[3]
+     * u64 triangleCount  u32 layerCount  {u16 length, bytes} per layer
+     * {u64 offset, u32 bytes, u32 triangles, u32 vertices} per block
+     * block payloads
+     * @endcode
+     *
+     * @code
+     * MeshCodec codec;                          // 1 mm
+     * codec.save(*meshData, "pit.dxm");
+     * auto restored = codec.load("pit.dxm");
+     * @endcode
+     */
+    class MeshCodec {
+    public:
+        static constexpr std::uint32_t FORMAT_VERSION = 1;
+        
+        /// @throws MeshCodecException if precision is not positive or trianglesPerBlock is 0
+        explicit MeshCodec(MeshCodecOptions options = MeshCodecOptions());
+        
+        /**
+         * @brief Encodes a mesh (double or compact storage) into the .dxm format
+         * @throws MeshCodecException if a coordinate is too far from the origin for the precision
+         */
+        std::string encode(const MeshData& meshData) const;
+        
+        /**
+         * @brief Decodes a .dxm image into a double-precision mesh
+         * @throws MeshCodecException if the data is truncated, corrupt or of another version
+         */
+        std::unique_ptr<MeshData> decode(std::string_view bytes) const;
+        
+        /**
+         * @brief Encodes a mesh into a file, replacing it
+         * @throws MeshCodecException if the mesh cannot be encoded or the file written
+         */
+        void save(const MeshData& meshData, const std::string& path) const;
+        
+        /**
+         * @brief Memory-maps and decodes a .dxm file
+         * @throws MeshCodecException if the file cannot be opened or is not a valid .dxm file
+         */
+        std::unique_ptr<MeshData> load(const std::string& path) const;
+        
+        const MeshCodecOptions& options() const { return options_; }
+        
+        /// True if the path ends in ".dxm"
+        static bool isMeshFile(const std::string& path);
+
+    private:
+        MeshCodecOptions options_;
+    };
+
+} // namespace DXFProcessor
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "MeshData.h"
+#include "MeshSummarizer.h"
+#include "MeshTopology.h"
+#include <cstddef>
+#include <vector>
+
+namespace DXFProcessor {
+
+    /// What makes two triangles part of the same component
+    enum class ComponentConnectivity {
+        Vertex,  ///< Sharing a welded vertex (touching corners join pieces)
+        Edge     ///< Sharing a manifold edge; pieces meeting at a point or a non-manifold edge stay apart
+    };
+
+    struct ComponentOptions {
+        ComponentConnectivity connectivity = ComponentConnectivity::Vertex;
+        
+        /**
+         * Components with a smaller surface area are removed from the mesh by
+         * ComponentLabeler::analyze; 0 keeps every component.
+         */
+        double minArea = 0.0;
+        size_t threadCount = 0;  ///< Threads for topology and labeling; 0 = one per hardware thread
+        ThreadPool* threadPool = nullptr;  ///< Shared pool to run on (not owned); replaces threadCount when set
+    };
+
+    /**
+     * @brief Component of every triangle
+     *
+     * Components are numbered from 0 in the order of their lowest triangle
+     * index, so the numbering does not depend on the thread count.
+     */
+    struct ComponentLabels {
+        std::vector<MeshTopology::Index> componentOf;  ///< Parallel to the triangles
+        size_t count = 0;
+    };
+
+    /**
+     * @brief What ComponentLabeler::analyze found and removed
+     */
+    struct ComponentAnalysis {
+        std::vector<ComponentSummary> components;  ///< Components kept in the mesh, in label order
+        size_t droppedComponents = 0;              ///< Components under minArea, removed from the mesh
+        size_t droppedTriangles = 0;
+    };
+
+    /**
+     * @brief Splits a mesh into connected pieces with a lock-free union-find
+     *
+     * Tells one continuous surface from several disjoint ones (stray faces,
+     * separate stockpiles, a detached ramp). Triangles are the union-find
+     * elements; threads unite the triangles around each vertex (or across
+     * each linked edge) of the MeshTopology, one range per thread, with
+     * compare-and-swap links on a shared parent array and no locks. A root
+     * is always linked under the smaller root, so every component ends up
+     * rooted at its lowest triangle index whatever the interleaving.
+     *
+     * @code
+     * ComponentOptions options;
+     * options.minArea = 1.0;  // Drop slivers and stray faces under 1 m²
+     * ComponentAnalysis analysis = ComponentLabeler(options).analyze(*meshData);
+     * summary.components = std::move(analysis.components);
+     * @endcode
+     */
+    class ComponentLabeler {
+    public:
+        explicit ComponentLabeler(ComponentOptions options = ComponentOptions());
+        
+        /// Builds the topology of meshData and labels its components
+        ComponentLabels label(const MeshData& meshData) const;
+        
+        /**
+         * @brief Labels components using a topology already built from the mesh
+         * @throws std::invalid_argument if the topology has a different triangle count
+         */
+        ComponentLabels label(const MeshTopology& topology) const;
+        
+        /**
+         * @brief Count, area, bounds, centroid and volume of every component, in one pass
+         * @return One entry per label, named "Component 1", "Component 2", ...
+         * @throws std::invalid_argument if the labels don't match the mesh
+         */
+        static std::vector<ComponentSummary> summarize(const MeshData& meshData, const ComponentLabels& labels);
+        
+        /**
+         * @brief Labels and summarizes the components, removing those below ComponentOptions::minArea
+         *
+         * Removal compacts the mesh in place (MeshData::removeTriangles);
+         * the kept components are renumbered so their names stay consecutive.
+         */
+        ComponentAnalysis analyze(MeshData& meshData) const;
+        
+        /**
+         * @brief As analyze(MeshData&), labeling with a topology already built from the mesh
+         *
+         * Lets one topology serve several passes; MeshOrienter's flips don't
+         * change which triangles it connects, so it may come from before orienting.
+         *
+         * @throws std::invalid_argument if the topology has a different triangle count
+         */
+        ComponentAnalysis analyze(MeshData& meshData, const MeshTopology& topology) const;
+        
+        const ComponentOptions& options() const { return options_; }
+
+    private:
+        ComponentOptions options_;
+    };
+
+} // namespace DXFProcessor
@@ -1,9 +1,17 @@
 #pragma once
 
+#include "SegmentedVector.h"
+#include <algorithm>
 #include <vector>
 #include <array>
 #include <limits>
 #include <cmath>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <stdexcept>
+#include <utility>
 
 namespace DXFProcessor {
 
@@ -135,6 +143,22 @@ namespace DXFProcessor {
         }
     };
 
+    /**
+     * @brief Single-precision point, relative to a mesh's local origin
+     */
+    struct Point3F {
+        float x, y, z;
+    };
+
+    /**
+     * @brief Triangle stored in a compact MeshData: float32 offsets from the mesh origin
+     * 
+     * Half the size of Triangle (36 instead of 72 bytes).
+     */
+    struct CompactTriangle {
+        std::array<Point3F, 3> vertices;
+    };
+
     /**
      * @brief Axis-aligned bounding box for 3D geometry
      * 
@@ -194,53 +218,638 @@ namespace DXFProcessor {
         }
     };
 
+    /**
+     * @brief Compact identifier of an interned DXF layer name
+     *
+     * Layer ids index into MeshData::getLayerNames(). Id 0 is always the DXF
+     * default layer "0".
+     */
+    using LayerId = std::uint16_t;
+
+    /**
+     * @brief Whole-mesh figures gathered in a single pass over the triangles
+     *
+     * Returned by MeshData::getAggregates, which keeps them until the mesh changes.
+     */
+    struct MeshAggregates {
+        size_t triangleCount = 0;
+        BoundingBox boundingBox;
+        double totalSurfaceArea = 0.0;
+        Point3D centroid;              ///< Area-weighted centre of the triangles; (0, 0, 0) if the area is 0
+        double minTriangleArea = 0.0;  ///< 0 for an empty mesh
+        double maxTriangleArea = 0.0;
+        double signedVolume = 0.0;     ///< Sum of v0 . (v1 x v2) / 6; the enclosed volume of a closed mesh
+    };
+
+    /**
+     * @brief Triangles with per-triangle layer ids
+     * 
+     * Triangles are stored in double precision until compact() is called.
+     * A compact mesh stores them as float32 offsets from a local origin (the
+     * bounding box centre), which halves triangle memory while drawings stay
+     * within a few kilometres. getTriangle, forEachTriangle and the
+     * aggregates return world coordinates in double precision in both
+     * modes; the getTriangles() sequence is only filled in double mode.
+     * 
+     * Triangles and layer ids live in SegmentedVectors, so a growing mesh
+     * never reallocates and copies what it already holds.
+     * 
+     * Aggregates (getAggregates, getBoundingBox, getTotalSurfaceArea) and
+     * the per-triangle area and normal columns are computed on first use
+     * and cached until a member function changes the mesh, so summarizing
+     * a mesh several ways costs one pass. The storage is only writable
+     * through members that drop the cache, so it can't go stale. Since
+     * const queries fill the cache, the first query must not race with
+     * another from a different thread.
+     */
     class MeshData {
     public:
-        std::vector<Triangle> triangles;
+        static constexpr LayerId DEFAULT_LAYER = 0;  ///< Id of the DXF default layer "0"
+        
+        /// Default largest per-coordinate round-trip error compact() accepts (0.1 mm for metre drawings)
+        static constexpr double COMPACT_TOLERANCE = 1e-4;
         
         MeshData() = default;
         
         void addTriangle(const Triangle& triangle) {
-            triangles.push_back(triangle);
+            addTriangle(triangle, DEFAULT_LAYER);
+        }
+        
+        void addTriangle(const Triangle& triangle, LayerId layer) {
+            invalidateAggregates();
+            if (compact_) {
+                CompactTriangle local = toLocal(triangle, origin_);
+                if (roundTrips(triangle, local, origin_, tolerance_)) {
+                    compactTriangles_.push_back(local);
+                    triangleLayers_.push_back(layer);
+                    return;
+                }
+                expand();  // Too far from the origin for float32
+            }
+            triangles_.push_back(triangle);
+            triangleLayers_.push_back(layer);
         }
         
         void addTriangle(const Point3D& v1, const Point3D& v2, const Point3D& v3) {
-            triangles.emplace_back(v1, v2, v3);
+            addTriangle(Triangle(v1, v2, v3), DEFAULT_LAYER);
+        }
+        
+        /**
+         * @brief Switches to float32 storage relative to the bounding box centre
+         * 
+         * Every vertex is converted and converted back; if any coordinate
+         * moves by more than 'tolerance', the mesh is left in double
+         * precision and false is returned. Needs both copies while
+         * converting, then releases the double-precision triangles.
+         * Triangles added afterwards get the same check against the same
+         * origin; the first one that fails it returns the whole mesh to
+         * double precision, so isCompact() may turn false again.
+         * 
+         * @param tolerance Largest accepted round-trip error per coordinate
+         * @return true if the mesh is compact
+         */
+        bool compact(double tolerance = COMPACT_TOLERANCE) {
+            if (compact_ || triangles_.empty()) {
+                return compact_;
+            }
+            
+            const Point3D origin = getBoundingBox().center();
+            SegmentedVector<CompactTriangle> packed;
+            packed.reserve(triangles_.size());
+            for (size_t b = 0; b < triangles_.blockCount(); ++b) {
+                for (const auto& triangle : triangles_.block(b)) {
+                    CompactTriangle local = toLocal(triangle, origin);
+                    if (!roundTrips(triangle, local, origin, tolerance)) {
+                        return false;
+                    }
+                    packed.push_back(local);
+                }
+            }
+            
+            compactTriangles_ = std::move(packed);
+            triangles_ = SegmentedVector<Triangle>();
+            origin_ = origin;
+            tolerance_ = tolerance;
+            compact_ = true;
+            invalidateAggregates();  // Float32 rounding moves the figures slightly
+            return true;
+        }
+        
+        bool isCompact() const {
+            return compact_;
+        }
+        
+        /// Local origin of a compact mesh; (0, 0, 0) in double mode
+        const Point3D& getOrigin() const {
+            return origin_;
+        }
+        
+        /// Triangle in world coordinates, whatever the storage mode
+        Triangle getTriangle(size_t index) const {
+            return compact_ ? toWorld(compactTriangles_[index], origin_) : triangles_[index];
+        }
+        
+        /**
+         * @brief Calls visit(const Triangle&) for every triangle, in order, in world coordinates
+         * 
+         * Compact triangles are widened to double and moved back by the
+         * origin one at a time, so visitors accumulate in double precision.
+         */
+        template <typename Visitor>
+        void forEachTriangle(Visitor&& visit) const {
+            if (compact_) {
+                for (size_t b = 0; b < compactTriangles_.blockCount(); ++b) {
+                    for (const auto& local : compactTriangles_.block(b)) {
+                        visit(toWorld(local, origin_));
+                    }
+                }
+            } else {
+                for (size_t b = 0; b < triangles_.blockCount(); ++b) {
+                    for (const auto& triangle : triangles_.block(b)) {
+                        visit(triangle);
+                    }
+                }
+            }
+        }
+        
+        /**
+         * @brief Returns the id of a layer name, registering it on first use
+         * @param name DXF layer name (group code 8)
+         * @return Interned layer id
+         * @throws std::overflow_error if more than 65536 distinct layers are interned
+         */
+        LayerId internLayer(std::string_view name) {
+            // Consecutive entities usually share a layer
+            if (name == layerNames_[lastLayer_]) {
+                return lastLayer_;
+            }
+            if (name == layerNames_[DEFAULT_LAYER]) {
+                return lastLayer_ = DEFAULT_LAYER;
+            }
+            // The key buffer is reused, so looking up a known layer never allocates
+            lookupKey_.assign(name.data(), name.size());
+            auto it = layerIndex_.find(lookupKey_);
+            if (it != layerIndex_.end()) {
+                return lastLayer_ = it->second;
+            }
+            if (layerNames_.size() > std::numeric_limits<LayerId>::max()) {
+                throw std::overflow_error("Too many distinct layers: " + lookupKey_);
+            }
+            LayerId id = static_cast<LayerId>(layerNames_.size());
+            layerNames_.push_back(lookupKey_);
+            layerIndex_.emplace(lookupKey_, id);
+            return lastLayer_ = id;
+        }
+        
+        /// Double-precision triangles, in order; empty once compact
+        const SegmentedVector<Triangle>& getTriangles() const {
+            return triangles_;
+        }
+        
+        /// Layer id of every triangle, parallel to the triangles
+        const SegmentedVector<LayerId>& getTriangleLayers() const {
+            return triangleLayers_;
+        }
+        
+        /**
+         * @brief Writable double-precision triangles, for bulk fills such as a parallel decode
+         * 
+         * Drops the cached aggregates. The reference is meant for one batch of
+         * writes: query aggregates only once they are done, keep the layer
+         * sequence the same length, and don't use it on a compact mesh.
+         */
+        SegmentedVector<Triangle>& mutableTriangles() {
+            invalidateAggregates();
+            return triangles_;
+        }
+        
+        /// Writable layer ids, with the same rules as mutableTriangles()
+        SegmentedVector<LayerId>& mutableTriangleLayers() {
+            invalidateAggregates();
+            return triangleLayers_;
+        }
+        
+        LayerId getTriangleLayer(size_t index) const {
+            return triangleLayers_[index];
+        }
+        
+        const std::string& getLayerName(LayerId layer) const {
+            return layerNames_.at(layer);
+        }
+        
+        size_t getLayerCount() const {
+            return layerNames_.size();
+        }
+        
+        /// Interned layer names indexed by LayerId; "0" comes first
+        const std::vector<std::string>& getLayerNames() const {
+            return layerNames_;
         }
         
         void clear() {
-            triangles.clear();
+            invalidateAggregates();
+            triangles_.clear();
+            compactTriangles_.clear();
+            compact_ = false;
+            origin_ = Point3D();
+            tolerance_ = COMPACT_TOLERANCE;
+            triangleLayers_.clear();
+            layerNames_.assign(1, "0");
+            layerIndex_.clear();
+            lastLayer_ = DEFAULT_LAYER;
         }
         
         size_t getTriangleCount() const {
-            return triangles.size();
+            return compact_ ? compactTriangles_.size() : triangles_.size();
         }
         
         bool isEmpty() const {
-            return triangles.empty();
+            return getTriangleCount() == 0;
         }
         
-        BoundingBox getBoundingBox() const {
-            BoundingBox bbox;
-            for (const auto& triangle : triangles) {
-                for (const auto& vertex : triangle.vertices) {
-                    bbox.expand(vertex);
-                }
+        /**
+         * @brief Count, bounds, area, centroid and area range, from one pass over the triangles
+         * 
+         * The pass runs on the first call after the mesh changed; later calls
+         * return the cached figures. In compact mode areas are taken from the
+         * local coordinates, where float32 keeps the most precision.
+         */
+        const MeshAggregates& getAggregates() const {
+            if (!cache_.totalsValid) {
+                cache_.totals = computeAggregates();
+                cache_.totalsValid = true;
             }
-            return bbox;
+            return cache_.totals;
+        }
+        
+        BoundingBox getBoundingBox() const {
+            return getAggregates().boundingBox;
         }
         
         double getTotalSurfaceArea() const {
-            double totalArea = 0.0;
-            for (const auto& triangle : triangles) {
-                totalArea += triangle.area();
+            return getAggregates().totalSurfaceArea;
+        }
+        
+        /**
+         * @brief Area of every triangle, parallel to the triangles
+         * 
+         * Built on first use (8 bytes per triangle) and kept until the mesh changes.
+         */
+        const SegmentedVector<double>& getTriangleAreas() const {
+            if (!cache_.areasValid) {
+                SegmentedVector<double> areas;
+                areas.reserve(getTriangleCount());
+                forEachStored([&](const Triangle&, const Triangle& local) {
+                    areas.push_back(local.area());
+                });
+                cache_.areas = std::move(areas);
+                cache_.areasValid = true;
+            }
+            return cache_.areas;
+        }
+        
+        /**
+         * @brief Unit normal of every triangle, parallel to the triangles
+         * 
+         * Follows the vertex winding; degenerate triangles get (0, 0, 0).
+         * Built on first use (24 bytes per triangle) and kept until the mesh changes.
+         */
+        const SegmentedVector<Point3D>& getTriangleNormals() const {
+            if (!cache_.normalsValid) {
+                SegmentedVector<Point3D> normals;
+                normals.reserve(getTriangleCount());
+                forEachStored([&](const Triangle&, const Triangle& local) {
+                    Point3D normal = local.normal();
+                    double length = normal.magnitude();
+                    normals.push_back(length > 0.0 ? normal * (1.0 / length) : Point3D());
+                });
+                cache_.normals = std::move(normals);
+                cache_.normalsValid = true;
             }
-            return totalArea;
+            return cache_.normals;
+        }
+        
+        /**
+         * @brief Drops the cached aggregates and columns
+         * 
+         * Called by every member function that changes the mesh; benchmarks
+         * call it to time an uncached pass.
+         */
+        void invalidateAggregates() {
+            cache_.reset();
         }
         
         void reserve(size_t capacity) {
-            triangles.reserve(capacity);
+            if (compact_) {
+                compactTriangles_.reserve(capacity);
+            } else {
+                triangles_.reserve(capacity);
+            }
+            triangleLayers_.reserve(capacity);
+        }
+        
+        /**
+         * @brief Appends the triangles of another mesh, remapping its layer ids into this one's
+         * @throws std::overflow_error if the combined layer count exceeds the LayerId range
+         */
+        void append(const MeshData& part) {
+            std::vector<LayerId> remap(part.getLayerNames().size());
+            for (size_t id = 0; id < part.getLayerNames().size(); ++id) {
+                remap[id] = internLayer(part.getLayerNames()[id]);
+            }
+            for (size_t i = 0; i < part.getTriangleCount(); ++i) {
+                addTriangle(part.getTriangle(i), remap[part.triangleLayers_[i]]);
+            }
+        }
+        
+        /**
+         * @brief Moves the triangles of another mesh to the end of this one
+         * 
+         * Same result as append(const MeshData&), but the part's layer ids are
+         * remapped in place and its triangle blocks are spliced in rather
+         * than copied when this mesh ends on a block boundary. The part is
+         * left empty, with its memory released.
+         * 
+         * @throws std::overflow_error if the combined layer count exceeds the LayerId range
+         */
+        void append(MeshData&& part) {
+            if (part.compact_ || compact_) {
+                append(static_cast<const MeshData&>(part));
+                part = MeshData();
+                return;
+            }
+            std::vector<LayerId> remap(part.getLayerNames().size());
+            bool identity = true;
+            for (size_t id = 0; id < part.getLayerNames().size(); ++id) {
+                remap[id] = internLayer(part.getLayerNames()[id]);
+                identity = identity && remap[id] == id;
+            }
+            if (!identity) {
+                for (auto& layer : part.triangleLayers_) {
+                    layer = remap[layer];
+                }
+            }
+            invalidateAggregates();
+            triangles_.append(std::move(part.triangles_));
+            triangleLayers_.append(std::move(part.triangleLayers_));
+            part = MeshData();  // Also frees blocks left behind by an element-wise move
+        }
+        
+        /**
+         * @brief Rearranges the triangles so that position i holds the one previously at order[i]
+         * 
+         * 'order' must be a permutation of 0 to getTriangleCount() - 1; layer
+         * ids move with their triangles. Gathers into new storage, so both
+         * copies exist until it returns.
+         * 
+         * @throws std::invalid_argument if order has the wrong size
+         * @throws std::out_of_range if an index is not a triangle index
+         */
+        template <typename Order>
+        void permute(const Order& order) {
+            const size_t count = getTriangleCount();
+            if (order.size() != count) {
+                throw std::invalid_argument("Permutation size does not match the triangle count");
+            }
+            if (compact_) {
+                SegmentedVector<CompactTriangle> gathered;
+                gathered.reserve(count);
+                for (size_t i = 0; i < count; ++i) {
+                    gathered.push_back(compactTriangles_.at(order[i]));
+                }
+                compactTriangles_ = std::move(gathered);
+            } else {
+                SegmentedVector<Triangle> gathered;
+                gathered.reserve(count);
+                for (size_t i = 0; i < count; ++i) {
+                    gathered.push_back(triangles_.at(order[i]));
+                }
+                triangles_ = std::move(gathered);
+            }
+            SegmentedVector<LayerId> layers;
+            layers.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                layers.push_back(triangleLayers_[order[i]]);
+            }
+            triangleLayers_ = std::move(layers);
+            invalidateAggregates();
+        }
+        
+        /// Reverses the winding (and so the normal) of one triangle by swapping its last two vertices
+        void flipTriangle(size_t index) {
+            if (compact_) {
+                std::swap(compactTriangles_[index].vertices[1], compactTriangles_[index].vertices[2]);
+            } else {
+                std::swap(triangles_[index].vertices[1], triangles_[index].vertices[2]);
+            }
+            invalidateAggregates();
+        }
+        
+        /**
+         * @brief Drops every triangle i with remove[i] set, keeping the others in order
+         *
+         * Compacts the storage in place: kept triangles and layer ids slide
+         * down over the removed ones and the tail is truncated, so no
+         * memory is allocated (the emptied blocks are kept for reuse).
+         *
+         * @return Number of triangles removed
+         * @throws std::invalid_argument if remove has the wrong size
+         */
+        template <typename Flags>
+        size_t removeTriangles(const Flags& remove) {
+            const size_t count = getTriangleCount();
+            if (remove.size() != count) {
+                throw std::invalid_argument("Removal flags size does not match the triangle count");
+            }
+            size_t kept = 0;
+            for (size_t i = 0; i < count; ++i) {
+                if (remove[i]) {
+                    continue;
+                }
+                if (kept != i) {
+                    if (compact_) {
+                        compactTriangles_[kept] = compactTriangles_[i];
+                    } else {
+                        triangles_[kept] = triangles_[i];
+                    }
+                    triangleLayers_[kept] = triangleLayers_[i];
+                }
+                ++kept;
+            }
+            if (kept == count) {
+                return 0;
+            }
+            if (compact_) {
+                compactTriangles_.resize(kept);
+            } else {
+                triangles_.resize(kept);
+            }
+            triangleLayers_.resize(kept);
+            invalidateAggregates();
+            return count - kept;
+        }
+
+    private:
+        /**
+         * @brief Cached figures; a moved-from cache is left empty like the moved-from storage
+         */
+        struct AggregateCache {
+            MeshAggregates totals;
+            SegmentedVector<double> areas;
+            SegmentedVector<Point3D> normals;
+            bool totalsValid = false;
+            bool areasValid = false;
+            bool normalsValid = false;
+            
+            AggregateCache() = default;
+            AggregateCache(const AggregateCache&) = default;
+            AggregateCache& operator=(const AggregateCache&) = default;
+            
+            AggregateCache(AggregateCache&& other) noexcept
+                : totals(other.totals), areas(std::move(other.areas)), normals(std::move(other.normals)),
+                  totalsValid(other.totalsValid), areasValid(other.areasValid), normalsValid(other.normalsValid) {
+                other.reset();
+            }
+            
+            AggregateCache& operator=(AggregateCache&& other) noexcept {
+                if (this != &other) {
+                    totals = other.totals;
+                    areas = std::move(other.areas);
+                    normals = std::move(other.normals);
+                    totalsValid = other.totalsValid;
+                    areasValid = other.areasValid;
+                    normalsValid = other.normalsValid;
+                    other.reset();
+                }
+                return *this;
+            }
+            
+            void reset() {
+                totalsValid = false;
+                if (areasValid || normalsValid) {
+                    areas = SegmentedVector<double>();
+                    normals = SegmentedVector<Point3D>();
+                    areasValid = false;
+                    normalsValid = false;
+                }
+            }
+        };
+        
+        /**
+         * @brief Calls visit(world, local) for every triangle
+         * 
+         * 'local' has the same shape as 'world' but is relative to the
+         * origin in compact mode, so areas and normals taken from it keep
+         * the stored precision. In double mode both are the stored triangle.
+         */
+        template <typename Visitor>
+        void forEachStored(Visitor&& visit) const {
+            if (compact_) {
+                for (size_t b = 0; b < compactTriangles_.blockCount(); ++b) {
+                    for (const auto& stored : compactTriangles_.block(b)) {
+                        visit(toWorld(stored, origin_), toWorld(stored, Point3D()));
+                    }
+                }
+            } else {
+                for (size_t b = 0; b < triangles_.blockCount(); ++b) {
+                    for (const auto& triangle : triangles_.block(b)) {
+                        visit(triangle, triangle);
+                    }
+                }
+            }
         }
+        
+        MeshAggregates computeAggregates() const {
+            MeshAggregates totals;
+            totals.triangleCount = getTriangleCount();
+            if (totals.triangleCount == 0) {
+                return totals;
+            }
+            
+            Point3D weightedCenter;
+            double tripleProducts = 0.0;  // Divided by 6 once, not per triangle
+            double minArea = std::numeric_limits<double>::max();
+            double maxArea = std::numeric_limits<double>::lowest();
+            forEachStored([&](const Triangle& world, const Triangle& local) {
+                double area = local.area();
+                totals.totalSurfaceArea += area;
+                minArea = std::min(minArea, area);
+                maxArea = std::max(maxArea, area);
+                weightedCenter = weightedCenter + world.center() * area;
+                tripleProducts += world.vertices[0].dot(world.vertices[1].cross(world.vertices[2]));
+                for (const auto& vertex : world.vertices) {
+                    totals.boundingBox.expand(vertex);
+                }
+            });
+            
+            totals.signedVolume = tripleProducts / 6.0;
+            totals.minTriangleArea = minArea;
+            totals.maxTriangleArea = maxArea;
+            if (totals.totalSurfaceArea > 0.0) {
+                totals.centroid = weightedCenter * (1.0 / totals.totalSurfaceArea);
+            }
+            return totals;
+        }
+        
+        /**
+         * @brief Returns compact storage to double precision, in world coordinates
+         */
+        void expand() {
+            invalidateAggregates();
+            triangles_.reserve(compactTriangles_.size());
+            for (size_t b = 0; b < compactTriangles_.blockCount(); ++b) {
+                for (const auto& local : compactTriangles_.block(b)) {
+                    triangles_.push_back(toWorld(local, origin_));
+                }
+            }
+            compactTriangles_ = SegmentedVector<CompactTriangle>();
+            origin_ = Point3D();
+            compact_ = false;
+        }
+        
+        /// true if every coordinate of 'local' converts back to within 'tolerance' of 'triangle'
+        static bool roundTrips(const Triangle& triangle, const CompactTriangle& local, const Point3D& origin,
+                               double tolerance) {
+            for (size_t v = 0; v < 3; ++v) {
+                Point3D error = toWorld(local.vertices[v], origin) - triangle.vertices[v];
+                if (std::abs(error.x) > tolerance || std::abs(error.y) > tolerance ||
+                    std::abs(error.z) > tolerance) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        
+        static CompactTriangle toLocal(const Triangle& triangle, const Point3D& origin) {
+            CompactTriangle local;
+            for (size_t v = 0; v < 3; ++v) {
+                Point3D offset = triangle.vertices[v] - origin;
+                local.vertices[v] = Point3F{static_cast<float>(offset.x), static_cast<float>(offset.y),
+                                            static_cast<float>(offset.z)};
+            }
+            return local;
+        }
+        
+        static Point3D toWorld(const Point3F& local, const Point3D& origin) {
+            return Point3D(origin.x + local.x, origin.y + local.y, origin.z + local.z);
+        }
+        
+        static Triangle toWorld(const CompactTriangle& local, const Point3D& origin) {
+            return Triangle(toWorld(local.vertices[0], origin), toWorld(local.vertices[1], origin),
+                            toWorld(local.vertices[2], origin));
+        }
+        
+        SegmentedVector<Triangle> triangles_;       ///< Double-precision storage; empty once compact
+        SegmentedVector<LayerId> triangleLayers_;   ///< Layer id per triangle, parallel to the triangles
+        SegmentedVector<CompactTriangle> compactTriangles_;
+        Point3D origin_;
+        double tolerance_ = COMPACT_TOLERANCE;     ///< Round-trip error accepted by the last compact()
+        bool compact_ = false;
+        std::vector<std::string> layerNames_{"0"};  ///< Interned layer names indexed by LayerId
+        std::unordered_map<std::string, LayerId> layerIndex_;
+        std::string lookupKey_;  ///< Scratch key for layerIndex_ lookups
+        LayerId lastLayer_ = DEFAULT_LAYER;
+        mutable AggregateCache cache_;
     };
 
 } // namespace DXFProcessor
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "MeshData.h"
+#include "MeshTopology.h"
+#include <cstddef>
+
+namespace DXFProcessor {
+
+    struct OrientationOptions {
+        /**
+         * Orient each component so its area-weighted normal points up (+Z),
+         * as expected of 2.5D terrain and pit surfaces; components with no
+         * net vertical direction fall back to the majority winding.
+         */
+        bool upward = false;
+        size_t threadCount = 0;  ///< Threads for topology and search; 0 = one per hardware thread
+        ThreadPool* threadPool = nullptr;  ///< Shared pool to run on (not owned); replaces threadCount when set
+    };
+
+    /**
+     * @brief What an orientation pass found and changed
+     */
+    struct OrientationReport {
+        size_t flippedTriangles = 0;
+        size_t components = 0;        ///< Edge-connected components; an isolated triangle is one
+        size_t conflictingEdges = 0;  ///< Edges still inconsistent because their component is not orientable
+    };
+
+    /**
+     * @brief Makes the winding of edge-adjacent triangles consistent
+     *
+     * CAD exports often mix clockwise and counter-clockwise faces, which
+     * breaks signed quantities such as the enclosed volume and normals.
+     * Within every edge-connected component, each triangle is flipped or
+     * not so that every shared edge is traversed in opposite directions by
+     * its two triangles. Each component then keeps the winding of most of
+     * its triangles (fewest flips; ties keep the lowest-index triangle), or
+     * faces up when OrientationOptions::upward is set.
+     *
+     * The search is a breadth-first walk over MeshTopology neighbours in
+     * parallel: each worker seeds regions from its own range of triangles
+     * and claims neighbours with an atomic compare-and-swap, recording the
+     * relative flip of each claimed triangle. Edges where two regions meet
+     * then join them, and their relative flips, in a small union-find, so
+     * the whole pass is linear in the triangle count. Non-orientable
+     * components (a Möbius strip) are oriented as far as possible and
+     * their remaining inconsistent edges are reported.
+     *
+     * @code
+     * OrientationOptions options;
+     * options.upward = true;
+     * OrientationReport report = MeshOrienter(options).orient(*meshData);
+     * @endcode
+     */
+    class MeshOrienter {
+    public:
+        explicit MeshOrienter(OrientationOptions options = OrientationOptions());
+        
+        /// Builds the topology of meshData and orients it
+        OrientationReport orient(MeshData& meshData) const;
+        
+        /**
+         * @brief Orients meshData using a topology already built from it
+         *
+         * The topology keeps describing the winding from before the pass;
+         * rebuild it if consistency queries are needed afterwards.
+         *
+         * @throws std::invalid_argument if the topology has a different triangle count
+         */
+        OrientationReport orient(MeshData& meshData, const MeshTopology& topology) const;
+        
+        const OrientationOptions& options() const { return options_; }
+
+    private:
+        OrientationOptions options_;
+    };
+
+} // namespace DXFProcessor
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "MeshCleanup.h"
+#include "MeshComponents.h"
+#include "MeshData.h"
+#include "MeshOrientation.h"
+#include "MeshSummarizer.h"
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace DXFProcessor {
+
+    /**
+     * @brief Which repair and analysis passes to run between reading and summarizing
+     *
+     * Mirrors the --check-faces, --clean, --spatial-order, --orient and
+     * --components command-line options.
+     */
+    struct MeshPassOptions {
+        bool checkFaces = false;        ///< Count degenerate and duplicate faces
+        bool clean = false;             ///< Also remove them (implies checkFaces)
+        double minFaceArea = 0.0;       ///< CleanupOptions::minArea
+        bool spatialOrder = false;      ///< Sort faces along a Hilbert curve before the topology passes
+        bool orient = false;            ///< Make face winding consistent
+        bool orientUp = false;          ///< Also face each surface +Z (implies orient)
+        bool components = false;        ///< Label and summarize connected pieces
+        double minComponentArea = 0.0;  ///< ComponentOptions::minArea
+        size_t threadCount = 0;         ///< Threads for each pass; 0 = one per hardware thread
+        ThreadPool* threadPool = nullptr;  ///< Shared pool for every pass (not owned); replaces threadCount when set
+        
+        /// Tells whether any pass is enabled
+        bool any() const { return checkFaces || clean || spatialOrder || orient || orientUp || components; }
+    };
+
+    /**
+     * @brief Reports of the passes that ran; a pass that didn't run has no value
+     */
+    struct MeshPassReport {
+        std::optional<CleanupReport> cleanup;  ///< Counts only; CleanupReport::defects is left empty
+        std::optional<OrientationReport> orientation;
+        std::optional<ComponentAnalysis> components;
+        
+        /**
+         * @brief Adds the pass counts to summary.customFields, and moves the component table into it
+         *
+         * Adds degenerate_triangles, duplicate_triangles and removed_triangles
+         * after face checks; flipped_triangles and non_orientable_edges after
+         * orienting; component_count, dropped_components and dropped_triangles
+         * after labeling.
+         */
+        void addTo(MeshSummary& summary);
+    };
+
+    /**
+     * @brief Runs the enabled repair and analysis passes in their fixed order
+     *
+     * Faces are checked (and removed) first, so later passes never see
+     * them. The spatial sort then groups neighbouring faces in memory. One
+     * MeshTopology is built for orienting and labeling: flipping faces
+     * keeps their welded vertices and edge links, so labeling can reuse the
+     * topology built before orienting. Components under the area limit are
+     * dropped last.
+     *
+     * @code
+     * MeshPassOptions options;
+     * options.clean = true;
+     * options.components = true;
+     * MeshPassReport report = MeshPasses(options).run(*meshData);
+     * auto summary = summarizer->summarize(*meshData);
+     * report.addTo(summary);
+     * @endcode
+     */
+    class MeshPasses {
+    public:
+        explicit MeshPasses(MeshPassOptions options = MeshPassOptions());
+        
+        /**
+         * @brief Runs the enabled passes on the mesh, changing it in place
+         * @throws std::invalid_argument, MeshTopologyException or SpatialOrderException from the passes
+         */
+        MeshPassReport run(MeshData& meshData) const;
+        
+        /// Names of the metrics MeshPassReport::addTo adds for the enabled passes, in order
+        std::vector<std::string> metricNames() const;
+        
+        const MeshPassOptions& options() const { return options_; }
+
+    private:
+        MeshPassOptions options_;
+    };
+
+} // namespace DXFProcessor
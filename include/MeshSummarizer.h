@@ -1,27 +1,97 @@
 #pragma once
 
 #include "MeshData.h"
+#include "MetricStore.h"
 #include <string>
-#include <map>
 #include <memory>
+#include <vector>
 
 namespace DXFProcessor {
 
+    /**
+     * @brief Statistics for one group of triangles (e.g. a DXF layer)
+     */
+    struct GroupSummary {
+        std::string name;
+        size_t triangleCount = 0;
+        BoundingBox boundingBox;
+        double totalSurfaceArea = 0.0;
+        Point3D centroid;
+    };
+
+    /**
+     * @brief Running totals for one group, filled triangle by triangle
+     *
+     * Lets grouped statistics be gathered in a single pass over the mesh by
+     * keeping one accumulator per group.
+     */
+    struct GroupAccumulator {
+        size_t triangleCount = 0;
+        BoundingBox boundingBox;
+        double totalSurfaceArea = 0.0;
+        Point3D weightedCenter;  ///< Sum of triangle centers weighted by area
+        
+        void add(const Triangle& triangle) {
+            double area = triangle.area();
+            ++triangleCount;
+            totalSurfaceArea += area;
+            weightedCenter = weightedCenter + triangle.center() * area;
+            for (const auto& vertex : triangle.vertices) {
+                boundingBox.expand(vertex);
+            }
+        }
+        
+        GroupSummary finish(const std::string& name) const {
+            GroupSummary group;
+            group.name = name;
+            group.triangleCount = triangleCount;
+            group.boundingBox = boundingBox;
+            group.totalSurfaceArea = totalSurfaceArea;
+            if (totalSurfaceArea > 0.0) {
+                group.centroid = weightedCenter * (1.0 / totalSurfaceArea);
+            }
+            return group;
+        }
+    };
+
+    /**
+     * @brief Statistics for one connected piece of the mesh (see ComponentLabeler)
+     */
+    struct ComponentSummary : GroupSummary {
+        double volume = 0.0;  ///< Enclosed volume from signed tetrahedra; meaningful for closed, oriented pieces
+    };
+
     struct MeshSummary {
         size_t triangleCount = 0;
         BoundingBox boundingBox;
         double totalSurfaceArea = 0.0;
         Point3D centroid;
         
-        std::map<std::string, std::string> customFields;
+        MetricStore customFields;                  ///< Typed metrics in insertion order
+        std::vector<GroupSummary> layers;          ///< Per-layer statistics, empty unless grouping by layer
+        std::vector<ComponentSummary> components;  ///< Per-component statistics, empty unless requested
         
         void addCustomField(const std::string& key, const std::string& value) {
-            customFields[key] = value;
+            customFields.set(key, value);
         }
         
+        void addCustomField(const std::string& key, double value) {
+            customFields.set(key, value);
+        }
+        
+        template <typename Integer,
+                  typename = std::enable_if_t<std::is_integral_v<Integer> && !std::is_same_v<Integer, bool>>>
+        void addCustomField(const std::string& key, Integer value) {
+            customFields.set(key, value);
+        }
+        
+        /**
+         * @brief Returns a custom field formatted as text
+         * @return The value (numbers in shortest round-trip form), or "" if absent
+         */
         std::string getCustomField(const std::string& key) const {
-            auto it = customFields.find(key);
-            return (it != customFields.end()) ? it->second : "";
+            const MetricValue* value = customFields.find(key);
+            return value ? metricToString(*value) : "";
         }
     };
 
@@ -32,23 +102,70 @@ namespace DXFProcessor {
         
         virtual MeshSummary summarize(const MeshData& meshData);
         
+        /**
+         * @brief Computes statistics for every layer in a single pass
+         * @param meshData Mesh whose triangles carry layer ids
+         * @return One entry per layer that owns at least one triangle, in layer id order
+         */
+        std::vector<GroupSummary> summarizeByLayer(const MeshData& meshData);
+        
+        /**
+         * @brief Builds a summary from running totals instead of a stored mesh
+         * 
+         * Gives the same result as summarize() for summarizers whose metrics
+         * need only running totals (see isStreamable), so a streaming reader
+         * can discard triangles once they are accumulated.
+         * 
+         * @param total Accumulator fed with every triangle, in file order
+         * @param layers Per-layer statistics (used only when grouping by layer)
+         */
+        MeshSummary summarizeTotals(const GroupAccumulator& total, std::vector<GroupSummary> layers);
+        
+        /**
+         * @brief true if summarizeTotals computes every metric of summarize()
+         * 
+         * summarizeTotals never calls the protected hooks, so a subclass that
+         * overrides them stays on the whole-mesh path unless it opts in.
+         */
+        virtual bool isStreamable() const { return false; }
+        
+        void setGroupByLayer(bool enable) { groupByLayer_ = enable; }
+        bool getGroupByLayer() const { return groupByLayer_; }
+
     protected:
         virtual void calculateBasicStats(const MeshData& meshData, MeshSummary& summary);
         virtual void calculateAdvancedStats(const MeshData& meshData, MeshSummary& summary);
         virtual void addCustomCalculations(const MeshData& meshData, MeshSummary& summary);
-        
+
     private:
-        Point3D calculateCentroid(const MeshData& meshData);
+        bool groupByLayer_ = false;
     };
 
+    /**
+     * @brief The built-in "basic" summarizer: totals only, so it can run on a stream
+     */
+    class BasicMeshSummarizer : public MeshSummarizer {
+    public:
+        BasicMeshSummarizer() = default;
+        
+        bool isStreamable() const override { return true; }
+    };
+
+    /**
+     * @brief Adds volume and triangle-area statistics
+     * 
+     * Not streamable: small/large triangle counts compare each area to the
+     * mean, which needs a second pass.
+     */
     class DetailedMeshSummarizer : public MeshSummarizer {
     public:
         DetailedMeshSummarizer() = default;
-        
+
     protected:
         void addCustomCalculations(const MeshData& meshData, MeshSummary& summary) override;
-        
+
     private:
+        /// Enclosed volume from signed tetrahedra; only meaningful once winding is consistent (see MeshOrienter)
         double calculateVolume(const MeshData& meshData);
         double calculateAverageTriangleArea(const MeshData& meshData);
         std::pair<double, double> getTriangleAreaRange(const MeshData& meshData);
@@ -64,14 +181,20 @@ namespace DXFProcessor {
         static std::unique_ptr<MeshSummarizer> create(SummarizerType type = SummarizerType::Basic) {
             switch (type) {
                 case SummarizerType::Basic:
-                    return std::make_unique<MeshSummarizer>();
+                    return std::make_unique<BasicMeshSummarizer>();
                 case SummarizerType::Detailed:
                     return std::make_unique<DetailedMeshSummarizer>();
                 default:
-                    return std::make_unique<MeshSummarizer>();
+                    return std::make_unique<BasicMeshSummarizer>();
             }
         }
         
+        /**
+         * @brief Names of every metric the built-in summarizers can set
+         * @return Basic summarizer metrics first, then the detailed ones, in insertion order
+         */
+        static const std::vector<std::string>& metricNames();
+        
         static std::unique_ptr<MeshSummarizer> create(const std::string& typeName) {
             if (typeName == "basic" || typeName.empty()) {
                 return create(SummarizerType::Basic);
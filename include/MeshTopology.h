@@ -0,0 +1,163 @@
+#pragma once
+
+#include "MeshData.h"
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace DXFProcessor {
+
+    class ThreadPool;
+
+    /**
+     * @brief Exception thrown when a mesh is too large for 32-bit topology indices
+     */
+    class MeshTopologyException : public std::runtime_error {
+    public:
+        explicit MeshTopologyException(const std::string& message)
+            : std::runtime_error("Mesh Topology Error: " + message) {}
+    };
+
+    struct MeshTopologyOptions {
+        size_t threadCount = 0;  ///< Build threads; 0 = one per hardware thread
+        ThreadPool* threadPool = nullptr;  ///< Shared pool to run on (not owned); replaces threadCount when set
+    };
+
+    /**
+     * @brief Corner table connectivity of a mesh: welded vertices and edge neighbours
+     *
+     * Triangle t owns corners 3t, 3t + 1 and 3t + 2, in vertex order. Each
+     * corner stores the vertex it sits on and its opposite: the corner of
+     * the neighbouring triangle across the edge facing it. Everything is
+     * flat arrays of 32-bit indices, so neighbour, opposite and next/prev
+     * corner lookups are O(1), and the corners around each vertex are one
+     * contiguous slice, so the one-ring costs O(valence).
+     *
+     * Building welds corners with identical coordinates into vertices by
+     * sorting corner keys on the Morton code of their position with the
+     * parallel radix sort (vertex ids therefore follow space; the few
+     * corners sharing a grid cell are sorted locally). Edges are then
+     * matched at their smaller vertex from its slice of corners, one vertex
+     * range per thread, with no second global sort.
+     *
+     * An edge used by exactly two triangles links them whichever way they
+     * are oriented; isConsistent() tells the cases apart. Boundary edges,
+     * edges of three or more triangles and the collapsed edges of triangles
+     * with a repeated vertex are unlinked (opposite() is NONE). The
+     * topology is a snapshot: changing the mesh afterwards does not update it.
+     *
+     * @code
+     * MeshTopology topology(*meshData);
+     * for (MeshTopology::Index c = 0; c < topology.getCornerCount(); ++c) {
+     *     if (topology.isBoundary(c)) { ... }
+     * }
+     * @endcode
+     */
+    class MeshTopology {
+    public:
+        using Index = std::uint32_t;
+        
+        /// Missing corner or triangle
+        static constexpr Index NONE = UINT32_MAX;
+        
+        /**
+         * @brief Contiguous run of corner indices
+         */
+        struct CornerRange {
+            const Index* first;
+            const Index* last;
+            
+            const Index* begin() const { return first; }
+            const Index* end() const { return last; }
+            size_t size() const { return static_cast<size_t>(last - first); }
+        };
+        
+        MeshTopology() = default;
+        
+        /**
+         * @brief Builds the corner table of a mesh (double or compact storage)
+         * @throws MeshTopologyException if the mesh has 2^32 / 3 triangles or more
+         */
+        explicit MeshTopology(const MeshData& meshData, MeshTopologyOptions options = MeshTopologyOptions());
+        
+        size_t getTriangleCount() const { return cornerVertices_.size() / 3; }
+        size_t getCornerCount() const { return cornerVertices_.size(); }
+        size_t getVertexCount() const { return positions_.size(); }
+        
+        /// Edges of a single triangle
+        size_t getBoundaryEdgeCount() const { return boundaryEdges_; }
+        
+        /// Edges of three or more triangles
+        size_t getNonManifoldEdgeCount() const { return nonManifoldEdges_; }
+        
+        /// Linked edges whose two triangles run along them in the same direction
+        size_t getInconsistentEdgeCount() const { return inconsistentEdges_; }
+        
+        static Index triangleOf(Index corner) { return corner / 3; }
+        static Index cornerOf(Index triangle, unsigned k) { return triangle * 3 + k; }
+        static Index next(Index corner) { return corner % 3 == 2 ? corner - 2 : corner + 1; }
+        static Index prev(Index corner) { return corner % 3 == 0 ? corner + 2 : corner - 1; }
+        
+        /// Vertex the corner sits on
+        Index vertex(Index corner) const { return cornerVertices_[corner]; }
+        
+        /// Corner across the edge facing this one (from next(corner) to prev(corner)), or NONE
+        Index opposite(Index corner) const { return opposites_[corner]; }
+        
+        /// Triangle across the edge facing this corner, or NONE
+        Index neighbour(Index corner) const {
+            Index o = opposites_[corner];
+            return o == NONE ? NONE : triangleOf(o);
+        }
+        
+        /// True if the edge facing this corner has no linked neighbour
+        bool isBoundary(Index corner) const { return opposites_[corner] == NONE; }
+        
+        /// True if the edge facing this corner is linked and its triangles are oriented alike
+        bool isConsistent(Index corner) const {
+            Index o = opposites_[corner];
+            return o != NONE && cornerVertices_[next(corner)] == cornerVertices_[prev(o)];
+        }
+        
+        const Point3D& position(Index vertex) const { return positions_[vertex]; }
+        
+        /// All corners on a vertex, in triangle order
+        CornerRange cornersAround(Index vertex) const {
+            return CornerRange{vertexCorners_.data() + vertexCornerStart_[vertex],
+                               vertexCorners_.data() + vertexCornerStart_[vertex + 1]};
+        }
+        
+        /**
+         * @brief Calls visit(u) for every vertex u sharing an edge with v
+         *
+         * Each neighbour is visited once where the surface around v is
+         * consistently oriented and manifold; elsewhere a neighbour may be
+         * visited twice.
+         */
+        template <typename Visit>
+        void forEachRingVertex(Index v, Visit&& visit) const {
+            for (Index corner : cornersAround(v)) {
+                visit(cornerVertices_[next(corner)]);
+                if (!isConsistent(next(corner))) {
+                    visit(cornerVertices_[prev(corner)]);  // Not the next vertex of another corner
+                }
+            }
+        }
+
+    private:
+        void weldVertices(const MeshData& meshData, ThreadPool* pool);
+        void linkEdges(ThreadPool* pool);
+        
+        std::vector<Index> cornerVertices_;
+        std::vector<Index> opposites_;
+        std::vector<Point3D> positions_;
+        std::vector<Index> vertexCornerStart_;  ///< Vertex v owns vertexCorners_[start[v], start[v + 1])
+        std::vector<Index> vertexCorners_;
+        size_t boundaryEdges_ = 0;
+        size_t nonManifoldEdges_ = 0;
+        size_t inconsistentEdges_ = 0;
+    };
+
+} // namespace DXFProcessor
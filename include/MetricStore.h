@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace DXFProcessor {
+
+    /**
+     * @brief Interned metric name
+     *
+     * Names are interned once in a process-wide registry, so comparing keys
+     * is a pointer comparison and summaries don't store a copy of each name.
+     * Interning is thread-safe; keep frequently used keys in statics.
+     */
+    class MetricKey {
+    public:
+        /**
+         * @brief Returns the key for a name, registering it on first use
+         */
+        static MetricKey intern(std::string_view name);
+        
+        std::string_view name() const { return *name_; }
+        
+        bool operator==(const MetricKey& other) const { return name_ == other.name_; }
+        bool operator!=(const MetricKey& other) const { return name_ != other.name_; }
+
+    private:
+        explicit MetricKey(const std::string* name) : name_(name) {}
+        
+        const std::string* name_;  ///< Owned by the registry, never freed
+    };
+
+    /// Metric value: floating point, integer count, or text
+    using MetricValue = std::variant<double, std::int64_t, std::string>;
+
+    /**
+     * @brief Formats a metric value as text
+     *
+     * Doubles use the shortest round-trip form, so converting back with
+     * std::stod yields the same value.
+     */
+    std::string metricToString(const MetricValue& value);
+
+    /**
+     * @brief One named metric
+     */
+    struct MetricEntry {
+        MetricKey key;
+        MetricValue value;
+    };
+
+    /**
+     * @brief Small insertion-ordered store of typed summary metrics
+     *
+     * A flat vector of (interned key, value). Numbers are stored inline in
+     * the variant, so adding one doesn't allocate beyond vector growth.
+     * Lookups are linear, which is faster than a map at the dozen or so
+     * metrics a summary carries.
+     *
+     * Usage:
+     * @code
+     * static const MetricKey DENSITY = MetricKey::intern("mesh_density");
+     * store.set(DENSITY, 0.0001);
+     * for (const auto& [key, value] : store) { ... }
+     * @endcode
+     */
+    class MetricStore {
+    public:
+        using const_iterator = std::vector<MetricEntry>::const_iterator;
+        
+        /// Adds a metric or replaces the value of an existing one, keeping its position
+        void set(MetricKey key, MetricValue value);
+        
+        void set(std::string_view name, MetricValue value) { set(MetricKey::intern(name), std::move(value)); }
+        
+        /// Integer overload so that counts of any integral type are stored as int64
+        template <typename Integer,
+                  typename = std::enable_if_t<std::is_integral_v<Integer> && !std::is_same_v<Integer, bool>>>
+        void set(MetricKey key, Integer value) {
+            set(key, MetricValue(static_cast<std::int64_t>(value)));
+        }
+        
+        template <typename Integer,
+                  typename = std::enable_if_t<std::is_integral_v<Integer> && !std::is_same_v<Integer, bool>>>
+        void set(std::string_view name, Integer value) {
+            set(MetricKey::intern(name), MetricValue(static_cast<std::int64_t>(value)));
+        }
+        
+        /// Returns the metric's value, or nullptr if absent
+        const MetricValue* find(MetricKey key) const;
+        const MetricValue* find(std::string_view name) const;
+        
+        /**
+         * @brief Returns a numeric metric as double
+         * @return The value, or 'fallback' if absent or not numeric
+         */
+        double getNumber(std::string_view name, double fallback = 0.0) const;
+        
+        size_t size() const { return entries_.size(); }
+        bool empty() const { return entries_.empty(); }
+        void reserve(size_t count) { entries_.reserve(count); }
+        void clear() { entries_.clear(); }
+        
+        const_iterator begin() const { return entries_.begin(); }
+        const_iterator end() const { return entries_.end(); }
+
+    private:
+        std::vector<MetricEntry> entries_;
+    };
+
+} // namespace DXFProcessor
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace DXFProcessor {
+
+    /**
+     * @brief Reusable growable character buffer for formatted output
+     *
+     * Text is appended in place and numbers are formatted with std::to_chars,
+     * which produces the shortest representation that round-trips to the same
+     * double. Clearing keeps the capacity, so a buffer reused across many
+     * summaries stops allocating once it has grown to the largest output.
+     *
+     * Usage:
+     * @code
+     * OutputBuffer out;
+     * out.append("area: ");
+     * out.appendNumber(summary.totalSurfaceArea);
+     * out.writeTo("summary.txt");
+     * @endcode
+     */
+    class OutputBuffer {
+    public:
+        explicit OutputBuffer(size_t initialCapacity = 4096) { reserve(initialCapacity); }
+        
+        OutputBuffer(const OutputBuffer&) = delete;
+        OutputBuffer& operator=(const OutputBuffer&) = delete;
+        OutputBuffer(OutputBuffer&& other) noexcept
+            : data_(std::move(other.data_))
+            , size_(std::exchange(other.size_, 0))
+            , capacity_(std::exchange(other.capacity_, 0)) {}
+        OutputBuffer& operator=(OutputBuffer&& other) noexcept {
+            data_ = std::move(other.data_);
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, 0);
+            return *this;
+        }
+        
+        void clear() { size_ = 0; }
+        size_t size() const { return size_; }
+        size_t capacity() const { return capacity_; }
+        bool empty() const { return size_ == 0; }
+        const char* data() const { return data_.get(); }
+        std::string_view view() const { return std::string_view(data_.get(), size_); }
+        std::string str() const { return std::string(data_.get(), size_); }
+        
+        void reserve(size_t capacity);
+        
+        void append(char c) {
+            *grow(1) = c;
+            ++size_;
+        }
+        
+        void append(std::string_view text) {
+            if (!text.empty()) {
+                std::memcpy(grow(text.size()), text.data(), text.size());
+                size_ += text.size();
+            }
+        }
+        
+        /**
+         * @brief Appends a double in shortest round-trip form
+         *
+         * Infinities and NaN are written as "inf", "-inf" and "nan".
+         */
+        void appendNumber(double value) {
+            char* begin = grow(MAX_NUMBER_LENGTH);
+            size_ += static_cast<size_t>(std::to_chars(begin, begin + MAX_NUMBER_LENGTH, value).ptr - begin);
+        }
+        
+        /// Appends an integer in decimal
+        template <typename Integer, typename = std::enable_if_t<std::is_integral_v<Integer>>>
+        void appendInteger(Integer value) {
+            char* begin = grow(MAX_NUMBER_LENGTH);
+            size_ += static_cast<size_t>(std::to_chars(begin, begin + MAX_NUMBER_LENGTH, value).ptr - begin);
+        }
+        
+        /// Appends a double as a JSON number; non-finite values become null
+        void appendJSONNumber(double value);
+        
+        /// Appends a quoted JSON string, escaping quotes, backslashes and control characters
+        void appendJSONString(std::string_view text);
+        
+        /// Appends a CSV field, quoting it only if it contains a comma, quote or line break
+        void appendCSVField(std::string_view text);
+        
+        /**
+         * @brief Appends text padded with spaces to a minimum width
+         * @param leftAlign true to pad on the right (like std::left)
+         */
+        void appendPadded(std::string_view text, size_t width, bool leftAlign);
+        
+        /// Appends a number right-aligned to a minimum width
+        void appendPaddedNumber(double value, size_t width);
+        
+        /// Appends an integer right-aligned to a minimum width
+        void appendPaddedInteger(unsigned long long value, size_t width);
+        
+        /**
+         * @brief Replaces a file's contents with the buffer in a single write
+         * @return false if the file could not be created or fully written
+         */
+        bool writeTo(const std::filesystem::path& path) const;
+        
+        /// Longest output of to_chars for double or 64-bit integers
+        static constexpr size_t MAX_NUMBER_LENGTH = 32;
+
+    private:
+        /// Ensures room for 'extra' more bytes and returns the write position
+        char* grow(size_t extra) {
+            if (size_ + extra > capacity_) {
+                reserve(std::max(capacity_ * 2, size_ + extra));
+            }
+            return data_.get() + size_;
+        }
+        
+        std::unique_ptr<char[]> data_;
+        size_t size_ = 0;
+        size_t capacity_ = 0;
+    };
+
+    /**
+     * @brief Tests whether text is a complete JSON number literal
+     *
+     * Accepts an optional minus sign, an integer part without leading zeros,
+     * an optional fraction and an optional exponent. Hex, "inf", "nan",
+     * leading '+' and surrounding blanks are rejected.
+     */
+    bool isJSONNumber(std::string_view text);
+
+} // namespace DXFProcessor
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * DXF_PROFILING selects whether the DXF_PROFILE_* macros expand to code.
+ * It defaults to on; building with -DDXF_PROFILING=0 (CMake option
+ * DXF_ENABLE_PROFILING=OFF) removes every scope and counter from the hot paths.
+ */
+#ifndef DXF_PROFILING
+#define DXF_PROFILING 1
+#endif
+
+namespace DXFProcessor {
+
+    class OutputBuffer;
+
+    /**
+     * @brief Exception thrown when a profile report cannot be written
+     */
+    class ProfilerException : public std::runtime_error {
+    public:
+        explicit ProfilerException(const std::string& message)
+            : std::runtime_error("Profiler Error: " + message) {}
+    };
+
+    /// Event counters collected while profiling is enabled
+    enum class ProfileCounter {
+        BytesRead,           ///< Input bytes mapped or read
+        Lines,               ///< DXF lines tokenized
+        Entities,            ///< 3DFACE entities parsed
+        NumericConversions,  ///< Group codes and values converted from text, counted where converted
+        Allocations,         ///< operator new calls (command-line tool and unit tests only)
+        Count
+    };
+
+    /// Timing of all executions of one named scope
+    struct ProfileScopeStats {
+        std::string name;
+        size_t calls = 0;
+        double totalSeconds = 0.0;  ///< Summed over calls and threads; nested scopes overlap
+        double maxSeconds = 0.0;
+    };
+
+    /// Snapshot of everything recorded since Profiler::enable
+    struct ProfileReport {
+        std::vector<ProfileScopeStats> scopes;  ///< In order of first execution
+        std::array<std::uint64_t, static_cast<size_t>(ProfileCounter::Count)> counters{};
+        std::uint64_t peakResidentBytes = 0;    ///< Process high-water mark; 0 if unavailable
+        double wallSeconds = 0.0;               ///< Since Profiler::enable
+        
+        std::uint64_t counter(ProfileCounter which) const { return counters[static_cast<size_t>(which)]; }
+    };
+
+    /**
+     * @brief Process-wide scoped timers and event counters
+     *
+     * Disabled until enable() is called; while disabled a scope or counter
+     * costs one relaxed atomic load. Scopes are meant for phases (open,
+     * parse, summarize, write, one pipeline chunk), not per-entity work:
+     * counters are bumped in bulk, e.g. once per parsed range.
+     *
+     * Instrument code through the macros, which compile to nothing when
+     * DXF_PROFILING is 0:
+     * @code
+     * void parseRange(...) {
+     *     DXF_PROFILE_SCOPE("parse range");
+     *     ...
+     *     DXF_PROFILE_COUNT(Entities, faceCount);
+     * }
+     * @endcode
+     *
+     * With tracing on, every scope execution is also kept as a Chrome
+     * trace event (one row per thread) for writeChromeTrace.
+     */
+    class Profiler {
+    public:
+        using Clock = std::chrono::steady_clock;
+        
+        /// false when built with DXF_PROFILING=0; enable() then records nothing
+        static constexpr bool compiledIn() { return DXF_PROFILING != 0; }
+        
+        /**
+         * @brief Clears previous data and starts recording
+         * @param trace Also keep one trace event per scope execution
+         */
+        static void enable(bool trace = false);
+        
+        /// Stops recording; collected data stays available to report()
+        static void disable();
+        
+        static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+        
+        static void count(ProfileCounter which, std::uint64_t amount) {
+            if (enabled()) {
+                counters_[static_cast<size_t>(which)].fetch_add(amount, std::memory_order_relaxed);
+            }
+        }
+        
+        /// Records one execution of a scope; called by ProfileScope
+        static void recordScope(const char* name, Clock::time_point start, Clock::time_point end);
+        
+        static ProfileReport report();
+        
+        /// Display name of a counter, e.g. "numeric conversions"
+        static const char* counterName(ProfileCounter which);
+        
+        /// Formats a report as an aligned text table of scopes then counters
+        static void formatTable(const ProfileReport& report, OutputBuffer& out);
+        
+        /**
+         * @brief Writes the recorded trace events as Chrome trace-event JSON
+         *
+         * Scopes become complete ("X") events on their thread's row; the
+         * counters are appended as one counter ("C") event at the end.
+         * Load the file in chrome://tracing or https://ui.perfetto.dev.
+         *
+         * @throws ProfilerException if the file cannot be written
+         */
+        static void writeChromeTrace(const std::filesystem::path& path);
+        
+        /// Peak resident set size of this process in bytes, 0 where unsupported
+        static std::uint64_t peakResidentBytes();
+
+    private:
+        static std::atomic<bool> enabled_;
+        static std::array<std::atomic<std::uint64_t>, static_cast<size_t>(ProfileCounter::Count)> counters_;
+    };
+
+    /**
+     * @brief Times the enclosing block while profiling is enabled
+     *
+     * The name must outlive the profiler data (in practice, a string literal).
+     */
+    class ProfileScope {
+    public:
+        explicit ProfileScope(const char* name)
+            : name_(Profiler::enabled() ? name : nullptr) {
+            if (name_ != nullptr) {
+                start_ = Profiler::Clock::now();
+            }
+        }
+        
+        ~ProfileScope() {
+            if (name_ != nullptr) {
+                Profiler::recordScope(name_, start_, Profiler::Clock::now());
+            }
+        }
+        
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+        const char* name_;
+        Profiler::Clock::time_point start_;
+    };
+
+} // namespace DXFProcessor
+
+#if DXF_PROFILING
+#define DXF_PROFILE_CONCAT_IMPL(a, b) a##b
+#define DXF_PROFILE_CONCAT(a, b) DXF_PROFILE_CONCAT_IMPL(a, b)
+/// Times the rest of the enclosing block under the given name
+#define DXF_PROFILE_SCOPE(name) \
+    ::DXFProcessor::ProfileScope DXF_PROFILE_CONCAT(profileScope_, __LINE__)(name)
+/// Adds to a ProfileCounter, e.g. DXF_PROFILE_COUNT(Entities, faceCount)
+#define DXF_PROFILE_COUNT(counter, amount) \
+    ::DXFProcessor::Profiler::count(::DXFProcessor::ProfileCounter::counter, (amount))
+#else
+#define DXF_PROFILE_SCOPE(name) ((void)0)
+#define DXF_PROFILE_COUNT(counter, amount) ((void)0)
+#endif
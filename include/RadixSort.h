@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace DXFProcessor {
+
+    class ThreadPool;
+
+    /// Bits needed to hold every value from 0 to 'largest' (at least 1), e.g. for the index part of a key
+    int bitWidth(size_t largest);
+
+    /**
+     * @brief Stable LSD radix sort of 64-bit keys by their bits from lowBit up
+     *
+     * Meant for keys that pack a sort code above an element index: the bits
+     * below lowBit don't take part in the ordering, so equal codes keep
+     * their input order, and reading them back gives a permutation.
+     *
+     * Sorts 11 bits per pass. Every pass counts digits per chunk, turns the
+     * counts into per-chunk output offsets (digit-major, which keeps the
+     * sort stable) and scatters each chunk, with one chunk per pool worker.
+     * Passes whose digit is the same for every key are skipped, so codes
+     * that leave high bits unused cost no extra passes.
+     *
+     * @param keys Keys to sort in place; a buffer of the same size is allocated
+     * @param lowBit Lowest bit that takes part in the ordering, 0 to 63
+     * @param pool Workers to count and scatter on, or nullptr for the calling thread
+     */
+    void radixSortKeys(std::vector<std::uint64_t>& keys, int lowBit, ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Cuts keys sorted by radixSortKeys into chunkCount ranges that don't split a run of equal codes
+     *
+     * Lets threads each scan one range of the sorted keys while every group
+     * of equal codes is seen whole by a single thread.
+     *
+     * @param keys Sorted keys
+     * @param lowBit Same lowBit as the sort; bits below it are not part of the code
+     * @return chunkCount + 1 bounds; some ranges may be empty
+     */
+    std::vector<size_t> sortedRunBounds(const std::vector<std::uint64_t>& keys, int lowBit, size_t chunkCount);
+
+} // namespace DXFProcessor
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+namespace DXFProcessor {
+
+    /**
+     * @brief Bytes consumed by a read, published for a polling thread
+     *
+     * The reader stores with relaxed atomics once per chunk; a UI or
+     * progress thread calls fraction() whenever it likes. Nothing is called
+     * back, so observing progress costs the reader nothing extra.
+     *
+     * @code
+     * ReadProgress progress;
+     * reader->setProgress(&progress);
+     * auto result = std::async(std::launch::async, [&] { return reader->readFile(path); });
+     * while (result.wait_for(std::chrono::milliseconds(100)) != std::future_status::ready) {
+     *     drawBar(progress.fraction());
+     * }
+     * @endcode
+     */
+    class ReadProgress {
+    public:
+        /// Resets the counters for a new read of 'totalBytes'
+        void start(std::uint64_t totalBytes) {
+            done_.store(0, std::memory_order_relaxed);
+            total_.store(totalBytes, std::memory_order_relaxed);
+        }
+        
+        void advance(std::uint64_t bytes) { done_.fetch_add(bytes, std::memory_order_relaxed); }
+        
+        void finish() { done_.store(total_.load(std::memory_order_relaxed), std::memory_order_relaxed); }
+        
+        std::uint64_t bytesDone() const { return done_.load(std::memory_order_relaxed); }
+        std::uint64_t bytesTotal() const { return total_.load(std::memory_order_relaxed); }
+        
+        /// Share of the input consumed, 0.0 to 1.0; 0.0 before a read starts
+        double fraction() const {
+            std::uint64_t total = bytesTotal();
+            return total == 0 ? 0.0 : std::min(1.0, static_cast<double>(bytesDone()) / total);
+        }
+
+    private:
+        std::atomic<std::uint64_t> done_{0};
+        std::atomic<std::uint64_t> total_{0};
+    };
+
+    /**
+     * @brief Cooperative stop request shared between a caller and a long operation
+     *
+     * Readers check the token between chunks and throw their cancelled
+     * exception once it is set. cancel() is a lock-free atomic store, so it
+     * may be called from any thread or from a signal handler.
+     */
+    class CancellationToken {
+    public:
+        void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+        void reset() { cancelled_.store(false, std::memory_order_relaxed); }
+        bool isCancelled() const { return cancelled_.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<bool> cancelled_{false};
+    };
+
+} // namespace DXFProcessor
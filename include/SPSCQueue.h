@@ -0,0 +1,171 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace DXFProcessor {
+
+    /**
+     * @brief Bounded single-producer single-consumer ring buffer with blocking ends
+     *
+     * The fast path is lock-free: one producer advances the head, one consumer
+     * advances the tail, each on its own cache line. When the ring is full
+     * (back-pressure) or empty (starvation) the blocked side spins briefly and
+     * then sleeps on a condition variable; the other side only touches the
+     * mutex when it sees a sleeper, so a flowing pipeline never locks.
+     *
+     * Both ends count how often they had to wait and for how long, which is
+     * what tells a pipeline's slowest stage apart from the rest.
+     *
+     * close() ends the stream: pop() returns false once the ring is drained.
+     * cancel() ends it immediately on both sides, e.g. after a stage failed.
+     */
+    template <typename T>
+    class SPSCQueue {
+    public:
+        /// Wait counters of one end of the queue
+        struct WaitStats {
+            size_t waits = 0;     ///< Calls that found the ring full (push) or empty (pop)
+            double seconds = 0.0; ///< Time spent in those waits
+        };
+        
+        /**
+         * @param capacity Maximum number of queued items (at least 1)
+         */
+        explicit SPSCQueue(size_t capacity)
+            : capacity_(capacity > 0 ? capacity : 1)
+            , slots_(new T[capacity_ + 1]) {}
+        
+        SPSCQueue(const SPSCQueue&) = delete;
+        SPSCQueue& operator=(const SPSCQueue&) = delete;
+        
+        /**
+         * @brief Appends an item, waiting while the ring is full (producer only)
+         * @return false if the queue was cancelled; the item is dropped
+         */
+        bool push(T item) {
+            const size_t head = head_.load(std::memory_order_relaxed);
+            const size_t next = increment(head);
+            if (next == tail_.load(std::memory_order_acquire)) {
+                if (!waitUntil(pushStats_, [&] { return next != tail_.load(std::memory_order_acquire); })) {
+                    return false;
+                }
+            }
+            if (cancelled_.load(std::memory_order_acquire)) {
+                return false;
+            }
+            slots_[head] = std::move(item);
+            head_.store(next, std::memory_order_release);
+            wakeSleeper();
+            return true;
+        }
+        
+        /**
+         * @brief Removes the oldest item, waiting while the ring is empty (consumer only)
+         * @return false once the queue is closed and drained, or cancelled
+         */
+        bool pop(T& item) {
+            const size_t tail = tail_.load(std::memory_order_relaxed);
+            auto ready = [&] {
+                return tail != head_.load(std::memory_order_acquire) || closed_.load(std::memory_order_acquire);
+            };
+            if (!ready() && !waitUntil(popStats_, ready)) {
+                return false;
+            }
+            if (cancelled_.load(std::memory_order_acquire) || tail == head_.load(std::memory_order_acquire)) {
+                return false;  // Cancelled, or closed with nothing left
+            }
+            item = std::move(slots_[tail]);
+            tail_.store(increment(tail), std::memory_order_release);
+            wakeSleeper();
+            return true;
+        }
+        
+        /// Marks the end of the stream (producer only)
+        void close() {
+            closed_.store(true, std::memory_order_release);
+            wakeAll();
+        }
+        
+        /// Stops both ends; pending and future operations return false
+        void cancel() {
+            cancelled_.store(true, std::memory_order_release);
+            closed_.store(true, std::memory_order_release);
+            wakeAll();
+        }
+        
+        size_t capacity() const { return capacity_; }
+        
+        /// Producer waits (back-pressure); read after the producer finished
+        const WaitStats& pushStats() const { return pushStats_; }
+        
+        /// Consumer waits (starvation); read after the consumer finished
+        const WaitStats& popStats() const { return popStats_; }
+
+    private:
+        static constexpr size_t CACHE_LINE = 64;
+        static constexpr int SPIN_COUNT = 256;
+        
+        size_t increment(size_t index) const {
+            return index == capacity_ ? 0 : index + 1;
+        }
+        
+        template <typename Predicate>
+        bool waitUntil(WaitStats& stats, Predicate ready) {
+            auto start = std::chrono::steady_clock::now();
+            ++stats.waits;
+            
+            for (int spin = 0; spin < SPIN_COUNT && !ready(); ++spin) {
+                std::this_thread::yield();
+            }
+            while (!ready()) {
+                if (cancelled_.load(std::memory_order_acquire)) {
+                    break;
+                }
+                std::unique_lock<std::mutex> lock(mutex_);
+                sleepers_.fetch_add(1, std::memory_order_acq_rel);
+                // The timeout covers a wake-up sent between ready() and the sleeper count
+                wakeUp_.wait_for(lock, std::chrono::milliseconds(1), [&] {
+                    return ready() || cancelled_.load(std::memory_order_acquire);
+                });
+                sleepers_.fetch_sub(1, std::memory_order_acq_rel);
+            }
+            bool ok = !cancelled_.load(std::memory_order_acquire);
+            
+            stats.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return ok;
+        }
+        
+        void wakeSleeper() {
+            if (sleepers_.load(std::memory_order_acquire) > 0) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                wakeUp_.notify_all();
+            }
+        }
+        
+        void wakeAll() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            wakeUp_.notify_all();
+        }
+        
+        const size_t capacity_;
+        std::unique_ptr<T[]> slots_;  ///< capacity_ + 1 slots; one stays empty to tell full from empty
+        
+        alignas(CACHE_LINE) std::atomic<size_t> head_{0};  ///< Next slot to write (producer)
+        alignas(CACHE_LINE) std::atomic<size_t> tail_{0};  ///< Next slot to read (consumer)
+        alignas(CACHE_LINE) std::atomic<bool> closed_{false};
+        std::atomic<bool> cancelled_{false};
+        std::atomic<int> sleepers_{0};
+        std::mutex mutex_;
+        std::condition_variable wakeUp_;
+        WaitStats pushStats_;
+        WaitStats popStats_;
+    };
+
+} // namespace DXFProcessor
@@ -0,0 +1,316 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace DXFProcessor {
+
+    /**
+     * @brief Vector-like sequence stored in fixed-size blocks that never move
+     *
+     * Elements live in separately allocated blocks of BlockSize, so growing
+     * never copies existing elements: push_back is O(1) without the
+     * reallocation spikes of std::vector (which briefly holds old and new
+     * arrays, up to three times the data). References and pointers to
+     * elements stay valid until the element is removed.
+     *
+     * Indexing is a shift and a mask. Whole blocks are exposed through
+     * block(b) for tight or parallel loops, and append(SegmentedVector&&)
+     * takes over the other sequence's blocks when this one ends on a block
+     * boundary instead of copying.
+     *
+     * clear() keeps the blocks for reuse; shrink_to_fit() releases unused ones.
+     *
+     * @tparam T Element type
+     * @tparam BlockSize Elements per block, a power of two
+     */
+    template <typename T, size_t BlockSize = 16384>
+    class SegmentedVector {
+        static_assert(BlockSize > 0 && (BlockSize & (BlockSize - 1)) == 0, "BlockSize must be a power of two");
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Over-aligned types are not supported");
+        
+        static constexpr size_t BLOCK_MASK = BlockSize - 1;
+        static constexpr size_t blockShift() {
+            size_t shift = 0;
+            while ((size_t{1} << shift) < BlockSize) {
+                ++shift;
+            }
+            return shift;
+        }
+        static constexpr size_t BLOCK_SHIFT = blockShift();
+
+    public:
+        using value_type = T;
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using const_reference = const T&;
+        
+        static constexpr size_t BLOCK_SIZE = BlockSize;
+        
+        /**
+         * @brief Contiguous run of elements inside one block
+         */
+        template <typename Element>
+        struct BlockView {
+            Element* data;
+            size_t size;
+            
+            Element* begin() const { return data; }
+            Element* end() const { return data + size; }
+        };
+        
+        /**
+         * @brief Random-access iterator over all elements, across block boundaries
+         */
+        template <typename Element>
+        class Iterator {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::remove_const_t<Element>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Element*;
+            using reference = Element&;
+            
+            Iterator() = default;
+            Iterator(T* const* blocks, size_t index) : blocks_(blocks), index_(index) {}
+            
+            /// iterator converts to const_iterator
+            template <typename Other, typename = std::enable_if_t<std::is_const_v<Element> && !std::is_const_v<Other>>>
+            Iterator(const Iterator<Other>& other) : blocks_(other.blocks_), index_(other.index_) {}
+            
+            reference operator*() const { return blocks_[index_ >> BLOCK_SHIFT][index_ & BLOCK_MASK]; }
+            pointer operator->() const { return &**this; }
+            reference operator[](difference_type n) const { return *(*this + n); }
+            
+            Iterator& operator++() { ++index_; return *this; }
+            Iterator operator++(int) { Iterator old = *this; ++index_; return old; }
+            Iterator& operator--() { --index_; return *this; }
+            Iterator operator--(int) { Iterator old = *this; --index_; return old; }
+            Iterator& operator+=(difference_type n) { index_ += n; return *this; }
+            Iterator& operator-=(difference_type n) { index_ -= n; return *this; }
+            Iterator operator+(difference_type n) const { return Iterator(blocks_, index_ + n); }
+            Iterator operator-(difference_type n) const { return Iterator(blocks_, index_ - n); }
+            friend Iterator operator+(difference_type n, const Iterator& it) { return it + n; }
+            difference_type operator-(const Iterator& other) const {
+                return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+            }
+            
+            bool operator==(const Iterator& other) const { return index_ == other.index_; }
+            bool operator!=(const Iterator& other) const { return index_ != other.index_; }
+            bool operator<(const Iterator& other) const { return index_ < other.index_; }
+            bool operator>(const Iterator& other) const { return index_ > other.index_; }
+            bool operator<=(const Iterator& other) const { return index_ <= other.index_; }
+            bool operator>=(const Iterator& other) const { return index_ >= other.index_; }
+        
+        private:
+            template <typename> friend class Iterator;
+            
+            T* const* blocks_ = nullptr;
+            size_t index_ = 0;
+        };
+        
+        using iterator = Iterator<T>;
+        using const_iterator = Iterator<const T>;
+        
+        SegmentedVector() = default;
+        
+        SegmentedVector(const SegmentedVector& other) {
+            reserve(other.size_);
+            for (size_t b = 0; b < other.blockCount(); ++b) {
+                for (const T& value : other.block(b)) {
+                    push_back(value);
+                }
+            }
+        }
+        
+        SegmentedVector(SegmentedVector&& other) noexcept
+            : blocks_(std::move(other.blocks_)), size_(std::exchange(other.size_, 0)) {
+            other.blocks_.clear();
+        }
+        
+        SegmentedVector& operator=(const SegmentedVector& other) {
+            if (this != &other) {
+                SegmentedVector copy(other);
+                swap(copy);
+            }
+            return *this;
+        }
+        
+        SegmentedVector& operator=(SegmentedVector&& other) noexcept {
+            if (this != &other) {
+                SegmentedVector moved(std::move(other));
+                swap(moved);
+            }
+            return *this;
+        }
+        
+        ~SegmentedVector() {
+            clear();
+            for (T* block : blocks_) {
+                ::operator delete(block);
+            }
+        }
+        
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        size_t capacity() const { return blocks_.size() * BlockSize; }
+        
+        T& operator[](size_t index) { return blocks_[index >> BLOCK_SHIFT][index & BLOCK_MASK]; }
+        const T& operator[](size_t index) const { return blocks_[index >> BLOCK_SHIFT][index & BLOCK_MASK]; }
+        
+        T& at(size_t index) {
+            if (index >= size_) {
+                throw std::out_of_range("SegmentedVector index out of range");
+            }
+            return (*this)[index];
+        }
+        
+        const T& at(size_t index) const {
+            if (index >= size_) {
+                throw std::out_of_range("SegmentedVector index out of range");
+            }
+            return (*this)[index];
+        }
+        
+        T& front() { return (*this)[0]; }
+        const T& front() const { return (*this)[0]; }
+        T& back() { return (*this)[size_ - 1]; }
+        const T& back() const { return (*this)[size_ - 1]; }
+        
+        iterator begin() { return iterator(blocks_.data(), 0); }
+        iterator end() { return iterator(blocks_.data(), size_); }
+        const_iterator begin() const { return const_iterator(blocks_.data(), 0); }
+        const_iterator end() const { return const_iterator(blocks_.data(), size_); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+        
+        void push_back(const T& value) { emplace_back(value); }
+        void push_back(T&& value) { emplace_back(std::move(value)); }
+        
+        template <typename... Args>
+        T& emplace_back(Args&&... args) {
+            if ((size_ & BLOCK_MASK) == 0 && (size_ >> BLOCK_SHIFT) == blocks_.size()) {
+                allocateBlock();
+            }
+            T* slot = &blocks_[size_ >> BLOCK_SHIFT][size_ & BLOCK_MASK];
+            ::new (static_cast<void*>(slot)) T(std::forward<Args>(args)...);
+            ++size_;
+            return *slot;
+        }
+        
+        void pop_back() {
+            --size_;
+            (*this)[size_].~T();
+        }
+        
+        /// Destroys all elements; the blocks are kept for reuse
+        void clear() {
+            if (!std::is_trivially_destructible_v<T>) {
+                for (size_t i = 0; i < size_; ++i) {
+                    (*this)[i].~T();
+                }
+            }
+            size_ = 0;
+        }
+        
+        /// Allocates blocks up front for 'capacity' elements; existing elements don't move
+        void reserve(size_t capacity) {
+            size_t needed = (capacity + BLOCK_MASK) >> BLOCK_SHIFT;
+            blocks_.reserve(needed);
+            while (blocks_.size() < needed) {
+                allocateBlock();
+            }
+        }
+        
+        /// Grows with value-initialized elements or shrinks from the end
+        void resize(size_t count) {
+            while (size_ > count) {
+                pop_back();
+            }
+            reserve(count);
+            while (size_ < count) {
+                emplace_back();
+            }
+        }
+        
+        /// Releases blocks beyond the last one in use
+        void shrink_to_fit() {
+            size_t used = blockCount();
+            for (size_t b = used; b < blocks_.size(); ++b) {
+                ::operator delete(blocks_[b]);
+            }
+            blocks_.resize(used);
+            blocks_.shrink_to_fit();
+        }
+        
+        void swap(SegmentedVector& other) noexcept {
+            blocks_.swap(other.blocks_);
+            std::swap(size_, other.size_);
+        }
+        
+        /// Number of blocks holding elements
+        size_t blockCount() const { return (size_ + BLOCK_MASK) >> BLOCK_SHIFT; }
+        
+        /// Elements of block b; every block but the last is full
+        BlockView<T> block(size_t b) {
+            return BlockView<T>{blocks_[b], std::min(BlockSize, size_ - b * BlockSize)};
+        }
+        
+        BlockView<const T> block(size_t b) const {
+            return BlockView<const T>{blocks_[b], std::min(BlockSize, size_ - b * BlockSize)};
+        }
+        
+        /**
+         * @brief Moves the other sequence's elements to the end of this one
+         *
+         * When this sequence fills its last block exactly (or is empty), the
+         * other's blocks are taken over without touching any element;
+         * otherwise elements are moved one by one into this sequence's blocks.
+         * The other sequence is left empty.
+         */
+        void append(SegmentedVector&& other) {
+            if ((size_ & BLOCK_MASK) == 0) {
+                // Drop spare blocks past the end so the taken blocks follow the last full one
+                shrink_to_fit();
+                blocks_.insert(blocks_.end(), other.blocks_.begin(), other.blocks_.end());
+                size_ += other.size_;
+                other.blocks_.clear();
+                other.size_ = 0;
+                return;
+            }
+            reserve(size_ + other.size_);
+            for (size_t b = 0; b < other.blockCount(); ++b) {
+                for (T& value : other.block(b)) {
+                    emplace_back(std::move(value));
+                }
+            }
+            other.clear();
+        }
+        
+        /// Copies the other sequence's elements to the end of this one
+        void append(const SegmentedVector& other) {
+            reserve(size_ + other.size_);
+            for (size_t b = 0; b < other.blockCount(); ++b) {
+                for (const T& value : other.block(b)) {
+                    push_back(value);
+                }
+            }
+        }
+
+    private:
+        void allocateBlock() {
+            blocks_.push_back(static_cast<T*>(::operator new(sizeof(T) * BlockSize)));
+        }
+        
+        std::vector<T*> blocks_;
+        size_t size_ = 0;
+    };
+
+} // namespace DXFProcessor
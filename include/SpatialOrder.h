@@ -0,0 +1,99 @@
+#pragma once
+
+#include "MeshData.h"
+#include "SegmentedVector.h"
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace DXFProcessor {
+
+    class ThreadPool;
+
+    /**
+     * @brief Exception thrown when a mesh cannot be reordered
+     */
+    class SpatialOrderException : public std::runtime_error {
+    public:
+        explicit SpatialOrderException(const std::string& message)
+            : std::runtime_error("Spatial Order Error: " + message) {}
+    };
+
+    /// Curve that maps 3D grid cells to sort keys
+    enum class SpaceFillingCurve {
+        Morton,   ///< Bit interleaving; cheapest, with long jumps between octants
+        Hilbert   ///< Consecutive cells are always face neighbours; best locality
+    };
+
+    struct SpatialOrderOptions {
+        SpaceFillingCurve curve = SpaceFillingCurve::Hilbert;
+        size_t threadCount = 0;  ///< Sort threads; 0 = one per hardware thread
+        ThreadPool* threadPool = nullptr;  ///< Shared pool to run on (not owned); replaces threadCount when set
+    };
+
+    /// Original index of the triangle at each position of a reordered mesh
+    using TrianglePermutation = SegmentedVector<std::uint32_t>;
+
+    /**
+     * @brief Sorts the triangles of a mesh along a space-filling curve
+     *
+     * DXF files list faces in CAD export order, which jumps around the
+     * drawing. After reorder(), triangles that are close in space are close
+     * in memory, so passes that visit neighbours (adjacency, spatial
+     * lookups, block encoding) touch far fewer cache lines and pages.
+     *
+     * Each triangle's centroid is placed on a cubic grid over the bounding
+     * box and given the grid cell's Morton or Hilbert code. Codes are packed
+     * above the triangle index into 64-bit keys, so the grid gets every bit
+     * the index doesn't need (up to 21 per axis), and the keys are sorted
+     * with a parallel LSD radix sort that skips digits all keys share.
+     * Triangles in the same cell keep their file order.
+     *
+     * @code
+     * SpatialOrder order;                               // Hilbert, all cores
+     * TrianglePermutation fileOrder = order.reorder(*meshData);
+     * // ... spatial work on meshData ...
+     * SpatialOrder::restore(*meshData, fileOrder);      // Back to file order
+     * @endcode
+     */
+    class SpatialOrder {
+    public:
+        /// Largest grid resolution, in bits per axis (a 63-bit code)
+        static constexpr int MAX_BITS_PER_AXIS = 21;
+        
+        explicit SpatialOrder(SpatialOrderOptions options = SpatialOrderOptions());
+        
+        /**
+         * @brief Reorders the triangles (with their layer ids) along the curve
+         *
+         * Aggregates such as the bounding box and area are unchanged.
+         *
+         * @return fileOrder, where fileOrder[i] is the former index of the triangle now at i
+         * @throws SpatialOrderException if the mesh has 2^32 triangles or more
+         */
+        TrianglePermutation reorder(MeshData& meshData) const;
+        
+        /**
+         * @brief Puts the triangles of a reordered mesh back in their original order
+         * @param fileOrder Permutation returned by reorder for this mesh
+         * @throws std::invalid_argument if the permutation doesn't match the mesh size
+         */
+        static void restore(MeshData& meshData, const TrianglePermutation& fileOrder);
+        
+        /// Interleaves the low 21 bits of each axis: x in bit 0, y in bit 1, z in bit 2, and so on
+        static std::uint64_t mortonCode(std::uint32_t x, std::uint32_t y, std::uint32_t z);
+        
+        /**
+         * @brief Position of a cell along the 3D Hilbert curve over a 2^bits grid
+         * @param bits Bits per axis, 1 to MAX_BITS_PER_AXIS; coordinates must be below 2^bits
+         */
+        static std::uint64_t hilbertCode(std::uint32_t x, std::uint32_t y, std::uint32_t z, int bits);
+        
+        const SpatialOrderOptions& options() const { return options_; }
+
+    private:
+        SpatialOrderOptions options_;
+    };
+
+} // namespace DXFProcessor
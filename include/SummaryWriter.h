@@ -1,6 +1,8 @@
 #pragma once
 
 #include "MeshSummarizer.h"
+#include "DXFReader.h"
+#include "OutputBuffer.h"
 #include <string>
 #include <memory>
 #include <filesystem>
@@ -13,6 +15,17 @@ namespace DXFProcessor {
             : std::runtime_error("Summary Writer Error: " + message) {}
     };
 
+    /// Provenance note attached to every header-only output
+    inline constexpr const char* HEADER_ONLY_NOTE =
+        "Values read from the DXF HEADER section ($EXTMIN/$EXTMAX); not recomputed from entities";
+
+    /**
+     * @brief Formats mesh summaries as JSON, text or CSV files
+     * 
+     * Output is built in a reusable OutputBuffer with std::to_chars number
+     * formatting (shortest round-trip) and written with a single write call,
+     * so writing many summaries with one writer doesn't allocate per field.
+     */
     class SummaryWriter {
     public:
         enum class OutputFormat {
@@ -26,6 +39,21 @@ namespace DXFProcessor {
         
         std::string writeToFile(const MeshSummary& summary, const std::string& baseName = "mesh_summary");
         
+        /**
+         * @brief Writes header-only metadata, labelled as not recomputed
+         * @param header Values read by DXFReader::readHeader
+         * @param baseName Output file base name
+         * @return Absolute path of the written file
+         */
+        std::string writeHeaderToFile(const DXFHeaderInfo& header, const std::string& baseName = "header_summary");
+        
+        /**
+         * @brief Appends a summary in the current format to a buffer
+         * @param summary Summary to format
+         * @param out Buffer receiving the formatted text
+         */
+        void format(const MeshSummary& summary, OutputBuffer& out);
+        
         void setOutputDirectory(const std::string& directory);
         void setFormat(OutputFormat format);
         void setIncludeTimestamp(bool include) { includeTimestamp_ = include; }
@@ -34,21 +62,28 @@ namespace DXFProcessor {
         std::string getLastOutputPath() const { return lastOutputPath_; }
         
     protected:
-        virtual std::string formatAsJSON(const MeshSummary& summary);
-        virtual std::string formatAsText(const MeshSummary& summary);
-        virtual std::string formatAsCSV(const MeshSummary& summary);
+        virtual void formatAsJSON(const MeshSummary& summary, OutputBuffer& out);
+        virtual void formatAsText(const MeshSummary& summary, OutputBuffer& out);
+        virtual void formatAsCSV(const MeshSummary& summary, OutputBuffer& out);
+        virtual void formatHeaderAsJSON(const DXFHeaderInfo& header, OutputBuffer& out);
+        virtual void formatHeaderAsText(const DXFHeaderInfo& header, OutputBuffer& out);
+        virtual void formatHeaderAsCSV(const DXFHeaderInfo& header, OutputBuffer& out);
         
         std::string generateFilename(const std::string& baseName, const std::string& extension);
         void ensureOutputDirectoryExists();
         
+        /// Appends the current UTC time as ISO 8601 (YYYY-MM-DDTHH:MM:SSZ)
+        static void appendTimestamp(OutputBuffer& out);
+        
     private:
         OutputFormat format_;
         std::filesystem::path outputDirectory_;
         bool includeTimestamp_;
         bool prettyPrint_;
         std::string lastOutputPath_;
+        OutputBuffer buffer_;  ///< Reused for every file this writer produces
         
-        std::string getCurrentTimestamp();
+        std::string writeBuffer(const std::string& baseName);
         std::string getFileExtension(OutputFormat format);
         void validateOutputDirectory(const std::filesystem::path& path);
     };
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace DXFProcessor {
+
+    class TaskGroup;
+
+    /**
+     * @brief Fixed-size work-stealing thread pool
+     *
+     * Every worker owns a task deque. Tasks submitted from a worker go to the
+     * back of its own deque and are popped LIFO, so nested work stays on the
+     * core whose cache already holds its input; idle workers steal from the
+     * front of other deques. Tasks submitted from outside the pool go to one
+     * shared queue and start in submission order, so a caller that queues its
+     * longest jobs first has them started first.
+     *
+     * Waiting for nested work must go through TaskGroup, whose wait() runs
+     * the group's queued tasks instead of blocking, so a worker waiting on
+     * its own sub-tasks can never deadlock the pool. It runs no other tasks:
+     * a worker waiting inside one job never starts another job's work, so
+     * at most one outer job per thread is in progress.
+     *
+     * Usage:
+     * @code
+     * ThreadPool pool;  // One worker per hardware thread
+     * TaskGroup group(pool);
+     * for (const auto& file : files) {
+     *     group.run([&file] { process(file); });
+     * }
+     * group.wait();
+     * @endcode
+     */
+    class ThreadPool {
+    public:
+        using Task = std::function<void()>;
+        
+        /**
+         * @brief Starts the worker threads
+         * @param threadCount Number of workers; 0 uses defaultThreadCount()
+         */
+        explicit ThreadPool(size_t threadCount = 0);
+        
+        /// Runs the remaining queued tasks, then joins the workers
+        ~ThreadPool();
+        
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        
+        /**
+         * @brief Queues a task; exceptions escaping it terminate the program
+         *
+         * Use TaskGroup::run for tasks that may throw or must be waited for.
+         */
+        void submit(Task task);
+        
+        /**
+         * @brief Runs one queued task on the calling thread
+         * @return false if every deque was empty
+         */
+        bool runPendingTask();
+        
+        size_t size() const { return workers_.size(); }
+        
+        /// Index of the calling worker in this pool, or size() for other threads
+        size_t currentWorker() const;
+        
+        /// Hardware concurrency, at least 1
+        static size_t defaultThreadCount();
+
+    private:
+        friend class TaskGroup;
+        
+        struct QueuedTask {
+            Task run;
+            const TaskGroup* group;  ///< nullptr for submit()
+        };
+        
+        struct WorkerQueue {
+            std::mutex mutex;
+            std::deque<QueuedTask> tasks;
+        };
+        
+        void push(Task task, const TaskGroup* group);
+        
+        /// Runs one queued task of the group on the calling thread; false if none is queued
+        bool runGroupTask(const TaskGroup& group);
+        
+        void workerLoop(size_t index);
+        
+        /// Takes a task, only one of 'group' unless it is nullptr
+        bool popTask(size_t index, Task& task, const TaskGroup* group = nullptr);
+        
+        std::vector<std::unique_ptr<WorkerQueue>> queues_;
+        WorkerQueue shared_;  ///< Tasks submitted from outside the pool, oldest first
+        std::vector<std::thread> workers_;
+        std::atomic<size_t> queuedTasks_{0};
+        std::mutex sleepMutex_;
+        std::condition_variable wakeUp_;
+        bool stopping_ = false;
+    };
+
+    /**
+     * @brief Set of tasks on a ThreadPool that can be waited for together
+     *
+     * The first exception thrown by a task is kept and rethrown by wait();
+     * later ones are dropped. The destructor waits but never throws.
+     */
+    class TaskGroup {
+    public:
+        explicit TaskGroup(ThreadPool& pool) : pool_(pool) {}
+        ~TaskGroup();
+        
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+        
+        /// Queues a task belonging to this group
+        void run(ThreadPool::Task task);
+        
+        /**
+         * @brief Runs the group's queued tasks on the calling thread until the group is done
+         * @throws The first exception thrown by one of the group's tasks
+         */
+        void wait();
+        
+        ThreadPool& pool() const { return pool_; }
+
+    private:
+        void waitNoThrow();
+        
+        ThreadPool& pool_;
+        std::atomic<size_t> pending_{0};
+        std::mutex mutex_;
+        std::condition_variable done_;
+        std::exception_ptr error_;
+    };
+
+    /// Smallest mesh, in triangles, that a parallel pass splits across threads; below this a pool costs more than it saves
+    constexpr size_t MIN_PARALLEL_TRIANGLES = 1 << 15;
+
+    /**
+     * @brief Creates the pool for one pass over 'work' items, if threads would pay off
+     *
+     * Returns nullptr, meaning "run on the calling thread", when work is below
+     * minWork or threadCount resolves to a single worker.
+     *
+     * @param threadCount Requested workers; 0 = one per hardware thread
+     */
+    std::unique_ptr<ThreadPool> makePoolFor(size_t work, size_t minWork, size_t threadCount);
+
+    /**
+     * @brief The pool one pass over 'work' items runs on
+     *
+     * A shared pool, such as the batch pool whose worker is running the
+     * pass, is used as is; without one, a pool of its own comes from
+     * makePoolFor and lives as long as this object. get() is nullptr when
+     * the pass should run on the calling thread.
+     */
+    class PassPool {
+    public:
+        /**
+         * @param shared Pool to run on (not owned), or nullptr to create one from threadCount
+         * @param threadCount Requested workers when shared is nullptr; 0 = one per hardware thread
+         */
+        PassPool(ThreadPool* shared, size_t work, size_t minWork, size_t threadCount);
+        
+        ThreadPool* get() const { return pool_; }
+
+    private:
+        std::unique_ptr<ThreadPool> owned_;
+        ThreadPool* pool_ = nullptr;
+    };
+
+    /**
+     * @brief Runs task(c) for every chunk c in [0, chunkCount)
+     *
+     * With a pool the chunks run as one TaskGroup and the call returns when
+     * all are done, rethrowing the first exception; without one (nullptr)
+     * they run in order on the calling thread.
+     */
+    template <typename Task>
+    void forEachChunk(ThreadPool* pool, size_t chunkCount, Task&& task) {
+        if (pool == nullptr) {
+            for (size_t c = 0; c < chunkCount; ++c) {
+                task(c);
+            }
+            return;
+        }
+        TaskGroup group(*pool);
+        for (size_t c = 0; c < chunkCount; ++c) {
+            group.run([&task, c] { task(c); });
+        }
+        group.wait();
+    }
+
+} // namespace DXFProcessor
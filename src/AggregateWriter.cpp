@@ -0,0 +1,262 @@
+#include "AggregateWriter.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+
+namespace DXFProcessor {
+
+    namespace {
+
+        // Core columns written before the metric columns
+        const char* const CORE_COLUMNS[] = {
+            "source", "status", "error", "triangle_count", "total_surface_area",
+            "min_x", "min_y", "min_z", "max_x", "max_y", "max_z",
+            "centroid_x", "centroid_y", "centroid_z"
+        };
+        
+        constexpr size_t CORE_NUMBER_COLUMNS = 10;  ///< Surface area, bounding box and centroid
+        
+        // Rows collected before each write; the writer flushes earlier when the queue runs dry
+        constexpr size_t WRITE_BATCH_BYTES = 256 * 1024;
+        
+        std::FILE* openForWriting(const std::filesystem::path& path) {
+#ifdef _WIN32
+            return _wfopen(path.c_str(), L"wb");
+#else
+            return std::fopen(path.c_str(), "wb");
+#endif
+        }
+
+    }
+
+    AggregateWriter::AggregateWriter(const std::filesystem::path& path, Format format,
+                                     std::vector<std::string> metricColumns)
+        : path_(path)
+        , format_(format)
+        , columns_(std::begin(CORE_COLUMNS), std::end(CORE_COLUMNS)) {
+        for (auto& name : metricColumns) {
+            metricKeys_.push_back(MetricKey::intern(name));
+            columns_.push_back(std::move(name));
+        }
+        
+        if (path_.has_parent_path()) {
+            std::error_code error;
+            std::filesystem::create_directories(path_.parent_path(), error);
+        }
+        file_ = openForWriting(path_);
+        if (file_ == nullptr) {
+            throw SummaryWriterException("Cannot create output file: " + path_.string());
+        }
+        
+        if (format_ == Format::CSV) {
+            OutputBuffer header;
+            for (size_t i = 0; i < columns_.size(); ++i) {
+                if (i > 0) {
+                    header.append(',');
+                }
+                header.appendCSVField(columns_[i]);
+            }
+            header.append('\n');
+            writeFailed_ = std::fwrite(header.data(), 1, header.size(), file_) != header.size();
+        }
+        
+        writer_ = std::thread([this] { writerLoop(); });
+    }
+
+    AggregateWriter::~AggregateWriter() {
+        try {
+            close();
+        } catch (const SummaryWriterException&) {
+            // Destructors don't throw; call close() to see write errors
+        }
+    }
+
+    void AggregateWriter::append(const std::string& source, const MeshSummary& summary) {
+        OutputBuffer row;
+        formatRow(row, source, &summary, std::string());
+        enqueue(row);
+    }
+
+    void AggregateWriter::appendFailure(const std::string& source, const std::string& error) {
+        OutputBuffer row;
+        formatRow(row, source, nullptr, error);
+        enqueue(row);
+    }
+
+    void AggregateWriter::enqueue(OutputBuffer& row) {
+        queue_.push(row.str());
+        rowCount_.fetch_add(1, std::memory_order_relaxed);
+        
+        // notify_one doesn't take the mutex; a missed wake-up costs the writer one timeout
+        if (writerSleeping_.load(std::memory_order_acquire)) {
+            wakeUp_.notify_one();
+        }
+    }
+
+    void AggregateWriter::close() {
+        if (!writer_.joinable()) {
+            return;
+        }
+        
+        closing_.store(true, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+        }
+        wakeUp_.notify_one();
+        writer_.join();
+        
+        bool closed = std::fclose(file_) == 0;
+        file_ = nullptr;
+        if (writeFailed_ || !closed) {
+            throw SummaryWriterException("Cannot write output file: " + path_.string());
+        }
+    }
+
+    /**
+     * @brief Formats one CSV line or NDJSON object, newline included
+     *
+     * summary == nullptr formats a failure row: status "failed", the error
+     * text, and empty (CSV) or null (NDJSON) values everywhere else.
+     */
+    void AggregateWriter::formatRow(OutputBuffer& out, const std::string& source, const MeshSummary* summary,
+                                    const std::string& error) const {
+        double numbers[CORE_NUMBER_COLUMNS] = {};
+        if (summary != nullptr) {
+            const BoundingBox& box = summary->boundingBox;
+            const Point3D& centroid = summary->centroid;
+            const double values[CORE_NUMBER_COLUMNS] = {
+                summary->totalSurfaceArea,
+                box.min.x, box.min.y, box.min.z, box.max.x, box.max.y, box.max.z,
+                centroid.x, centroid.y, centroid.z
+            };
+            std::copy(std::begin(values), std::end(values), numbers);
+        }
+        
+        if (format_ == Format::CSV) {
+            out.appendCSVField(source);
+            out.append(summary != nullptr ? ",ok," : ",failed,");
+            out.appendCSVField(error);
+            out.append(',');
+            if (summary != nullptr) {
+                out.appendInteger(summary->triangleCount);
+            }
+            for (double number : numbers) {
+                out.append(',');
+                if (summary != nullptr) {
+                    out.appendNumber(number);
+                }
+            }
+            for (const MetricKey& key : metricKeys_) {
+                out.append(',');
+                const MetricValue* value = summary != nullptr ? summary->customFields.find(key) : nullptr;
+                if (value == nullptr) {
+                    continue;
+                }
+                if (const std::string* text = std::get_if<std::string>(value)) {
+                    out.appendCSVField(*text);
+                } else if (const double* number = std::get_if<double>(value)) {
+                    out.appendNumber(*number);
+                } else {
+                    out.appendInteger(std::get<std::int64_t>(*value));
+                }
+            }
+            out.append('\n');
+            return;
+        }
+        
+        out.append("{\"source\":");
+        out.appendJSONString(source);
+        out.append(summary != nullptr ? ",\"status\":\"ok\",\"error\":null" : ",\"status\":\"failed\",\"error\":");
+        if (summary == nullptr) {
+            out.appendJSONString(error);
+        }
+        out.append(",\"triangle_count\":");
+        if (summary != nullptr) {
+            out.appendInteger(summary->triangleCount);
+        } else {
+            out.append("null");
+        }
+        for (size_t i = 0; i < CORE_NUMBER_COLUMNS; ++i) {
+            out.append(",\"");
+            out.append(CORE_COLUMNS[4 + i]);
+            out.append("\":");
+            if (summary != nullptr) {
+                out.appendJSONNumber(numbers[i]);
+            } else {
+                out.append("null");
+            }
+        }
+        for (const MetricKey& key : metricKeys_) {
+            out.append(',');
+            out.appendJSONString(key.name());
+            out.append(':');
+            const MetricValue* value = summary != nullptr ? summary->customFields.find(key) : nullptr;
+            if (value == nullptr) {
+                out.append("null");
+            } else if (const std::string* text = std::get_if<std::string>(value)) {
+                out.appendJSONString(*text);
+            } else if (const double* number = std::get_if<double>(value)) {
+                out.appendJSONNumber(*number);
+            } else {
+                out.appendInteger(std::get<std::int64_t>(*value));
+            }
+        }
+        out.append("}\n");
+    }
+
+    /**
+     * @brief Background thread: drains the queue into large writes
+     *
+     * Sleeps on the condition variable when the queue is empty. Producers
+     * only notify while the writer is marked as sleeping, and the wait has a
+     * short timeout, so a notification missed between the two checks delays
+     * the next write by at most one timeout instead of losing rows.
+     */
+    void AggregateWriter::writerLoop() {
+        OutputBuffer pending(WRITE_BATCH_BYTES);
+        std::string row;
+        
+        auto flush = [&] {
+            if (!pending.empty() && !writeFailed_) {
+                DXF_PROFILE_SCOPE("aggregate write");
+                writeFailed_ = std::fwrite(pending.data(), 1, pending.size(), file_) != pending.size();
+            }
+            pending.clear();
+        };
+        
+        while (true) {
+            // Read before draining: every row queued before close() is then written
+            bool closing = closing_.load(std::memory_order_acquire);
+            while (queue_.tryPop(row)) {
+                pending.append(row);
+                if (pending.size() >= WRITE_BATCH_BYTES) {
+                    flush();
+                }
+            }
+            flush();
+            if (closing) {
+                break;
+            }
+            
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            writerSleeping_.store(true, std::memory_order_release);
+            wakeUp_.wait_for(lock, std::chrono::milliseconds(2));
+            writerSleeping_.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    AggregateWriter::Format AggregateWriter::parseFormat(const std::string& name) {
+        if (name == "csv") {
+            return Format::CSV;
+        }
+        if (name == "ndjson") {
+            return Format::NDJSON;
+        }
+        throw SummaryWriterException("Unknown aggregate format: " + name + " (expected csv or ndjson)");
+    }
+
+    std::string AggregateWriter::fileExtension(Format format) {
+        return format == Format::CSV ? ".csv" : ".ndjson";
+    }
+
+} // namespace DXFProcessor
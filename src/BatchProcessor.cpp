@@ -0,0 +1,286 @@
+#include "BatchProcessor.h"
+#include "AggregateWriter.h"
+#include "MeshSummarizer.h"
+#include "OutputBuffer.h"
+#include "Profiler.h"
+#include "SummaryWriter.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace DXFProcessor {
+
+    namespace {
+
+        using Clock = std::chrono::steady_clock;
+        
+        double secondsSince(Clock::time_point start) {
+            return std::chrono::duration<double>(Clock::now() - start).count();
+        }
+        
+        // Matches a file name against a pattern with '*' and '?' wildcards
+        bool matchesWildcard(const std::string& name, const std::string& pattern) {
+            size_t n = 0, p = 0;
+            size_t starPattern = std::string::npos, starName = 0;
+            while (n < name.size()) {
+                if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+                    ++n;
+                    ++p;
+                } else if (p < pattern.size() && pattern[p] == '*') {
+                    starPattern = p++;
+                    starName = n;
+                } else if (starPattern != std::string::npos) {
+                    p = starPattern + 1;
+                    n = ++starName;
+                } else {
+                    return false;
+                }
+            }
+            while (p < pattern.size() && pattern[p] == '*') {
+                ++p;
+            }
+            return p == pattern.size();
+        }
+        
+        bool hasDXFExtension(const std::filesystem::path& path) {
+            std::string extension = path.extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return extension == ".dxf";
+        }
+
+    }
+
+    size_t BatchResult::succeeded() const {
+        return static_cast<size_t>(std::count_if(files.begin(), files.end(),
+                                                 [](const BatchFileResult& file) { return file.success; }));
+    }
+
+    std::vector<std::string> BatchProcessor::expandInputs(const std::string& pattern) {
+        namespace fs = std::filesystem;
+        std::vector<std::string> files;
+        std::error_code error;
+        
+        fs::path path(pattern);
+        if (fs::is_directory(path, error)) {
+            for (const auto& entry : fs::directory_iterator(path, error)) {
+                if (entry.is_regular_file(error) && hasDXFExtension(entry.path())) {
+                    files.push_back(entry.path().string());
+                }
+            }
+        } else {
+            fs::path directory = path.has_parent_path() ? path.parent_path() : fs::path(".");
+            std::string namePattern = path.filename().string();
+            if (!fs::is_directory(directory, error)) {
+                throw BatchException("Directory does not exist: " + directory.string());
+            }
+            for (const auto& entry : fs::directory_iterator(directory, error)) {
+                if (entry.is_regular_file(error) && matchesWildcard(entry.path().filename().string(), namePattern)) {
+                    files.push_back(entry.path().string());
+                }
+            }
+        }
+        
+        if (files.empty()) {
+            throw BatchException("No DXF files match: " + pattern);
+        }
+        std::sort(files.begin(), files.end());
+        return files;
+    }
+
+    BatchResult BatchProcessor::run(const std::string& pattern) {
+        return run(expandInputs(pattern));
+    }
+
+    /**
+     * @brief Runs one job per file on a fresh pool and writes the index
+     *
+     * Each job fills its own slot of the result vector, so results stay in
+     * input order without locking; only the file callback is serialized.
+     * Largest files are queued first so the longest jobs don't start last.
+     */
+    BatchResult BatchProcessor::run(const std::vector<std::string>& files) {
+        auto startTime = Clock::now();
+        
+        BatchResult result;
+        result.files.resize(files.size());
+        
+        // Created up front so concurrent writers never race to create it
+        std::error_code directoryError;
+        std::filesystem::create_directories(options_.outputDir, directoryError);
+        
+        // Output base names: the input stem, suffixed when stems repeat
+        std::vector<std::string> baseNames(files.size());
+        std::map<std::string, size_t> stemCounts;
+        for (size_t i = 0; i < files.size(); ++i) {
+            std::string stem = std::filesystem::path(files[i]).stem().string();
+            size_t seen = stemCounts[stem]++;
+            baseNames[i] = seen == 0 ? stem : stem + "_" + std::to_string(seen + 1);
+        }
+        
+        std::vector<std::pair<std::uintmax_t, size_t>> order;
+        order.reserve(files.size());
+        for (size_t i = 0; i < files.size(); ++i) {
+            std::error_code error;
+            std::uintmax_t size = std::filesystem::file_size(files[i], error);
+            order.emplace_back(error ? 0 : size, i);
+        }
+        std::stable_sort(order.begin(), order.end(),
+                         [](const auto& a, const auto& b) { return a.first > b.first; });
+        
+        std::unique_ptr<AggregateWriter> table;
+        if (!options_.aggregateFormat.empty()) {
+            try {
+                AggregateWriter::Format format = AggregateWriter::parseFormat(options_.aggregateFormat);
+                std::filesystem::path tablePath = std::filesystem::path(options_.outputDir) /
+                                                  (options_.aggregateName + AggregateWriter::fileExtension(format));
+                std::vector<std::string> columns = MeshSummarizerFactory::metricNames();
+                for (std::string& name : MeshPasses(options_.passes).metricNames()) {
+                    columns.push_back(std::move(name));
+                }
+                table = std::make_unique<AggregateWriter>(tablePath, format, std::move(columns));
+            } catch (const SummaryWriterException& e) {
+                throw BatchException(e.what());
+            }
+        }
+        
+        {
+            ThreadPool pool(options_.threadCount);
+            TaskGroup group(pool);
+            std::mutex callbackMutex;
+            
+            for (const auto& [size, index] : order) {
+                group.run([&, index = index] {
+                    result.files[index] = processFile(files[index], baseNames[index], pool, table.get());
+                    if (fileCallback_) {
+                        std::lock_guard<std::mutex> lock(callbackMutex);
+                        fileCallback_(result.files[index]);
+                    }
+                });
+            }
+            group.wait();
+        }
+        
+        if (table) {
+            try {
+                table->close();
+            } catch (const SummaryWriterException& e) {
+                throw BatchException(e.what());
+            }
+            result.aggregatePath = std::filesystem::absolute(table->path()).string();
+        }
+        
+        result.seconds = secondsSince(startTime);
+        result.indexPath = writeIndex(result);
+        return result;
+    }
+
+    /**
+     * @brief Reads, repairs, summarizes and writes one file, catching every error
+     */
+    BatchFileResult BatchProcessor::processFile(const std::string& inputPath, const std::string& baseName,
+                                                ThreadPool& pool, AggregateWriter* table) const {
+        DXF_PROFILE_SCOPE("batch file");
+        auto startTime = Clock::now();
+        
+        BatchFileResult file;
+        file.inputPath = inputPath;
+        try {
+            std::error_code error;
+            std::uintmax_t size = std::filesystem::file_size(inputPath, error);
+            file.fileSize = error ? 0 : size;
+            
+            auto reader = DXFReaderFactory::createReader();
+            reader->setThreadPool(&pool, options_.splitBytes);
+            auto meshData = reader->readFile(inputPath);
+            
+            MeshPassOptions passOptions = options_.passes;
+            passOptions.threadPool = &pool;
+            MeshPassReport passes = MeshPasses(passOptions).run(*meshData);
+            
+            auto summarizer = MeshSummarizerFactory::create(options_.summarizerType);
+            summarizer->setGroupByLayer(options_.groupByLayer);
+            auto summary = summarizer->summarize(*meshData);
+            passes.addTo(summary);
+            
+            if (table != nullptr) {
+                table->append(inputPath, summary);
+                file.outputPath = table->path();
+            } else {
+                auto writer = SummaryWriterFactory::create(options_.outputFormat, options_.outputDir);
+                writer->setIncludeTimestamp(options_.includeTimestamp);
+                writer->setPrettyPrint(options_.prettyPrint);
+                file.outputPath = writer->writeToFile(summary, baseName);
+            }
+            
+            file.triangleCount = summary.triangleCount;
+            file.totalSurfaceArea = summary.totalSurfaceArea;
+            file.success = true;
+        } catch (const std::exception& e) {
+            file.error = e.what();
+        } catch (...) {
+            file.error = "Unknown error";
+        }
+        
+        if (!file.success && table != nullptr) {
+            table->appendFailure(inputPath, file.error);
+        }
+        
+        file.seconds = secondsSince(startTime);
+        return file;
+    }
+
+    /**
+     * @brief Writes <indexName>.json listing every file's outcome in input order
+     */
+    std::string BatchProcessor::writeIndex(const BatchResult& result) const {
+        OutputBuffer out;
+        out.append("{\n  \"file_count\": ");
+        out.appendInteger(result.files.size());
+        out.append(",\n  \"succeeded\": ");
+        out.appendInteger(result.succeeded());
+        out.append(",\n  \"failed\": ");
+        out.appendInteger(result.failed());
+        out.append(",\n  \"seconds\": ");
+        out.appendJSONNumber(result.seconds);
+        out.append(",\n  \"files\": [");
+        
+        for (size_t i = 0; i < result.files.size(); ++i) {
+            const BatchFileResult& file = result.files[i];
+            out.append(i == 0 ? "\n    {\"input\": " : ",\n    {\"input\": ");
+            out.appendJSONString(file.inputPath);
+            out.append(", \"status\": ");
+            out.append(file.success ? "\"ok\"" : "\"failed\"");
+            if (file.success) {
+                out.append(", \"output\": ");
+                out.appendJSONString(file.outputPath);
+                out.append(", \"triangle_count\": ");
+                out.appendInteger(file.triangleCount);
+                out.append(", \"total_surface_area\": ");
+                out.appendJSONNumber(file.totalSurfaceArea);
+            } else {
+                out.append(", \"error\": ");
+                out.appendJSONString(file.error);
+            }
+            out.append(", \"file_size\": ");
+            out.appendInteger(file.fileSize);
+            out.append(", \"seconds\": ");
+            out.appendJSONNumber(file.seconds);
+            out.append('}');
+        }
+        out.append(result.files.empty() ? "]\n}\n" : "\n  ]\n}\n");
+        
+        std::filesystem::path indexPath = std::filesystem::path(options_.outputDir) / (options_.indexName + ".json");
+        if (!out.writeTo(indexPath)) {
+            throw BatchException("Cannot write index file: " + indexPath.string());
+        }
+        return std::filesystem::absolute(indexPath).string();
+    }
+
+} // namespace DXFProcessor
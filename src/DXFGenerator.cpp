@@ -0,0 +1,409 @@
+#include "DXFGenerator.h"
+#include "OutputBuffer.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace DXFProcessor {
+
+    namespace {
+
+        // Pit geometry, in units of the grid's half extents
+        constexpr double RIM_RADIUS = 0.9;          ///< Crest of the top bench
+        constexpr double FLOOR_RADIUS = 0.15;       ///< Edge of the flat floor
+        constexpr double DEPTH_RATIO = 0.35;        ///< Pit depth over the smaller half extent
+        constexpr int BENCH_COUNT = 12;
+        constexpr double BATTER_FRACTION = 0.6;     ///< Share of each bench step that is face, the rest berm
+        
+        // Natural surface and placement
+        constexpr double SURFACE_LEVEL = 420.0;
+        constexpr double SURFACE_TILT_X = 0.005;
+        constexpr double SURFACE_TILT_Y = 0.003;
+        constexpr double ORIGIN_EASTING = 512000.0;
+        constexpr double ORIGIN_NORTHING = 7004000.0;
+        
+        // Handles: LAYER table, then one per layer, then one per face
+        constexpr std::uint64_t LAYER_TABLE_HANDLE = 0x2;
+        constexpr std::uint64_t FIRST_LAYER_HANDLE = 0x10;
+        
+        constexpr size_t ESTIMATED_BYTES_PER_FACE = 320;
+        
+        std::FILE* openForWriting(const std::filesystem::path& path) {
+#ifdef _WIN32
+            return _wfopen(path.c_str(), L"wb");
+#else
+            return std::fopen(path.c_str(), "wb");
+#endif
+        }
+        
+        /// splitmix64 finalizer: a well-mixed hash of a 64-bit key
+        std::uint64_t mix(std::uint64_t key) {
+            key += 0x9E3779B97F4A7C15ull;
+            key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ull;
+            key = (key ^ (key >> 27)) * 0x94D049BB133111EBull;
+            return key ^ (key >> 31);
+        }
+        
+        /// Writes code/value groups as ASCII or binary DXF
+        class GroupWriter {
+        public:
+            GroupWriter(OutputBuffer& out, const GeneratorOptions& options)
+                : out_(out), binary_(options.binary), lineEnd_(options.crlf ? "\r\n" : "\n") {}
+            
+            void text(int code, std::string_view value) {
+                writeCode(code);
+                out_.append(value);
+                endValue();
+            }
+            
+            void real(int code, double value) {
+                writeCode(code);
+                if (binary_) {
+                    std::uint64_t bits;
+                    std::memcpy(&bits, &value, sizeof(bits));
+                    for (int shift = 0; shift < 64; shift += 8) {
+                        out_.append(static_cast<char>((bits >> shift) & 0xFF));
+                    }
+                } else {
+                    out_.appendNumber(value);
+                    out_.append(lineEnd_);
+                }
+            }
+            
+            /// 16-bit integer group (codes 60-79)
+            void integer(int code, int value) {
+                writeCode(code);
+                if (binary_) {
+                    writeInt16(value);
+                } else {
+                    out_.appendInteger(value);
+                    out_.append(lineEnd_);
+                }
+            }
+            
+            void handle(int code, std::uint64_t value) {
+                char digits[16];
+                size_t length = 0;
+                do {
+                    digits[length++] = "0123456789ABCDEF"[value & 0xF];
+                    value >>= 4;
+                } while (value != 0);
+                std::reverse(digits, digits + length);
+                text(code, std::string_view(digits, length));
+            }
+        
+        private:
+            void writeCode(int code) {
+                if (binary_) {
+                    writeInt16(code);
+                    return;
+                }
+                // Right-aligned to three columns, as AutoCAD writes them
+                if (code < 10) {
+                    out_.append("  ");
+                } else if (code < 100) {
+                    out_.append(' ');
+                }
+                out_.appendInteger(code);
+                out_.append(lineEnd_);
+            }
+            
+            void writeInt16(int value) {
+                auto bits = static_cast<std::uint16_t>(value);
+                out_.append(static_cast<char>(bits & 0xFF));
+                out_.append(static_cast<char>(bits >> 8));
+            }
+            
+            void endValue() {
+                if (binary_) {
+                    out_.append('\0');
+                } else {
+                    out_.append(lineEnd_);
+                }
+            }
+            
+            OutputBuffer& out_;
+            bool binary_;
+            std::string_view lineEnd_;
+        };
+        
+        /// Grid vertex positions and depth bands of the pit surface
+        class PitSurface {
+        public:
+            PitSurface(const GeneratorOptions& options, size_t columns, size_t rows)
+                : cellSize_(options.cellSize)
+                , noise_(options.noise)
+                , seed_(options.seed)
+                , halfWidth_(std::max(columns * options.cellSize / 2.0, options.cellSize))
+                , halfHeight_(std::max(rows * options.cellSize / 2.0, options.cellSize))
+                , depth_(DEPTH_RATIO * std::min(halfWidth_, halfHeight_)) {}
+            
+            /// Bench steps below the rim at a point: 0 outside the pit, BENCH_COUNT on the floor
+            double benchDepth(double x, double y) const {
+                double radius = std::sqrt((x / halfWidth_) * (x / halfWidth_) + (y / halfHeight_) * (y / halfHeight_));
+                double steps = std::clamp((RIM_RADIUS - radius) / (RIM_RADIUS - FLOOR_RADIUS), 0.0, 1.0) * BENCH_COUNT;
+                double bench = std::floor(steps);
+                return std::min(bench + std::min((steps - bench) / BATTER_FRACTION, 1.0), double(BENCH_COUNT));
+            }
+            
+            /// World position of grid vertex (i, j), rounded to millimetres
+            std::array<double, 3> vertex(size_t i, size_t j) const {
+                double x = i * cellSize_ - halfWidth_;
+                double y = j * cellSize_ - halfHeight_;
+                std::uint64_t hash = mix(seed_ ^ mix((static_cast<std::uint64_t>(j) << 32) | i));
+                double roughness = noise_ * ((hash >> 11) * (2.0 / 9007199254740992.0) - 1.0);
+                double z = SURFACE_LEVEL + SURFACE_TILT_X * x + SURFACE_TILT_Y * y
+                         - depth_ * benchDepth(x, y) / BENCH_COUNT + roughness;
+                return {millimetres(x + ORIGIN_EASTING), millimetres(y + ORIGIN_NORTHING), millimetres(z)};
+            }
+            
+            /// Depth band of the cell whose lower-left vertex is (i, j)
+            size_t layerOf(size_t i, size_t j, size_t layerCount) const {
+                double depth = benchDepth((i + 0.5) * cellSize_ - halfWidth_, (j + 0.5) * cellSize_ - halfHeight_);
+                return std::min(static_cast<size_t>(depth / BENCH_COUNT * layerCount), layerCount - 1);
+            }
+            
+            /// Conservative extents, for $EXTMIN/$EXTMAX
+            std::array<double, 3> minimum() const {
+                return {millimetres(ORIGIN_EASTING - halfWidth_), millimetres(ORIGIN_NORTHING - halfHeight_),
+                        std::floor(SURFACE_LEVEL - tilt() - depth_ - noise_)};
+            }
+            
+            std::array<double, 3> maximum() const {
+                return {millimetres(ORIGIN_EASTING + halfWidth_), millimetres(ORIGIN_NORTHING + halfHeight_),
+                        std::ceil(SURFACE_LEVEL + tilt() + noise_)};
+            }
+        
+        private:
+            static double millimetres(double value) {
+                return std::round(value * 1000.0) / 1000.0 + 0.0;  // + 0.0 turns -0 into 0
+            }
+            
+            double tilt() const {
+                return SURFACE_TILT_X * halfWidth_ + SURFACE_TILT_Y * halfHeight_;
+            }
+            
+            double cellSize_;
+            double noise_;
+            std::uint64_t seed_;
+            double halfWidth_;
+            double halfHeight_;
+            double depth_;
+        };
+        
+        std::string layerName(size_t layer) {
+            char name[32];
+            std::snprintf(name, sizeof(name), "PIT_%02zu", layer + 1);
+            return name;
+        }
+
+    }
+
+    DXFGenerator::DXFGenerator(GeneratorOptions options)
+        : options_(options) {
+        if (options_.layerCount == 0 || options_.layerCount > std::numeric_limits<std::uint16_t>::max()) {
+            throw GeneratorException("Layer count must be between 1 and 65535");
+        }
+        if (!(options_.cellSize > 0.0) || !std::isfinite(options_.cellSize)) {
+            throw GeneratorException("Cell size must be positive");
+        }
+        if (!(options_.noise >= 0.0) || !std::isfinite(options_.noise)) {
+            throw GeneratorException("Noise must be zero or positive");
+        }
+        if (options_.binary && options_.crlf) {
+            throw GeneratorException("Line endings only apply to ASCII output");
+        }
+        
+        // Near-square grid with just enough cells for the requested faces
+        size_t facesPerCell = options_.quads ? 1 : 2;
+        size_t cells = (options_.faceCount + facesPerCell - 1) / facesPerCell;
+        columns_ = std::max<size_t>(1, static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(cells)))));
+        rows_ = std::max<size_t>(1, (cells + columns_ - 1) / columns_);
+    }
+
+    void DXFGenerator::formatHeader(OutputBuffer& out) const {
+        if (options_.binary) {
+            out.append(std::string_view(BINARY_SENTINEL, BINARY_SENTINEL_SIZE));
+        }
+        GroupWriter groups(out, options_);
+        PitSurface surface(options_, columns_, rows_);
+        const std::uint64_t firstFaceHandle = FIRST_LAYER_HANDLE + options_.layerCount;
+        
+        groups.text(0, "SECTION");
+        groups.text(2, "HEADER");
+        groups.text(9, "$ACADVER");
+        groups.text(1, "AC1027");
+        groups.text(9, "$INSUNITS");
+        groups.integer(70, 6);  // Metres
+        const std::array<double, 3> extents[2] = {surface.minimum(), surface.maximum()};
+        const char* const extentNames[2] = {"$EXTMIN", "$EXTMAX"};
+        for (int e = 0; e < 2; ++e) {
+            groups.text(9, extentNames[e]);
+            groups.real(10, extents[e][0]);
+            groups.real(20, extents[e][1]);
+            groups.real(30, extents[e][2]);
+        }
+        groups.text(9, "$HANDSEED");
+        groups.handle(5, firstFaceHandle + options_.faceCount);
+        groups.text(0, "ENDSEC");
+        
+        groups.text(0, "SECTION");
+        groups.text(2, "TABLES");
+        groups.text(0, "TABLE");
+        groups.text(2, "LAYER");
+        groups.handle(5, LAYER_TABLE_HANDLE);
+        groups.text(100, "AcDbSymbolTable");
+        groups.integer(70, static_cast<int>(std::min<size_t>(options_.layerCount, 32767)));
+        for (size_t layer = 0; layer < options_.layerCount; ++layer) {
+            groups.text(0, "LAYER");
+            groups.handle(5, FIRST_LAYER_HANDLE + layer);
+            groups.text(100, "AcDbSymbolTableRecord");
+            groups.text(100, "AcDbLayerTableRecord");
+            groups.text(2, layerName(layer));
+            groups.integer(70, 0);
+            groups.integer(62, static_cast<int>(1 + layer % 255));
+            groups.text(6, "CONTINUOUS");
+        }
+        groups.text(0, "ENDTAB");
+        groups.text(0, "ENDSEC");
+        
+        groups.text(0, "SECTION");
+        groups.text(2, "ENTITIES");
+    }
+
+    void DXFGenerator::formatFaces(size_t firstFace, size_t count, OutputBuffer& out) const {
+        GroupWriter groups(out, options_);
+        PitSurface surface(options_, columns_, rows_);
+        const std::uint64_t firstFaceHandle = FIRST_LAYER_HANDLE + options_.layerCount;
+        std::vector<std::string> layerNames;
+        for (size_t layer = 0; layer < options_.layerCount; ++layer) {
+            layerNames.push_back(layerName(layer));
+        }
+        
+        for (size_t face = firstFace; face < firstFace + count; ++face) {
+            size_t cell = options_.quads ? face : face / 2;
+            size_t i = cell % columns_;
+            size_t j = cell / columns_;
+            
+            // Corners in order; a triangle repeats its third corner as the fourth
+            std::array<double, 3> corners[4];
+            if (options_.quads) {
+                corners[0] = surface.vertex(i, j);
+                corners[1] = surface.vertex(i + 1, j);
+                corners[2] = surface.vertex(i + 1, j + 1);
+                corners[3] = surface.vertex(i, j + 1);
+            } else if (face % 2 == 0) {
+                corners[0] = surface.vertex(i, j);
+                corners[1] = surface.vertex(i + 1, j);
+                corners[2] = surface.vertex(i, j + 1);
+                corners[3] = corners[2];
+            } else {
+                corners[0] = surface.vertex(i + 1, j);
+                corners[1] = surface.vertex(i + 1, j + 1);
+                corners[2] = surface.vertex(i, j + 1);
+                corners[3] = corners[2];
+            }
+            
+            groups.text(0, "3DFACE");
+            groups.handle(5, firstFaceHandle + face);
+            groups.text(100, "AcDbEntity");
+            groups.text(8, layerNames[surface.layerOf(i, j, options_.layerCount)]);
+            groups.text(100, "AcDbFace");
+            for (int corner = 0; corner < 4; ++corner) {
+                groups.real(10 + corner, corners[corner][0]);
+                groups.real(20 + corner, corners[corner][1]);
+                groups.real(30 + corner, corners[corner][2]);
+            }
+        }
+    }
+
+    void DXFGenerator::formatFooter(OutputBuffer& out) const {
+        GroupWriter groups(out, options_);
+        groups.text(0, "ENDSEC");
+        groups.text(0, "EOF");
+    }
+
+    template <typename Sink>
+    GeneratorResult DXFGenerator::run(Sink&& sink) const {
+        auto start = std::chrono::steady_clock::now();
+        GeneratorResult result;
+        result.faceCount = options_.faceCount;
+        auto emit = [&](const OutputBuffer& buffer) {
+            sink(buffer.view());
+            result.bytesWritten += buffer.size();
+        };
+        
+        OutputBuffer edge;
+        formatHeader(edge);
+        emit(edge);
+        
+        // Two waves of one block per worker: one being formatted, one being written
+        ThreadPool pool(options_.threadCount);
+        const size_t waveSize = std::max<size_t>(1, pool.size());
+        const size_t blockCount = (options_.faceCount + FACES_PER_BLOCK - 1) / FACES_PER_BLOCK;
+        std::vector<OutputBuffer> waves[2];
+        for (auto& wave : waves) {
+            for (size_t b = 0; b < std::min(waveSize, blockCount); ++b) {
+                wave.emplace_back(FACES_PER_BLOCK * ESTIMATED_BYTES_PER_FACE);
+            }
+        }
+        
+        size_t nextBlock = 0;
+        size_t pending = 0;  // Formatted blocks of the other wave, not yet written
+        for (int current = 0; nextBlock < blockCount || pending > 0; current ^= 1) {
+            size_t count = std::min(waveSize, blockCount - nextBlock);
+            TaskGroup group(pool);
+            for (size_t b = 0; b < count; ++b) {
+                size_t firstFace = (nextBlock + b) * FACES_PER_BLOCK;
+                OutputBuffer& buffer = waves[current][b];
+                group.run([this, firstFace, &buffer] {
+                    buffer.clear();
+                    formatFaces(firstFace, std::min(FACES_PER_BLOCK, options_.faceCount - firstFace), buffer);
+                });
+            }
+            for (size_t b = 0; b < pending; ++b) {
+                emit(waves[current ^ 1][b]);
+            }
+            group.wait();
+            nextBlock += count;
+            pending = count;
+        }
+        
+        edge.clear();
+        formatFooter(edge);
+        emit(edge);
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+    GeneratorResult DXFGenerator::write(const std::filesystem::path& path) const {
+        std::unique_ptr<std::FILE, int (*)(std::FILE*)> file(openForWriting(path), &std::fclose);
+        if (!file) {
+            throw GeneratorException("Cannot create output file: " + path.string());
+        }
+        GeneratorResult result = run([&](std::string_view bytes) {
+            if (std::fwrite(bytes.data(), 1, bytes.size(), file.get()) != bytes.size()) {
+                throw GeneratorException("Write failed: " + path.string());
+            }
+        });
+        if (std::fclose(file.release()) != 0) {
+            throw GeneratorException("Write failed: " + path.string());
+        }
+        return result;
+    }
+
+    std::string DXFGenerator::generate() const {
+        std::string text;
+        text.reserve(std::min<size_t>(options_.faceCount, 1 << 20) * ESTIMATED_BYTES_PER_FACE);
+        run([&](std::string_view bytes) { text.append(bytes); });
+        return text;
+    }
+
+} // namespace DXFProcessor
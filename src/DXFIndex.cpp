@@ -0,0 +1,458 @@
+#include "DXFIndex.h"
+#include "DXFEntityParser.h"
+#include "DXFTokenizer.h"
+#include "Profiler.h"
+#include <fstream>
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+#include <string_view>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace DXFProcessor {
+
+    namespace {
+
+        const char INDEX_MAGIC[8] = {'D', 'X', 'F', 'I', 'D', 'X', '\0', '\0'};
+        
+        float roundDown(double value) {
+            float rounded = static_cast<float>(value);
+            return (static_cast<double>(rounded) > value)
+                ? std::nextafter(rounded, -std::numeric_limits<float>::infinity()) : rounded;
+        }
+        
+        float roundUp(double value) {
+            float rounded = static_cast<float>(value);
+            return (static_cast<double>(rounded) < value)
+                ? std::nextafter(rounded, std::numeric_limits<float>::infinity()) : rounded;
+        }
+        
+        template <typename T>
+        void writeValue(std::ofstream& out, const T& value) {
+            out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+        
+        template <typename T>
+        void readValue(std::ifstream& in, T& value) {
+            if (!in.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+                throw DXFIndexException("Truncated index file");
+            }
+        }
+        
+        void writeString(std::ofstream& out, const std::string& text) {
+            writeValue(out, static_cast<std::uint16_t>(text.size()));
+            out.write(text.data(), static_cast<std::streamsize>(text.size()));
+        }
+        
+        std::string readString(std::ifstream& in) {
+            std::uint16_t length = 0;
+            readValue(in, length);
+            std::string text(length, '\0');
+            if (length > 0 && !in.read(&text[0], length)) {
+                throw DXFIndexException("Truncated index file");
+            }
+            return text;
+        }
+        
+        /// FNV-1a over a byte range, continuing from 'hash'
+        std::uint64_t hashBytes(std::string_view bytes, std::uint64_t hash) {
+            for (unsigned char byte : bytes) {
+                hash = (hash ^ byte) * 0x100000001B3ULL;
+            }
+            return hash;
+        }
+        
+        /// Smallest sidecar byte count of one section record (empty name, begin, end)
+        constexpr std::uint64_t MIN_SECTION_BYTES = sizeof(std::uint16_t) + 2 * sizeof(std::uint64_t);
+
+    } // namespace
+
+    /**
+     * @brief Scans a DXF buffer once, recording sections and 3DFACE footprints
+     * 
+     * A face is indexed only if it carries numeric X coordinate groups for
+     * its first three vertices, matching the rule EntityParser<Face3DEntity>
+     * uses to accept a triangle.
+     */
+    DXFIndex DXFIndex::build(const MappedFile& file) {
+        DXFIndex index;
+        index.stampSource(file);
+        
+        // Keys view into the mapped file, which outlives this scan
+        std::unordered_map<std::string_view, LayerId> layerIds;
+        DXFTokenizer tokenizer(file.view());
+        DXFGroup pair;
+        
+        bool inEntities = false;
+        bool expectSectionName = false;
+        bool inFace = false;
+        DXFIndexEntry face{};
+        // X and Y of the first three vertices; a later group replaces an earlier one, as in the parser
+        double xs[3] = {0, 0, 0};
+        double ys[3] = {0, 0, 0};
+        int numericX = 0;         // Bit per vertex whose X parsed
+        size_t conversions = 0;   // Coordinates converted, for the profiler
+        
+        auto finishFace = [&](size_t endOffset) {
+            if (inFace && numericX == 0x7) {
+                // A missing or unparseable Y stays 0, where the parser puts it
+                index.addFace(face.offset, endOffset, face.layer,
+                              std::min({xs[0], xs[1], xs[2]}), std::min({ys[0], ys[1], ys[2]}),
+                              std::max({xs[0], xs[1], xs[2]}), std::max({ys[0], ys[1], ys[2]}));
+            }
+            inFace = false;
+        };
+        
+        while (tokenizer.next(pair)) {
+            if (!pair.valid) {
+                continue;
+            }
+            
+            if (expectSectionName) {
+                expectSectionName = false;
+                if (pair.code == 2) {
+                    index.sections.back().name = std::string(pair.value);
+                    inEntities = (pair.value == "ENTITIES");
+                    continue;
+                }
+            }
+            
+            if (pair.code == 0) {
+                finishFace(pair.offset);
+                
+                if (pair.value == "SECTION") {
+                    DXFSectionRange section;
+                    section.begin = pair.offset;
+                    index.sections.push_back(section);
+                    expectSectionName = true;
+                } else if (pair.value == "ENDSEC") {
+                    if (!index.sections.empty()) {
+                        index.sections.back().end = tokenizer.position();
+                    }
+                    inEntities = false;
+                } else if (inEntities && pair.value == "3DFACE") {
+                    inFace = true;
+                    face = DXFIndexEntry{};
+                    face.offset = pair.offset;
+                    face.layer = MeshData::DEFAULT_LAYER;
+                    ys[0] = ys[1] = ys[2] = 0.0;
+                    numericX = 0;
+                }
+                continue;
+            }
+            
+            if (!inFace) {
+                continue;
+            }
+            
+            if (pair.code == 8) {
+                if (pair.value != "0") {
+                    auto it = layerIds.find(pair.value);
+                    if (it == layerIds.end()) {
+                        if (index.layerNames.size() > std::numeric_limits<LayerId>::max()) {
+                            throw DXFIndexException("Too many distinct layers: " + std::string(pair.value));
+                        }
+                        LayerId id = static_cast<LayerId>(index.layerNames.size());
+                        index.layerNames.emplace_back(pair.value);
+                        it = layerIds.emplace(pair.value, id).first;
+                    }
+                    face.layer = it->second;
+                }
+            } else if (pair.code >= 10 && pair.code <= 12) {
+                const int vertex = pair.code - 10;
+                ++conversions;
+                if (DXFTokenizer::parseDouble(pair.value, xs[vertex])) {
+                    numericX |= 1 << vertex;
+                } else {
+                    numericX &= ~(1 << vertex);
+                }
+            } else if (pair.code >= 20 && pair.code <= 22) {
+                const int vertex = pair.code - 20;
+                ++conversions;
+                if (!DXFTokenizer::parseDouble(pair.value, ys[vertex])) {
+                    ys[vertex] = 0.0;
+                }
+            }
+        }
+        finishFace(tokenizer.position());
+        
+        DXF_PROFILE_COUNT(Lines, tokenizer.lineCount());
+        DXF_PROFILE_COUNT(NumericConversions, tokenizer.codeCount() + conversions);
+        
+        return index;
+    }
+
+    DXFIndex DXFIndex::build(const std::string& dxfPath) {
+        try {
+            MappedFile file(dxfPath, MappedFile::AccessHint::Sequential);
+            return build(file);
+        } catch (const MappedFileException& e) {
+            throw DXFIndexException(e.what());
+        }
+    }
+
+    DXFIndex DXFIndex::load(const std::string& indexPath) {
+        std::ifstream in(indexPath, std::ios::binary | std::ios::ate);
+        if (!in.is_open()) {
+            throw DXFIndexException("Cannot open index file: " + indexPath);
+        }
+        const std::uint64_t fileSize = static_cast<std::uint64_t>(in.tellg());
+        in.seekg(0);
+        
+        char magic[sizeof(INDEX_MAGIC)];
+        std::uint32_t version = 0;
+        if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, INDEX_MAGIC, sizeof(magic)) != 0) {
+            throw DXFIndexException("Not a DXF index file: " + indexPath);
+        }
+        readValue(in, version);
+        if (version != FORMAT_VERSION) {
+            throw DXFIndexException("Unsupported index version " + std::to_string(version) + ": " + indexPath);
+        }
+        
+        DXFIndex index;
+        std::uint32_t sectionCount = 0, layerCount = 0;
+        std::uint64_t faceCount = 0;
+        readValue(in, index.sourceSize);
+        readValue(in, index.sourceModified);
+        readValue(in, index.sourceHash);
+        readValue(in, sectionCount);
+        readValue(in, layerCount);
+        readValue(in, faceCount);
+        
+        // Counts are checked against the bytes left before anything is sized from them
+        auto remaining = [&] { return fileSize - static_cast<std::uint64_t>(in.tellg()); };
+        if (sectionCount > remaining() / MIN_SECTION_BYTES ||
+            layerCount > static_cast<std::uint64_t>(std::numeric_limits<LayerId>::max()) + 1) {
+            throw DXFIndexException("Corrupt index header: " + indexPath);
+        }
+        
+        index.sections.resize(sectionCount);
+        for (auto& section : index.sections) {
+            section.name = readString(in);
+            readValue(in, section.begin);
+            readValue(in, section.end);
+            if (section.begin > section.end || section.end > index.sourceSize) {
+                throw DXFIndexException("Section beyond end of indexed file: " + indexPath);
+            }
+        }
+        
+        index.layerNames.clear();
+        for (std::uint32_t i = 0; i < layerCount; ++i) {
+            index.layerNames.push_back(readString(in));
+        }
+        
+        if (faceCount != remaining() / sizeof(DXFIndexEntry)) {
+            throw DXFIndexException("Face count does not match index size: " + indexPath);
+        }
+        index.faces.resize(static_cast<size_t>(faceCount));
+        std::streamsize faceBytes = static_cast<std::streamsize>(faceCount * sizeof(DXFIndexEntry));
+        if (faceBytes > 0 && !in.read(reinterpret_cast<char*>(index.faces.data()), faceBytes)) {
+            throw DXFIndexException("Truncated index file: " + indexPath);
+        }
+        for (const DXFIndexEntry& face : index.faces) {
+            if (face.layer >= index.layerNames.size()) {
+                throw DXFIndexException("Face on unknown layer " + std::to_string(face.layer) + ": " + indexPath);
+            }
+            if (face.offset > index.sourceSize || face.length > index.sourceSize - face.offset) {
+                throw DXFIndexException("Face beyond end of indexed file: " + indexPath);
+            }
+        }
+        
+        return index;
+    }
+
+    void DXFIndex::save(const std::string& indexPath) const {
+        std::ofstream out(indexPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            throw DXFIndexException("Cannot create index file: " + indexPath);
+        }
+        
+        out.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+        writeValue(out, FORMAT_VERSION);
+        writeValue(out, sourceSize);
+        writeValue(out, sourceModified);
+        writeValue(out, sourceHash);
+        writeValue(out, static_cast<std::uint32_t>(sections.size()));
+        writeValue(out, static_cast<std::uint32_t>(layerNames.size()));
+        writeValue(out, static_cast<std::uint64_t>(faces.size()));
+        
+        for (const auto& section : sections) {
+            writeString(out, section.name);
+            writeValue(out, section.begin);
+            writeValue(out, section.end);
+        }
+        for (const auto& name : layerNames) {
+            writeString(out, name);
+        }
+        out.write(reinterpret_cast<const char*>(faces.data()),
+                  static_cast<std::streamsize>(faces.size() * sizeof(DXFIndexEntry)));
+        
+        if (!out) {
+            throw DXFIndexException("Failed writing index file: " + indexPath);
+        }
+    }
+
+    std::vector<size_t> DXFIndex::select(const DXFIndexQuery& query) const {
+        std::vector<bool> layerSelected(layerNames.size(), query.layers.empty());
+        for (const auto& name : query.layers) {
+            for (size_t id = 0; id < layerNames.size(); ++id) {
+                if (layerNames[id] == name) {
+                    layerSelected[id] = true;
+                }
+            }
+        }
+        
+        std::vector<size_t> selected;
+        for (size_t i = 0; i < faces.size(); ++i) {
+            const DXFIndexEntry& face = faces[i];
+            if (!layerSelected[face.layer]) {
+                continue;
+            }
+            if (query.hasWindow &&
+                (face.maxX < query.minX || face.minX > query.maxX ||
+                 face.maxY < query.minY || face.minY > query.maxY)) {
+                continue;
+            }
+            selected.push_back(i);
+        }
+        return selected;
+    }
+
+    const DXFSectionRange* DXFIndex::findSection(const std::string& name) const {
+        for (const auto& section : sections) {
+            if (section.name == name) {
+                return &section;
+            }
+        }
+        return nullptr;
+    }
+
+    void DXFIndex::addFace(std::uint64_t begin, std::uint64_t end, LayerId layer,
+                           double minX, double minY, double maxX, double maxY) {
+        DXFIndexEntry face{};
+        face.offset = begin;
+        face.length = static_cast<std::uint32_t>(end - begin);
+        face.layer = layer;
+        face.minX = roundDown(minX);
+        face.minY = roundDown(minY);
+        face.maxX = roundUp(maxX);
+        face.maxY = roundUp(maxY);
+        faces.push_back(face);
+    }
+
+    void DXFIndex::addFace(std::uint64_t begin, std::uint64_t end, LayerId layer, const Triangle& triangle) {
+        const auto& v = triangle.vertices;
+        addFace(begin, end, layer,
+                std::min({v[0].x, v[1].x, v[2].x}), std::min({v[0].y, v[1].y, v[2].y}),
+                std::max({v[0].x, v[1].x, v[2].x}), std::max({v[0].y, v[1].y, v[2].y}));
+    }
+
+    void DXFIndex::append(DXFIndex&& part, const std::vector<LayerId>& layerMap) {
+        auto section = part.sections.begin();
+        if (section != part.sections.end() && section->begin == 0 && section->name.empty() &&
+            !sections.empty() && sections.back().end == 0) {
+            sections.back().end = section->end;
+            ++section;
+        }
+        sections.insert(sections.end(), std::make_move_iterator(section), std::make_move_iterator(part.sections.end()));
+        
+        faces.reserve(faces.size() + part.faces.size());
+        for (DXFIndexEntry face : part.faces) {
+            face.layer = layerMap.at(face.layer);
+            faces.push_back(face);
+        }
+        part = DXFIndex();
+    }
+
+    void DXFIndex::stampSource(const MappedFile& file) {
+        std::string_view bytes = file.view();
+        sourceSize = bytes.size();
+        
+        std::error_code error;
+        auto modified = std::filesystem::last_write_time(file.path(), error);
+        sourceModified = error ? 0 : static_cast<std::int64_t>(modified.time_since_epoch().count());
+        
+        // Both ends: headers change with most saves, and entities are usually appended
+        const size_t head = std::min(bytes.size(), STAMP_BYTES);
+        const size_t tail = std::min(bytes.size() - head, STAMP_BYTES);
+        sourceHash = hashBytes(bytes.substr(0, head), 0xCBF29CE484222325ULL);
+        sourceHash = hashBytes(bytes.substr(bytes.size() - tail), sourceHash);
+    }
+
+    bool DXFIndex::matchesSource(const MappedFile& file) const {
+        DXFIndex current;
+        current.stampSource(file);
+        return current.sourceSize == sourceSize && current.sourceModified == sourceModified &&
+               current.sourceHash == sourceHash;
+    }
+
+    DXFIndexedReader::DXFIndexedReader(const std::string& dxfPath, bool writeSidecar) {
+        try {
+            file_ = MappedFile(dxfPath, MappedFile::AccessHint::Random);
+        } catch (const MappedFileException& e) {
+            throw DXFIndexException(e.what());
+        }
+        
+        std::string sidecar = DXFIndex::sidecarPath(dxfPath);
+        if (std::filesystem::exists(sidecar)) {
+            try {
+                index_ = DXFIndex::load(sidecar);
+                if (index_.matchesSource(file_)) {
+                    return;
+                }
+            } catch (const DXFIndexException&) {
+                // Unreadable sidecar, rebuild below
+            }
+        }
+        
+        index_ = DXFIndex::build(file_);
+        if (writeSidecar) {
+            try {
+                index_.save(sidecar);
+            } catch (const DXFIndexException&) {
+                // Read-only directory; the sidecar only speeds up the next open
+            }
+        }
+    }
+
+    std::unique_ptr<MeshData> DXFIndexedReader::read(const DXFIndexQuery& query) const {
+        DXF_PROFILE_SCOPE("indexed read");
+        auto meshData = std::make_unique<MeshData>();
+        std::vector<size_t> selected = index_.select(query);
+        meshData->reserve(selected.size());
+        
+        std::vector<LayerId> layerMap(index_.layerNames.size());
+        for (size_t id = 0; id < index_.layerNames.size(); ++id) {
+            layerMap[id] = meshData->internLayer(index_.layerNames[id]);
+        }
+        
+        std::string_view bytes = file_.view();
+        EntityParser<Face3DEntity>::Record face;
+        size_t lines = 0;
+        size_t codes = 0;
+        for (size_t faceIndex : selected) {
+            const DXFIndexEntry& entry = index_.faces[faceIndex];
+            if (entry.offset + entry.length > bytes.size()) {
+                throw DXFIndexException("Index entry beyond end of file: " + file_.path());
+            }
+            
+            DXFTokenizer tokenizer(bytes.substr(static_cast<size_t>(entry.offset), entry.length));
+            DXFGroup pair;
+            tokenizer.next(pair);  // "0 / 3DFACE"
+            EntityParser<Face3DEntity>::parse(tokenizer, pair, face);
+            lines += tokenizer.lineCount();
+            codes += tokenizer.codeCount();
+            
+            meshData->addTriangle(Triangle(face.vertex(0), face.vertex(1), face.vertex(2)), layerMap[entry.layer]);
+        }
+        
+        DXF_PROFILE_COUNT(Lines, lines);
+        DXF_PROFILE_COUNT(Entities, selected.size());
+        DXF_PROFILE_COUNT(NumericConversions, codes + face.conversions);
+        return meshData;
+    }
+
+} // namespace DXFProcessor
@@ -0,0 +1,328 @@
+#include "DXFPipeline.h"
+#include "DXFEntityParser.h"
+#include "DXFReader.h"
+#include "Profiler.h"
+#include "SPSCQueue.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <thread>
+#include <utility>
+
+namespace DXFProcessor {
+
+    namespace {
+
+        using Clock = std::chrono::steady_clock;
+        
+        double secondsSince(Clock::time_point start) {
+            return std::chrono::duration<double>(Clock::now() - start).count();
+        }
+        
+        std::string_view trimLine(std::string_view line) {
+            size_t begin = line.find_first_not_of(" \t");
+            if (begin == std::string_view::npos) {
+                return {};
+            }
+            size_t end = line.find_last_not_of(" \t\r");
+            return line.substr(begin, end - begin + 1);
+        }
+        
+        /// Entity and section names: letters, digits, '_' and '$', with at least one letter
+        bool isEntityName(std::string_view value) {
+            bool hasLetter = false;
+            for (char c : value) {
+                bool letter = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+                if (!letter && !(c >= '0' && c <= '9') && c != '_' && c != '$') {
+                    return false;
+                }
+                hasLetter = hasLetter || letter;
+            }
+            return hasLetter;
+        }
+        
+        /**
+         * @brief Offset of the last complete code-0 group in a buffer, or 0 if there is none
+         *
+         * Scans backward for a "0" line followed by a full line holding an
+         * entity name. Code lines are plain integers, so a value line that
+         * happens to read "0" is always followed by a code line and never
+         * matches; the match is a real group start even though the buffer
+         * begins at an arbitrary line of the file.
+         */
+        size_t findLastGroupStart(std::string_view text) {
+            size_t valueEnd = text.rfind('\n');
+            while (valueEnd != std::string_view::npos && valueEnd > 0) {
+                size_t codeEnd = text.rfind('\n', valueEnd - 1);
+                if (codeEnd == std::string_view::npos || codeEnd == 0) {
+                    return 0;
+                }
+                size_t codeStart = text.rfind('\n', codeEnd - 1);
+                codeStart = (codeStart == std::string_view::npos) ? 0 : codeStart + 1;
+                if (codeStart > 0 && trimLine(text.substr(codeStart, codeEnd - codeStart)) == "0" &&
+                    isEntityName(trimLine(text.substr(codeEnd + 1, valueEnd - codeEnd - 1)))) {
+                    return codeStart;
+                }
+                valueEnd = codeEnd;
+            }
+            return 0;
+        }
+        
+        std::FILE* openForReading(const std::filesystem::path& path) {
+#ifdef _WIN32
+            return _wfopen(path.c_str(), L"rb");
+#else
+            return std::fopen(path.c_str(), "rb");
+#endif
+        }
+        
+        /// Triangles parsed from one chunk, with the chunk's own layer table
+        struct TriangleBatch {
+            MeshData mesh;
+            size_t faceCount = 0;
+        };
+        
+        template <typename T>
+        void addWaits(PipelineStageStats& stage, const typename SPSCQueue<T>::WaitStats& waits, bool input) {
+            if (input) {
+                stage.inputWaits += waits.waits;
+                stage.inputWaitSeconds += waits.seconds;
+            } else {
+                stage.outputWaits += waits.waits;
+                stage.outputWaitSeconds += waits.seconds;
+            }
+        }
+
+    }
+
+    DXFPipeline::DXFPipeline(PipelineOptions options)
+        : options_(options) {
+        if (options_.chunkBytes == 0) {
+            options_.chunkBytes = PipelineOptions().chunkBytes;
+        }
+        if (options_.queueDepth == 0) {
+            options_.queueDepth = 1;
+        }
+    }
+
+    /**
+     * @brief Runs the three stages until the file is consumed or a stage fails
+     *
+     * The read and parse stages run on their own threads; accumulation runs
+     * on the calling thread. A failing stage cancels every queue so the
+     * others stop at their next push or pop, and the first error is rethrown
+     * once all threads have joined.
+     */
+    PipelineResult DXFPipeline::run(const std::string& filePath, MeshSummarizer& summarizer) {
+        if (!std::filesystem::is_regular_file(filePath)) {
+            throw DXFReaderException("File does not exist: " + filePath);
+        }
+        std::FILE* file = openForReading(filePath);
+        if (file == nullptr) {
+            throw DXFReaderException("Cannot open file: " + filePath);
+        }
+        
+        const auto start = Clock::now();
+        const size_t depth = options_.queueDepth;
+        const size_t bufferCount = depth + 2;  // Queued items plus one held by each end
+        
+        SPSCQueue<std::string> chunks(depth);
+        SPSCQueue<std::string> freeChunks(bufferCount);
+        SPSCQueue<TriangleBatch> batches(depth);
+        SPSCQueue<TriangleBatch> freeBatches(bufferCount);
+        for (size_t i = 0; i < bufferCount; ++i) {
+            freeChunks.push(std::string());
+            freeBatches.push(TriangleBatch());
+        }
+        
+        auto cancelAll = [&] {
+            chunks.cancel();
+            freeChunks.cancel();
+            batches.cancel();
+            freeBatches.cancel();
+        };
+        
+        PipelineResult result;
+        result.stages.resize(3);
+        PipelineStageStats& readStage = result.stages[0];
+        PipelineStageStats& parseStage = result.stages[1];
+        PipelineStageStats& accumulateStage = result.stages[2];
+        readStage.name = "read";
+        parseStage.name = "parse";
+        accumulateStage.name = "accumulate";
+        
+        std::exception_ptr readError;
+        std::exception_ptr parseError;
+        std::exception_ptr accumulateError;
+        double readSeconds = 0.0;
+        double parseSeconds = 0.0;
+        
+        // Stage 1: read chunks, each ending just before its last code-0 group
+        std::thread reader([&] {
+            const auto stageStart = Clock::now();
+            try {
+                std::string carry;
+                bool eof = false;
+                while (!eof) {
+                    std::string chunk;
+                    if (!freeChunks.pop(chunk)) {
+                        break;
+                    }
+                    {
+                        DXF_PROFILE_SCOPE("read chunk");
+                        chunk.assign(carry);
+                        
+                        size_t cut = 0;
+                        while (cut == 0 && !eof) {
+                            size_t used = chunk.size();
+                            chunk.resize(used + options_.chunkBytes);
+                            size_t count = std::fread(&chunk[used], 1, options_.chunkBytes, file);
+                            chunk.resize(used + count);
+                            result.bytesRead += count;
+                            DXF_PROFILE_COUNT(BytesRead, count);
+                            if (count < options_.chunkBytes) {
+                                if (std::ferror(file)) {
+                                    throw DXFReaderException("Cannot read file: " + filePath);
+                                }
+                                eof = true;
+                            }
+                            // No cut found means one entity spans the whole buffer; read on
+                            cut = eof ? chunk.size() : findLastGroupStart(chunk);
+                        }
+                        
+                        carry.assign(chunk, cut, std::string::npos);
+                        chunk.resize(cut);
+                    }
+                    ++readStage.items;
+                    if (!chunks.push(std::move(chunk))) {
+                        break;
+                    }
+                }
+                chunks.close();
+            } catch (...) {
+                readError = std::current_exception();
+                cancelAll();
+            }
+            readSeconds = secondsSince(stageStart);
+        });
+        
+        // Stage 2: tokenize and parse each chunk into a triangle batch
+        std::thread parser([&] {
+            const auto stageStart = Clock::now();
+            try {
+                bool inEntitiesSection = false;
+                std::string chunk;
+                TriangleBatch batch;
+                while (chunks.pop(chunk)) {
+                    if (!freeBatches.pop(batch)) {
+                        break;
+                    }
+                    {
+                        DXF_PROFILE_SCOPE("parse chunk");
+                        batch.mesh.clear();
+                        batch.faceCount = parseFaceRange(chunk, inEntitiesSection, batch.mesh);
+                    }
+                    ++parseStage.items;
+                    freeChunks.push(std::move(chunk));
+                    if (!batches.push(std::move(batch))) {
+                        break;
+                    }
+                }
+                batches.close();
+            } catch (const DXFReaderException&) {
+                parseError = std::current_exception();
+                cancelAll();
+            } catch (const std::exception& e) {
+                parseError = std::make_exception_ptr(DXFReaderException("Parse error: " + std::string(e.what())));
+                cancelAll();
+            }
+            parseSeconds = secondsSince(stageStart);
+        });
+        
+        // Stage 3 (this thread): fold batches into running totals, or into a mesh
+        const auto accumulateStart = Clock::now();
+        const bool streaming = summarizer.isStreamable();
+        const bool byLayer = summarizer.getGroupByLayer();
+        GroupAccumulator total;
+        std::vector<GroupAccumulator> layerTotals;
+        MeshData layerTable;  // File-wide layer ids, in first-seen order like a sequential read
+        MeshData mesh;
+        try {
+            TriangleBatch batch;
+            std::vector<LayerId> remap;
+            while (batches.pop(batch)) {
+                DXF_PROFILE_SCOPE("accumulate batch");
+                result.entityCount += batch.faceCount;
+                ++accumulateStage.items;
+                if (!streaming) {
+                    mesh.append(batch.mesh);
+                } else {
+                    const MeshData& part = batch.mesh;
+                    if (byLayer) {
+                        remap.resize(part.getLayerNames().size());
+                        for (size_t id = 0; id < part.getLayerNames().size(); ++id) {
+                            remap[id] = layerTable.internLayer(part.getLayerNames()[id]);
+                        }
+                        layerTotals.resize(layerTable.getLayerCount());
+                    }
+                    const SegmentedVector<Triangle>& triangles = part.getTriangles();
+                    for (size_t i = 0; i < triangles.size(); ++i) {
+                        total.add(triangles[i]);
+                        if (byLayer) {
+                            layerTotals[remap[part.getTriangleLayer(i)]].add(triangles[i]);
+                        }
+                    }
+                }
+                freeBatches.push(std::move(batch));
+            }
+        } catch (const std::exception& e) {
+            accumulateError = std::make_exception_ptr(DXFReaderException("Parse error: " + std::string(e.what())));
+            cancelAll();
+        }
+        
+        reader.join();
+        parser.join();
+        std::fclose(file);
+        
+        for (const std::exception_ptr& error : {readError, parseError, accumulateError}) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+        if (result.entityCount == 0) {
+            throw DXFReaderException("No 3D faces found in DXF file");
+        }
+        
+        if (streaming) {
+            std::vector<GroupSummary> layers;
+            for (size_t id = 0; id < layerTotals.size(); ++id) {
+                if (layerTotals[id].triangleCount > 0) {
+                    layers.push_back(layerTotals[id].finish(layerTable.getLayerName(static_cast<LayerId>(id))));
+                }
+            }
+            result.summary = summarizer.summarizeTotals(total, std::move(layers));
+        } else {
+            result.summary = summarizer.summarize(mesh);
+        }
+        
+        // Wait counters are final now that every thread has joined
+        addWaits<std::string>(readStage, freeChunks.popStats(), false);
+        addWaits<std::string>(readStage, chunks.pushStats(), false);
+        addWaits<std::string>(parseStage, chunks.popStats(), true);
+        addWaits<TriangleBatch>(parseStage, freeBatches.popStats(), false);
+        addWaits<TriangleBatch>(parseStage, batches.pushStats(), false);
+        addWaits<TriangleBatch>(accumulateStage, batches.popStats(), true);
+        
+        const double accumulateSeconds = secondsSince(accumulateStart);
+        const double stageSeconds[] = {readSeconds, parseSeconds, accumulateSeconds};
+        for (size_t i = 0; i < result.stages.size(); ++i) {
+            PipelineStageStats& stage = result.stages[i];
+            stage.busySeconds = std::max(0.0, stageSeconds[i] - stage.inputWaitSeconds - stage.outputWaitSeconds);
+        }
+        result.seconds = secondsSince(start);
+        return result;
+    }
+
+} // namespace DXFProcessor
@@ -1,11 +1,15 @@
 #include "DXFReader.h"
-#include <fstream>
-#include <sstream>
-#include <iostream>
+#include "DXFEntityParser.h"
+#include "DXFIndex.h"
+#include "DXFTokenizer.h"
+#include "MappedFile.h"
+#include "Profiler.h"
+#include "ThreadPool.h"
 #include <functional>
 #include <filesystem>
 #include <limits>
 #include <cmath>
+#include <memory_resource>
 #include <vector>
 
 namespace DXFProcessor {
@@ -14,7 +18,8 @@ namespace DXFProcessor {
      * @brief Reads and parses a DXF file to extract 3D mesh data
      * 
      * This is the main entry point for DXF file processing. It validates the file
-     * exists and is readable before delegating to the internal parser.
+     * exists and is readable before delegating to the internal parser (which
+     * also writes the sidecar index if enabled), then compacts the mesh if enabled.
      * 
      * @param filePath Path to the DXF file to process
      * @return std::unique_ptr<MeshData> Parsed mesh data containing triangles
@@ -29,512 +34,432 @@ namespace DXFProcessor {
             throw DXFReaderException("Path is not a regular file: " + filePath);
         }
         
-        return parseFile(filePath);
-    }
-
-    /**
-     * @brief Internal parser that processes DXF file content line by line
-     * 
-     * Uses a robust line-based parsing approach that reads the entire file into memory
-     * first, then processes it sequentially. This eliminates file seeking issues and
-     * provides reliable parsing of DXF code-value pairs.
-     * 
-     * @param filePath Path to the DXF file (already validated)
-     * @return std::unique_ptr<MeshData> Mesh data with all parsed 3DFACE entities
-     * @throws DXFReaderException if file cannot be opened or parsing fails
-     */
-    std::unique_ptr<MeshData> DXFReader::parseFile(const std::string& filePath) {
-        std::ifstream file(filePath);
-        if (!file.is_open()) {
-            throw DXFReaderException("Cannot open file: " + filePath);
-        }
-        
-        auto meshData = std::make_unique<MeshData>();
-        lastEntityCount_ = 0;
-        
-        size_t fileSize = std::filesystem::file_size(filePath);
+        auto meshData = parseFile(filePath);
         
-        meshData->reserve(3000);
-        
-        std::vector<std::string> lines;
-        std::string line;
-        
-        // Read all lines first
-        while (std::getline(file, line)) {
-            line.erase(line.find_last_not_of(" \t\r\n") + 1);
-            line.erase(0, line.find_first_not_of(" \t"));
-            lines.push_back(line);
-        }
-        
-        file.close();
-        
-        bool inEntitiesSection = false;
-        size_t i = 0;
-        
-        try {
-            while (i < lines.size()) {
-                if (lines[i] == "0" && i + 1 < lines.size()) {
-                    std::string entityType = lines[i + 1];
-                    
-                    if (entityType == "SECTION" && i + 3 < lines.size()) {
-                        if (lines[i + 2] == "2" && lines[i + 3] == "ENTITIES") {
-                            inEntitiesSection = true;
-                            i += 4;
-                            continue;
-                        }
-                    } else if (entityType == "ENDSEC") {
-                        inEntitiesSection = false;
-                        i += 2;
-                        continue;
-                    } else if (inEntitiesSection && entityType == "3DFACE") {
-                        Triangle triangle;
-                        size_t nextEntityIndex = i + 2;
-                        if (parse3DFaceFromLines(lines, nextEntityIndex, triangle)) {
-                            meshData->addTriangle(triangle);
-                            lastEntityCount_++;
-                            
-                            if (lastEntityCount_ % 100 == 0 && fileSize > 0) {
-                                double progress = static_cast<double>(nextEntityIndex) / lines.size();
-                                reportProgress(progress);
-                            }
-                        }
-                        i = nextEntityIndex;
-                        continue;
-                    }
-                }
-                i++;
-            }
-        } catch (const std::exception& e) {
-            throw DXFReaderException("Parse error: " + std::string(e.what()));
-        }
-        
-        reportProgress(1.0);
-        
-        if (meshData->isEmpty()) {
-            throw DXFReaderException("No 3D faces found in DXF file");
+        if (compactStorage_) {
+            DXF_PROFILE_SCOPE("compact");
+            meshData->compact();
         }
         
         return meshData;
     }
 
     /**
-     * @brief Reads the next DXF code-value pair from file stream
+     * @brief Reads header variables without parsing any entities
      * 
-     * DXF files consist of code-value pairs where the code (integer) appears on one line
-     * and its corresponding value appears on the next line.
+     * Tokenizes code-value pairs from the start of the mapped file until the
+     * ENDSEC that closes the HEADER section, so only the header's pages are
+     * read. Only $ACADVER, $INSUNITS, $EXTMIN and $EXTMAX are kept; all other
+     * variables are skipped.
      * 
-     * @param file Input file stream positioned at a code line
-     * @param code Reference to DXFCode structure to populate
-     * @return true if code-value pair was successfully read, false on EOF or error
+     * @param filePath Path to the DXF file
+     * @return DXFHeaderInfo with header values and an entity count estimate
+     * @throws DXFReaderException if the file can't be opened or has no HEADER section
      */
-    bool DXFReader::readNextCode(std::ifstream& file, DXFCode& code) {
-        std::string line;
-        
-        if (!std::getline(file, line)) {
-            return false;
+    DXFHeaderInfo DXFReader::readHeader(const std::string& filePath) {
+        if (!std::filesystem::exists(filePath)) {
+            throw DXFReaderException("File does not exist: " + filePath);
         }
         
-        line.erase(line.find_last_not_of(" \t\r\n") + 1);
-        
-        try {
-            code.code = std::stoi(line);
-        } catch (const std::exception&) {
-            return false;
+        if (!std::filesystem::is_regular_file(filePath)) {
+            throw DXFReaderException("Path is not a regular file: " + filePath);
         }
         
-        if (!std::getline(file, line)) {
-            return false;
+        MappedFile file;
+        try {
+            file = MappedFile(filePath, MappedFile::AccessHint::Sequential);
+        } catch (const MappedFileException& e) {
+            throw DXFReaderException("Cannot open file: " + filePath);
         }
         
-        line.erase(line.find_last_not_of(" \t\r\n") + 1);
-        code.value = line;
+        DXFHeaderInfo info;
+        info.fileSize = file.size();
         
-        return true;
-    }
-
-    /**
-     * @brief Legacy 3DFACE parser using file stream (deprecated)
-     * 
-     * This method uses file stream operations with seeking, which proved unreliable
-     * for complex DXF files. Kept for compatibility but not used in current implementation.
-     * 
-     * @param file Input file stream positioned after 3DFACE entity marker
-     * @param triangle Reference to Triangle to populate with vertex data
-     * @return true if triangle was successfully parsed
-     * @deprecated Use parse3DFaceFromLines instead
-     */
-    bool DXFReader::parse3DFace(std::ifstream& file, Triangle& triangle) {
-        DXFCode code;
-        Point3D vertices[4];
-        int vertexCount = 0;
+        DXFTokenizer tokenizer(file.view());
+        DXFGroup group;
+        std::string_view variable;
+        bool inHeader = false;
+        bool headerFound = false;
+        bool hasMin = false, hasMax = false;
+        size_t conversions = 0;  // Values converted, for the profiler
         
-        while (readNextCode(file, code)) {
-            if (code.code == 0) {
-                // We've reached the next entity, put this code back
-                std::string codeStr = std::to_string(code.code);
-                int bytesToGoBack = codeStr.length() + 1 + code.value.length() + 1;
-                file.seekg(-bytesToGoBack, std::ios::cur);
+        while (tokenizer.next(group)) {
+            if (!group.valid) {
                 break;
             }
             
-            switch (code.code) {
-                case 10:
-                case 11:
-                case 12:
-                case 13: {
-                    int vertexIndex = code.code - 10;
-                    if (vertexIndex < 4) {
-                        try {
-                            vertices[vertexIndex].x = std::stod(code.value);
-                        } catch (const std::exception&) {
-                            vertices[vertexIndex].x = 0.0;
-                        }
-                    }
-                    break;
+            if (!inHeader) {
+                if (group.code == 2 && group.value == "HEADER") {
+                    inHeader = true;
+                    headerFound = true;
+                } else if (group.code == 2) {
+                    break;  // First section is not HEADER
                 }
-                case 20:
-                case 21:
-                case 22:
-                case 23: {
-                    int vertexIndex = code.code - 20;
-                    if (vertexIndex < 4) {
-                        try {
-                            vertices[vertexIndex].y = std::stod(code.value);
-                        } catch (const std::exception&) {
-                            vertices[vertexIndex].y = 0.0;
-                        }
-                    }
-                    break;
+                continue;
+            }
+            
+            if (group.code == 0 && group.value == "ENDSEC") {
+                break;
+            }
+            
+            if (group.code == 9) {
+                variable = group.value;
+                continue;
+            }
+            
+            int intValue;
+            double coordinate;
+            if (variable == "$ACADVER" && group.code == 1) {
+                info.acadVersion = std::string(group.value);
+            } else if (variable == "$INSUNITS" && group.code == 70) {
+                ++conversions;
+                if (DXFTokenizer::parseInt(group.value, intValue)) {
+                    info.insUnits = intValue;
                 }
-                case 30:
-                case 31:
-                case 32:
-                case 33: {
-                    int vertexIndex = code.code - 30;
-                    if (vertexIndex < 4) {
-                        try {
-                            vertices[vertexIndex].z = std::stod(code.value);
-                            vertexCount = std::max(vertexCount, vertexIndex + 1);
-                        } catch (const std::exception&) {
-                            vertices[vertexIndex].z = 0.0;
-                        }
+            } else if (variable == "$EXTMIN" || variable == "$EXTMAX") {
+                ++conversions;
+                if (DXFTokenizer::parseDouble(group.value, coordinate)) {
+                    Point3D& target = (variable == "$EXTMIN") ? info.extents.min : info.extents.max;
+                    switch (group.code) {
+                        case 10: target.x = coordinate; break;
+                        case 20: target.y = coordinate; break;
+                        case 30: target.z = coordinate; break;
+                        default: break;
                     }
-                    break;
+                    (variable == "$EXTMIN" ? hasMin : hasMax) = true;
                 }
             }
         }
         
-        if (vertexCount >= 3) {
-            triangle = Triangle(vertices[0], vertices[1], vertices[2]);
-            return true;
+        DXF_PROFILE_COUNT(Lines, tokenizer.lineCount());
+        DXF_PROFILE_COUNT(NumericConversions, tokenizer.codeCount() + conversions);
+        
+        if (!headerFound) {
+            throw DXFReaderException("No HEADER section found in DXF file: " + filePath);
         }
         
-        return false;
+        info.headerBytes = tokenizer.position();
+        info.hasExtents = hasMin && hasMax && !info.extents.isEmpty();
+        info.estimatedEntityCount = static_cast<size_t>(
+            (info.fileSize - info.headerBytes) / ESTIMATED_BYTES_PER_ENTITY);
+        
+        return info;
     }
 
-    /**
-     * @brief Simplified 3DFACE parser with basic error handling
-     * 
-     * An intermediate parsing approach that improved upon the original but still
-     * suffered from file positioning issues. Kept for reference.
-     * 
-     * @param file Input file stream positioned after 3DFACE entity marker
-     * @param triangle Reference to Triangle to populate with vertex data
-     * @return true if triangle was successfully parsed
-     * @deprecated Use parse3DFaceFromLines instead
-     */
-    bool DXFReader::parse3DFaceSimple(std::ifstream& file, Triangle& triangle) {
-        std::string line;
-        Point3D vertices[4];
-        bool hasVertices[4] = {false, false, false, false};
+    std::string DXFHeaderInfo::unitsName() const {
+        static const char* const names[] = {
+            "unitless", "inches", "feet", "miles", "millimeters", "centimeters",
+            "meters", "kilometers", "microinches", "mils", "yards", "angstroms",
+            "nanometers", "microns", "decimeters", "decameters", "hectometers",
+            "gigameters", "astronomical units", "light years", "parsecs",
+            "US survey feet", "US survey inches", "US survey yards", "US survey miles"
+        };
+        if (insUnits >= 0 && insUnits < static_cast<int>(sizeof(names) / sizeof(names[0]))) {
+            return names[insUnits];
+        }
+        return "unknown";
+    }
+
+    namespace {
+
+        std::string_view trimLine(std::string_view line) {
+            size_t begin = line.find_first_not_of(" \t");
+            if (begin == std::string_view::npos) {
+                return {};
+            }
+            size_t end = line.find_last_not_of(" \t\r");
+            return line.substr(begin, end - begin + 1);
+        }
         
-        // Read until next entity (code 0)
-        while (std::getline(file, line)) {
-            line.erase(line.find_last_not_of(" \t\r\n") + 1);
-            line.erase(0, line.find_first_not_of(" \t"));
-            
-            // Check if it's a code line (should be a number)
-            if (line.empty()) continue;
+        /**
+         * @brief Finds the first "0 / 3DFACE" or "0 / ENDSEC" pair at or after an offset
+         * 
+         * A code line can never read "3DFACE" or "ENDSEC", so a "0" line
+         * followed by one of those is always a real code-0 group, even though
+         * the scan starts at an arbitrary line.
+         * 
+         * @return Offset of the "0" code line, or text.size() if there is none
+         */
+        size_t findEntityBoundary(std::string_view text, size_t from) {
+            // Start at the beginning of the next full line
+            if (from > 0) {
+                size_t newline = text.find('\n', from - 1);
+                if (newline == std::string_view::npos) {
+                    return text.size();
+                }
+                from = newline + 1;
+            }
             
-            try {
-                int code = std::stoi(line);
-                
-                if (code == 0) {
-                    // Put this line back by seeking back
-                    file.seekg(-static_cast<int>(line.length() + 3), std::ios::cur);
+            while (from < text.size()) {
+                size_t newline = text.find('\n', from);
+                if (newline == std::string_view::npos) {
                     break;
                 }
-                
-                // Read the value line
-                if (!std::getline(file, line)) break;
-                line.erase(line.find_last_not_of(" \t\r\n") + 1);
-                line.erase(0, line.find_first_not_of(" \t"));
-                
-                // Parse vertex coordinates
-                switch (code) {
-                    case 10: case 11: case 12: case 13: {
-                        int vertexIndex = code - 10;
-                        if (vertexIndex < 4) {
-                            try {
-                                vertices[vertexIndex].x = std::stod(line);
-                                hasVertices[vertexIndex] = true;
-                            } catch (const std::exception&) {
-                                vertices[vertexIndex].x = 0.0;
-                            }
-                        }
-                        break;
+                if (trimLine(text.substr(from, newline - from)) == "0") {
+                    size_t valueEnd = text.find('\n', newline + 1);
+                    std::string_view value = trimLine(text.substr(newline + 1, valueEnd == std::string_view::npos
+                                                                               ? std::string_view::npos
+                                                                               : valueEnd - newline - 1));
+                    if (value == "3DFACE" || value == "ENDSEC") {
+                        return from;
                     }
-                    case 20: case 21: case 22: case 23: {
-                        int vertexIndex = code - 20;
-                        if (vertexIndex < 4) {
-                            try {
-                                vertices[vertexIndex].y = std::stod(line);
-                            } catch (const std::exception&) {
-                                vertices[vertexIndex].y = 0.0;
-                            }
-                        }
-                        break;
+                }
+                from = newline + 1;
+            }
+            return text.size();
+        }
+        
+        /**
+         * @brief Offset just past the "2 / ENTITIES" group, or npos if there is none
+         * 
+         * Sections met on the way, ENTITIES included, are recorded in index if given.
+         */
+        size_t findEntitiesStart(std::string_view text, DXFIndex* index) {
+            DXFTokenizer tokenizer(text);
+            DXFGroup group;
+            bool afterSection = false;
+            while (tokenizer.next(group)) {
+                if (!group.valid) {
+                    afterSection = false;
+                    continue;
+                }
+                if (afterSection && group.code == 2) {
+                    if (index != nullptr) {
+                        index->sections.back().name = std::string(group.value);
                     }
-                    case 30: case 31: case 32: case 33: {
-                        int vertexIndex = code - 30;
-                        if (vertexIndex < 4) {
-                            try {
-                                vertices[vertexIndex].z = std::stod(line);
-                            } catch (const std::exception&) {
-                                vertices[vertexIndex].z = 0.0;
-                            }
-                        }
-                        break;
+                    if (group.value == "ENTITIES") {
+                        return tokenizer.position();
                     }
                 }
-            } catch (const std::exception&) {
-                // Not a valid code, continue
+                afterSection = (group.code == 0 && group.value == "SECTION");
+                if (index != nullptr && afterSection) {
+                    index->sections.emplace_back();
+                    index->sections.back().begin = group.offset;
+                } else if (index != nullptr && group.code == 0 && group.value == "ENDSEC" && !index->sections.empty()) {
+                    index->sections.back().end = tokenizer.position();
+                }
             }
+            return std::string_view::npos;
         }
         
-        // Check if we have at least 3 vertices
-        if (hasVertices[0] && hasVertices[1] && hasVertices[2]) {
-            triangle = Triangle(vertices[0], vertices[1], vertices[2]);
-            return true;
-        }
+        /// Releases a per-parse arena when the parse ends, however it ends
+        class ScratchRelease {
+        public:
+            explicit ScratchRelease(std::pmr::monotonic_buffer_resource& arena) : arena_(arena) {}
+            ~ScratchRelease() { arena_.release(); }
+            
+            ScratchRelease(const ScratchRelease&) = delete;
+            ScratchRelease& operator=(const ScratchRelease&) = delete;
         
-        return false;
+        private:
+            std::pmr::monotonic_buffer_resource& arena_;
+        };
     }
 
     /**
-     * @brief Streamlined 3DFACE parser with improved line handling
+     * @brief Internal parser that processes DXF file content pair by pair
      * 
-     * Another iteration of the parsing logic that attempted to fix file positioning
-     * issues but still had reliability problems with large files.
+     * Memory-maps the file and feeds it through DXFTokenizer, which yields
+     * code-value pairs as views into the mapping. No per-line strings are
+     * created; 3DFACE entities inside the ENTITIES section are parsed by
+     * EntityParser<Face3DEntity> and converted to triangles (first three
+     * vertices) tagged with their layer.
      * 
-     * @param file Input file stream positioned after 3DFACE entity marker
-     * @param triangle Reference to Triangle to populate with vertex data
-     * @return true if triangle was successfully parsed
-     * @deprecated Use parse3DFaceFromLines instead
+     * The text is consumed in PROGRESS_CHUNK_BYTES chunks (see parseChunked)
+     * so progress and cancellation are handled between chunks rather than
+     * per entity. Files of at least the split size are parsed in parallel on
+     * the thread pool set with setThreadPool (see parseSplit).
+     * 
+     * Bookkeeping that only lives as long as the parse is allocated from
+     * the reader's scratch arena, which is released when the parse returns
+     * or throws. Apart from the mesh's own storage blocks, a read therefore
+     * makes about the same number of heap allocations whatever its size.
+     * 
+     * With setWriteIndex, sections and face offsets are recorded as the
+     * entities are parsed and the sidecar is saved once the parse ends, so
+     * the file is not scanned a second time.
+     * 
+     * @param filePath Path to the DXF file (already validated)
+     * @return std::unique_ptr<MeshData> Mesh data with all parsed 3DFACE entities
+     * @throws DXFReaderException if file cannot be opened, parsing fails or the index can't be saved
+     * @throws DXFReadCancelledException if the cancellation token is set
      */
-    bool DXFReader::parse3DFaceStreamlined(std::ifstream& file, Triangle& triangle) {
-        std::string line;
-        Point3D vertices[3];
-        int vertexCount = 0;
+    std::unique_ptr<MeshData> DXFReader::parseFile(const std::string& filePath) {
+        MappedFile file;
+        try {
+            DXF_PROFILE_SCOPE("open");
+            file = MappedFile(filePath, MappedFile::AccessHint::Sequential);
+        } catch (const MappedFileException& e) {
+            throw DXFReaderException("Cannot open file: " + filePath);
+        }
         
-        // Read until next entity (code 0) or end of file
-        while (std::getline(file, line)) {
-            line.erase(line.find_last_not_of(" \t\r\n") + 1);
-            line.erase(0, line.find_first_not_of(" \t"));
-            
-            if (line.empty()) continue;
-            
-            try {
-                int code = std::stoi(line);
-                
-                if (code == 0) {
-                    // Put this line back for main parser
-                    file.seekg(-static_cast<int>(line.length() + 1), std::ios::cur);
-                    break;
-                }
-                
-                // Read the value line
-                if (!std::getline(file, line)) break;
-                line.erase(line.find_last_not_of(" \t\r\n") + 1);
-                line.erase(0, line.find_first_not_of(" \t"));
-                
-                // Parse vertex coordinates for first 3 vertices only
-                switch (code) {
-                    case 10: case 11: case 12: {
-                        int vertexIndex = code - 10;
-                        if (vertexIndex < 3) {
-                            try {
-                                vertices[vertexIndex].x = std::stod(line);
-                            } catch (const std::exception&) {
-                                vertices[vertexIndex].x = 0.0;
-                            }
-                        }
-                        break;
-                    }
-                    case 20: case 21: case 22: {
-                        int vertexIndex = code - 20;
-                        if (vertexIndex < 3) {
-                            try {
-                                vertices[vertexIndex].y = std::stod(line);
-                            } catch (const std::exception&) {
-                                vertices[vertexIndex].y = 0.0;
-                            }
-                        }
-                        break;
-                    }
-                    case 30: case 31: case 32: {
-                        int vertexIndex = code - 30;
-                        if (vertexIndex < 3) {
-                            try {
-                                vertices[vertexIndex].z = std::stod(line);
-                                vertexCount = std::max(vertexCount, vertexIndex + 1);
-                            } catch (const std::exception&) {
-                                vertices[vertexIndex].z = 0.0;
-                            }
-                        }
-                        break;
-                    }
-                }
-            } catch (const std::exception&) {
-                // Not a valid code, skip
+        DXF_PROFILE_SCOPE("parse");
+        DXF_PROFILE_COUNT(BytesRead, file.size());
+        auto meshData = std::make_unique<MeshData>();
+        lastEntityCount_ = 0;
+        ScratchRelease releaseScratch(scratch_);
+        
+        const size_t fileSize = file.size();
+        DXFIndex index;
+        DXFIndex* recorder = writeIndex_ ? &index : nullptr;
+        
+        if (progress_ != nullptr) {
+            progress_->start(fileSize);
+        }
+        
+        try {
+            if (threadPool_ != nullptr && fileSize >= splitBytes_ && threadPool_->size() > 1) {
+                parseSplit(file.view(), *meshData, recorder);
+            } else {
+                bool inEntitiesSection = false;
+                lastEntityCount_ = parseChunked(file.view(), 0, inEntitiesSection, *meshData, recorder,
+                    [&](size_t position) {
+                        reportProgress(static_cast<double>(position) / fileSize);
+                    });
             }
+        } catch (const DXFReadCancelledException&) {
+            throw;
+        } catch (const std::exception& e) {
+            throw DXFReaderException("Parse error: " + std::string(e.what()));
         }
         
-        if (vertexCount >= 3) {
-            triangle = Triangle(vertices[0], vertices[1], vertices[2]);
-            return true;
+        if (progress_ != nullptr) {
+            progress_->finish();
+        }
+        reportProgress(1.0);
+        
+        if (meshData->isEmpty()) {
+            throw DXFReaderException("No 3D faces found in DXF file");
+        }
+        
+        if (recorder != nullptr) {
+            DXF_PROFILE_SCOPE("write index");
+            index.layerNames = meshData->getLayerNames();
+            index.stampSource(file);
+            try {
+                index.save(DXFIndex::sidecarPath(filePath));
+            } catch (const DXFIndexException& e) {
+                throw DXFReaderException(e.what());
+            }
         }
         
-        return false;
+        return meshData;
     }
 
     /**
-     * @brief Robust 3DFACE parser using pre-loaded lines array
-     * 
-     * This is the current production parser that processes 3DFACE entities from
-     * a pre-loaded array of file lines. It correctly handles DXF code-value pairs
-     * and extracts the first three vertices to form a triangle.
-     * 
-     * DXF 3DFACE format:
-     * - Codes 10,11,12,13: X coordinates for vertices 0,1,2,3
-     * - Codes 20,21,22,23: Y coordinates for vertices 0,1,2,3  
-     * - Codes 30,31,32,33: Z coordinates for vertices 0,1,2,3
+     * @brief Parses the ENTITIES section as independent byte ranges on the pool
      * 
-     * @param lines Vector of all file lines (trimmed)
-     * @param index Reference to current line index, updated to point past this entity
-     * @param triangle Reference to Triangle to populate with vertex data
-     * @return true if triangle was successfully parsed with all 3 vertices
+     * The section is cut into roughly splitBytes_ pieces, each moved forward
+     * to the next 3DFACE (or ENDSEC) code-0 group so no entity straddles two
+     * ranges. Every range fills its own MeshData; the parts are appended in
+     * file order, so triangle order and layer ids match a sequential read.
+     * Ranges are parsed in chunks, so every task advances the shared
+     * ReadProgress and stops at its next chunk once cancelled; the first
+     * cancellation is rethrown by the group's wait. The progress callback is
+     * only called from the calling thread, while merging. With an index,
+     * each range records into its own part, appended in file order with
+     * its layer ids mapped like the mesh part's.
      */
-    bool DXFReader::parse3DFaceFromLines(const std::vector<std::string>& lines, size_t& index, Triangle& triangle) {
-        Point3D vertices[3];
-        bool hasVertex[3] = {false, false, false};
+    void DXFReader::parseSplit(std::string_view text, MeshData& meshData, DXFIndex* index) {
+        size_t entitiesStart = findEntitiesStart(text, index);
+        if (entitiesStart == std::string_view::npos) {
+            return;
+        }
+        if (progress_ != nullptr) {
+            progress_->advance(entitiesStart);
+        }
         
-        // Read until next "0" code or end of lines
-        while (index < lines.size()) {
-            if (lines[index] == "0") {
-                break; // Next entity found
-            }
-            
-            try {
-                int code = std::stoi(lines[index]);
-                
-                if (index + 1 >= lines.size()) break;
-                std::string value = lines[index + 1];
-                
-                // Parse vertex coordinates for first 3 vertices
-                switch (code) {
-                    case 10: case 11: case 12: {
-                        int vertexIndex = code - 10;
-                        if (vertexIndex < 3) {
-                            try {
-                                vertices[vertexIndex].x = std::stod(value);
-                                hasVertex[vertexIndex] = true;
-                            } catch (const std::exception&) {
-                                vertices[vertexIndex].x = 0.0;
-                            }
-                        }
-                        break;
-                    }
-                    case 20: case 21: case 22: {
-                        int vertexIndex = code - 20;
-                        if (vertexIndex < 3) {
-                            try {
-                                vertices[vertexIndex].y = std::stod(value);
-                            } catch (const std::exception&) {
-                                vertices[vertexIndex].y = 0.0;
-                            }
-                        }
-                        break;
-                    }
-                    case 30: case 31: case 32: {
-                        int vertexIndex = code - 30;
-                        if (vertexIndex < 3) {
-                            try {
-                                vertices[vertexIndex].z = std::stod(value);
-                            } catch (const std::exception&) {
-                                vertices[vertexIndex].z = 0.0;
-                            }
-                        }
-                        break;
-                    }
-                }
-                
-                index += 2; // Skip code and value
-            } catch (const std::exception&) {
-                // Not a valid code, skip
-                index++;
+        // Range bookkeeping lives in the scratch arena, so reserve rather than regrow
+        std::pmr::vector<size_t> bounds(&scratch_);
+        bounds.reserve((text.size() - entitiesStart) / splitBytes_ + 2);
+        bounds.push_back(entitiesStart);
+        for (size_t cut = entitiesStart + splitBytes_; cut < text.size(); cut += splitBytes_) {
+            size_t boundary = findEntityBoundary(text, cut);
+            if (boundary >= text.size()) {
+                break;
             }
+            bounds.push_back(boundary);
+            cut = boundary;
         }
-        
-        // Check if we have all 3 vertices
-        if (hasVertex[0] && hasVertex[1] && hasVertex[2]) {
-            triangle = Triangle(vertices[0], vertices[1], vertices[2]);
-            return true;
+        bounds.push_back(text.size());
+        
+        const size_t rangeCount = bounds.size() - 1;
+        std::pmr::vector<MeshData> parts(rangeCount, &scratch_);
+        std::pmr::vector<size_t> counts(rangeCount, 0, &scratch_);
+        std::pmr::vector<DXFIndex> partIndexes(index != nullptr ? rangeCount : 0, &scratch_);
+        
+        TaskGroup group(*threadPool_);
+        for (size_t i = 0; i < rangeCount; ++i) {
+            group.run([&, i] {
+                DXF_PROFILE_SCOPE("parse range");
+                std::string_view range = text.substr(bounds[i], bounds[i + 1] - bounds[i]);
+                bool inEntitiesSection = true;
+                DXFIndex* partIndex = index != nullptr ? &partIndexes[i] : nullptr;
+                counts[i] = parseChunked(range, bounds[i], inEntitiesSection, parts[i], partIndex, nullptr);
+            });
         }
+        group.wait();
         
-        return false;
+        DXF_PROFILE_SCOPE("merge ranges");
+        size_t total = 0;
+        for (size_t count : counts) {
+            total += count;
+        }
+        // The first part's blocks are taken over; each part is freed once merged
+        for (size_t i = 0; i < rangeCount; ++i) {
+            if (index != nullptr) {
+                std::vector<LayerId> layerMap(parts[i].getLayerNames().size());
+                for (size_t id = 0; id < layerMap.size(); ++id) {
+                    layerMap[id] = meshData.internLayer(parts[i].getLayerNames()[id]);
+                }
+                index->append(std::move(partIndexes[i]), layerMap);
+            }
+            meshData.append(std::move(parts[i]));
+            reportProgress(static_cast<double>(bounds[i + 1]) / text.size());
+        }
+        lastEntityCount_ = total;
     }
 
     /**
-     * @brief Parses a 3D point from DXF code-value pairs
+     * @brief Parses text in chunks of about PROGRESS_CHUNK_BYTES
      * 
-     * Utility function for extracting 3D coordinates from specific DXF codes.
-     * Used by legacy parsers but not in the current implementation.
+     * Chunks end just before a 3DFACE or ENDSEC code-0 group (as found by
+     * findEntityBoundary), so no entity is cut in two, and inEntitiesSection
+     * carries the section state from one chunk to the next. Before each
+     * chunk the cancellation token is checked; after it the ReadProgress is
+     * advanced by the chunk's size and onChunk, if any, receives the offset
+     * reached. Sections and faces are recorded in index, if given, at their
+     * offset in text plus textOffset.
      * 
-     * @param file Input file stream
-     * @param xCode DXF code for X coordinate
-     * @param yCode DXF code for Y coordinate  
-     * @param zCode DXF code for Z coordinate
-     * @return Point3D with extracted coordinates
-     * @deprecated Not used in current line-based parser
+     * @return Number of 3DFACE entities parsed
+     * @throws DXFReadCancelledException if the cancellation token is set
      */
-    Point3D DXFReader::parsePoint(std::ifstream& file, int xCode, int yCode, int zCode) {
-        Point3D point;
-        DXFCode code;
-        
-        while (readNextCode(file, code) && code.code != 0) {
-            if (code.code == xCode) {
-                try {
-                    point.x = std::stod(code.value);
-                } catch (const std::exception&) {
-                    point.x = 0.0;
-                }
-            } else if (code.code == yCode) {
-                try {
-                    point.y = std::stod(code.value);
-                } catch (const std::exception&) {
-                    point.y = 0.0;
-                }
-            } else if (code.code == zCode) {
-                try {
-                    point.z = std::stod(code.value);
-                } catch (const std::exception&) {
-                    point.z = 0.0;
-                }
+    size_t DXFReader::parseChunked(std::string_view text, std::uint64_t textOffset, bool& inEntitiesSection,
+                                   MeshData& meshData, DXFIndex* index, const std::function<void(size_t)>& onChunk) {
+        size_t faceCount = 0;
+        size_t begin = 0;
+        while (begin < text.size()) {
+            throwIfCancelled();
+            size_t end = text.size() - begin <= PROGRESS_CHUNK_BYTES
+                             ? text.size()
+                             : findEntityBoundary(text, begin + PROGRESS_CHUNK_BYTES);
+            faceCount += parseFaceRange(text.substr(begin, end - begin), inEntitiesSection, meshData,
+                                        index, textOffset + begin);
+            if (progress_ != nullptr) {
+                progress_->advance(end - begin);
+            }
+            if (onChunk) {
+                onChunk(end);
             }
+            begin = end;
+        }
+        return faceCount;
+    }
+
+    void DXFReader::throwIfCancelled() const {
+        if (cancellation_ != nullptr && cancellation_->isCancelled()) {
+            throw DXFReadCancelledException();
         }
-        
-        return point;
     }
 
     /**
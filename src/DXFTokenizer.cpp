@@ -0,0 +1,191 @@
+#include "DXFTokenizer.h"
+#include <cstring>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DXF_TOKENIZER_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+namespace DXFProcessor {
+
+    namespace {
+
+        /**
+         * @brief Newline and blank bit masks of one 64-byte block
+         */
+        struct BlockMasks {
+            uint64_t newlines;
+            uint64_t blanks;
+        };
+
+        using ClassifyFn = BlockMasks (*)(const char* block);
+
+        BlockMasks classifyScalar(const char* block) {
+            BlockMasks masks{0, 0};
+            for (size_t i = 0; i < DXFTokenizer::BLOCK_SIZE; ++i) {
+                char c = block[i];
+                masks.newlines |= static_cast<uint64_t>(c == '\n') << i;
+                masks.blanks |= static_cast<uint64_t>(c == ' ' || c == '\t') << i;
+            }
+            return masks;
+        }
+
+#ifdef DXF_TOKENIZER_X86
+        BlockMasks classifySSE2(const char* block) {
+            const __m128i newline = _mm_set1_epi8('\n');
+            const __m128i space = _mm_set1_epi8(' ');
+            const __m128i tab = _mm_set1_epi8('\t');
+            
+            BlockMasks masks{0, 0};
+            for (int lane = 0; lane < 4; ++lane) {
+                __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + lane * 16));
+                uint64_t nl = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newline)));
+                uint64_t bl = static_cast<uint32_t>(_mm_movemask_epi8(
+                    _mm_or_si128(_mm_cmpeq_epi8(bytes, space), _mm_cmpeq_epi8(bytes, tab))));
+                masks.newlines |= nl << (lane * 16);
+                masks.blanks |= bl << (lane * 16);
+            }
+            return masks;
+        }
+
+#if defined(__GNUC__) || defined(__clang__)
+        __attribute__((target("avx2")))
+#endif
+        BlockMasks classifyAVX2(const char* block) {
+            const __m256i newline = _mm256_set1_epi8('\n');
+            const __m256i space = _mm256_set1_epi8(' ');
+            const __m256i tab = _mm256_set1_epi8('\t');
+            
+            __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+            __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+            
+            uint64_t newlinesLow = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, newline)));
+            uint64_t newlinesHigh = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, newline)));
+            uint64_t blanksLow = static_cast<uint32_t>(_mm256_movemask_epi8(
+                _mm256_or_si256(_mm256_cmpeq_epi8(low, space), _mm256_cmpeq_epi8(low, tab))));
+            uint64_t blanksHigh = static_cast<uint32_t>(_mm256_movemask_epi8(
+                _mm256_or_si256(_mm256_cmpeq_epi8(high, space), _mm256_cmpeq_epi8(high, tab))));
+            
+            return BlockMasks{newlinesLow | (newlinesHigh << 32), blanksLow | (blanksHigh << 32)};
+        }
+
+        bool cpuSupportsAVX2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) {
+                return false;
+            }
+            __cpuid(info, 1);
+            bool osSavesYmm = (info[2] & (1 << 27)) && ((_xgetbv(0) & 0x6) == 0x6);
+            __cpuidex(info, 7, 0);
+            return osSavesYmm && (info[1] & (1 << 5));
+#else
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#endif
+        }
+#endif
+
+        struct Classifier {
+            ClassifyFn function;
+            const char* name;
+        };
+
+        Classifier selectClassifier() {
+#ifdef DXF_TOKENIZER_X86
+            if (cpuSupportsAVX2()) {
+                return {classifyAVX2, "AVX2"};
+            }
+            return {classifySSE2, "SSE2"};
+#else
+            return {classifyScalar, "scalar"};
+#endif
+        }
+
+        const Classifier& classifier() {
+            static const Classifier selected = selectClassifier();
+            return selected;
+        }
+
+    } // namespace
+
+    /**
+     * @brief Classifies the chunk containing 'from' and flattens its newlines
+     * 
+     * Full blocks go through the SIMD classifier chosen for this CPU; the final
+     * partial block is copied into a padded buffer first so no read runs past
+     * the end of the input. Newlines before 'from' are dropped.
+     */
+    void DXFTokenizer::loadChunk(size_t from) {
+        const size_t size = buffer_.size();
+        const ClassifyFn classify = classifier().function;
+        
+        chunkStart_ = from - from % BLOCK_SIZE;
+        chunkEnd_ = std::min(chunkStart_ + CHUNK_SIZE, size);
+        newlineCount_ = 0;
+        newlineIndex_ = 0;
+        
+        size_t block = 0;
+        for (size_t offset = chunkStart_; offset < chunkEnd_; offset += BLOCK_SIZE, ++block) {
+            BlockMasks masks;
+            if (offset + BLOCK_SIZE <= size) {
+                masks = classify(buffer_.data() + offset);
+            } else {
+                char padded[BLOCK_SIZE];
+                std::memset(padded, 0, sizeof(padded));
+                std::memcpy(padded, buffer_.data() + offset, size - offset);
+                masks = classifyScalar(padded);
+            }
+            
+            if (offset == chunkStart_) {
+                masks.newlines &= ~uint64_t(0) << (from - chunkStart_);
+            }
+            blankMasks_[block] = masks.blanks;
+            
+            uint64_t newlines = masks.newlines;
+            const uint16_t base = static_cast<uint16_t>(offset - chunkStart_);
+            while (newlines != 0) {
+                newlineOffsets_[newlineCount_++] = static_cast<uint16_t>(base + countTrailingZeros(newlines));
+                newlines &= newlines - 1;
+            }
+        }
+        blankMasks_[block] = 0;  // Sentinel: position just past the chunk is never blank-skipped here
+    }
+
+    /**
+     * @brief Skips a run of blanks longer than the rest of the current block
+     */
+    void DXFTokenizer::skipBlanksSlow() {
+        const size_t size = buffer_.size();
+        while (pos_ < size && (buffer_[pos_] == ' ' || buffer_[pos_] == '\t')) {
+            ++pos_;
+        }
+        if (pos_ >= chunkEnd_ && pos_ < size) {
+            loadChunk(pos_);
+        }
+    }
+
+    /**
+     * @brief Finds the newline ending a line that runs past the current chunk
+     */
+    size_t DXFTokenizer::findNewlineSlow(size_t from) {
+        const size_t size = buffer_.size();
+        const void* found = from < size ? std::memchr(buffer_.data() + from, '\n', size - from) : nullptr;
+        size_t newline = found ? static_cast<size_t>(static_cast<const char*>(found) - buffer_.data()) : size;
+        
+        // Force the next line to classify a fresh chunk
+        chunkEnd_ = 0;
+        newlineCount_ = 0;
+        return newline;
+    }
+
+    const char* DXFTokenizer::implementationName() {
+        return classifier().name;
+    }
+
+} // namespace DXFProcessor
@@ -0,0 +1,130 @@
+#include "MappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace DXFProcessor {
+
+    MappedFile::MappedFile(const std::string& filePath, AccessHint hint)
+        : path_(filePath) {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING,
+                                  hint == AccessHint::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN
+                                                                 : FILE_FLAG_RANDOM_ACCESS,
+                                  nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw MappedFileException("Cannot open file: " + filePath);
+        }
+        fileHandle_ = file;
+        
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize)) {
+            close();
+            throw MappedFileException("Cannot determine file size: " + filePath);
+        }
+        size_ = static_cast<size_t>(fileSize.QuadPart);
+        if (size_ == 0) {
+            return;
+        }
+        
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr) {
+            close();
+            throw MappedFileException("Cannot create file mapping: " + filePath);
+        }
+        mappingHandle_ = mapping;
+        
+        data_ = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (data_ == nullptr) {
+            close();
+            throw MappedFileException("Cannot map view of file: " + filePath);
+        }
+#else
+        fd_ = ::open(filePath.c_str(), O_RDONLY);
+        if (fd_ < 0) {
+            throw MappedFileException("Cannot open file: " + filePath);
+        }
+        
+        struct stat status;
+        if (::fstat(fd_, &status) != 0) {
+            close();
+            throw MappedFileException("Cannot determine file size: " + filePath);
+        }
+        size_ = static_cast<size_t>(status.st_size);
+        if (size_ == 0) {
+            return;
+        }
+        
+        void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (mapping == MAP_FAILED) {
+            close();
+            throw MappedFileException("Cannot map file: " + filePath);
+        }
+        data_ = static_cast<const char*>(mapping);
+        
+        ::madvise(mapping, size_, hint == AccessHint::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+#endif
+    }
+
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            path_ = std::move(other.path_);
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+#ifdef _WIN32
+            fileHandle_ = std::exchange(other.fileHandle_, nullptr);
+            mappingHandle_ = std::exchange(other.mappingHandle_, nullptr);
+#else
+            fd_ = std::exchange(other.fd_, -1);
+#endif
+        }
+        return *this;
+    }
+
+    void MappedFile::close() {
+#ifdef _WIN32
+        if (data_ != nullptr) {
+            UnmapViewOfFile(data_);
+        }
+        if (mappingHandle_ != nullptr) {
+            CloseHandle(static_cast<HANDLE>(mappingHandle_));
+            mappingHandle_ = nullptr;
+        }
+        if (fileHandle_ != nullptr) {
+            CloseHandle(static_cast<HANDLE>(fileHandle_));
+            fileHandle_ = nullptr;
+        }
+#else
+        if (data_ != nullptr) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+} // namespace DXFProcessor
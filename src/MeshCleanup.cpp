@@ -0,0 +1,163 @@
+#include "MeshCleanup.h"
+#include "Profiler.h"
+#include "RadixSort.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+
+namespace DXFProcessor {
+
+    namespace {
+
+        /**
+         * Hash bits kept in a sort key: three 11-bit radix passes. Collisions
+         * only cost an exact comparison of two keys, and stay rare (about
+         * a hundred pairs per million triangles).
+         */
+        constexpr int HASH_BITS = 33;
+        
+        /// Quantized vertices of a triangle, sorted so vertex order and winding don't matter
+        using VertexKey = std::array<std::int64_t, 9>;
+        
+        /// Nearest grid line to value / step, given 1 / step; avoids a libm call per coordinate
+        std::int64_t quantize(double value, double inverseStep) {
+            return static_cast<std::int64_t>(std::floor(value * inverseStep + 0.5));
+        }
+        
+        VertexKey vertexKey(const Triangle& triangle, double inverseStep) {
+            using Vertex = std::array<std::int64_t, 3>;
+            std::array<Vertex, 3> vertices;
+            for (size_t v = 0; v < 3; ++v) {
+                const Point3D& p = triangle.vertices[v];
+                vertices[v] = {quantize(p.x, inverseStep), quantize(p.y, inverseStep), quantize(p.z, inverseStep)};
+            }
+            // Three-element sorting network
+            if (vertices[1] < vertices[0]) {
+                std::swap(vertices[0], vertices[1]);
+            }
+            if (vertices[2] < vertices[1]) {
+                std::swap(vertices[1], vertices[2]);
+                if (vertices[1] < vertices[0]) {
+                    std::swap(vertices[0], vertices[1]);
+                }
+            }
+            VertexKey key;
+            for (size_t v = 0; v < 3; ++v) {
+                std::copy(vertices[v].begin(), vertices[v].end(), key.begin() + v * 3);
+            }
+            return key;
+        }
+        
+        /// splitmix64 finalizer: spreads every input bit over the whole hash
+        std::uint64_t mix(std::uint64_t value) {
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+            return value ^ (value >> 31);
+        }
+        
+        /// One multiply per coordinate, then a single full mix
+        std::uint64_t hashKey(const VertexKey& key) {
+            std::uint64_t hash = 0;
+            for (std::int64_t value : key) {
+                hash = (hash ^ static_cast<std::uint64_t>(value)) * 0x9E3779B97F4A7C15ULL;
+            }
+            return mix(hash);
+        }
+    }
+
+    MeshCleaner::MeshCleaner(CleanupOptions options) : options_(options) {}
+
+    CleanupReport MeshCleaner::inspect(const MeshData& meshData) const {
+        DXF_PROFILE_SCOPE("inspect triangles");
+        if (!(options_.precision > 0.0)) {
+            throw std::invalid_argument("Duplicate precision must be positive");
+        }
+        const size_t count = meshData.getTriangleCount();
+        CleanupReport report;
+        report.defects.assign(count, TriangleDefect::None);
+        if (count == 0) {
+            return report;
+        }
+        
+        PassPool pool(options_.threadPool, count, MIN_PARALLEL_TRIANGLES, options_.threadCount);
+        const size_t chunkCount = pool.get() != nullptr ? pool.get()->size() : 1;
+        const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+        
+        // Keys hold the hash of the sorted quantized vertices above the triangle index
+        const int indexBits = bitWidth(count - 1);
+        const std::uint64_t indexMask = (std::uint64_t{1} << indexBits) - 1;
+        const int hashBits = std::min(HASH_BITS, 64 - indexBits);
+        const double qualityScale = 4.0 * std::sqrt(3.0);
+        const double inverseStep = 1.0 / options_.precision;
+        std::vector<std::uint64_t> keys(count);
+        std::vector<size_t> degenerate(chunkCount, 0);
+        forEachChunk(pool.get(), chunkCount, [&](size_t c) {
+            const size_t end = std::min(count, (c + 1) * chunkSize);
+            for (size_t t = c * chunkSize; t < end; ++t) {
+                const Triangle triangle = meshData.getTriangle(t);
+                const Point3D ab = triangle.vertices[1] - triangle.vertices[0];
+                const Point3D bc = triangle.vertices[2] - triangle.vertices[1];
+                const Point3D ca = triangle.vertices[0] - triangle.vertices[2];
+                const double area = ab.cross(bc).magnitude() * 0.5;
+                const double squaredEdges = ab.dot(ab) + bc.dot(bc) + ca.dot(ca);
+                if (area <= options_.minArea || squaredEdges == 0.0 ||
+                    qualityScale * area < options_.minQuality * squaredEdges) {
+                    report.defects[t] = TriangleDefect::Degenerate;
+                    ++degenerate[c];
+                }
+                keys[t] = ((hashKey(vertexKey(triangle, inverseStep)) >> (64 - hashBits)) << indexBits) | t;
+            }
+        });
+        radixSortKeys(keys, indexBits, pool.get());
+        
+        // Equal hashes sit side by side in index order; confirm each copy against the earlier ones
+        const std::vector<size_t> bounds = sortedRunBounds(keys, indexBits, chunkCount);
+        std::vector<size_t> duplicates(chunkCount, 0);
+        forEachChunk(pool.get(), chunkCount, [&](size_t c) {
+            std::vector<VertexKey> run;
+            for (size_t i = bounds[c]; i < bounds[c + 1];) {
+                size_t j = i + 1;
+                while (j < bounds[c + 1] && (keys[j] >> indexBits) == (keys[i] >> indexBits)) {
+                    ++j;
+                }
+                if (j - i > 1) {
+                    run.clear();
+                    for (size_t k = i; k < j; ++k) {
+                        const size_t t = static_cast<size_t>(keys[k] & indexMask);
+                        run.push_back(vertexKey(meshData.getTriangle(t), inverseStep));
+                        const bool copy = std::find(run.begin(), run.end() - 1, run.back()) != run.end() - 1;
+                        if (copy && report.defects[t] == TriangleDefect::None) {
+                            report.defects[t] = TriangleDefect::Duplicate;
+                            ++duplicates[c];
+                        }
+                    }
+                }
+                i = j;
+            }
+        });
+        
+        for (size_t c = 0; c < chunkCount; ++c) {
+            report.degenerateTriangles += degenerate[c];
+            report.duplicateTriangles += duplicates[c];
+        }
+        return report;
+    }
+
+    CleanupReport MeshCleaner::clean(MeshData& meshData) const {
+        CleanupReport report = inspect(meshData);
+        if (report.degenerateTriangles + report.duplicateTriangles > 0) {
+            DXF_PROFILE_SCOPE("remove triangles");
+            std::vector<bool> remove(report.defects.size());
+            for (size_t t = 0; t < remove.size(); ++t) {
+                remove[t] = report.defects[t] != TriangleDefect::None;
+            }
+            report.removedTriangles = meshData.removeTriangles(remove);
+        }
+        report.defects.clear();
+        return report;
+    }
+
+} // namespace DXFProcessor
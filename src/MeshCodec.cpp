@@ -0,0 +1,481 @@
+#include "MeshCodec.h"
+#include "MappedFile.h"
+#include "Profiler.h"
+#include "SpatialOrder.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace DXFProcessor {
+
+    namespace {
+
+        const char MESH_MAGIC[8] = {'D', 'X', 'F', 'M', 'E', 'S', 'H', '\0'};
+        
+        /// Bytes of one block directory entry: u64 offset, u32 bytes, u32 triangles, u32 vertices
+        constexpr size_t DIRECTORY_ENTRY_SIZE = 20;
+        
+        /// Largest quantized coordinate; keeps origin + q * precision exact in a double
+        constexpr double MAX_QUANTIZED = 4503599627370496.0;  // 2^52
+        
+        constexpr int MORTON_BITS = 21;  ///< Bits per axis in a 63-bit Morton code
+        
+        struct QuantizedPoint {
+            std::int64_t x, y, z;
+            
+            bool operator==(const QuantizedPoint& other) const {
+                return x == other.x && y == other.y && z == other.z;
+            }
+        };
+        
+        struct QuantizedPointHash {
+            size_t operator()(const QuantizedPoint& p) const {
+                std::uint64_t h = static_cast<std::uint64_t>(p.x) * 0x9E3779B97F4A7C15ull;
+                h ^= static_cast<std::uint64_t>(p.y) * 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2);
+                h ^= static_cast<std::uint64_t>(p.z) * 0x165667B19E3779F9ull + (h << 6) + (h >> 2);
+                return static_cast<size_t>(h ^ (h >> 29));
+            }
+        };
+        
+        /**
+         * @brief Integer grid of 'precision' steps anchored at the mesh's minimum corner
+         */
+        struct Quantizer {
+            Point3D origin;
+            double precision;
+            
+            std::int64_t quantize(double value, double originValue) const {
+                double steps = std::round((value - originValue) / precision);
+                if (!(std::abs(steps) <= MAX_QUANTIZED)) {
+                    throw MeshCodecException("Coordinate " + std::to_string(value) +
+                                             " cannot be quantized at precision " + std::to_string(precision));
+                }
+                return static_cast<std::int64_t>(steps);
+            }
+            
+            QuantizedPoint quantize(const Point3D& point) const {
+                return QuantizedPoint{quantize(point.x, origin.x), quantize(point.y, origin.y),
+                                      quantize(point.z, origin.z)};
+            }
+        };
+        
+        std::uint64_t mortonCode(const QuantizedPoint& p, int shift) {
+            auto axis = [shift](std::int64_t v) {
+                return static_cast<std::uint32_t>(static_cast<std::uint64_t>(std::max<std::int64_t>(v, 0)) >> shift);
+            };
+            return SpatialOrder::mortonCode(axis(p.x), axis(p.y), axis(p.z));
+        }
+        
+        std::uint64_t zigzag(std::int64_t value) {
+            return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+        }
+        
+        std::int64_t unzigzag(std::uint64_t value) {
+            return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+        }
+        
+        void appendVarint(std::string& out, std::uint64_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<char>(value));
+        }
+        
+        template <typename T>
+        void appendValue(std::string& out, const T& value) {
+            out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+        
+        /**
+         * @brief Bounds-checked cursor over an encoded image
+         */
+        class ByteReader {
+        public:
+            ByteReader(const char* begin, const char* end) : pos_(begin), end_(end) {}
+            
+            template <typename T>
+            T value() {
+                T result;
+                std::memcpy(&result, take(sizeof(T)), sizeof(T));
+                return result;
+            }
+            
+            std::string_view bytes(size_t count) {
+                return std::string_view(take(count), count);
+            }
+            
+            std::uint64_t varint() {
+                // Most deltas and references fit in one byte
+                if (pos_ < end_ && static_cast<unsigned char>(*pos_) < 0x80) {
+                    return static_cast<unsigned char>(*pos_++);
+                }
+                std::uint64_t result = 0;
+                for (int shift = 0; shift < 64; shift += 7) {
+                    if (pos_ == end_) {
+                        throw MeshCodecException("Truncated block");
+                    }
+                    unsigned char byte = static_cast<unsigned char>(*pos_++);
+                    result |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                    if (byte < 0x80) {
+                        return result;
+                    }
+                }
+                throw MeshCodecException("Malformed varint");
+            }
+            
+            bool atEnd() const { return pos_ == end_; }
+            
+            /// Bytes left to read
+            size_t remaining() const { return static_cast<size_t>(end_ - pos_); }
+        
+        private:
+            const char* take(size_t count) {
+                if (static_cast<size_t>(end_ - pos_) < count) {
+                    throw MeshCodecException("Truncated mesh file");
+                }
+                const char* start = pos_;
+                pos_ += count;
+                return start;
+            }
+            
+            const char* pos_;
+            const char* end_;
+        };
+        
+        struct BlockInfo {
+            std::uint64_t offset = 0;
+            std::uint32_t bytes = 0;
+            std::uint32_t triangles = 0;
+            std::uint32_t vertices = 0;
+        };
+        
+        /**
+         * @brief Encodes the triangles order[first, first + count) of the mesh as one block
+         */
+        std::string encodeBlock(const MeshData& meshData, const Quantizer& quantizer,
+                                const std::vector<std::pair<std::uint64_t, size_t>>& order,
+                                size_t first, size_t count, BlockInfo& info) {
+            std::string vertices;
+            std::string references;
+            std::string layers;
+            vertices.reserve(count * 4);
+            references.reserve(count * 4);
+            
+            std::unordered_map<QuantizedPoint, std::uint32_t, QuantizedPointHash> vertexIds;
+            vertexIds.reserve(count);
+            QuantizedPoint previous{0, 0, 0};
+            std::uint32_t nextVertex = 0;
+            LayerId runLayer = 0;
+            std::uint64_t runLength = 0;
+            
+            for (size_t i = first; i < first + count; ++i) {
+                size_t index = order[i].second;
+                Triangle triangle = meshData.getTriangle(index);
+                for (const auto& vertex : triangle.vertices) {
+                    QuantizedPoint q = quantizer.quantize(vertex);
+                    auto [it, inserted] = vertexIds.emplace(q, nextVertex);
+                    if (inserted) {
+                        appendVarint(vertices, zigzag(q.x - previous.x));
+                        appendVarint(vertices, zigzag(q.y - previous.y));
+                        appendVarint(vertices, zigzag(q.z - previous.z));
+                        previous = q;
+                        ++nextVertex;
+                        appendVarint(references, 0);
+                    } else {
+                        // k-th vertex before the next new one
+                        appendVarint(references, nextVertex - it->second);
+                    }
+                }
+                
+                LayerId layer = meshData.getTriangleLayer(index);
+                if (runLength > 0 && layer != runLayer) {
+                    appendVarint(layers, runLayer);
+                    appendVarint(layers, runLength);
+                    runLength = 0;
+                }
+                runLayer = layer;
+                ++runLength;
+            }
+            if (runLength > 0) {
+                appendVarint(layers, runLayer);
+                appendVarint(layers, runLength);
+            }
+            
+            vertices += references;
+            vertices += layers;
+            info.triangles = static_cast<std::uint32_t>(count);
+            info.vertices = nextVertex;
+            info.bytes = static_cast<std::uint32_t>(vertices.size());
+            return vertices;
+        }
+        
+        /**
+         * @brief Decodes one block into [first, first + info.triangles) of the mesh's sequences
+         */
+        void decodeBlock(std::string_view payload, const BlockInfo& info, const Quantizer& quantizer,
+                         size_t layerCount, SegmentedVector<Triangle>& triangles,
+                         SegmentedVector<LayerId>& triangleLayers, size_t first) {
+            ByteReader reader(payload.data(), payload.data() + payload.size());
+            
+            thread_local std::vector<Point3D> vertices;
+            vertices.resize(info.vertices);
+            // Unsigned sums wrap instead of overflowing on corrupt deltas
+            std::uint64_t x = 0, y = 0, z = 0;
+            const Point3D& origin = quantizer.origin;
+            const double precision = quantizer.precision;
+            for (std::uint32_t v = 0; v < info.vertices; ++v) {
+                x += static_cast<std::uint64_t>(unzigzag(reader.varint()));
+                y += static_cast<std::uint64_t>(unzigzag(reader.varint()));
+                z += static_cast<std::uint64_t>(unzigzag(reader.varint()));
+                vertices[v] = Point3D(origin.x + static_cast<std::int64_t>(x) * precision,
+                                      origin.y + static_cast<std::int64_t>(y) * precision,
+                                      origin.z + static_cast<std::int64_t>(z) * precision);
+            }
+            
+            std::uint32_t nextVertex = 0;
+            for (std::uint32_t t = 0; t < info.triangles; ++t) {
+                for (auto& vertex : triangles[first + t].vertices) {
+                    std::uint64_t reference = reader.varint();
+                    if (reference == 0) {
+                        if (nextVertex == info.vertices) {
+                            throw MeshCodecException("Block references more vertices than it holds");
+                        }
+                        vertex = vertices[nextVertex++];
+                    } else {
+                        if (reference > nextVertex) {
+                            throw MeshCodecException("Block references a vertex before its first");
+                        }
+                        vertex = vertices[nextVertex - reference];
+                    }
+                }
+            }
+            
+            std::uint64_t filled = 0;
+            while (filled < info.triangles) {
+                std::uint64_t layer = reader.varint();
+                std::uint64_t runLength = reader.varint();
+                if (layer >= layerCount || runLength == 0 || runLength > info.triangles - filled) {
+                    throw MeshCodecException("Corrupt layer runs");
+                }
+                std::fill_n(triangleLayers.begin() + (first + filled), runLength, static_cast<LayerId>(layer));
+                filled += runLength;
+            }
+            if (!reader.atEnd()) {
+                throw MeshCodecException("Trailing bytes in block");
+            }
+        }
+        
+        /// Runs task(b) for every block, on a pool when there is more than one block
+        template <typename Task>
+        void forEachBlock(size_t blockCount, size_t threadCount, Task&& task) {
+            if (blockCount <= 1 || threadCount == 1) {
+                for (size_t b = 0; b < blockCount; ++b) {
+                    task(b);
+                }
+                return;
+            }
+            ThreadPool pool(threadCount == 0 ? 0 : std::min(threadCount, blockCount));
+            TaskGroup group(pool);
+            for (size_t b = 0; b < blockCount; ++b) {
+                group.run([&task, b] { task(b); });
+            }
+            group.wait();
+        }
+    }
+
+    MeshCodec::MeshCodec(MeshCodecOptions options) : options_(options) {
+        if (!(options_.precision > 0.0) || !std::isfinite(options_.precision)) {
+            throw MeshCodecException("Precision must be a positive number");
+        }
+        if (options_.trianglesPerBlock == 0 || options_.trianglesPerBlock > UINT32_MAX) {
+            throw MeshCodecException("Triangles per block must be between 1 and 2^32 - 1");
+        }
+    }
+
+    /**
+     * @brief Quantizes, Morton-sorts and block-encodes a mesh
+     *
+     * Morton codes use the top 21 bits of each quantized axis, which is
+     * enough to order triangles spatially; exact coordinates go in the blocks.
+     */
+    std::string MeshCodec::encode(const MeshData& meshData) const {
+        DXF_PROFILE_SCOPE("encode mesh");
+        const size_t triangleCount = meshData.getTriangleCount();
+        BoundingBox box = meshData.getBoundingBox();
+        Quantizer quantizer{box.isEmpty() ? Point3D() : box.min, options_.precision};
+        
+        std::vector<std::pair<std::uint64_t, size_t>> order(triangleCount);
+        if (triangleCount > 0) {
+            QuantizedPoint extent = quantizer.quantize(box.max);
+            std::uint64_t largest = static_cast<std::uint64_t>(std::max({extent.x, extent.y, extent.z, std::int64_t{1}}));
+            int shift = 0;
+            while ((largest >> shift) >= (1ull << MORTON_BITS)) {
+                ++shift;
+            }
+            for (size_t i = 0; i < triangleCount; ++i) {
+                order[i] = {mortonCode(quantizer.quantize(meshData.getTriangle(i).center()), shift), i};
+            }
+            std::sort(order.begin(), order.end());
+        }
+        
+        const size_t blockCount = (triangleCount + options_.trianglesPerBlock - 1) / options_.trianglesPerBlock;
+        std::vector<std::string> blocks(blockCount);
+        std::vector<BlockInfo> directory(blockCount);
+        forEachBlock(blockCount, options_.threadCount, [&](size_t b) {
+            size_t first = b * options_.trianglesPerBlock;
+            size_t count = std::min(options_.trianglesPerBlock, triangleCount - first);
+            blocks[b] = encodeBlock(meshData, quantizer, order, first, count, directory[b]);
+        });
+        
+        std::string out;
+        out.append(MESH_MAGIC, sizeof(MESH_MAGIC));
+        appendValue(out, FORMAT_VERSION);
+        appendValue(out, static_cast<std::uint32_t>(blockCount));
+        appendValue(out, options_.precision);
+        appendValue(out, quantizer.origin.x);
+        appendValue(out, quantizer.origin.y);
+        appendValue(out, quantizer.origin.z);
+        appendValue(out, static_cast<std::uint64_t>(triangleCount));
+        appendValue(out, static_cast<std::uint32_t>(meshData.getLayerCount()));
+        for (const auto& name : meshData.getLayerNames()) {
+            appendValue(out, static_cast<std::uint16_t>(name.size()));
+            out += name;
+        }
+        
+        std::uint64_t offset = out.size() + blockCount * DIRECTORY_ENTRY_SIZE;
+        for (auto& info : directory) {
+            info.offset = offset;
+            offset += info.bytes;
+            appendValue(out, info.offset);
+            appendValue(out, info.bytes);
+            appendValue(out, info.triangles);
+            appendValue(out, info.vertices);
+        }
+        out.reserve(offset);
+        for (const auto& block : blocks) {
+            out += block;
+        }
+        return out;
+    }
+
+    /**
+     * @brief Validates the header and directory, then decodes blocks in parallel
+     *
+     * The directory must describe contiguous blocks within the file, so a
+     * corrupt one can't claim more triangles than the bytes could hold. The
+     * mesh is then sized up front from it, so every block task writes its
+     * own range of the (never reallocating) triangle and layer sequences.
+     */
+    std::unique_ptr<MeshData> MeshCodec::decode(std::string_view bytes) const {
+        DXF_PROFILE_SCOPE("decode mesh");
+        ByteReader reader(bytes.data(), bytes.data() + bytes.size());
+        if (bytes.size() < sizeof(MESH_MAGIC) || std::memcmp(bytes.data(), MESH_MAGIC, sizeof(MESH_MAGIC)) != 0) {
+            throw MeshCodecException("Not a mesh file (bad magic)");
+        }
+        reader.bytes(sizeof(MESH_MAGIC));
+        std::uint32_t version = reader.value<std::uint32_t>();
+        if (version != FORMAT_VERSION) {
+            throw MeshCodecException("Unsupported format version " + std::to_string(version));
+        }
+        
+        const std::uint32_t blockCount = reader.value<std::uint32_t>();
+        Quantizer quantizer;
+        quantizer.precision = reader.value<double>();
+        quantizer.origin.x = reader.value<double>();
+        quantizer.origin.y = reader.value<double>();
+        quantizer.origin.z = reader.value<double>();
+        const std::uint64_t triangleCount = reader.value<std::uint64_t>();
+        const std::uint32_t layerCount = reader.value<std::uint32_t>();
+        if (!(quantizer.precision > 0.0) || layerCount == 0 || layerCount > 65536u) {
+            throw MeshCodecException("Corrupt header");
+        }
+        
+        auto meshData = std::make_unique<MeshData>();
+        for (std::uint32_t id = 0; id < layerCount; ++id) {
+            std::string_view name = reader.bytes(reader.value<std::uint16_t>());
+            if ((id == 0 && name != meshData->getLayerName(0)) || (id > 0 && meshData->internLayer(name) != id)) {
+                throw MeshCodecException("Corrupt layer table");
+            }
+        }
+        
+        if (blockCount > reader.remaining() / DIRECTORY_ENTRY_SIZE) {
+            throw MeshCodecException("Truncated block directory");
+        }
+        // Blocks follow the directory back to back, so their bytes, and with
+        // them the triangle count, are bounded by the file size
+        std::uint64_t nextOffset = bytes.size() - reader.remaining() + std::uint64_t{blockCount} * DIRECTORY_ENTRY_SIZE;
+        std::vector<BlockInfo> directory(blockCount);
+        std::vector<size_t> firstTriangle(blockCount);
+        std::uint64_t total = 0;
+        for (std::uint32_t b = 0; b < blockCount; ++b) {
+            BlockInfo& info = directory[b];
+            info.offset = reader.value<std::uint64_t>();
+            info.bytes = reader.value<std::uint32_t>();
+            info.triangles = reader.value<std::uint32_t>();
+            info.vertices = reader.value<std::uint32_t>();
+            // Every vertex takes at least three bytes and every triangle three references
+            if (info.offset != nextOffset || info.bytes > bytes.size() - info.offset ||
+                info.vertices > info.bytes / 3 || info.triangles > info.bytes / 3) {
+                throw MeshCodecException("Corrupt block directory");
+            }
+            nextOffset += info.bytes;
+            firstTriangle[b] = static_cast<size_t>(total);
+            total += info.triangles;
+        }
+        if (total != triangleCount) {
+            throw MeshCodecException("Block triangle counts don't add up to the header's");
+        }
+        
+        // Taken once, before the blocks fill them in parallel
+        SegmentedVector<Triangle>& triangles = meshData->mutableTriangles();
+        SegmentedVector<LayerId>& triangleLayers = meshData->mutableTriangleLayers();
+        triangles.resize(static_cast<size_t>(triangleCount));
+        triangleLayers.resize(static_cast<size_t>(triangleCount));
+        forEachBlock(blockCount, options_.threadCount, [&](size_t b) {
+            const BlockInfo& info = directory[b];
+            decodeBlock(bytes.substr(info.offset, info.bytes), info, quantizer, layerCount,
+                        triangles, triangleLayers, firstTriangle[b]);
+        });
+        return meshData;
+    }
+
+    void MeshCodec::save(const MeshData& meshData, const std::string& path) const {
+        std::string bytes = encode(meshData);
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            throw MeshCodecException("Cannot create mesh file: " + path);
+        }
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (!out.flush()) {
+            throw MeshCodecException("Write failed: " + path);
+        }
+    }
+
+    std::unique_ptr<MeshData> MeshCodec::load(const std::string& path) const {
+        MappedFile file;
+        try {
+            file = MappedFile(path, MappedFile::AccessHint::Sequential);
+        } catch (const MappedFileException& e) {
+            throw MeshCodecException("Cannot open mesh file: " + path);
+        }
+        return decode(file.view());
+    }
+
+    bool MeshCodec::isMeshFile(const std::string& path) {
+        constexpr std::string_view extension = ".dxm";
+        if (path.size() < extension.size()) {
+            return false;
+        }
+        return std::equal(extension.begin(), extension.end(), path.end() - extension.size(),
+                          [](char a, char b) { return a == std::tolower(static_cast<unsigned char>(b)); });
+    }
+
+} // namespace DXFProcessor
@@ -0,0 +1,207 @@
+#include "MeshComponents.h"
+#include "Profiler.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace DXFProcessor {
+
+    namespace {
+
+        using Index = MeshTopology::Index;
+        
+        /**
+         * @brief Union-find whose unite and find may run on many threads at once
+         *
+         * Parents only ever point to a smaller index: a root is linked under
+         * the smaller of the two roots by compare-and-swap (retried if another
+         * thread linked it first), and find halves paths with a CAS that may
+         * harmlessly lose its race. Each set's root is therefore its smallest
+         * element, independent of the thread interleaving.
+         */
+        class ConcurrentUnionFind {
+        public:
+            explicit ConcurrentUnionFind(size_t size) : parent_(size) {
+                for (size_t i = 0; i < size; ++i) {
+                    parent_[i].store(static_cast<Index>(i), std::memory_order_relaxed);
+                }
+            }
+            
+            Index find(Index x) {
+                while (true) {
+                    Index parent = parent_[x].load(std::memory_order_relaxed);
+                    if (parent == x) {
+                        return x;
+                    }
+                    Index grandparent = parent_[parent].load(std::memory_order_relaxed);
+                    if (grandparent != parent) {
+                        parent_[x].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+                    }
+                    x = grandparent;
+                }
+            }
+            
+            void unite(Index a, Index b) {
+                while (true) {
+                    a = find(a);
+                    b = find(b);
+                    if (a == b) {
+                        return;
+                    }
+                    if (a < b) {
+                        std::swap(a, b);
+                    }
+                    Index expected = a;
+                    if (parent_[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) {
+                        return;
+                    }
+                }
+            }
+        
+        private:
+            std::vector<std::atomic<Index>> parent_;
+        };
+        
+        std::string componentName(size_t label) {
+            return "Component " + std::to_string(label + 1);
+        }
+    }
+
+    ComponentLabeler::ComponentLabeler(ComponentOptions options) : options_(options) {}
+
+    ComponentLabels ComponentLabeler::label(const MeshData& meshData) const {
+        MeshTopologyOptions topologyOptions;
+        topologyOptions.threadCount = options_.threadCount;
+        topologyOptions.threadPool = options_.threadPool;
+        return label(MeshTopology(meshData, topologyOptions));
+    }
+
+    ComponentLabels ComponentLabeler::label(const MeshTopology& topology) const {
+        DXF_PROFILE_SCOPE("label components");
+        const size_t count = topology.getTriangleCount();
+        ComponentLabels labels;
+        if (count == 0) {
+            return labels;
+        }
+        
+        PassPool pool(options_.threadPool, count, MIN_PARALLEL_TRIANGLES, options_.threadCount);
+        const size_t chunkCount = pool.get() != nullptr ? pool.get()->size() : 1;
+        
+        ConcurrentUnionFind sets(count);
+        if (options_.connectivity == ComponentConnectivity::Vertex) {
+            const size_t vertexCount = topology.getVertexCount();
+            const size_t verticesPerChunk = (vertexCount + chunkCount - 1) / chunkCount;
+            forEachChunk(pool.get(), chunkCount, [&](size_t c) {
+                const size_t end = std::min(vertexCount, (c + 1) * verticesPerChunk);
+                for (size_t v = c * verticesPerChunk; v < end; ++v) {
+                    MeshTopology::CornerRange corners = topology.cornersAround(static_cast<Index>(v));
+                    const Index first = MeshTopology::triangleOf(*corners.begin());
+                    for (Index corner : corners) {
+                        sets.unite(first, MeshTopology::triangleOf(corner));
+                    }
+                }
+            });
+        } else {
+            const size_t cornerCount = topology.getCornerCount();
+            const size_t cornersPerChunk = (cornerCount + chunkCount - 1) / chunkCount;
+            forEachChunk(pool.get(), chunkCount, [&](size_t c) {
+                const size_t end = std::min(cornerCount, (c + 1) * cornersPerChunk);
+                for (size_t corner = c * cornersPerChunk; corner < end; ++corner) {
+                    const Index opposite = topology.opposite(static_cast<Index>(corner));
+                    if (opposite != MeshTopology::NONE && corner < opposite) {
+                        sets.unite(MeshTopology::triangleOf(static_cast<Index>(corner)),
+                                   MeshTopology::triangleOf(opposite));
+                    }
+                }
+            });
+        }
+        
+        labels.componentOf.resize(count);
+        const size_t trianglesPerChunk = (count + chunkCount - 1) / chunkCount;
+        forEachChunk(pool.get(), chunkCount, [&](size_t c) {
+            const size_t end = std::min(count, (c + 1) * trianglesPerChunk);
+            for (size_t t = c * trianglesPerChunk; t < end; ++t) {
+                labels.componentOf[t] = sets.find(static_cast<Index>(t));
+            }
+        });
+        
+        // A root is the smallest triangle of its set, so it is numbered before any other member
+        for (size_t t = 0; t < count; ++t) {
+            const Index root = labels.componentOf[t];
+            labels.componentOf[t] = root == t ? static_cast<Index>(labels.count++) : labels.componentOf[root];
+        }
+        return labels;
+    }
+
+    std::vector<ComponentSummary> ComponentLabeler::summarize(const MeshData& meshData, const ComponentLabels& labels) {
+        DXF_PROFILE_SCOPE("summarize components");
+        if (labels.componentOf.size() != meshData.getTriangleCount()) {
+            throw std::invalid_argument("Component labels were made for a mesh with a different triangle count");
+        }
+        
+        std::vector<GroupAccumulator> accumulators(labels.count);
+        std::vector<double> tripleProducts(labels.count, 0.0);
+        size_t index = 0;
+        meshData.forEachTriangle([&](const Triangle& triangle) {
+            const Index label = labels.componentOf[index++];
+            accumulators[label].add(triangle);
+            tripleProducts[label] += triangle.vertices[0].dot(triangle.vertices[1].cross(triangle.vertices[2]));
+        });
+        
+        std::vector<ComponentSummary> components(labels.count);
+        for (size_t label = 0; label < labels.count; ++label) {
+            static_cast<GroupSummary&>(components[label]) = accumulators[label].finish(componentName(label));
+            components[label].volume = std::abs(tripleProducts[label]) / 6.0;
+        }
+        return components;
+    }
+
+    ComponentAnalysis ComponentLabeler::analyze(MeshData& meshData) const {
+        MeshTopologyOptions topologyOptions;
+        topologyOptions.threadCount = options_.threadCount;
+        topologyOptions.threadPool = options_.threadPool;
+        return analyze(meshData, MeshTopology(meshData, topologyOptions));
+    }
+
+    ComponentAnalysis ComponentLabeler::analyze(MeshData& meshData, const MeshTopology& topology) const {
+        if (topology.getTriangleCount() != meshData.getTriangleCount()) {
+            throw std::invalid_argument("Topology was built from a mesh with a different triangle count");
+        }
+        ComponentLabels labels = label(topology);
+        ComponentAnalysis analysis;
+        analysis.components = summarize(meshData, labels);
+        if (options_.minArea <= 0.0) {
+            return analysis;
+        }
+        
+        std::vector<std::uint8_t> dropComponent(labels.count, 0);
+        std::vector<ComponentSummary> kept;
+        for (size_t label = 0; label < labels.count; ++label) {
+            ComponentSummary& component = analysis.components[label];
+            if (component.totalSurfaceArea < options_.minArea) {
+                dropComponent[label] = 1;
+                ++analysis.droppedComponents;
+            } else {
+                component.name = componentName(kept.size());
+                kept.push_back(std::move(component));
+            }
+        }
+        analysis.components = std::move(kept);
+        if (analysis.droppedComponents == 0) {
+            return analysis;
+        }
+        
+        std::vector<std::uint8_t> dropTriangle(labels.componentOf.size());
+        for (size_t t = 0; t < dropTriangle.size(); ++t) {
+            dropTriangle[t] = dropComponent[labels.componentOf[t]];
+        }
+        analysis.droppedTriangles = meshData.removeTriangles(dropTriangle);
+        return analysis;
+    }
+
+} // namespace DXFProcessor
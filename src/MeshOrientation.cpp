@@ -0,0 +1,214 @@
+#include "MeshOrientation.h"
+#include "Profiler.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace DXFProcessor {
+
+    namespace {
+
+        using Index = MeshTopology::Index;
+        
+        /// Edge between triangles claimed by two different regions
+        struct Crossing {
+            Index from;
+            Index to;
+            std::uint8_t edgeParity;  ///< 1 if the two triangles wind the same way along the edge
+        };
+        
+        /**
+         * @brief Union-find over region seeds that tracks whether each seed is flipped relative to its root
+         */
+        class ParityUnionFind {
+        public:
+            explicit ParityUnionFind(size_t size) : parent_(size), parity_(size, 0) {
+                for (size_t i = 0; i < size; ++i) {
+                    parent_[i] = static_cast<Index>(i);
+                }
+            }
+            
+            /// Root of x and the parity between x and the root; compresses the path
+            std::pair<Index, std::uint8_t> find(Index x) {
+                Index root = x;
+                std::uint8_t parity = 0;
+                while (parent_[root] != root) {
+                    parity ^= parity_[root];
+                    root = parent_[root];
+                }
+                std::uint8_t toRoot = parity;
+                while (parent_[x] != root) {
+                    Index up = parent_[x];
+                    std::uint8_t step = parity_[x];
+                    parent_[x] = root;
+                    parity_[x] = toRoot;
+                    toRoot ^= step;
+                    x = up;
+                }
+                return {root, parity};
+            }
+            
+            /**
+             * @brief Records that b is flipped relative to a by 'relation'
+             * @return false if a and b are already joined with the other parity
+             */
+            bool join(Index a, Index b, std::uint8_t relation) {
+                auto [rootA, parityA] = find(a);
+                auto [rootB, parityB] = find(b);
+                if (rootA == rootB) {
+                    return (parityA ^ parityB) == relation;
+                }
+                parent_[rootB] = rootA;
+                parity_[rootB] = parityA ^ parityB ^ relation;
+                return true;
+            }
+        
+        private:
+            std::vector<Index> parent_;
+            std::vector<std::uint8_t> parity_;
+        };
+        
+        struct ComponentTally {
+            size_t triangles = 0;
+            size_t flipped = 0;          ///< Triangles flipped relative to the component root
+            double upwardArea = 0.0;     ///< Twice the area-weighted normal Z once flipped
+            std::uint8_t firstFlip = 0;  ///< Relative flip of the component's lowest-index triangle
+        };
+    }
+
+    MeshOrienter::MeshOrienter(OrientationOptions options) : options_(options) {}
+
+    OrientationReport MeshOrienter::orient(MeshData& meshData) const {
+        MeshTopologyOptions topologyOptions;
+        topologyOptions.threadCount = options_.threadCount;
+        topologyOptions.threadPool = options_.threadPool;
+        MeshTopology topology(meshData, topologyOptions);
+        return orient(meshData, topology);
+    }
+
+    OrientationReport MeshOrienter::orient(MeshData& meshData, const MeshTopology& topology) const {
+        DXF_PROFILE_SCOPE("orient mesh");
+        const size_t count = topology.getTriangleCount();
+        if (count != meshData.getTriangleCount()) {
+            throw std::invalid_argument("Topology was built from a mesh with a different triangle count");
+        }
+        OrientationReport report;
+        if (count == 0) {
+            return report;
+        }
+        
+        PassPool pool(options_.threadPool, count, MIN_PARALLEL_TRIANGLES, options_.threadCount);
+        const size_t chunkCount = pool.get() != nullptr ? pool.get()->size() : 1;
+        const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+        
+        // Region of each triangle as seed + 1 (0 = unclaimed), and its flip relative to the seed
+        std::vector<std::atomic<Index>> region(count);
+        std::vector<std::uint8_t> flip(count, 0);
+        std::vector<std::vector<Crossing>> crossings(chunkCount);
+        std::vector<size_t> conflicts(chunkCount, 0);
+        
+        forEachChunk(pool.get(), chunkCount, [&](size_t c) {
+            DXF_PROFILE_SCOPE("orientation search");
+            std::vector<Index> queue;
+            const size_t end = std::min(count, (c + 1) * chunkSize);
+            for (size_t seed = c * chunkSize; seed < end; ++seed) {
+                const Index label = static_cast<Index>(seed + 1);
+                Index unclaimed = 0;
+                if (!region[seed].compare_exchange_strong(unclaimed, label, std::memory_order_relaxed)) {
+                    continue;
+                }
+                queue.assign(1, static_cast<Index>(seed));
+                for (size_t head = 0; head < queue.size(); ++head) {
+                    const Index t = queue[head];
+                    for (unsigned k = 0; k < 3; ++k) {
+                        const Index corner = MeshTopology::cornerOf(t, k);
+                        const Index u = topology.neighbour(corner);
+                        if (u == MeshTopology::NONE) {
+                            continue;
+                        }
+                        const std::uint8_t edgeParity = topology.isConsistent(corner) ? 0 : 1;
+                        const std::uint8_t wanted = flip[t] ^ edgeParity;
+                        Index owner = 0;
+                        if (region[u].compare_exchange_strong(owner, label, std::memory_order_relaxed)) {
+                            flip[u] = wanted;
+                            queue.push_back(u);
+                        } else if (owner == label) {
+                            // Seen from both triangles; count it once
+                            if (flip[u] != wanted && t < u) {
+                                ++conflicts[c];
+                            }
+                        } else {
+                            crossings[c].push_back(Crossing{t, u, edgeParity});
+                        }
+                    }
+                }
+            }
+        });
+        
+        DXF_PROFILE_SCOPE("orientation merge");
+        // A crossing is recorded from both of its triangles; joining from one side is enough
+        ParityUnionFind seeds(count);
+        for (size_t c = 0; c < chunkCount; ++c) {
+            report.conflictingEdges += conflicts[c];
+            for (const Crossing& crossing : crossings[c]) {
+                if (crossing.from > crossing.to) {
+                    continue;
+                }
+                Index a = region[crossing.from].load(std::memory_order_relaxed) - 1;
+                Index b = region[crossing.to].load(std::memory_order_relaxed) - 1;
+                std::uint8_t relation = flip[crossing.from] ^ crossing.edgeParity ^ flip[crossing.to];
+                if (!seeds.join(a, b, relation)) {
+                    ++report.conflictingEdges;
+                }
+            }
+        }
+        
+        // Flip of every triangle relative to its component root, tallied per component in first-seen order
+        std::vector<Index> componentOfRoot(count, MeshTopology::NONE);
+        std::vector<ComponentTally> components;
+        std::vector<Index> component(count);
+        for (size_t t = 0; t < count; ++t) {
+            auto [root, seedFlip] = seeds.find(region[t].load(std::memory_order_relaxed) - 1);
+            flip[t] ^= seedFlip;
+            if (componentOfRoot[root] == MeshTopology::NONE) {
+                componentOfRoot[root] = static_cast<Index>(components.size());
+                components.emplace_back();
+                components.back().firstFlip = flip[t];
+            }
+            ComponentTally& tally = components[componentOfRoot[root]];
+            component[t] = componentOfRoot[root];
+            ++tally.triangles;
+            tally.flipped += flip[t];
+            if (options_.upward) {
+                const Triangle triangle = meshData.getTriangle(t);
+                Point3D normal = (triangle.vertices[1] - triangle.vertices[0])
+                                     .cross(triangle.vertices[2] - triangle.vertices[0]);
+                tally.upwardArea += flip[t] ? -normal.z : normal.z;
+            }
+        }
+        
+        std::vector<std::uint8_t> invert(components.size(), 0);
+        for (size_t i = 0; i < components.size(); ++i) {
+            const ComponentTally& tally = components[i];
+            if (options_.upward && tally.upwardArea != 0.0) {
+                invert[i] = tally.upwardArea < 0.0;
+            } else if (tally.flipped * 2 != tally.triangles) {
+                invert[i] = tally.flipped * 2 > tally.triangles;
+            } else {
+                invert[i] = tally.firstFlip;
+            }
+        }
+        for (size_t t = 0; t < count; ++t) {
+            if (flip[t] ^ invert[component[t]]) {
+                meshData.flipTriangle(t);
+                ++report.flippedTriangles;
+            }
+        }
+        report.components = components.size();
+        return report;
+    }
+
+} // namespace DXFProcessor
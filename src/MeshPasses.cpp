@@ -0,0 +1,120 @@
+#include "MeshPasses.h"
+#include "MeshTopology.h"
+#include "SpatialOrder.h"
+#include <array>
+#include <utility>
+
+namespace DXFProcessor {
+
+    namespace metrics {
+
+        // One list per pass, in column order; addTo and metricNames both read these
+        const std::array<MetricKey, 3> CLEANUP = {
+            MetricKey::intern("degenerate_triangles"),
+            MetricKey::intern("duplicate_triangles"),
+            MetricKey::intern("removed_triangles")};
+        const std::array<MetricKey, 2> ORIENTATION = {
+            MetricKey::intern("flipped_triangles"),
+            MetricKey::intern("non_orientable_edges")};
+        const std::array<MetricKey, 3> COMPONENTS = {
+            MetricKey::intern("component_count"),
+            MetricKey::intern("dropped_components"),
+            MetricKey::intern("dropped_triangles")};
+
+    } // namespace metrics
+
+    namespace {
+
+        template <std::size_t N>
+        void setCounts(MetricStore& store, const std::array<MetricKey, N>& keys,
+                       const std::array<std::size_t, N>& counts) {
+            for (std::size_t i = 0; i < N; ++i) {
+                store.set(keys[i], counts[i]);
+            }
+        }
+
+        template <std::size_t N>
+        void appendNames(std::vector<std::string>& names, const std::array<MetricKey, N>& keys) {
+            for (const MetricKey& key : keys) {
+                names.emplace_back(key.name());
+            }
+        }
+
+    } // namespace
+
+    void MeshPassReport::addTo(MeshSummary& summary) {
+        if (cleanup) {
+            setCounts(summary.customFields, metrics::CLEANUP,
+                      {cleanup->degenerateTriangles, cleanup->duplicateTriangles, cleanup->removedTriangles});
+        }
+        if (orientation) {
+            setCounts(summary.customFields, metrics::ORIENTATION,
+                      {orientation->flippedTriangles, orientation->conflictingEdges});
+        }
+        if (components) {
+            setCounts(summary.customFields, metrics::COMPONENTS,
+                      {components->components.size(), components->droppedComponents, components->droppedTriangles});
+            summary.components = std::move(components->components);
+        }
+    }
+
+    MeshPasses::MeshPasses(MeshPassOptions options) : options_(options) {}
+
+    MeshPassReport MeshPasses::run(MeshData& meshData) const {
+        MeshPassReport report;
+        if (options_.checkFaces || options_.clean) {
+            CleanupOptions cleanupOptions;
+            cleanupOptions.minArea = options_.minFaceArea;
+            cleanupOptions.threadCount = options_.threadCount;
+            cleanupOptions.threadPool = options_.threadPool;
+            MeshCleaner cleaner(cleanupOptions);
+            report.cleanup = options_.clean ? cleaner.clean(meshData) : cleaner.inspect(meshData);
+            report.cleanup->defects = std::vector<TriangleDefect>();  // Per-face flags aren't kept
+        }
+        
+        if (options_.spatialOrder) {
+            SpatialOrderOptions orderOptions;
+            orderOptions.threadCount = options_.threadCount;
+            orderOptions.threadPool = options_.threadPool;
+            SpatialOrder(orderOptions).reorder(meshData);
+        }
+        
+        const bool orient = options_.orient || options_.orientUp;
+        if (orient || options_.components) {
+            MeshTopologyOptions topologyOptions;
+            topologyOptions.threadCount = options_.threadCount;
+            topologyOptions.threadPool = options_.threadPool;
+            MeshTopology topology(meshData, topologyOptions);
+            if (orient) {
+                OrientationOptions orientationOptions;
+                orientationOptions.upward = options_.orientUp;
+                orientationOptions.threadCount = options_.threadCount;
+                orientationOptions.threadPool = options_.threadPool;
+                report.orientation = MeshOrienter(orientationOptions).orient(meshData, topology);
+            }
+            if (options_.components) {
+                ComponentOptions componentOptions;
+                componentOptions.minArea = options_.minComponentArea;
+                componentOptions.threadCount = options_.threadCount;
+                componentOptions.threadPool = options_.threadPool;
+                report.components = ComponentLabeler(componentOptions).analyze(meshData, topology);
+            }
+        }
+        return report;
+    }
+
+    std::vector<std::string> MeshPasses::metricNames() const {
+        std::vector<std::string> names;
+        if (options_.checkFaces || options_.clean) {
+            appendNames(names, metrics::CLEANUP);
+        }
+        if (options_.orient || options_.orientUp) {
+            appendNames(names, metrics::ORIENTATION);
+        }
+        if (options_.components) {
+            appendNames(names, metrics::COMPONENTS);
+        }
+        return names;
+    }
+
+} // namespace DXFProcessor
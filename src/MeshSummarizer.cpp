@@ -1,72 +1,131 @@
 #include "MeshSummarizer.h"
+#include "Profiler.h"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
 
 namespace DXFProcessor {
 
+    namespace metrics {
+
+        // Interned once; summaries store only the key
+        const MetricKey MESH_DENSITY = MetricKey::intern("mesh_density");
+        const MetricKey AVERAGE_TRIANGLE_AREA = MetricKey::intern("average_triangle_area");
+        const MetricKey BOUNDING_BOX_VOLUME = MetricKey::intern("bounding_box_volume");
+        const MetricKey WIDTH = MetricKey::intern("width");
+        const MetricKey HEIGHT = MetricKey::intern("height");
+        const MetricKey DEPTH = MetricKey::intern("depth");
+        const MetricKey VOLUME_ESTIMATE = MetricKey::intern("volume_estimate");
+        const MetricKey MIN_TRIANGLE_AREA = MetricKey::intern("min_triangle_area");
+        const MetricKey MAX_TRIANGLE_AREA = MetricKey::intern("max_triangle_area");
+        const MetricKey TRIANGLE_AREA_VARIANCE = MetricKey::intern("triangle_area_variance");
+        const MetricKey COMPACTNESS_RATIO = MetricKey::intern("compactness_ratio");
+        const MetricKey AVERAGE_TRIANGLE_AREA_DETAILED = MetricKey::intern("average_triangle_area_detailed");
+        const MetricKey SMALL_TRIANGLES_COUNT = MetricKey::intern("small_triangles_count");
+        const MetricKey LARGE_TRIANGLES_COUNT = MetricKey::intern("large_triangles_count");
+        const MetricKey SMALL_TRIANGLES_PERCENTAGE = MetricKey::intern("small_triangles_percentage");
+        const MetricKey LARGE_TRIANGLES_PERCENTAGE = MetricKey::intern("large_triangles_percentage");
+
+    } // namespace metrics
+
+    const std::vector<std::string>& MeshSummarizerFactory::metricNames() {
+        static const std::vector<std::string> names = [] {
+            std::vector<std::string> list;
+            for (const MetricKey& key : {
+                     metrics::MESH_DENSITY, metrics::AVERAGE_TRIANGLE_AREA, metrics::BOUNDING_BOX_VOLUME,
+                     metrics::WIDTH, metrics::HEIGHT, metrics::DEPTH,
+                     metrics::VOLUME_ESTIMATE, metrics::MIN_TRIANGLE_AREA, metrics::MAX_TRIANGLE_AREA,
+                     metrics::TRIANGLE_AREA_VARIANCE, metrics::COMPACTNESS_RATIO,
+                     metrics::AVERAGE_TRIANGLE_AREA_DETAILED, metrics::SMALL_TRIANGLES_COUNT,
+                     metrics::LARGE_TRIANGLES_COUNT, metrics::SMALL_TRIANGLES_PERCENTAGE,
+                     metrics::LARGE_TRIANGLES_PERCENTAGE}) {
+                list.emplace_back(key.name());
+            }
+            return list;
+        }();
+        return names;
+    }
+
     MeshSummary MeshSummarizer::summarize(const MeshData& meshData) {
+        DXF_PROFILE_SCOPE("summarize");
         MeshSummary summary;
         
         calculateBasicStats(meshData, summary);
         calculateAdvancedStats(meshData, summary);
         addCustomCalculations(meshData, summary);
         
+        if (groupByLayer_) {
+            summary.layers = summarizeByLayer(meshData);
+        }
+        
+        return summary;
+    }
+
+    MeshSummary MeshSummarizer::summarizeTotals(const GroupAccumulator& total, std::vector<GroupSummary> layers) {
+        DXF_PROFILE_SCOPE("summarize");
+        GroupSummary totals = total.finish(std::string());
+        
+        MeshSummary summary;
+        summary.triangleCount = totals.triangleCount;
+        summary.boundingBox = totals.boundingBox;
+        summary.totalSurfaceArea = totals.totalSurfaceArea;
+        summary.centroid = totals.centroid;
+        
+        // Advanced stats only read the summary; the mesh argument is not consulted
+        calculateAdvancedStats(MeshData(), summary);
+        
+        if (groupByLayer_) {
+            summary.layers = std::move(layers);
+        }
         return summary;
     }
 
+    std::vector<GroupSummary> MeshSummarizer::summarizeByLayer(const MeshData& meshData) {
+        std::vector<GroupAccumulator> accumulators(meshData.getLayerCount());
+        
+        size_t index = 0;
+        meshData.forEachTriangle([&](const Triangle& triangle) {
+            accumulators[meshData.getTriangleLayer(index++)].add(triangle);
+        });
+        
+        std::vector<GroupSummary> layers;
+        for (size_t id = 0; id < accumulators.size(); ++id) {
+            if (accumulators[id].triangleCount > 0) {
+                layers.push_back(accumulators[id].finish(meshData.getLayerName(static_cast<LayerId>(id))));
+            }
+        }
+        return layers;
+    }
+
     void MeshSummarizer::calculateBasicStats(const MeshData& meshData, MeshSummary& summary) {
-        summary.triangleCount = meshData.getTriangleCount();
-        summary.boundingBox = meshData.getBoundingBox();
-        summary.totalSurfaceArea = meshData.getTotalSurfaceArea();
-        summary.centroid = calculateCentroid(meshData);
+        // One cached pass serves these and the detailed metrics, however often the mesh is summarized
+        const MeshAggregates& totals = meshData.getAggregates();
+        summary.triangleCount = totals.triangleCount;
+        summary.boundingBox = totals.boundingBox;
+        summary.totalSurfaceArea = totals.totalSurfaceArea;
+        summary.centroid = totals.centroid;
     }
 
     void MeshSummarizer::calculateAdvancedStats(const MeshData& meshData, MeshSummary& summary) {
-        if (meshData.isEmpty()) {
+        (void)meshData;
+        if (summary.triangleCount == 0) {
             return;
         }
         
-        summary.addCustomField("mesh_density", 
-            std::to_string(summary.triangleCount / summary.boundingBox.volume()));
-        
-        summary.addCustomField("average_triangle_area", 
-            std::to_string(summary.totalSurfaceArea / summary.triangleCount));
+        summary.customFields.set(metrics::MESH_DENSITY, summary.triangleCount / summary.boundingBox.volume());
+        summary.customFields.set(metrics::AVERAGE_TRIANGLE_AREA, summary.totalSurfaceArea / summary.triangleCount);
         
         Point3D size = summary.boundingBox.size();
-        summary.addCustomField("bounding_box_volume", std::to_string(summary.boundingBox.volume()));
-        summary.addCustomField("width", std::to_string(size.x));
-        summary.addCustomField("height", std::to_string(size.y));
-        summary.addCustomField("depth", std::to_string(size.z));
+        summary.customFields.set(metrics::BOUNDING_BOX_VOLUME, summary.boundingBox.volume());
+        summary.customFields.set(metrics::WIDTH, size.x);
+        summary.customFields.set(metrics::HEIGHT, size.y);
+        summary.customFields.set(metrics::DEPTH, size.z);
     }
 
     void MeshSummarizer::addCustomCalculations(const MeshData& meshData, MeshSummary& summary) {
         // Base implementation - can be overridden by derived classes
     }
 
-    Point3D MeshSummarizer::calculateCentroid(const MeshData& meshData) {
-        if (meshData.isEmpty()) {
-            return Point3D(0, 0, 0);
-        }
-        
-        Point3D centroid(0, 0, 0);
-        double totalArea = 0.0;
-        
-        for (const auto& triangle : meshData.triangles) {
-            double area = triangle.area();
-            Point3D triangleCenter = triangle.center();
-            
-            centroid = centroid + (triangleCenter * area);
-            totalArea += area;
-        }
-        
-        if (totalArea > 0.0) {
-            centroid = centroid * (1.0 / totalArea);
-        }
-        
-        return centroid;
-    }
-
     // DetailedMeshSummarizer implementation
 
     void DetailedMeshSummarizer::addCustomCalculations(const MeshData& meshData, MeshSummary& summary) {
@@ -74,52 +133,37 @@ namespace DXFProcessor {
             return;
         }
         
-        summary.addCustomField("volume_estimate", std::to_string(calculateVolume(meshData)));
+        summary.customFields.set(metrics::VOLUME_ESTIMATE, calculateVolume(meshData));
         
         auto [minArea, maxArea] = getTriangleAreaRange(meshData);
-        summary.addCustomField("min_triangle_area", std::to_string(minArea));
-        summary.addCustomField("max_triangle_area", std::to_string(maxArea));
-        summary.addCustomField("triangle_area_variance", 
-            std::to_string(maxArea - minArea));
+        summary.customFields.set(metrics::MIN_TRIANGLE_AREA, minArea);
+        summary.customFields.set(metrics::MAX_TRIANGLE_AREA, maxArea);
+        summary.customFields.set(metrics::TRIANGLE_AREA_VARIANCE, maxArea - minArea);
         
-        summary.addCustomField("compactness_ratio", 
-            std::to_string(summary.totalSurfaceArea / summary.boundingBox.volume()));
+        summary.customFields.set(metrics::COMPACTNESS_RATIO, summary.totalSurfaceArea / summary.boundingBox.volume());
         
         double avgArea = calculateAverageTriangleArea(meshData);
-        summary.addCustomField("average_triangle_area_detailed", std::to_string(avgArea));
+        summary.customFields.set(metrics::AVERAGE_TRIANGLE_AREA_DETAILED, avgArea);
         
         size_t smallTriangles = 0, largeTriangles = 0;
-        for (const auto& triangle : meshData.triangles) {
-            double area = triangle.area();
-            if (area < avgArea * 0.5) smallTriangles++;
-            if (area > avgArea * 2.0) largeTriangles++;
+        const SegmentedVector<double>& areas = meshData.getTriangleAreas();
+        for (size_t b = 0; b < areas.blockCount(); ++b) {
+            for (double area : areas.block(b)) {
+                if (area < avgArea * 0.5) smallTriangles++;
+                if (area > avgArea * 2.0) largeTriangles++;
+            }
         }
         
-        summary.addCustomField("small_triangles_count", std::to_string(smallTriangles));
-        summary.addCustomField("large_triangles_count", std::to_string(largeTriangles));
-        summary.addCustomField("small_triangles_percentage", 
-            std::to_string((double)smallTriangles / summary.triangleCount * 100.0));
-        summary.addCustomField("large_triangles_percentage", 
-            std::to_string((double)largeTriangles / summary.triangleCount * 100.0));
+        summary.customFields.set(metrics::SMALL_TRIANGLES_COUNT, smallTriangles);
+        summary.customFields.set(metrics::LARGE_TRIANGLES_COUNT, largeTriangles);
+        summary.customFields.set(metrics::SMALL_TRIANGLES_PERCENTAGE,
+            static_cast<double>(smallTriangles) / summary.triangleCount * 100.0);
+        summary.customFields.set(metrics::LARGE_TRIANGLES_PERCENTAGE,
+            static_cast<double>(largeTriangles) / summary.triangleCount * 100.0);
     }
 
     double DetailedMeshSummarizer::calculateVolume(const MeshData& meshData) {
-        if (meshData.isEmpty()) {
-            return 0.0;
-        }
-        
-        double volume = 0.0;
-        Point3D origin(0, 0, 0);
-        
-        for (const auto& triangle : meshData.triangles) {
-            Point3D v0 = triangle.vertices[0];
-            Point3D v1 = triangle.vertices[1];
-            Point3D v2 = triangle.vertices[2];
-            
-            volume += (v0.dot(v1.cross(v2))) / 6.0;
-        }
-        
-        return std::abs(volume);
+        return std::abs(meshData.getAggregates().signedVolume);
     }
 
     double DetailedMeshSummarizer::calculateAverageTriangleArea(const MeshData& meshData) {
@@ -131,20 +175,8 @@ namespace DXFProcessor {
     }
 
     std::pair<double, double> DetailedMeshSummarizer::getTriangleAreaRange(const MeshData& meshData) {
-        if (meshData.isEmpty()) {
-            return {0.0, 0.0};
-        }
-        
-        double minArea = std::numeric_limits<double>::max();
-        double maxArea = std::numeric_limits<double>::lowest();
-        
-        for (const auto& triangle : meshData.triangles) {
-            double area = triangle.area();
-            minArea = std::min(minArea, area);
-            maxArea = std::max(maxArea, area);
-        }
-        
-        return {minArea, maxArea};
+        const MeshAggregates& totals = meshData.getAggregates();
+        return {totals.minTriangleArea, totals.maxTriangleArea};
     }
 
 } // namespace DXFProcessor
\ No newline at end of file
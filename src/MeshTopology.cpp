@@ -0,0 +1,224 @@
+#include "MeshTopology.h"
+#include "Profiler.h"
+#include "RadixSort.h"
+#include "SpatialOrder.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <memory>
+
+namespace DXFProcessor {
+
+    namespace {
+
+        bool samePosition(const Point3D& a, const Point3D& b) {
+            return a.x == b.x && a.y == b.y && a.z == b.z;
+        }
+        
+        bool lessPosition(const Point3D& a, const Point3D& b) {
+            if (a.x != b.x) {
+                return a.x < b.x;
+            }
+            if (a.y != b.y) {
+                return a.y < b.y;
+            }
+            return a.z < b.z;
+        }
+        
+        struct EdgeCounts {
+            size_t boundary = 0;
+            size_t nonManifold = 0;
+            size_t inconsistent = 0;
+        };
+    }
+
+    MeshTopology::MeshTopology(const MeshData& meshData, MeshTopologyOptions options) {
+        DXF_PROFILE_SCOPE("build topology");
+        const size_t triangleCount = meshData.getTriangleCount();
+        if (triangleCount >= NONE / 3) {
+            throw MeshTopologyException("Meshes of 2^32 / 3 triangles or more are not supported");
+        }
+        if (triangleCount == 0) {
+            return;
+        }
+        
+        PassPool pool(options.threadPool, triangleCount, MIN_PARALLEL_TRIANGLES, options.threadCount);
+        
+        weldVertices(meshData, pool.get());
+        linkEdges(pool.get());
+    }
+
+    /**
+     * Sorts corners by the Morton code of their position on a grid over the
+     * bounding box, so corners on one vertex end up next to each other.
+     * Distinct positions that share a grid cell are told apart by sorting
+     * that run by coordinates. Vertex ids are then handed out in sorted
+     * order: each chunk counts its vertices, a prefix sum gives each chunk
+     * its first id, and the chunks fill the vertex arrays in parallel.
+     */
+    void MeshTopology::weldVertices(const MeshData& meshData, ThreadPool* pool) {
+        DXF_PROFILE_SCOPE("weld vertices");
+        const size_t triangleCount = meshData.getTriangleCount();
+        const size_t cornerCount = triangleCount * 3;
+        
+        // Keys hold the cell code above the corner index
+        const int cornerBits = bitWidth(cornerCount - 1);
+        const std::uint64_t cornerMask = (std::uint64_t{1} << cornerBits) - 1;
+        const int bitsPerAxis = std::min(SpatialOrder::MAX_BITS_PER_AXIS, (64 - cornerBits) / 3);
+        const double maxCell = static_cast<double>((std::uint32_t{1} << bitsPerAxis) - 1);
+        
+        const BoundingBox box = meshData.getBoundingBox();
+        const Point3D size = box.size();
+        const double extent = std::max({size.x, size.y, size.z});
+        const double scale = extent > 0.0 ? maxCell / extent : 0.0;
+        auto cell = [&](double value, double min) {
+            return static_cast<std::uint32_t>(std::clamp((value - min) * scale, 0.0, maxCell));
+        };
+        auto position = [&](std::uint64_t key) {
+            const size_t corner = static_cast<size_t>(key & cornerMask);
+            return meshData.getTriangle(corner / 3).vertices[corner % 3];
+        };
+        
+        const size_t chunkCount = pool != nullptr ? pool->size() : 1;
+        const size_t trianglesPerChunk = (triangleCount + chunkCount - 1) / chunkCount;
+        std::vector<std::uint64_t> keys(cornerCount);
+        forEachChunk(pool, chunkCount, [&](size_t c) {
+            const size_t end = std::min(triangleCount, (c + 1) * trianglesPerChunk);
+            for (size_t t = c * trianglesPerChunk; t < end; ++t) {
+                const Triangle triangle = meshData.getTriangle(t);
+                for (size_t k = 0; k < 3; ++k) {
+                    const Point3D& p = triangle.vertices[k];
+                    std::uint64_t code = SpatialOrder::mortonCode(cell(p.x, box.min.x), cell(p.y, box.min.y),
+                                                                  cell(p.z, box.min.z));
+                    keys[t * 3 + k] = (code << cornerBits) | (t * 3 + k);
+                }
+            }
+        });
+        radixSortKeys(keys, cornerBits, pool);
+        
+        const std::vector<size_t> bounds = sortedRunBounds(keys, cornerBits, chunkCount);
+        std::vector<size_t> firstVertex(chunkCount + 1, 0);
+        forEachChunk(pool, chunkCount, [&](size_t c) {
+            size_t vertices = 0;
+            for (size_t i = bounds[c]; i < bounds[c + 1];) {
+                size_t j = i + 1;
+                while (j < bounds[c + 1] && (keys[j] >> cornerBits) == (keys[i] >> cornerBits)) {
+                    ++j;
+                }
+                // Usually the whole run is one vertex, already in corner order
+                const Point3D first = position(keys[i]);
+                size_t k = i + 1;
+                while (k < j && samePosition(position(keys[k]), first)) {
+                    ++k;
+                }
+                if (k < j) {
+                    std::sort(keys.begin() + i, keys.begin() + j, [&](std::uint64_t a, std::uint64_t b) {
+                        Point3D pa = position(a);
+                        Point3D pb = position(b);
+                        return samePosition(pa, pb) ? a < b : lessPosition(pa, pb);
+                    });
+                    Point3D previous = position(keys[i]);
+                    ++vertices;
+                    for (size_t m = i + 1; m < j; ++m) {
+                        Point3D current = position(keys[m]);
+                        vertices += samePosition(current, previous) ? 0 : 1;
+                        previous = current;
+                    }
+                } else {
+                    ++vertices;
+                }
+                i = j;
+            }
+            firstVertex[c + 1] = vertices;
+        });
+        for (size_t c = 0; c < chunkCount; ++c) {
+            firstVertex[c + 1] += firstVertex[c];
+        }
+        
+        const size_t vertexCount = firstVertex[chunkCount];
+        cornerVertices_.resize(cornerCount);
+        vertexCorners_.resize(cornerCount);
+        positions_.resize(vertexCount);
+        vertexCornerStart_.resize(vertexCount + 1);
+        vertexCornerStart_[vertexCount] = static_cast<Index>(cornerCount);
+        forEachChunk(pool, chunkCount, [&](size_t c) {
+            size_t vertex = firstVertex[c];
+            for (size_t i = bounds[c]; i < bounds[c + 1]; ++i) {
+                const Point3D current = position(keys[i]);
+                const bool newVertex = i == bounds[c] || (keys[i] >> cornerBits) != (keys[i - 1] >> cornerBits) ||
+                                       !samePosition(current, positions_[vertex - 1]);
+                if (newVertex) {
+                    positions_[vertex] = current;
+                    vertexCornerStart_[vertex] = static_cast<Index>(i);
+                    ++vertex;
+                }
+                const Index corner = static_cast<Index>(keys[i] & cornerMask);
+                cornerVertices_[corner] = static_cast<Index>(vertex - 1);
+                vertexCorners_[i] = corner;
+            }
+        });
+    }
+
+    /**
+     * Every edge is matched at its smaller vertex: the corners on that
+     * vertex give the corners facing each of its edges, and sorting this
+     * short list by the other end puts the corners facing one edge side by
+     * side. Vertices are independent, so ranges of them run in parallel.
+     */
+    void MeshTopology::linkEdges(ThreadPool* pool) {
+        DXF_PROFILE_SCOPE("link edges");
+        const size_t vertexCount = positions_.size();
+        const size_t chunkCount = pool != nullptr ? pool->size() : 1;
+        const size_t verticesPerChunk = (vertexCount + chunkCount - 1) / chunkCount;
+        
+        opposites_.assign(cornerVertices_.size(), NONE);
+        std::vector<EdgeCounts> counts(chunkCount);
+        forEachChunk(pool, chunkCount, [&](size_t c) {
+            EdgeCounts& edges = counts[c];
+            std::vector<std::pair<Index, Index>> facing;  // (other end, corner facing the edge)
+            const size_t end = std::min(vertexCount, (c + 1) * verticesPerChunk);
+            for (size_t v = c * verticesPerChunk; v < end; ++v) {
+                facing.clear();
+                for (Index corner : cornersAround(static_cast<Index>(v))) {
+                    const Index ahead = cornerVertices_[next(corner)];
+                    const Index behind = cornerVertices_[prev(corner)];
+                    if (ahead > v) {
+                        facing.emplace_back(ahead, prev(corner));
+                    }
+                    if (behind > v) {
+                        facing.emplace_back(behind, next(corner));
+                    }
+                }
+                std::sort(facing.begin(), facing.end());
+                
+                for (size_t g = 0; g < facing.size();) {
+                    size_t h = g + 1;
+                    while (h < facing.size() && facing[h].first == facing[g].first) {
+                        ++h;
+                    }
+                    const Index first = facing[g].second;
+                    const Index second = facing[h - 1].second;
+                    if (h - g == 1) {
+                        ++edges.boundary;
+                    } else if (h - g > 2) {
+                        ++edges.nonManifold;
+                    } else if (triangleOf(first) != triangleOf(second)) {
+                        opposites_[first] = second;
+                        opposites_[second] = first;
+                        if (cornerVertices_[next(first)] != cornerVertices_[prev(second)]) {
+                            ++edges.inconsistent;
+                        }
+                    }
+                    // Otherwise both sides of a collapsed triangle with a repeated vertex
+                    g = h;
+                }
+            }
+        });
+        
+        for (const EdgeCounts& edges : counts) {
+            boundaryEdges_ += edges.boundary;
+            nonManifoldEdges_ += edges.nonManifold;
+            inconsistentEdges_ += edges.inconsistent;
+        }
+    }
+
+} // namespace DXFProcessor
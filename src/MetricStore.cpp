@@ -0,0 +1,83 @@
+#include "MetricStore.h"
+#include <charconv>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace DXFProcessor {
+
+    MetricKey MetricKey::intern(std::string_view name) {
+        // Names live in a deque, whose elements never move, so the registry
+        // can key on views of them and a hit allocates nothing
+        static std::deque<std::string> names;
+        static std::unordered_map<std::string_view, const std::string*> registry;
+        static std::mutex mutex;
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = registry.find(name);
+        if (it == registry.end()) {
+            const std::string& stored = names.emplace_back(name);
+            it = registry.emplace(stored, &stored).first;
+        }
+        return MetricKey(it->second);
+    }
+
+    std::string metricToString(const MetricValue& value) {
+        if (const std::string* text = std::get_if<std::string>(&value)) {
+            return *text;
+        }
+        
+        char digits[32];
+        std::to_chars_result result;
+        if (const double* number = std::get_if<double>(&value)) {
+            result = std::to_chars(digits, digits + sizeof(digits), *number);
+        } else {
+            result = std::to_chars(digits, digits + sizeof(digits), std::get<std::int64_t>(value));
+        }
+        return std::string(digits, result.ptr);
+    }
+
+    void MetricStore::set(MetricKey key, MetricValue value) {
+        for (auto& entry : entries_) {
+            if (entry.key == key) {
+                entry.value = std::move(value);
+                return;
+            }
+        }
+        entries_.push_back(MetricEntry{key, std::move(value)});
+    }
+
+    const MetricValue* MetricStore::find(MetricKey key) const {
+        for (const auto& entry : entries_) {
+            if (entry.key == key) {
+                return &entry.value;
+            }
+        }
+        return nullptr;
+    }
+
+    const MetricValue* MetricStore::find(std::string_view name) const {
+        // Compare names rather than interning, so lookups never grow the registry
+        for (const auto& entry : entries_) {
+            if (entry.key.name() == name) {
+                return &entry.value;
+            }
+        }
+        return nullptr;
+    }
+
+    double MetricStore::getNumber(std::string_view name, double fallback) const {
+        const MetricValue* value = find(name);
+        if (value == nullptr) {
+            return fallback;
+        }
+        if (const double* number = std::get_if<double>(value)) {
+            return *number;
+        }
+        if (const std::int64_t* count = std::get_if<std::int64_t>(value)) {
+            return static_cast<double>(*count);
+        }
+        return fallback;
+    }
+
+} // namespace DXFProcessor
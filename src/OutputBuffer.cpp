@@ -0,0 +1,146 @@
+#include "OutputBuffer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace DXFProcessor {
+
+    void OutputBuffer::reserve(size_t capacity) {
+        if (capacity <= capacity_) {
+            return;
+        }
+        std::unique_ptr<char[]> data(new char[capacity]);
+        if (size_ > 0) {
+            std::memcpy(data.get(), data_.get(), size_);
+        }
+        data_ = std::move(data);
+        capacity_ = capacity;
+    }
+
+    void OutputBuffer::appendJSONNumber(double value) {
+        if (std::isfinite(value)) {
+            appendNumber(value);
+        } else {
+            append("null");
+        }
+    }
+
+    void OutputBuffer::appendJSONString(std::string_view text) {
+        static const char hex[] = "0123456789abcdef";
+        
+        append('"');
+        size_t runStart = 0;
+        for (size_t i = 0; i < text.size(); ++i) {
+            unsigned char c = static_cast<unsigned char>(text[i]);
+            if (c >= 0x20 && c != '"' && c != '\\') {
+                continue;
+            }
+            append(text.substr(runStart, i - runStart));
+            runStart = i + 1;
+            switch (c) {
+                case '"': append("\\\""); break;
+                case '\\': append("\\\\"); break;
+                case '\n': append("\\n"); break;
+                case '\r': append("\\r"); break;
+                case '\t': append("\\t"); break;
+                default: {
+                    char escaped[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+                    append(std::string_view(escaped, sizeof(escaped)));
+                    break;
+                }
+            }
+        }
+        append(text.substr(runStart));
+        append('"');
+    }
+
+    void OutputBuffer::appendCSVField(std::string_view text) {
+        if (text.find_first_of(",\"\r\n") == std::string_view::npos) {
+            append(text);
+            return;
+        }
+        append('"');
+        for (char c : text) {
+            if (c == '"') {
+                append('"');
+            }
+            append(c);
+        }
+        append('"');
+    }
+
+    void OutputBuffer::appendPadded(std::string_view text, size_t width, bool leftAlign) {
+        size_t padding = text.size() < width ? width - text.size() : 0;
+        if (!leftAlign) {
+            std::memset(grow(padding), ' ', padding);
+            size_ += padding;
+        }
+        append(text);
+        if (leftAlign) {
+            std::memset(grow(padding), ' ', padding);
+            size_ += padding;
+        }
+    }
+
+    void OutputBuffer::appendPaddedNumber(double value, size_t width) {
+        char digits[MAX_NUMBER_LENGTH];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        appendPadded(std::string_view(digits, static_cast<size_t>(result.ptr - digits)), width, false);
+    }
+
+    void OutputBuffer::appendPaddedInteger(unsigned long long value, size_t width) {
+        char digits[MAX_NUMBER_LENGTH];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        appendPadded(std::string_view(digits, static_cast<size_t>(result.ptr - digits)), width, false);
+    }
+
+    bool OutputBuffer::writeTo(const std::filesystem::path& path) const {
+#ifdef _WIN32
+        std::FILE* file = _wfopen(path.c_str(), L"wb");
+#else
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+#endif
+        if (file == nullptr) {
+            return false;
+        }
+        bool written = size_ == 0 || std::fwrite(data_.get(), 1, size_, file) == size_;
+        return (std::fclose(file) == 0) && written;
+    }
+
+    bool isJSONNumber(std::string_view text) {
+        size_t i = 0;
+        const size_t n = text.size();
+        auto isDigit = [&](size_t index) { return index < n && text[index] >= '0' && text[index] <= '9'; };
+        
+        if (i < n && text[i] == '-') {
+            ++i;
+        }
+        if (!isDigit(i)) {
+            return false;
+        }
+        if (text[i] == '0') {
+            ++i;
+        } else {
+            while (isDigit(i)) ++i;
+        }
+        if (i < n && text[i] == '.') {
+            ++i;
+            if (!isDigit(i)) {
+                return false;
+            }
+            while (isDigit(i)) ++i;
+        }
+        if (i < n && (text[i] == 'e' || text[i] == 'E')) {
+            ++i;
+            if (i < n && (text[i] == '+' || text[i] == '-')) {
+                ++i;
+            }
+            if (!isDigit(i)) {
+                return false;
+            }
+            while (isDigit(i)) ++i;
+        }
+        return i == n;
+    }
+
+} // namespace DXFProcessor
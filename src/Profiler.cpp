@@ -0,0 +1,226 @@
+#include "Profiler.h"
+#include "OutputBuffer.h"
+#include <algorithm>
+#include <charconv>
+#include <mutex>
+#include <unordered_map>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace DXFProcessor {
+
+    std::atomic<bool> Profiler::enabled_{false};
+    std::array<std::atomic<std::uint64_t>, static_cast<size_t>(ProfileCounter::Count)> Profiler::counters_{};
+
+    namespace {
+
+        struct TraceEvent {
+            const char* name;
+            unsigned thread;
+            double startMicros;
+            double durationMicros;
+        };
+        
+        /// Scope data; written only on scope exit, so a mutex is cheap enough
+        struct ProfileData {
+            std::mutex mutex;
+            Profiler::Clock::time_point origin = Profiler::Clock::now();
+            bool trace = false;
+            std::vector<ProfileScopeStats> scopes;
+            std::unordered_map<std::string_view, size_t> scopeIndex;  ///< Views of the scope name literals
+            std::vector<TraceEvent> events;
+        };
+        
+        ProfileData& profileData() {
+            static ProfileData data;
+            return data;
+        }
+        
+        /// Small sequential id per thread, used as the trace row
+        unsigned currentThreadId() {
+            static std::atomic<unsigned> nextId{0};
+            thread_local unsigned id = nextId.fetch_add(1, std::memory_order_relaxed);
+            return id;
+        }
+        
+        double microseconds(Profiler::Clock::duration duration) {
+            return std::chrono::duration<double, std::micro>(duration).count();
+        }
+        
+        void appendFixed(OutputBuffer& out, double value, int decimals, size_t width) {
+            char digits[OutputBuffer::MAX_NUMBER_LENGTH + 16];
+            auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, decimals);
+            out.appendPadded(std::string_view(digits, static_cast<size_t>(result.ptr - digits)), width, false);
+        }
+        
+        const char* const COUNTER_NAMES[] = {
+            "bytes read", "lines", "entities", "numeric conversions", "allocations"
+        };
+        static_assert(sizeof(COUNTER_NAMES) / sizeof(COUNTER_NAMES[0]) == static_cast<size_t>(ProfileCounter::Count),
+                      "one name per counter");
+
+    }
+
+    void Profiler::enable(bool trace) {
+        ProfileData& data = profileData();
+        {
+            std::lock_guard<std::mutex> lock(data.mutex);
+            data.origin = Clock::now();
+            data.trace = trace;
+            data.scopes.clear();
+            data.scopeIndex.clear();
+            data.events.clear();
+        }
+        for (auto& counter : counters_) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        enabled_.store(true, std::memory_order_release);
+    }
+
+    void Profiler::disable() {
+        enabled_.store(false, std::memory_order_release);
+    }
+
+    void Profiler::recordScope(const char* name, Clock::time_point start, Clock::time_point end) {
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        ProfileData& data = profileData();
+        std::lock_guard<std::mutex> lock(data.mutex);
+        
+        auto it = data.scopeIndex.find(name);
+        if (it == data.scopeIndex.end()) {
+            it = data.scopeIndex.emplace(name, data.scopes.size()).first;
+            data.scopes.push_back(ProfileScopeStats{name, 0, 0.0, 0.0});
+        }
+        ProfileScopeStats& stats = data.scopes[it->second];
+        ++stats.calls;
+        stats.totalSeconds += seconds;
+        stats.maxSeconds = std::max(stats.maxSeconds, seconds);
+        
+        if (data.trace) {
+            data.events.push_back(TraceEvent{name, currentThreadId(), microseconds(start - data.origin),
+                                             microseconds(end - start)});
+        }
+    }
+
+    ProfileReport Profiler::report() {
+        ProfileReport report;
+        ProfileData& data = profileData();
+        {
+            std::lock_guard<std::mutex> lock(data.mutex);
+            report.scopes = data.scopes;
+            report.wallSeconds = std::chrono::duration<double>(Clock::now() - data.origin).count();
+        }
+        for (size_t i = 0; i < counters_.size(); ++i) {
+            report.counters[i] = counters_[i].load(std::memory_order_relaxed);
+        }
+        report.peakResidentBytes = peakResidentBytes();
+        return report;
+    }
+
+    const char* Profiler::counterName(ProfileCounter which) {
+        size_t index = static_cast<size_t>(which);
+        return index < static_cast<size_t>(ProfileCounter::Count) ? COUNTER_NAMES[index] : "unknown";
+    }
+
+    void Profiler::formatTable(const ProfileReport& report, OutputBuffer& out) {
+        out.appendPadded("Scope", 24, true);
+        out.appendPadded("Calls", 10, false);
+        out.appendPadded("Total ms", 14, false);
+        out.appendPadded("Max ms", 12, false);
+        out.appendPadded("% wall", 9, false);
+        out.append('\n');
+        for (const ProfileScopeStats& scope : report.scopes) {
+            out.appendPadded(scope.name, 24, true);
+            out.appendPaddedInteger(scope.calls, 10);
+            appendFixed(out, scope.totalSeconds * 1000.0, 3, 14);
+            appendFixed(out, scope.maxSeconds * 1000.0, 3, 12);
+            appendFixed(out, report.wallSeconds > 0.0 ? 100.0 * scope.totalSeconds / report.wallSeconds : 0.0, 1, 9);
+            out.append('\n');
+        }
+        
+        out.append('\n');
+        out.appendPadded("Counter", 24, true);
+        out.appendPadded("Value", 20, false);
+        out.append('\n');
+        for (size_t i = 0; i < report.counters.size(); ++i) {
+            out.appendPadded(COUNTER_NAMES[i], 24, true);
+            out.appendPaddedInteger(report.counters[i], 20);
+            out.append('\n');
+        }
+        out.appendPadded("peak RSS (KB)", 24, true);
+        out.appendPaddedInteger(report.peakResidentBytes / 1024, 20);
+        out.append('\n');
+        out.appendPadded("wall time (ms)", 24, true);
+        appendFixed(out, report.wallSeconds * 1000.0, 3, 20);
+        out.append('\n');
+    }
+
+    void Profiler::writeChromeTrace(const std::filesystem::path& path) {
+        ProfileReport summary = report();
+        ProfileData& data = profileData();
+        
+        OutputBuffer out(64 * 1024);
+        out.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        {
+            std::lock_guard<std::mutex> lock(data.mutex);
+            for (const TraceEvent& event : data.events) {
+                out.append("{\"name\":");
+                out.appendJSONString(event.name);
+                out.append(",\"cat\":\"dxf\",\"ph\":\"X\",\"pid\":1,\"tid\":");
+                out.appendInteger(event.thread);
+                out.append(",\"ts\":");
+                out.appendJSONNumber(event.startMicros);
+                out.append(",\"dur\":");
+                out.appendJSONNumber(event.durationMicros);
+                out.append("},\n");
+            }
+        }
+        out.append("{\"name\":\"counters\",\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":");
+        out.appendJSONNumber(summary.wallSeconds * 1e6);
+        out.append(",\"args\":{");
+        for (size_t i = 0; i < summary.counters.size(); ++i) {
+            out.appendJSONString(COUNTER_NAMES[i]);
+            out.append(':');
+            out.appendInteger(summary.counters[i]);
+            out.append(',');
+        }
+        out.append("\"peak RSS bytes\":");
+        out.appendInteger(summary.peakResidentBytes);
+        out.append("}}\n]}\n");
+        
+        if (path.has_parent_path()) {
+            std::error_code error;
+            std::filesystem::create_directories(path.parent_path(), error);
+        }
+        if (!out.writeTo(path)) {
+            throw ProfilerException("Cannot write trace file: " + path.string());
+        }
+    }
+
+    std::uint64_t Profiler::peakResidentBytes() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return counters.PeakWorkingSetSize;
+        }
+        return 0;
+#else
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) {
+            return 0;
+        }
+#ifdef __APPLE__
+        return static_cast<std::uint64_t>(usage.ru_maxrss);          // bytes
+#else
+        return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;   // kilobytes
+#endif
+#endif
+    }
+
+} // namespace DXFProcessor
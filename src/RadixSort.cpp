@@ -0,0 +1,89 @@
+#include "RadixSort.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace DXFProcessor {
+
+    namespace {
+
+        constexpr int DIGIT_BITS = 11;  ///< 2048 counters (16 KB) per chunk still fit in L1
+        constexpr size_t RADIX = size_t{1} << DIGIT_BITS;
+
+    }
+
+    int bitWidth(size_t largest) {
+        int bits = 1;
+        while (bits < 64 && (largest >> bits) != 0) {
+            ++bits;
+        }
+        return bits;
+    }
+
+    void radixSortKeys(std::vector<std::uint64_t>& keys, int lowBit, ThreadPool* pool) {
+        const size_t count = keys.size();
+        if (count < 2) {
+            return;
+        }
+        const size_t chunkCount = pool != nullptr ? pool->size() : 1;
+        const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+        auto chunkRange = [&](size_t c) {
+            size_t begin = std::min(count, c * chunkSize);
+            return std::make_pair(begin, std::min(count, begin + chunkSize));
+        };
+        
+        std::vector<std::uint64_t> buffer(count);
+        std::vector<std::array<size_t, RADIX>> offsets(chunkCount);
+        for (int shift = lowBit; shift < 64; shift += DIGIT_BITS) {
+            forEachChunk(pool, chunkCount, [&](size_t c) {
+                auto& histogram = offsets[c];
+                histogram.fill(0);
+                auto [begin, end] = chunkRange(c);
+                for (size_t i = begin; i < end; ++i) {
+                    ++histogram[(keys[i] >> shift) & (RADIX - 1)];
+                }
+            });
+            
+            size_t total = 0;
+            bool allSameDigit = false;
+            for (size_t digit = 0; digit < RADIX; ++digit) {
+                size_t digitCount = 0;
+                for (size_t c = 0; c < chunkCount; ++c) {
+                    size_t n = offsets[c][digit];
+                    offsets[c][digit] = total;
+                    total += n;
+                    digitCount += n;
+                }
+                allSameDigit = allSameDigit || digitCount == count;
+            }
+            if (allSameDigit) {
+                continue;
+            }
+            
+            forEachChunk(pool, chunkCount, [&](size_t c) {
+                auto& next = offsets[c];
+                auto [begin, end] = chunkRange(c);
+                for (size_t i = begin; i < end; ++i) {
+                    buffer[next[(keys[i] >> shift) & (RADIX - 1)]++] = keys[i];
+                }
+            });
+            keys.swap(buffer);
+        }
+    }
+
+    std::vector<size_t> sortedRunBounds(const std::vector<std::uint64_t>& keys, int lowBit, size_t chunkCount) {
+        const size_t count = keys.size();
+        std::vector<size_t> bounds(chunkCount + 1, count);
+        bounds[0] = 0;
+        for (size_t c = 1; c < chunkCount; ++c) {
+            size_t bound = std::max(bounds[c - 1], c * count / chunkCount);
+            while (bound > 0 && bound < count && (keys[bound] >> lowBit) == (keys[bound - 1] >> lowBit)) {
+                ++bound;
+            }
+            bounds[c] = bound;
+        }
+        return bounds;
+    }
+
+} // namespace DXFProcessor
@@ -0,0 +1,142 @@
+#include "SpatialOrder.h"
+#include "Profiler.h"
+#include "RadixSort.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace DXFProcessor {
+
+    namespace {
+
+        /// Spreads the low 21 bits of v so two zero bits follow each one
+        std::uint64_t spreadBits(std::uint64_t v) {
+            v &= 0x1FFFFF;
+            v = (v | (v << 32)) & 0x1F00000000FFFFull;
+            v = (v | (v << 16)) & 0x1F0000FF0000FFull;
+            v = (v | (v << 8)) & 0x100F00F00F00F00Full;
+            v = (v | (v << 4)) & 0x10C30C30C30C30C3ull;
+            v = (v | (v << 2)) & 0x1249249249249249ull;
+            return v;
+        }
+    }
+
+    SpatialOrder::SpatialOrder(SpatialOrderOptions options) : options_(options) {}
+
+    std::uint64_t SpatialOrder::mortonCode(std::uint32_t x, std::uint32_t y, std::uint32_t z) {
+        return spreadBits(x) | (spreadBits(y) << 1) | (spreadBits(z) << 2);
+    }
+
+    /**
+     * @brief Skilling's transform of cell coordinates to the transposed Hilbert index
+     *
+     * The coordinates are rotated and reflected level by level into the
+     * curve's orientation, then Gray-decoded; interleaving the result with
+     * x as the most significant bit of each level gives the index.
+     * (J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707, 2004.)
+     */
+    std::uint64_t SpatialOrder::hilbertCode(std::uint32_t x, std::uint32_t y, std::uint32_t z, int bits) {
+        std::uint32_t axes[3] = {x, y, z};
+        const std::uint32_t top = std::uint32_t{1} << (bits - 1);
+        
+        for (std::uint32_t q = top; q > 1; q >>= 1) {
+            const std::uint32_t lower = q - 1;
+            for (auto& axis : axes) {
+                if (axis & q) {
+                    axes[0] ^= lower;
+                } else {
+                    std::uint32_t swap = (axes[0] ^ axis) & lower;
+                    axes[0] ^= swap;
+                    axis ^= swap;
+                }
+            }
+        }
+        
+        axes[1] ^= axes[0];
+        axes[2] ^= axes[1];
+        std::uint32_t flip = 0;
+        for (std::uint32_t q = top; q > 1; q >>= 1) {
+            if (axes[2] & q) {
+                flip ^= q - 1;
+            }
+        }
+        for (auto& axis : axes) {
+            axis ^= flip;
+        }
+        
+        return (spreadBits(axes[0]) << 2) | (spreadBits(axes[1]) << 1) | spreadBits(axes[2]);
+    }
+
+    TrianglePermutation SpatialOrder::reorder(MeshData& meshData) const {
+        DXF_PROFILE_SCOPE("spatial reorder");
+        const size_t count = meshData.getTriangleCount();
+        if (count > UINT32_MAX) {
+            throw SpatialOrderException("Meshes of 2^32 triangles or more cannot be reordered");
+        }
+        TrianglePermutation fileOrder;
+        if (count == 0) {
+            return fileOrder;
+        }
+        
+        // The triangle index fills the low bits of each key, the cell code the rest
+        const int indexBits = bitWidth(count - 1);
+        const int bitsPerAxis = std::min(MAX_BITS_PER_AXIS, (64 - indexBits) / 3);
+        const double maxCell = static_cast<double>((std::uint32_t{1} << bitsPerAxis) - 1);
+        
+        // A cube, so the curve's cells are the same size along every axis
+        const BoundingBox box = meshData.getBoundingBox();
+        const Point3D size = box.size();
+        const double extent = std::max({size.x, size.y, size.z});
+        const double scale = extent > 0.0 ? maxCell / extent : 0.0;
+        auto cell = [&](double value, double min) {
+            return static_cast<std::uint32_t>(std::clamp((value - min) * scale, 0.0, maxCell));
+        };
+        
+        PassPool pool(options_.threadPool, count, MIN_PARALLEL_TRIANGLES, options_.threadCount);
+        
+        const size_t chunkCount = pool.get() != nullptr ? pool.get()->size() : 1;
+        const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+        std::vector<std::uint64_t> keys(count);
+        forEachChunk(pool.get(), chunkCount, [&](size_t c) {
+            const size_t end = std::min(count, (c + 1) * chunkSize);
+            for (size_t i = c * chunkSize; i < end; ++i) {
+                Point3D center = meshData.getTriangle(i).center();
+                std::uint32_t x = cell(center.x, box.min.x);
+                std::uint32_t y = cell(center.y, box.min.y);
+                std::uint32_t z = cell(center.z, box.min.z);
+                std::uint64_t code = options_.curve == SpaceFillingCurve::Hilbert
+                                         ? hilbertCode(x, y, z, bitsPerAxis)
+                                         : mortonCode(x, y, z);
+                keys[i] = (code << indexBits) | i;
+            }
+        });
+        
+        radixSortKeys(keys, indexBits, pool.get());
+        
+        const std::uint64_t indexMask = (std::uint64_t{1} << indexBits) - 1;
+        fileOrder.reserve(count);
+        for (std::uint64_t key : keys) {
+            fileOrder.push_back(static_cast<std::uint32_t>(key & indexMask));
+        }
+        keys = std::vector<std::uint64_t>();
+        
+        DXF_PROFILE_SCOPE("gather triangles");
+        meshData.permute(fileOrder);
+        return fileOrder;
+    }
+
+    void SpatialOrder::restore(MeshData& meshData, const TrianglePermutation& fileOrder) {
+        const size_t count = meshData.getTriangleCount();
+        if (fileOrder.size() != count) {
+            throw std::invalid_argument("Permutation size does not match the triangle count");
+        }
+        TrianglePermutation inverse;
+        inverse.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            inverse.at(fileOrder[i]) = static_cast<std::uint32_t>(i);
+        }
+        meshData.permute(inverse);
+    }
+
+} // namespace DXFProcessor
@@ -1,9 +1,9 @@
 #include "SummaryWriter.h"
-#include <fstream>
+#include "Profiler.h"
 #include <sstream>
 #include <iomanip>
 #include <chrono>
-#include <iostream>
+#include <ctime>
 
 namespace DXFProcessor {
 
@@ -18,32 +18,54 @@ namespace DXFProcessor {
     std::string SummaryWriter::writeToFile(const MeshSummary& summary, const std::string& baseName) {
         ensureOutputDirectoryExists();
         
-        std::string content;
-        std::string extension = getFileExtension(format_);
+        buffer_.clear();
+        format(summary, buffer_);
+        return writeBuffer(baseName);
+    }
+
+    std::string SummaryWriter::writeHeaderToFile(const DXFHeaderInfo& header, const std::string& baseName) {
+        ensureOutputDirectoryExists();
         
+        buffer_.clear();
         switch (format_) {
             case OutputFormat::JSON:
-                content = formatAsJSON(summary);
+                formatHeaderAsJSON(header, buffer_);
                 break;
             case OutputFormat::TEXT:
-                content = formatAsText(summary);
+                formatHeaderAsText(header, buffer_);
                 break;
             case OutputFormat::CSV:
-                content = formatAsCSV(summary);
+                formatHeaderAsCSV(header, buffer_);
                 break;
         }
         
-        std::string filename = generateFilename(baseName, extension);
+        return writeBuffer(baseName);
+    }
+
+    void SummaryWriter::format(const MeshSummary& summary, OutputBuffer& out) {
+        DXF_PROFILE_SCOPE("format");
+        switch (format_) {
+            case OutputFormat::JSON:
+                formatAsJSON(summary, out);
+                break;
+            case OutputFormat::TEXT:
+                formatAsText(summary, out);
+                break;
+            case OutputFormat::CSV:
+                formatAsCSV(summary, out);
+                break;
+        }
+    }
+
+    std::string SummaryWriter::writeBuffer(const std::string& baseName) {
+        DXF_PROFILE_SCOPE("write");
+        std::string filename = generateFilename(baseName, getFileExtension(format_));
         std::filesystem::path fullPath = outputDirectory_ / filename;
         
-        std::ofstream file(fullPath);
-        if (!file.is_open()) {
+        if (!buffer_.writeTo(fullPath)) {
             throw SummaryWriterException("Cannot create output file: " + fullPath.string());
         }
         
-        file << content;
-        file.close();
-        
         lastOutputPath_ = std::filesystem::absolute(fullPath).string();
         return lastOutputPath_;
     }
@@ -58,154 +80,557 @@ namespace DXFProcessor {
         format_ = format;
     }
 
-    std::string SummaryWriter::formatAsJSON(const MeshSummary& summary) {
-        std::ostringstream json;
+    namespace {
+
+        // Thread-safe localtime/gmtime: batch jobs format summaries concurrently
+        std::tm toCalendarTime(std::time_t time, bool utc) {
+            std::tm calendar{};
+#ifdef _WIN32
+            utc ? gmtime_s(&calendar, &time) : localtime_s(&calendar, &time);
+#else
+            utc ? gmtime_r(&time, &calendar) : localtime_r(&time, &calendar);
+#endif
+            return calendar;
+        }
+        
+        // Appends {"x": .., "y": .., "z": ..} on one line
+        void appendJSONPoint(OutputBuffer& out, const Point3D& point, bool pretty) {
+            out.append(pretty ? "{\"x\": " : "{\"x\":");
+            out.appendJSONNumber(point.x);
+            out.append(pretty ? ", \"y\": " : ",\"y\":");
+            out.appendJSONNumber(point.y);
+            out.append(pretty ? ", \"z\": " : ",\"z\":");
+            out.appendJSONNumber(point.z);
+            out.append('}');
+        }
+        
+        // Appends one object of the "layers" or "components" array on one line; volume only if given
+        void appendJSONGroup(OutputBuffer& out, const GroupSummary& group, bool pretty, const double* volume = nullptr) {
+            const std::string_view sep = pretty ? ": " : ":";
+            const std::string_view comma = pretty ? ", " : ",";
+            
+            out.append("{\"name\"");
+            out.append(sep);
+            out.appendJSONString(group.name);
+            out.append(comma);
+            out.append("\"triangle_count\"");
+            out.append(sep);
+            out.appendInteger(group.triangleCount);
+            out.append(comma);
+            out.append("\"total_surface_area\"");
+            out.append(sep);
+            out.appendJSONNumber(group.totalSurfaceArea);
+            out.append(comma);
+            if (volume != nullptr) {
+                out.append("\"volume\"");
+                out.append(sep);
+                out.appendJSONNumber(*volume);
+                out.append(comma);
+            }
+            out.append("\"bounding_box\"");
+            out.append(sep);
+            out.append("{\"min\"");
+            out.append(sep);
+            appendJSONPoint(out, group.boundingBox.min, pretty);
+            out.append(comma);
+            out.append("\"max\"");
+            out.append(sep);
+            appendJSONPoint(out, group.boundingBox.max, pretty);
+            out.append('}');
+            out.append(comma);
+            out.append("\"centroid\"");
+            out.append(sep);
+            appendJSONPoint(out, group.centroid, pretty);
+            out.append('}');
+        }
         
+        enum class MetricSyntax { JSON, Text, CSV };
+        
+        // Appends a typed metric; numbers are written directly, text is escaped per syntax
+        void appendMetric(OutputBuffer& out, const MetricValue& value, MetricSyntax syntax) {
+            if (const double* number = std::get_if<double>(&value)) {
+                if (syntax == MetricSyntax::JSON) {
+                    out.appendJSONNumber(*number);
+                } else {
+                    out.appendNumber(*number);
+                }
+            } else if (const std::int64_t* count = std::get_if<std::int64_t>(&value)) {
+                out.appendInteger(*count);
+            } else {
+                const std::string& text = std::get<std::string>(value);
+                switch (syntax) {
+                    case MetricSyntax::JSON:
+                        // Numeric text from addCustomField is already a valid JSON literal
+                        if (isJSONNumber(text)) {
+                            out.append(text);
+                        } else {
+                            out.appendJSONString(text);
+                        }
+                        break;
+                    case MetricSyntax::Text:
+                        out.append(text);
+                        break;
+                    case MetricSyntax::CSV:
+                        out.appendCSVField(text);
+                        break;
+                }
+            }
+        }
+        
+        // Appends "(x, y, z)"
+        void appendTextPoint(OutputBuffer& out, const Point3D& point) {
+            out.append('(');
+            out.appendNumber(point.x);
+            out.append(", ");
+            out.appendNumber(point.y);
+            out.append(", ");
+            out.appendNumber(point.z);
+            out.append(')');
+        }
+        
+        // Appends "name,value\n" with the value as a number
+        void appendCSVRow(OutputBuffer& out, std::string_view name, double value) {
+            out.append(name);
+            out.append(',');
+            out.appendNumber(value);
+            out.append('\n');
+        }
+        
+        // Appends "    \"name\": value,\n" for the pretty JSON layout
+        void appendJSONMember(OutputBuffer& out, std::string_view indent, std::string_view name,
+                              double value, bool last = false) {
+            out.append(indent);
+            out.append('"');
+            out.append(name);
+            out.append("\": ");
+            out.appendJSONNumber(value);
+            out.append(last ? "\n" : ",\n");
+        }
+
+    } // namespace
+
+    void SummaryWriter::formatAsJSON(const MeshSummary& summary, OutputBuffer& out) {
         if (prettyPrint_) {
-            json << "{\n";
-            json << "  \"triangle_count\": " << summary.triangleCount << ",\n";
-            json << "  \"total_surface_area\": " << std::fixed << std::setprecision(6) 
-                 << summary.totalSurfaceArea << ",\n";
+            out.append("{\n");
+            out.append("  \"triangle_count\": ");
+            out.appendInteger(summary.triangleCount);
+            out.append(",\n");
+            appendJSONMember(out, "  ", "total_surface_area", summary.totalSurfaceArea);
             
-            json << "  \"bounding_box\": {\n";
-            json << "    \"min\": {\n";
-            json << "      \"x\": " << summary.boundingBox.min.x << ",\n";
-            json << "      \"y\": " << summary.boundingBox.min.y << ",\n";
-            json << "      \"z\": " << summary.boundingBox.min.z << "\n";
-            json << "    },\n";
-            json << "    \"max\": {\n";
-            json << "      \"x\": " << summary.boundingBox.max.x << ",\n";
-            json << "      \"y\": " << summary.boundingBox.max.y << ",\n";
-            json << "      \"z\": " << summary.boundingBox.max.z << "\n";
-            json << "    },\n";
-            json << "    \"size\": {\n";
+            out.append("  \"bounding_box\": {\n");
+            out.append("    \"min\": {\n");
+            appendJSONMember(out, "      ", "x", summary.boundingBox.min.x);
+            appendJSONMember(out, "      ", "y", summary.boundingBox.min.y);
+            appendJSONMember(out, "      ", "z", summary.boundingBox.min.z, true);
+            out.append("    },\n");
+            out.append("    \"max\": {\n");
+            appendJSONMember(out, "      ", "x", summary.boundingBox.max.x);
+            appendJSONMember(out, "      ", "y", summary.boundingBox.max.y);
+            appendJSONMember(out, "      ", "z", summary.boundingBox.max.z, true);
+            out.append("    },\n");
+            out.append("    \"size\": {\n");
             Point3D size = summary.boundingBox.size();
-            json << "      \"width\": " << size.x << ",\n";
-            json << "      \"height\": " << size.y << ",\n";
-            json << "      \"depth\": " << size.z << "\n";
-            json << "    }\n";
-            json << "  },\n";
+            appendJSONMember(out, "      ", "width", size.x);
+            appendJSONMember(out, "      ", "height", size.y);
+            appendJSONMember(out, "      ", "depth", size.z, true);
+            out.append("    }\n");
+            out.append("  },\n");
             
-            json << "  \"centroid\": {\n";
-            json << "    \"x\": " << summary.centroid.x << ",\n";
-            json << "    \"y\": " << summary.centroid.y << ",\n";
-            json << "    \"z\": " << summary.centroid.z << "\n";
-            json << "  }";
+            out.append("  \"centroid\": {\n");
+            appendJSONMember(out, "    ", "x", summary.centroid.x);
+            appendJSONMember(out, "    ", "y", summary.centroid.y);
+            appendJSONMember(out, "    ", "z", summary.centroid.z, true);
+            out.append("  }");
             
             if (!summary.customFields.empty()) {
-                json << ",\n  \"custom_fields\": {\n";
+                out.append(",\n  \"custom_fields\": {\n");
                 size_t count = 0;
                 for (const auto& [key, value] : summary.customFields) {
-                    json << "    \"" << key << "\": ";
-                    
-                    try {
-                        double numValue = std::stod(value);
-                        json << std::fixed << std::setprecision(6) << numValue;
-                    } catch (const std::exception&) {
-                        json << "\"" << value << "\"";
-                    }
-                    
-                    if (++count < summary.customFields.size()) {
-                        json << ",";
-                    }
-                    json << "\n";
+                    out.append("    ");
+                    out.appendJSONString(key.name());
+                    out.append(": ");
+                    appendMetric(out, value, MetricSyntax::JSON);
+                    out.append(++count < summary.customFields.size() ? ",\n" : "\n");
+                }
+                out.append("  }");
+            }
+            
+            if (!summary.layers.empty()) {
+                out.append(",\n  \"layers\": [\n");
+                for (size_t i = 0; i < summary.layers.size(); ++i) {
+                    out.append("    ");
+                    appendJSONGroup(out, summary.layers[i], true);
+                    out.append(i + 1 < summary.layers.size() ? ",\n" : "\n");
                 }
-                json << "  }";
+                out.append("  ]");
+            }
+            
+            if (!summary.components.empty()) {
+                out.append(",\n  \"components\": [\n");
+                for (size_t i = 0; i < summary.components.size(); ++i) {
+                    out.append("    ");
+                    appendJSONGroup(out, summary.components[i], true, &summary.components[i].volume);
+                    out.append(i + 1 < summary.components.size() ? ",\n" : "\n");
+                }
+                out.append("  ]");
             }
             
             if (includeTimestamp_) {
-                json << ",\n  \"timestamp\": \"" << getCurrentTimestamp() << "\"";
+                out.append(",\n  \"timestamp\": \"");
+                appendTimestamp(out);
+                out.append('"');
             }
             
-            json << "\n}";
+            out.append("\n}");
         } else {
-            json << "{\"triangle_count\":" << summary.triangleCount
-                 << ",\"total_surface_area\":" << summary.totalSurfaceArea
-                 << ",\"bounding_box\":{\"min\":{\"x\":" << summary.boundingBox.min.x
-                 << ",\"y\":" << summary.boundingBox.min.y << ",\"z\":" << summary.boundingBox.min.z
-                 << "},\"max\":{\"x\":" << summary.boundingBox.max.x
-                 << ",\"y\":" << summary.boundingBox.max.y << ",\"z\":" << summary.boundingBox.max.z
-                 << "}},\"centroid\":{\"x\":" << summary.centroid.x
-                 << ",\"y\":" << summary.centroid.y << ",\"z\":" << summary.centroid.z << "}}";
+            out.append("{\"triangle_count\":");
+            out.appendInteger(summary.triangleCount);
+            out.append(",\"total_surface_area\":");
+            out.appendJSONNumber(summary.totalSurfaceArea);
+            out.append(",\"bounding_box\":{\"min\":");
+            appendJSONPoint(out, summary.boundingBox.min, false);
+            out.append(",\"max\":");
+            appendJSONPoint(out, summary.boundingBox.max, false);
+            out.append("},\"centroid\":");
+            appendJSONPoint(out, summary.centroid, false);
+            
+            if (!summary.layers.empty()) {
+                out.append(",\"layers\":[");
+                for (size_t i = 0; i < summary.layers.size(); ++i) {
+                    if (i > 0) {
+                        out.append(',');
+                    }
+                    appendJSONGroup(out, summary.layers[i], false);
+                }
+                out.append(']');
+            }
+            
+            if (!summary.components.empty()) {
+                out.append(",\"components\":[");
+                for (size_t i = 0; i < summary.components.size(); ++i) {
+                    if (i > 0) {
+                        out.append(',');
+                    }
+                    appendJSONGroup(out, summary.components[i], false, &summary.components[i].volume);
+                }
+                out.append(']');
+            }
+            
+            out.append('}');
         }
-        
-        return json.str();
     }
 
-    std::string SummaryWriter::formatAsText(const MeshSummary& summary) {
-        std::ostringstream text;
-        
-        text << "DXF Mesh Summary\n";
-        text << "================\n\n";
+    void SummaryWriter::formatAsText(const MeshSummary& summary, OutputBuffer& out) {
+        out.append("DXF Mesh Summary\n");
+        out.append("================\n\n");
         
         if (includeTimestamp_) {
-            text << "Generated: " << getCurrentTimestamp() << "\n\n";
+            out.append("Generated: ");
+            appendTimestamp(out);
+            out.append("\n\n");
         }
         
-        text << "Basic Statistics:\n";
-        text << "-----------------\n";
-        text << "Triangle Count: " << summary.triangleCount << "\n";
-        text << "Total Surface Area: " << std::fixed << std::setprecision(6) 
-             << summary.totalSurfaceArea << "\n\n";
+        out.append("Basic Statistics:\n");
+        out.append("-----------------\n");
+        out.append("Triangle Count: ");
+        out.appendInteger(summary.triangleCount);
+        out.append("\nTotal Surface Area: ");
+        out.appendNumber(summary.totalSurfaceArea);
+        out.append("\n\n");
         
-        text << "Bounding Box:\n";
-        text << "-------------\n";
-        text << "Min Point: (" << summary.boundingBox.min.x << ", " 
-             << summary.boundingBox.min.y << ", " << summary.boundingBox.min.z << ")\n";
-        text << "Max Point: (" << summary.boundingBox.max.x << ", " 
-             << summary.boundingBox.max.y << ", " << summary.boundingBox.max.z << ")\n";
+        out.append("Bounding Box:\n");
+        out.append("-------------\n");
+        out.append("Min Point: ");
+        appendTextPoint(out, summary.boundingBox.min);
+        out.append("\nMax Point: ");
+        appendTextPoint(out, summary.boundingBox.max);
         
         Point3D size = summary.boundingBox.size();
-        text << "Dimensions: " << size.x << " x " << size.y << " x " << size.z << "\n";
-        text << "Volume: " << summary.boundingBox.volume() << "\n\n";
+        out.append("\nDimensions: ");
+        out.appendNumber(size.x);
+        out.append(" x ");
+        out.appendNumber(size.y);
+        out.append(" x ");
+        out.appendNumber(size.z);
+        out.append("\nVolume: ");
+        out.appendNumber(summary.boundingBox.volume());
+        out.append("\n\n");
         
-        text << "Centroid: (" << summary.centroid.x << ", " 
-             << summary.centroid.y << ", " << summary.centroid.z << ")\n\n";
+        out.append("Centroid: ");
+        appendTextPoint(out, summary.centroid);
+        out.append("\n\n");
         
         if (!summary.customFields.empty()) {
-            text << "Additional Properties:\n";
-            text << "---------------------\n";
+            out.append("Additional Properties:\n");
+            out.append("---------------------\n");
             for (const auto& [key, value] : summary.customFields) {
-                text << key << ": " << value << "\n";
+                out.append(key.name());
+                out.append(": ");
+                appendMetric(out, value, MetricSyntax::Text);
+                out.append('\n');
+            }
+        }
+        
+        if (!summary.layers.empty()) {
+            out.append("\nLayers:\n");
+            out.append("-------\n");
+            out.appendPadded("Layer", 24, true);
+            out.appendPadded("Triangles", 12, false);
+            out.appendPadded("Surface Area", 20, false);
+            out.append("  Bounding Box / Centroid\n");
+            for (const auto& layer : summary.layers) {
+                out.appendPadded(layer.name, 24, true);
+                out.appendPaddedInteger(layer.triangleCount, 12);
+                out.appendPaddedNumber(layer.totalSurfaceArea, 20);
+                out.append("  ");
+                appendTextPoint(out, layer.boundingBox.min);
+                out.append(" to ");
+                appendTextPoint(out, layer.boundingBox.max);
+                out.append(" / ");
+                appendTextPoint(out, layer.centroid);
+                out.append('\n');
             }
         }
         
-        return text.str();
+        if (!summary.components.empty()) {
+            out.append("\nComponents:\n");
+            out.append("-----------\n");
+            out.appendPadded("Component", 24, true);
+            out.appendPadded("Triangles", 12, false);
+            out.appendPadded("Surface Area", 20, false);
+            out.appendPadded("Volume", 20, false);
+            out.append("  Bounding Box / Centroid\n");
+            for (const auto& component : summary.components) {
+                out.appendPadded(component.name, 24, true);
+                out.appendPaddedInteger(component.triangleCount, 12);
+                out.appendPaddedNumber(component.totalSurfaceArea, 20);
+                out.appendPaddedNumber(component.volume, 20);
+                out.append("  ");
+                appendTextPoint(out, component.boundingBox.min);
+                out.append(" to ");
+                appendTextPoint(out, component.boundingBox.max);
+                out.append(" / ");
+                appendTextPoint(out, component.centroid);
+                out.append('\n');
+            }
+        }
     }
 
-    std::string SummaryWriter::formatAsCSV(const MeshSummary& summary) {
-        std::ostringstream csv;
-        
-        csv << "Property,Value\n";
-        csv << "triangle_count," << summary.triangleCount << "\n";
-        csv << "total_surface_area," << std::fixed << std::setprecision(6) 
-            << summary.totalSurfaceArea << "\n";
-        csv << "bounding_box_min_x," << summary.boundingBox.min.x << "\n";
-        csv << "bounding_box_min_y," << summary.boundingBox.min.y << "\n";
-        csv << "bounding_box_min_z," << summary.boundingBox.min.z << "\n";
-        csv << "bounding_box_max_x," << summary.boundingBox.max.x << "\n";
-        csv << "bounding_box_max_y," << summary.boundingBox.max.y << "\n";
-        csv << "bounding_box_max_z," << summary.boundingBox.max.z << "\n";
+    void SummaryWriter::formatAsCSV(const MeshSummary& summary, OutputBuffer& out) {
+        out.append("Property,Value\n");
+        out.append("triangle_count,");
+        out.appendInteger(summary.triangleCount);
+        out.append('\n');
+        appendCSVRow(out, "total_surface_area", summary.totalSurfaceArea);
+        appendCSVRow(out, "bounding_box_min_x", summary.boundingBox.min.x);
+        appendCSVRow(out, "bounding_box_min_y", summary.boundingBox.min.y);
+        appendCSVRow(out, "bounding_box_min_z", summary.boundingBox.min.z);
+        appendCSVRow(out, "bounding_box_max_x", summary.boundingBox.max.x);
+        appendCSVRow(out, "bounding_box_max_y", summary.boundingBox.max.y);
+        appendCSVRow(out, "bounding_box_max_z", summary.boundingBox.max.z);
         
         Point3D size = summary.boundingBox.size();
-        csv << "width," << size.x << "\n";
-        csv << "height," << size.y << "\n";
-        csv << "depth," << size.z << "\n";
-        csv << "volume," << summary.boundingBox.volume() << "\n";
+        appendCSVRow(out, "width", size.x);
+        appendCSVRow(out, "height", size.y);
+        appendCSVRow(out, "depth", size.z);
+        appendCSVRow(out, "volume", summary.boundingBox.volume());
         
-        csv << "centroid_x," << summary.centroid.x << "\n";
-        csv << "centroid_y," << summary.centroid.y << "\n";
-        csv << "centroid_z," << summary.centroid.z << "\n";
+        appendCSVRow(out, "centroid_x", summary.centroid.x);
+        appendCSVRow(out, "centroid_y", summary.centroid.y);
+        appendCSVRow(out, "centroid_z", summary.centroid.z);
         
         for (const auto& [key, value] : summary.customFields) {
-            csv << key << "," << value << "\n";
+            out.appendCSVField(key.name());
+            out.append(',');
+            appendMetric(out, value, MetricSyntax::CSV);
+            out.append('\n');
         }
         
         if (includeTimestamp_) {
-            csv << "timestamp," << getCurrentTimestamp() << "\n";
+            out.append("timestamp,");
+            appendTimestamp(out);
+            out.append('\n');
+        }
+        
+        if (!summary.layers.empty()) {
+            out.append("\nlayer,triangle_count,total_surface_area,"
+                       "bounding_box_min_x,bounding_box_min_y,bounding_box_min_z,"
+                       "bounding_box_max_x,bounding_box_max_y,bounding_box_max_z,"
+                       "centroid_x,centroid_y,centroid_z\n");
+            for (const auto& layer : summary.layers) {
+                out.appendCSVField(layer.name);
+                out.append(',');
+                out.appendInteger(layer.triangleCount);
+                const double values[] = {
+                    layer.totalSurfaceArea,
+                    layer.boundingBox.min.x, layer.boundingBox.min.y, layer.boundingBox.min.z,
+                    layer.boundingBox.max.x, layer.boundingBox.max.y, layer.boundingBox.max.z,
+                    layer.centroid.x, layer.centroid.y, layer.centroid.z
+                };
+                for (double value : values) {
+                    out.append(',');
+                    out.appendNumber(value);
+                }
+                out.append('\n');
+            }
         }
         
-        return csv.str();
+        if (!summary.components.empty()) {
+            out.append("\ncomponent,triangle_count,total_surface_area,volume,"
+                       "bounding_box_min_x,bounding_box_min_y,bounding_box_min_z,"
+                       "bounding_box_max_x,bounding_box_max_y,bounding_box_max_z,"
+                       "centroid_x,centroid_y,centroid_z\n");
+            for (const auto& component : summary.components) {
+                out.appendCSVField(component.name);
+                out.append(',');
+                out.appendInteger(component.triangleCount);
+                const double values[] = {
+                    component.totalSurfaceArea, component.volume,
+                    component.boundingBox.min.x, component.boundingBox.min.y, component.boundingBox.min.z,
+                    component.boundingBox.max.x, component.boundingBox.max.y, component.boundingBox.max.z,
+                    component.centroid.x, component.centroid.y, component.centroid.z
+                };
+                for (double value : values) {
+                    out.append(',');
+                    out.appendNumber(value);
+                }
+                out.append('\n');
+            }
+        }
+    }
+
+    void SummaryWriter::formatHeaderAsJSON(const DXFHeaderInfo& header, OutputBuffer& out) {
+        const std::string_view nl = prettyPrint_ ? "\n" : "";
+        const std::string_view indent = prettyPrint_ ? "  " : "";
+        const std::string_view sep = prettyPrint_ ? ": " : ":";
+        
+        auto member = [&](std::string_view name) {
+            out.append(indent);
+            out.append('"');
+            out.append(name);
+            out.append('"');
+            out.append(sep);
+        };
+        auto next = [&]() {
+            out.append(',');
+            out.append(nl);
+        };
+        
+        out.append('{');
+        out.append(nl);
+        member("source");
+        out.append("\"header\"");
+        next();
+        member("recomputed");
+        out.append("false");
+        next();
+        member("note");
+        out.appendJSONString(HEADER_ONLY_NOTE);
+        next();
+        member("acad_version");
+        out.appendJSONString(header.acadVersion);
+        next();
+        member("units");
+        out.appendJSONString(header.unitsName());
+        next();
+        member("insunits");
+        out.appendInteger(header.insUnits);
+        next();
+        member("file_size");
+        out.appendInteger(header.fileSize);
+        next();
+        member("estimated_entity_count");
+        out.appendInteger(header.estimatedEntityCount);
+        next();
+        member("extents");
+        if (header.hasExtents) {
+            out.append("{\"min\":");
+            appendJSONPoint(out, header.extents.min, false);
+            out.append(",\"max\":");
+            appendJSONPoint(out, header.extents.max, false);
+            out.append('}');
+        } else {
+            out.append("null");
+        }
+        
+        if (includeTimestamp_) {
+            next();
+            member("timestamp");
+            out.append('"');
+            appendTimestamp(out);
+            out.append('"');
+        }
+        
+        out.append(nl);
+        out.append('}');
+    }
+
+    void SummaryWriter::formatHeaderAsText(const DXFHeaderInfo& header, OutputBuffer& out) {
+        out.append("DXF Header Summary\n");
+        out.append("==================\n\n");
+        out.append("NOTE: ");
+        out.append(HEADER_ONLY_NOTE);
+        out.append(".\n\n");
+        
+        if (includeTimestamp_) {
+            out.append("Generated: ");
+            appendTimestamp(out);
+            out.append("\n\n");
+        }
+        
+        out.append("AutoCAD Version: ");
+        out.append(header.acadVersion);
+        out.append("\nUnits: ");
+        out.append(header.unitsName());
+        out.append(" ($INSUNITS ");
+        out.appendInteger(header.insUnits);
+        out.append(")\nFile Size: ");
+        out.appendInteger(header.fileSize);
+        out.append(" bytes\nEstimated Entity Count: ~");
+        out.appendInteger(header.estimatedEntityCount);
+        out.append('\n');
+        
+        if (header.hasExtents) {
+            out.append("Header Extents Min: ");
+            appendTextPoint(out, header.extents.min);
+            out.append("\nHeader Extents Max: ");
+            appendTextPoint(out, header.extents.max);
+            out.append('\n');
+        } else {
+            out.append("Header Extents: not present\n");
+        }
+    }
+
+    void SummaryWriter::formatHeaderAsCSV(const DXFHeaderInfo& header, OutputBuffer& out) {
+        out.append("Property,Value\n");
+        out.append("source,header\n");
+        out.append("recomputed,false\n");
+        out.append("note,");
+        out.appendCSVField(HEADER_ONLY_NOTE);
+        out.append("\nacad_version,");
+        out.appendCSVField(header.acadVersion);
+        out.append("\nunits,");
+        out.append(header.unitsName());
+        out.append("\nfile_size,");
+        out.appendInteger(header.fileSize);
+        out.append("\nestimated_entity_count,");
+        out.appendInteger(header.estimatedEntityCount);
+        out.append('\n');
+        
+        if (header.hasExtents) {
+            appendCSVRow(out, "extents_min_x", header.extents.min.x);
+            appendCSVRow(out, "extents_min_y", header.extents.min.y);
+            appendCSVRow(out, "extents_min_z", header.extents.min.z);
+            appendCSVRow(out, "extents_max_x", header.extents.max.x);
+            appendCSVRow(out, "extents_max_y", header.extents.max.y);
+            appendCSVRow(out, "extents_max_z", header.extents.max.z);
+        }
+        
+        if (includeTimestamp_) {
+            out.append("timestamp,");
+            appendTimestamp(out);
+            out.append('\n');
+        }
     }
 
     std::string SummaryWriter::generateFilename(const std::string& baseName, const std::string& extension) {
@@ -218,7 +643,8 @@ namespace DXFProcessor {
             auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
                 now.time_since_epoch()) % 1000;
             
-            filename << "_" << std::put_time(std::localtime(&time_t), "%Y%m%d_%H%M%S");
+            std::tm local = toCalendarTime(time_t, false);
+            filename << "_" << std::put_time(&local, "%Y%m%d_%H%M%S");
             filename << "_" << std::setfill('0') << std::setw(3) << ms.count();
         }
         
@@ -237,13 +663,14 @@ namespace DXFProcessor {
         validateOutputDirectory(outputDirectory_);
     }
 
-    std::string SummaryWriter::getCurrentTimestamp() {
+    void SummaryWriter::appendTimestamp(OutputBuffer& out) {
         auto now = std::chrono::system_clock::now();
         auto time_t = std::chrono::system_clock::to_time_t(now);
         
-        std::ostringstream timestamp;
-        timestamp << std::put_time(std::gmtime(&time_t), "%Y-%m-%dT%H:%M:%SZ");
-        return timestamp.str();
+        std::tm utc = toCalendarTime(time_t, true);
+        char timestamp[32];
+        size_t length = std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", &utc);
+        out.append(std::string_view(timestamp, length));
     }
 
     std::string SummaryWriter::getFileExtension(OutputFormat format) {
@@ -0,0 +1,230 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+namespace DXFProcessor {
+
+    namespace {
+        // Pool and worker index of the calling thread, set once per worker
+        thread_local const ThreadPool* currentPool = nullptr;
+        thread_local size_t currentIndex = 0;
+    }
+
+    ThreadPool::ThreadPool(size_t threadCount) {
+        if (threadCount == 0) {
+            threadCount = defaultThreadCount();
+        }
+        
+        queues_.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i) {
+            queues_.push_back(std::make_unique<WorkerQueue>());
+        }
+        workers_.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i) {
+            workers_.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            stopping_ = true;
+        }
+        wakeUp_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    size_t ThreadPool::defaultThreadCount() {
+        unsigned count = std::thread::hardware_concurrency();
+        return count > 0 ? count : 1;
+    }
+
+    size_t ThreadPool::currentWorker() const {
+        return currentPool == this ? currentIndex : workers_.size();
+    }
+
+    void ThreadPool::submit(Task task) {
+        push(std::move(task), nullptr);
+    }
+
+    void ThreadPool::push(Task task, const TaskGroup* group) {
+        const size_t index = currentWorker();
+        WorkerQueue& queue = index < queues_.size() ? *queues_[index] : shared_;
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(QueuedTask{std::move(task), group});
+        }
+        queuedTasks_.fetch_add(1, std::memory_order_release);
+        
+        // Taking the lock orders the count update before a sleeper's predicate check
+        { std::lock_guard<std::mutex> lock(sleepMutex_); }
+        wakeUp_.notify_one();
+    }
+
+    bool ThreadPool::popTask(size_t index, Task& task, const TaskGroup* group) {
+        const size_t count = queues_.size();
+        
+        // Takes the newest or oldest task of a deque that the caller may run
+        auto take = [&](WorkerQueue& queue, bool newest) {
+            auto allowed = [group](const QueuedTask& queued) { return group == nullptr || queued.group == group; };
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            std::deque<QueuedTask>& tasks = queue.tasks;
+            auto it = tasks.end();
+            if (newest) {
+                auto found = std::find_if(tasks.rbegin(), tasks.rend(), allowed);
+                if (found != tasks.rend()) {
+                    it = std::prev(found.base());
+                }
+            } else {
+                it = std::find_if(tasks.begin(), tasks.end(), allowed);
+            }
+            if (it == tasks.end()) {
+                return false;
+            }
+            task = std::move(it->run);
+            tasks.erase(it);
+            queuedTasks_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        };
+        
+        // Own deque first, newest task first
+        if (index < count && take(*queues_[index], true)) {
+            return true;
+        }
+        
+        // Then the oldest task from outside the pool
+        if (take(shared_, false)) {
+            return true;
+        }
+        
+        // Steal the oldest task of another worker
+        size_t start = index < count ? index + 1 : 0;
+        for (size_t n = 0; n < count; ++n) {
+            size_t victim = (start + n) % count;
+            if (victim != index && take(*queues_[victim], false)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ThreadPool::runPendingTask() {
+        Task task;
+        if (!popTask(currentWorker(), task)) {
+            return false;
+        }
+        task();
+        return true;
+    }
+
+    bool ThreadPool::runGroupTask(const TaskGroup& group) {
+        Task task;
+        if (!popTask(currentWorker(), task, &group)) {
+            return false;
+        }
+        task();
+        return true;
+    }
+
+    void ThreadPool::workerLoop(size_t index) {
+        currentPool = this;
+        currentIndex = index;
+        
+        Task task;
+        while (true) {
+            if (popTask(index, task)) {
+                task();
+                task = nullptr;
+                continue;
+            }
+            
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            wakeUp_.wait(lock, [this] {
+                return stopping_ || queuedTasks_.load(std::memory_order_acquire) > 0;
+            });
+            if (stopping_ && queuedTasks_.load(std::memory_order_acquire) == 0) {
+                return;
+            }
+        }
+    }
+
+    TaskGroup::~TaskGroup() {
+        waitNoThrow();
+    }
+
+    void TaskGroup::run(ThreadPool::Task task) {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        pool_.push([this, task = std::move(task)] {
+            std::exception_ptr error;
+            try {
+                task();
+            } catch (...) {
+                error = std::current_exception();
+            }
+            
+            // Last access to the group; the waiter may destroy it once this lock is released
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (error && !error_) {
+                error_ = error;
+            }
+            if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                done_.notify_all();
+            }
+        }, this);
+    }
+
+    void TaskGroup::wait() {
+        waitNoThrow();
+        
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::swap(error, error_);
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    void TaskGroup::waitNoThrow() {
+        while (pending_.load(std::memory_order_acquire) > 0) {
+            // Help out instead of blocking, but only with this group's tasks: running
+            // another job here would stack it on top of the one waiting
+            if (pool_.runGroupTask(*this)) {
+                continue;
+            }
+            
+            // Remaining tasks are running on other threads
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait_for(lock, std::chrono::milliseconds(1), [this] {
+                return pending_.load(std::memory_order_acquire) == 0;
+            });
+        }
+        
+        // The last task may still hold the lock it decremented under
+        std::lock_guard<std::mutex> lock(mutex_);
+    }
+
+    std::unique_ptr<ThreadPool> makePoolFor(size_t work, size_t minWork, size_t threadCount) {
+        if (threadCount == 0) {
+            threadCount = ThreadPool::defaultThreadCount();
+        }
+        if (threadCount == 1 || work < minWork) {
+            return nullptr;
+        }
+        return std::make_unique<ThreadPool>(threadCount);
+    }
+
+    PassPool::PassPool(ThreadPool* shared, size_t work, size_t minWork, size_t threadCount) {
+        if (shared == nullptr) {
+            owned_ = makePoolFor(work, minWork, threadCount);
+            pool_ = owned_.get();
+        } else if (shared->size() > 1 && work >= minWork) {
+            pool_ = shared;
+        }
+    }
+
+} // namespace DXFProcessor
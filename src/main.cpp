@@ -1,17 +1,34 @@
 #include "DXFReader.h"
+#include "DXFIndex.h"
+#include "DXFPipeline.h"
+#include "BatchProcessor.h"
+#include "MeshCodec.h"
+#include "MeshPasses.h"
 #include "MeshSummarizer.h"
+#include "OutputBuffer.h"
+#include "Profiler.h"
 #include "SummaryWriter.h"
+#include "ThreadPool.h"
+#include <algorithm>
 #include <iostream>
+#include <iomanip>
 #include <filesystem>
 #include <chrono>
+#include <csignal>
+#include <future>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
+#include <cstdio>
+#include <stdexcept>
 
 using namespace DXFProcessor;
 
 void printUsage(const char* programName) {
     std::cout << "DXF Processor - Cross-platform DXF mesh analyzer\n\n";
-    std::cout << "Usage: " << programName << " [options] <dxf_file>\n\n";
+    std::cout << "Usage: " << programName << " [options] <dxf_file>\n";
+    std::cout << "       " << programName << " [options] --batch <dir|glob>\n\n";
     std::cout << "Options:\n";
     std::cout << "  -o, --output <dir>     Output directory (default: current directory)\n";
     std::cout << "  -f, --format <format>  Output format: json, text, csv (default: json)\n";
@@ -19,10 +36,35 @@ void printUsage(const char* programName) {
     std::cout << "  -n, --name <basename>  Output file base name (default: mesh_summary)\n";
     std::cout << "  --no-timestamp         Don't include timestamp in filename\n";
     std::cout << "  --no-pretty            Compact JSON output (if using JSON format)\n";
+    std::cout << "  --by-layer             Add per-layer statistics table to the summary\n";
+    std::cout << "  --header-only          Report HEADER extents/version/units without parsing entities\n";
+    std::cout << "  --write-index          Write a <file>.dxfidx sidecar index for random access\n";
+    std::cout << "  --compact              Hold vertices as float32 offsets from the mesh centre (half the memory)\n";
+    std::cout << "  --save-mesh <file.dxm> Also write the mesh in the compressed .dxm format (read back like a DXF)\n";
+    std::cout << "  --mesh-precision <d>   Quantization step of --save-mesh in drawing units (default: 0.001)\n";
+    std::cout << "  --check-faces          Count zero-area/sliver and duplicate faces into the summary\n";
+    std::cout << "  --clean                As --check-faces, removing those faces before analysis\n";
+    std::cout << "  --min-face-area <a>    As --check-faces, also flagging faces of area a or less\n";
+    std::cout << "  --spatial-order        Sort faces along a Hilbert curve first, speeding up --orient/--components\n";
+    std::cout << "  --orient               Make face winding consistent across shared edges before analysis\n";
+    std::cout << "  --orient-up            As --orient, with each surface facing +Z (terrain, pit shells)\n";
+    std::cout << "  --components           Add a table of connected pieces (area, bounds, volume) to the summary\n";
+    std::cout << "  --min-component-area <a> As --components, dropping pieces under area a before analysis\n";
+    std::cout << "  --window <x0,y0,x1,y1> Read only faces overlapping an XY window (uses the index)\n";
+    std::cout << "  --layer <name>         Read only faces on this layer (repeatable, uses the index)\n";
+    std::cout << "  --batch <dir|glob>     Summarize every matching DXF file; writes batch_index.json\n";
+    std::cout << "  -j, --threads <n>      Worker threads for --batch (default: one per hardware thread)\n";
+    std::cout << "  --aggregate <csv|ndjson> With --batch, append one row per file to a single table\n";
+    std::cout << "  --pipeline             Stream the file through concurrent read/parse/accumulate stages\n";
+    std::cout << "                         (ignored, with a note, when another option needs the whole mesh)\n";
+    std::cout << "  --verbose              With --pipeline, report per-stage time and queue waits\n";
+    std::cout << "  --profile              Print time per phase and counters (bytes, lines, entities, ...)\n";
+    std::cout << "  --profile-trace <file> Write phase timings as Chrome trace-event JSON\n";
     std::cout << "  -h, --help             Show this help message\n";
     std::cout << "  -v, --version          Show version information\n\n";
     std::cout << "Example:\n";
     std::cout << "  " << programName << " --format json --output ./results data/mesh.dxf\n";
+    std::cout << "  " << programName << " --output ./results --batch \"nightly/*.dxf\"\n";
 }
 
 void printVersion() {
@@ -45,14 +87,63 @@ void showProgress(double progress) {
     }
 }
 
+/// Set by Ctrl+C while a file is being read; the reader stops at its next chunk
+CancellationToken interruptToken;
+
+extern "C" void onInterrupt(int) {
+    interruptToken.cancel();
+}
+
+/**
+ * @brief Reads a file on a worker thread while this thread draws the progress bar
+ * 
+ * Ctrl+C cancels the read instead of killing the process, so the mapping is
+ * released and the caller can report the cancellation.
+ * 
+ * @throws DXFReadCancelledException if interrupted
+ */
+std::unique_ptr<MeshData> readWithProgress(DXFReader& reader, const std::string& filePath) {
+    ReadProgress progress;
+    reader.setProgress(&progress);
+    reader.setCancellationToken(&interruptToken);
+    
+    auto previousHandler = std::signal(SIGINT, onInterrupt);
+    auto result = std::async(std::launch::async, [&] { return reader.readFile(filePath); });
+    while (result.wait_for(std::chrono::milliseconds(100)) != std::future_status::ready) {
+        // 100% is printed once the read has really finished
+        showProgress(std::min(progress.fraction(), 0.99));
+    }
+    std::signal(SIGINT, previousHandler);
+    
+    auto meshData = result.get();
+    showProgress(1.0);
+    return meshData;
+}
+
 struct CommandLineArgs {
     std::string inputFile;
+    std::string batchPattern;
+    std::string aggregateFormat;
+    size_t threadCount = 0;
     std::string outputDir = ".";
     std::string outputFormat = "json";
     std::string summarizerType = "basic";
     std::string baseName = "mesh_summary";
     bool includeTimestamp = true;
     bool prettyPrint = true;
+    bool groupByLayer = false;
+    bool headerOnly = false;
+    bool writeIndex = false;
+    bool compact = false;
+    std::string saveMesh;
+    double meshPrecision = 0.001;
+    MeshPassOptions passes;
+    DXFIndexQuery indexQuery;
+    bool useIndex = false;
+    bool pipeline = false;
+    bool verbose = false;
+    bool profile = false;
+    std::string profileTrace;
     bool showHelp = false;
     bool showVersion = false;
 };
@@ -79,6 +170,63 @@ CommandLineArgs parseCommandLine(int argc, char* argv[]) {
             args.includeTimestamp = false;
         } else if (arg == "--no-pretty") {
             args.prettyPrint = false;
+        } else if (arg == "--by-layer") {
+            args.groupByLayer = true;
+        } else if (arg == "--header-only") {
+            args.headerOnly = true;
+        } else if (arg == "--write-index") {
+            args.writeIndex = true;
+        } else if (arg == "--compact") {
+            args.compact = true;
+        } else if (arg == "--save-mesh" && i + 1 < argc) {
+            args.saveMesh = argv[++i];
+        } else if (arg == "--mesh-precision" && i + 1 < argc) {
+            args.meshPrecision = std::stod(argv[++i]);
+        } else if (arg == "--check-faces") {
+            args.passes.checkFaces = true;
+        } else if (arg == "--clean") {
+            args.passes.checkFaces = true;
+            args.passes.clean = true;
+        } else if (arg == "--min-face-area" && i + 1 < argc) {
+            args.passes.checkFaces = true;
+            args.passes.minFaceArea = std::stod(argv[++i]);
+        } else if (arg == "--spatial-order") {
+            args.passes.spatialOrder = true;
+        } else if (arg == "--orient") {
+            args.passes.orient = true;
+        } else if (arg == "--orient-up") {
+            args.passes.orient = true;
+            args.passes.orientUp = true;
+        } else if (arg == "--components") {
+            args.passes.components = true;
+        } else if (arg == "--min-component-area" && i + 1 < argc) {
+            args.passes.components = true;
+            args.passes.minComponentArea = std::stod(argv[++i]);
+        } else if (arg == "--window" && i + 1 < argc) {
+            DXFIndexQuery& query = args.indexQuery;
+            if (std::sscanf(argv[++i], "%lf,%lf,%lf,%lf",
+                            &query.minX, &query.minY, &query.maxX, &query.maxY) != 4) {
+                throw std::invalid_argument("--window expects minX,minY,maxX,maxY");
+            }
+            query.hasWindow = true;
+            args.useIndex = true;
+        } else if (arg == "--layer" && i + 1 < argc) {
+            args.indexQuery.layers.push_back(argv[++i]);
+            args.useIndex = true;
+        } else if (arg == "--pipeline") {
+            args.pipeline = true;
+        } else if (arg == "--verbose") {
+            args.verbose = true;
+        } else if (arg == "--profile") {
+            args.profile = true;
+        } else if (arg == "--profile-trace" && i + 1 < argc) {
+            args.profileTrace = argv[++i];
+        } else if (arg == "--batch" && i + 1 < argc) {
+            args.batchPattern = argv[++i];
+        } else if (arg == "--aggregate" && i + 1 < argc) {
+            args.aggregateFormat = argv[++i];
+        } else if ((arg == "-j" || arg == "--threads") && i + 1 < argc) {
+            args.threadCount = static_cast<size_t>(std::stoul(argv[++i]));
         } else if (arg[0] != '-') {
             args.inputFile = arg;
         }
@@ -87,6 +235,377 @@ CommandLineArgs parseCommandLine(int argc, char* argv[]) {
     return args;
 }
 
+int runHeaderOnly(const CommandLineArgs& args, std::chrono::high_resolution_clock::time_point startTime) {
+    auto reader = DXFReaderFactory::createReader();
+    
+    std::cout << "Reading DXF header only (entities are not parsed)...\n";
+    DXFHeaderInfo header = reader->readHeader(args.inputFile);
+    
+    auto writer = SummaryWriterFactory::create(args.outputFormat, args.outputDir);
+    writer->setIncludeTimestamp(args.includeTimestamp);
+    writer->setPrettyPrint(args.prettyPrint);
+    
+    std::string baseName = args.baseName == "mesh_summary" ? "header_summary" : args.baseName;
+    std::string outputPath = writer->writeHeaderToFile(header, baseName);
+    
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+    
+    std::cout << "\nHeader read completed successfully!\n";
+    std::cout << "Output written to: " << outputPath << "\n";
+    std::cout << "Processing time: " << duration.count() << " ms\n";
+    
+    std::cout << "\nHeader Summary (" << HEADER_ONLY_NOTE << "):\n";
+    std::cout << "  Version: " << header.acadVersion << "\n";
+    std::cout << "  Units: " << header.unitsName() << "\n";
+    std::cout << "  Estimated entities: ~" << header.estimatedEntityCount << "\n";
+    if (header.hasExtents) {
+        std::cout << "  Extents: ("
+                  << header.extents.min.x << ", " << header.extents.min.y << ", " << header.extents.min.z
+                  << ") to ("
+                  << header.extents.max.x << ", " << header.extents.max.y << ", " << header.extents.max.z
+                  << ")\n";
+    } else {
+        std::cout << "  Extents: not present in header\n";
+    }
+    
+    return 0;
+}
+
+void printSummary(const MeshSummary& summary) {
+    std::cout << "\nSummary:\n";
+    std::cout << "  Triangles: " << summary.triangleCount << "\n";
+    std::cout << "  Surface Area: " << std::fixed << std::setprecision(2) 
+              << summary.totalSurfaceArea << "\n";
+    std::cout << "  Bounding Box: (" 
+              << summary.boundingBox.min.x << ", " << summary.boundingBox.min.y << ", " << summary.boundingBox.min.z
+              << ") to ("
+              << summary.boundingBox.max.x << ", " << summary.boundingBox.max.y << ", " << summary.boundingBox.max.z
+              << ")\n";
+    
+    auto size = summary.boundingBox.size();
+    std::cout << "  Dimensions: " << size.x << " x " << size.y << " x " << size.z << "\n";
+    
+    if (!summary.layers.empty()) {
+        std::cout << "  Layers: " << summary.layers.size() << "\n";
+        for (const auto& layer : summary.layers) {
+            std::cout << "    " << layer.name << ": " << layer.triangleCount << " triangles, area "
+                      << layer.totalSurfaceArea << "\n";
+        }
+    }
+    
+    if (!summary.components.empty()) {
+        std::cout << "  Components: " << summary.components.size() << "\n";
+        for (const auto& component : summary.components) {
+            std::cout << "    " << component.name << ": " << component.triangleCount << " triangles, area "
+                      << component.totalSurfaceArea << ", volume " << component.volume << "\n";
+        }
+    }
+}
+
+void printStageStats(const std::vector<PipelineStageStats>& stages) {
+    std::cout << "\nPipeline stages:\n";
+    std::cout << "  " << std::left << std::setw(12) << "stage" << std::right
+              << std::setw(8) << "items" << std::setw(10) << "busy ms"
+              << std::setw(12) << "starved ms" << std::setw(9) << "(waits)"
+              << std::setw(12) << "blocked ms" << std::setw(9) << "(waits)" << "\n";
+    for (const auto& stage : stages) {
+        std::cout << "  " << std::left << std::setw(12) << stage.name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(8) << stage.items
+                  << std::setw(10) << stage.busySeconds * 1000.0
+                  << std::setw(12) << stage.inputWaitSeconds * 1000.0 << std::setw(9) << stage.inputWaits
+                  << std::setw(12) << stage.outputWaitSeconds * 1000.0 << std::setw(9) << stage.outputWaits << "\n";
+    }
+}
+
+/**
+ * @brief Names the option that keeps --pipeline from serving the run, if any
+ * 
+ * The pipeline discards triangles once they are accumulated and doesn't
+ * go through DXFReader, so anything needing the whole mesh or a reader
+ * option falls back to the sequential path.
+ * 
+ * @return Why streaming is off, e.g. "--clean needs the whole mesh"; empty if the pipeline can run
+ */
+std::string streamBlocker(const CommandLineArgs& args) {
+    if (MeshCodec::isMeshFile(args.inputFile)) {
+        return "a .dxm input is loaded whole";
+    }
+    if (args.useIndex) {
+        return "--window/--layer read through the index";
+    }
+    if (args.writeIndex) {
+        return "--write-index needs the sequential reader";
+    }
+    if (args.compact) {
+        return "--compact needs the whole mesh";
+    }
+    if (!args.saveMesh.empty()) {
+        return "--save-mesh needs the whole mesh";
+    }
+    
+    const std::pair<bool, const char*> passes[] = {
+        {args.passes.clean, "--clean"}, {args.passes.checkFaces, "--check-faces"},
+        {args.passes.spatialOrder, "--spatial-order"}, {args.passes.orientUp, "--orient-up"},
+        {args.passes.orient, "--orient"}, {args.passes.components, "--components"}};
+    for (const auto& [enabled, option] : passes) {
+        if (enabled) {
+            return std::string(option) + " needs the whole mesh";
+        }
+    }
+    return std::string();
+}
+
+int runPipeline(const CommandLineArgs& args, std::chrono::high_resolution_clock::time_point startTime) {
+    auto summarizer = MeshSummarizerFactory::create(args.summarizerType);
+    summarizer->setGroupByLayer(args.groupByLayer);
+    
+    std::cout << "Streaming DXF file through read/parse/accumulate stages...\n";
+    DXFPipeline pipeline;
+    PipelineResult result = pipeline.run(args.inputFile, *summarizer);
+    std::cout << "Read " << result.summary.triangleCount << " triangles from DXF file.\n";
+    
+    std::cout << "Writing summary...\n";
+    auto writeStart = std::chrono::steady_clock::now();
+    auto writer = SummaryWriterFactory::create(args.outputFormat, args.outputDir);
+    writer->setIncludeTimestamp(args.includeTimestamp);
+    writer->setPrettyPrint(args.prettyPrint);
+    std::string outputPath = writer->writeToFile(result.summary, args.baseName);
+    
+    if (args.verbose) {
+        PipelineStageStats write;
+        write.name = "write";
+        write.items = 1;
+        write.busySeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - writeStart).count();
+        result.stages.push_back(write);
+        printStageStats(result.stages);
+    }
+    
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+    
+    std::cout << "\nProcessing completed successfully!\n";
+    std::cout << "Output written to: " << outputPath << "\n";
+    std::cout << "Processing time: " << duration.count() << " ms\n";
+    
+    printSummary(result.summary);
+    
+    return 0;
+}
+
+/**
+ * @brief Notes for the single-file options a batch run doesn't honour
+ * 
+ * BatchProcessor reads every file whole with the sequential reader and
+ * writes only summaries, so these options would otherwise do nothing
+ * without a word.
+ * 
+ * @return One "<option> ignored: <reason>" line per such option given
+ */
+std::vector<std::string> batchIgnoredOptions(const CommandLineArgs& args) {
+    const std::pair<bool, const char*> options[] = {
+        {args.headerOnly, "--header-only ignored: --batch parses every file"},
+        {args.pipeline, "--pipeline ignored: --batch reads each file with the sequential reader"},
+        {args.useIndex, "--window/--layer ignored: --batch reads every face"},
+        {args.writeIndex, "--write-index ignored: --batch writes no sidecars"},
+        {args.compact, "--compact ignored: --batch keeps double-precision meshes"},
+        {!args.saveMesh.empty(), "--save-mesh ignored: --batch writes only summaries"}};
+    std::vector<std::string> notes;
+    for (const auto& [given, note] : options) {
+        if (given) {
+            notes.emplace_back(note);
+        }
+    }
+    return notes;
+}
+
+int runBatch(const CommandLineArgs& args) {
+    for (const std::string& note : batchIgnoredOptions(args)) {
+        std::cerr << note << "\n";
+    }
+    
+    BatchOptions options;
+    options.outputDir = args.outputDir;
+    options.outputFormat = args.outputFormat;
+    options.summarizerType = args.summarizerType;
+    options.includeTimestamp = args.includeTimestamp;
+    options.prettyPrint = args.prettyPrint;
+    options.groupByLayer = args.groupByLayer;
+    options.threadCount = args.threadCount;
+    options.aggregateFormat = args.aggregateFormat;
+    options.passes = args.passes;
+    
+    std::vector<std::string> files = BatchProcessor::expandInputs(args.batchPattern);
+    size_t threads = args.threadCount > 0 ? args.threadCount : ThreadPool::defaultThreadCount();
+    
+    std::cout << "DXF Processor v1.0.0\n";
+    std::cout << "Batch: " << files.size() << " files matching " << args.batchPattern
+              << " on " << threads << " threads\n";
+    std::cout << "Output directory: " << std::filesystem::absolute(args.outputDir) << "\n\n";
+    
+    BatchProcessor batch(options);
+    size_t done = 0;
+    batch.setFileCallback([&](const BatchFileResult& file) {
+        std::cout << "[" << ++done << "/" << files.size() << "] " << file.inputPath;
+        if (file.success) {
+            std::cout << ": " << file.triangleCount << " triangles\n";
+        } else {
+            std::cout << ": FAILED - " << file.error << "\n";
+        }
+    });
+    
+    BatchResult result = batch.run(files);
+    
+    std::cout << "\nBatch completed: " << result.succeeded() << " succeeded, "
+              << result.failed() << " failed in "
+              << std::fixed << std::setprecision(2) << result.seconds << " s\n";
+    if (!result.aggregatePath.empty()) {
+        std::cout << "Summary table written to: " << result.aggregatePath << "\n";
+    }
+    std::cout << "Index written to: " << result.indexPath << "\n";
+    
+    return result.failed() == 0 ? 0 : 2;
+}
+
+int runFile(const CommandLineArgs& args, const char* programName) {
+    if (args.inputFile.empty()) {
+        std::cerr << "Error: No input file specified.\n";
+        printUsage(programName);
+        return 1;
+    }
+    
+    if (!std::filesystem::exists(args.inputFile)) {
+        std::cerr << "Error: Input file does not exist: " << args.inputFile << "\n";
+        return 1;
+    }
+    
+    std::cout << "DXF Processor v1.0.0\n";
+    std::cout << "Processing: " << args.inputFile << "\n";
+    std::cout << "Output directory: " << std::filesystem::absolute(args.outputDir) << "\n";
+    std::cout << "Output format: " << args.outputFormat << "\n";
+    std::cout << "Summarizer: " << args.summarizerType << "\n\n";
+    
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    if (args.headerOnly) {
+        return runHeaderOnly(args, startTime);
+    }
+    
+    if (args.pipeline) {
+        std::string blocker = streamBlocker(args);
+        if (blocker.empty()) {
+            return runPipeline(args, startTime);
+        }
+        std::cerr << "--pipeline ignored: " << blocker << "\n";
+    }
+    
+    std::unique_ptr<MeshData> meshData;
+    if (MeshCodec::isMeshFile(args.inputFile)) {
+        std::cout << "Loading compressed mesh...\n";
+        meshData = MeshCodec().load(args.inputFile);
+    } else if (args.useIndex) {
+        std::cout << "Reading indexed subset of DXF file...\n";
+        DXFIndexedReader indexedReader(args.inputFile);
+        meshData = indexedReader.read(args.indexQuery);
+        if (meshData->isEmpty()) {
+            std::cerr << "Error: No 3D faces match the requested layers/window.\n";
+            return 2;
+        }
+    } else {
+        auto reader = DXFReaderFactory::createReader();
+        reader->setWriteIndex(args.writeIndex);
+        reader->setCompactStorage(args.compact);
+        
+        std::cout << "Reading DXF file...\n";
+        meshData = readWithProgress(*reader, args.inputFile);
+        if (args.compact && !meshData->isCompact()) {
+            std::cout << "Coordinates too far apart for float32 storage; keeping double precision.\n";
+        }
+    }
+    
+    std::cout << "Read " << meshData->getTriangleCount() << " triangles from DXF file.\n";
+    
+    MeshPassReport passes = MeshPasses(args.passes).run(*meshData);
+    if (passes.cleanup) {
+        std::cout << "Found " << passes.cleanup->degenerateTriangles << " degenerate and "
+                  << passes.cleanup->duplicateTriangles << " duplicate faces";
+        if (args.passes.clean) {
+            std::cout << "; removed " << passes.cleanup->removedTriangles;
+        }
+        std::cout << "\n";
+    }
+    if (args.passes.spatialOrder) {
+        std::cout << "Sorted faces along a Hilbert curve\n";
+    }
+    if (passes.orientation) {
+        std::cout << "Oriented " << passes.orientation->components << " component(s): flipped "
+                  << passes.orientation->flippedTriangles << " triangles";
+        if (passes.orientation->conflictingEdges > 0) {
+            std::cout << "; " << passes.orientation->conflictingEdges
+                      << " edges of non-orientable parts stay inconsistent";
+        }
+        std::cout << "\n";
+    }
+    if (passes.components) {
+        const ComponentAnalysis& components = *passes.components;
+        std::cout << "Found " << components.components.size() + components.droppedComponents << " component(s)";
+        if (components.droppedComponents > 0) {
+            std::cout << "; dropped " << components.droppedComponents << " under area " << args.passes.minComponentArea
+                      << " (" << components.droppedTriangles << " triangles)";
+        }
+        std::cout << "\n";
+    }
+    
+    if (!args.saveMesh.empty()) {
+        MeshCodecOptions codecOptions;
+        codecOptions.precision = args.meshPrecision;
+        MeshCodec(codecOptions).save(*meshData, args.saveMesh);
+        std::cout << "Mesh written to: " << args.saveMesh << " ("
+                  << std::filesystem::file_size(args.saveMesh) << " bytes)\n";
+    }
+    
+    std::cout << "Analyzing mesh...\n";
+    auto summarizer = MeshSummarizerFactory::create(args.summarizerType);
+    summarizer->setGroupByLayer(args.groupByLayer);
+    auto summary = summarizer->summarize(*meshData);
+    passes.addTo(summary);
+    
+    std::cout << "Writing summary...\n";
+    auto writer = SummaryWriterFactory::create(args.outputFormat, args.outputDir);
+    writer->setIncludeTimestamp(args.includeTimestamp);
+    writer->setPrettyPrint(args.prettyPrint);
+    
+    std::string outputPath = writer->writeToFile(summary, args.baseName);
+    
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+    
+    std::cout << "\nProcessing completed successfully!\n";
+    std::cout << "Output written to: " << outputPath << "\n";
+    std::cout << "Processing time: " << duration.count() << " ms\n";
+    
+    printSummary(summary);
+    
+    return 0;
+}
+
+void reportProfile(const CommandLineArgs& args) {
+    if (!Profiler::enabled()) {
+        return;
+    }
+    Profiler::disable();
+    
+    if (args.profile) {
+        OutputBuffer table;
+        Profiler::formatTable(Profiler::report(), table);
+        std::cout << "\nProfile:\n" << table.view();
+    }
+    if (!args.profileTrace.empty()) {
+        Profiler::writeChromeTrace(args.profileTrace);
+        std::cout << "Trace written to: " << args.profileTrace << "\n";
+    }
+}
+
 int main(int argc, char* argv[]) {
     try {
         CommandLineArgs args = parseCommandLine(argc, argv);
@@ -101,72 +620,35 @@ int main(int argc, char* argv[]) {
             return 0;
         }
         
-        if (args.inputFile.empty()) {
-            std::cerr << "Error: No input file specified.\n";
-            printUsage(argv[0]);
-            return 1;
-        }
-        
-        if (!std::filesystem::exists(args.inputFile)) {
-            std::cerr << "Error: Input file does not exist: " << args.inputFile << "\n";
-            return 1;
+        if (args.profile || !args.profileTrace.empty()) {
+            if (!Profiler::compiledIn()) {
+                std::cerr << "Warning: built with DXF_PROFILING=0, the profile will be empty.\n";
+            }
+            Profiler::enable(!args.profileTrace.empty());
         }
         
-        std::cout << "DXF Processor v1.0.0\n";
-        std::cout << "Processing: " << args.inputFile << "\n";
-        std::cout << "Output directory: " << std::filesystem::absolute(args.outputDir) << "\n";
-        std::cout << "Output format: " << args.outputFormat << "\n";
-        std::cout << "Summarizer: " << args.summarizerType << "\n\n";
-        
-        auto startTime = std::chrono::high_resolution_clock::now();
-        
-        auto reader = DXFReaderFactory::createReader();
-        reader->setProgressCallback(showProgress);
-        
-        std::cout << "Reading DXF file...\n";
-        auto meshData = reader->readFile(args.inputFile);
-        
-        std::cout << "Read " << meshData->getTriangleCount() << " triangles from DXF file.\n";
-        
-        std::cout << "Analyzing mesh...\n";
-        auto summarizer = MeshSummarizerFactory::create(args.summarizerType);
-        auto summary = summarizer->summarize(*meshData);
-        
-        std::cout << "Writing summary...\n";
-        auto writer = SummaryWriterFactory::create(args.outputFormat, args.outputDir);
-        writer->setIncludeTimestamp(args.includeTimestamp);
-        writer->setPrettyPrint(args.prettyPrint);
-        
-        std::string outputPath = writer->writeToFile(summary, args.baseName);
-        
-        auto endTime = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
-        
-        std::cout << "\nProcessing completed successfully!\n";
-        std::cout << "Output written to: " << outputPath << "\n";
-        std::cout << "Processing time: " << duration.count() << " ms\n";
-        
-        std::cout << "\nSummary:\n";
-        std::cout << "  Triangles: " << summary.triangleCount << "\n";
-        std::cout << "  Surface Area: " << std::fixed << std::setprecision(2) 
-                  << summary.totalSurfaceArea << "\n";
-        std::cout << "  Bounding Box: (" 
-                  << summary.boundingBox.min.x << ", " << summary.boundingBox.min.y << ", " << summary.boundingBox.min.z
-                  << ") to ("
-                  << summary.boundingBox.max.x << ", " << summary.boundingBox.max.y << ", " << summary.boundingBox.max.z
-                  << ")\n";
-        
-        auto size = summary.boundingBox.size();
-        std::cout << "  Dimensions: " << size.x << " x " << size.y << " x " << size.z << "\n";
-        
-        return 0;
-        
+        int status = args.batchPattern.empty() ? runFile(args, argv[0]) : runBatch(args);
+        reportProfile(args);
+        return status;
+    
+    } catch (const DXFReadCancelledException&) {
+        std::cerr << "\nCancelled.\n";
+        return 130;
     } catch (const DXFReaderException& e) {
         std::cerr << "DXF Reader Error: " << e.what() << "\n";
         return 2;
+    } catch (const DXFIndexException& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    } catch (const BatchException& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
     } catch (const SummaryWriterException& e) {
         std::cerr << "Summary Writer Error: " << e.what() << "\n";
         return 3;
+    } catch (const MeshCodecException& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << "\n";
         return 1;
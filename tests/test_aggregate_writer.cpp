@@ -0,0 +1,171 @@
+/**
+ * @file test_aggregate_writer.cpp
+ * @brief Unit tests for the aggregate CSV/NDJSON table writer and its queue
+ */
+
+#include <gtest/gtest.h>
+#include "AggregateWriter.h"
+#include "MPSCQueue.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace DXFProcessor;
+
+class AggregateWriterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testOutputDir = "aggregate_test_output";
+        std::filesystem::create_directories(testOutputDir);
+        
+        MeshData mesh;
+        mesh.addTriangle(Point3D(0, 0, 0), Point3D(1, 0, 0), Point3D(0, 1, 0));
+        mesh.addTriangle(Point3D(0, 0, 1), Point3D(1, 0, 1), Point3D(0, 1, 1));
+        basicSummary = MeshSummarizerFactory::create("basic")->summarize(mesh);
+        detailedSummary = MeshSummarizerFactory::create("detailed")->summarize(mesh);
+    }
+    
+    void TearDown() override {
+        std::filesystem::remove_all(testOutputDir);
+    }
+    
+    static std::vector<std::string> readLines(const std::string& path) {
+        std::ifstream file(path);
+        std::vector<std::string> lines;
+        for (std::string line; std::getline(file, line);) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+    
+    std::string testOutputDir;
+    MeshSummary basicSummary;
+    MeshSummary detailedSummary;
+};
+
+TEST(MPSCQueueTest, DeliversEveryValueOnceInProducerOrder) {
+    MPSCQueue<int> queue;
+    constexpr int PRODUCERS = 4;
+    constexpr int PER_PRODUCER = 5000;
+    
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&queue, p] {
+            for (int i = 0; i < PER_PRODUCER; ++i) {
+                queue.push(p * PER_PRODUCER + i);
+            }
+        });
+    }
+    
+    std::vector<int> lastSeen(PRODUCERS, -1);
+    int received = 0;
+    while (received < PRODUCERS * PER_PRODUCER) {
+        int value;
+        if (!queue.tryPop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        int producer = value / PER_PRODUCER;
+        EXPECT_GT(value, lastSeen[producer]);  // FIFO per producer
+        lastSeen[producer] = value;
+        ++received;
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    
+    int value;
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST_F(AggregateWriterTest, CSVColumnsAreFixedAcrossSummarizerTypes) {
+    std::string path = testOutputDir + "/table.csv";
+    {
+        AggregateWriter table(path, AggregateWriter::Format::CSV);
+        table.append("basic.dxf", basicSummary);
+        table.append("detailed.dxf", detailedSummary);
+        table.appendFailure("broken.dxf", "No 3D faces, \"really\"");
+        table.close();
+        EXPECT_EQ(table.rowCount(), 3);
+    }
+    
+    auto lines = readLines(path);
+    ASSERT_EQ(lines.size(), 4);
+    EXPECT_EQ(lines[0].rfind("source,status,error,triangle_count,total_surface_area,min_x,", 0), 0);
+    EXPECT_NE(lines[0].find(",mesh_density,"), std::string::npos);
+    EXPECT_NE(lines[0].find(",volume_estimate,"), std::string::npos);
+    
+    // Every row has the header's column count, whatever the summarizer
+    auto commas = [](const std::string& line) { return std::count(line.begin(), line.end(), ','); };
+    EXPECT_EQ(commas(lines[1]), commas(lines[0]));
+    EXPECT_EQ(commas(lines[2]), commas(lines[0]));
+    EXPECT_EQ(commas(lines[3]), commas(lines[0]) + 1);  // One comma inside the quoted error
+    
+    EXPECT_EQ(lines[1].rfind("basic.dxf,ok,,2,1,0,0,0,1,1,1,", 0), 0);
+    EXPECT_EQ(lines[1].back(), ',');  // Detailed-only metrics are empty
+    EXPECT_NE(lines[2].back(), ',');
+    EXPECT_EQ(lines[3].rfind("broken.dxf,failed,\"No 3D faces, \"\"really\"\"\",,,", 0), 0);
+}
+
+TEST_F(AggregateWriterTest, NDJSONWritesOneObjectPerLine) {
+    std::string path = testOutputDir + "/table.ndjson";
+    {
+        AggregateWriter table(path, AggregateWriter::Format::NDJSON, {"mesh_density", "volume_estimate"});
+        table.append("basic.dxf", basicSummary);
+        table.appendFailure("broken.dxf", "bad");
+    }
+    
+    auto lines = readLines(path);
+    ASSERT_EQ(lines.size(), 2);
+    EXPECT_EQ(lines[0].rfind("{\"source\":\"basic.dxf\",\"status\":\"ok\",\"error\":null,\"triangle_count\":2,", 0), 0);
+    EXPECT_NE(lines[0].find("\"mesh_density\":2,"), std::string::npos);
+    EXPECT_NE(lines[0].find("\"volume_estimate\":null}"), std::string::npos);
+    EXPECT_EQ(lines[1], "{\"source\":\"broken.dxf\",\"status\":\"failed\",\"error\":\"bad\",\"triangle_count\":null,"
+                        "\"total_surface_area\":null,\"min_x\":null,\"min_y\":null,\"min_z\":null,"
+                        "\"max_x\":null,\"max_y\":null,\"max_z\":null,"
+                        "\"centroid_x\":null,\"centroid_y\":null,\"centroid_z\":null,"
+                        "\"mesh_density\":null,\"volume_estimate\":null}");
+}
+
+TEST_F(AggregateWriterTest, ConcurrentAppendsWriteEveryRowOnce) {
+    std::string path = testOutputDir + "/concurrent.csv";
+    constexpr int THREADS = 8;
+    constexpr int ROWS = 500;
+    {
+        AggregateWriter table(path, AggregateWriter::Format::CSV);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < THREADS; ++t) {
+            workers.emplace_back([&, t] {
+                for (int i = 0; i < ROWS; ++i) {
+                    table.append("file_" + std::to_string(t * ROWS + i), detailedSummary);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        table.close();
+    }
+    
+    auto lines = readLines(path);
+    ASSERT_EQ(lines.size(), THREADS * ROWS + 1);
+    std::set<std::string> sources;
+    for (size_t i = 1; i < lines.size(); ++i) {
+        sources.insert(lines[i].substr(0, lines[i].find(',')));
+    }
+    EXPECT_EQ(sources.size(), static_cast<size_t>(THREADS * ROWS));
+}
+
+TEST_F(AggregateWriterTest, RejectsUnknownFormatsAndPaths) {
+    EXPECT_EQ(AggregateWriter::parseFormat("csv"), AggregateWriter::Format::CSV);
+    EXPECT_EQ(AggregateWriter::parseFormat("ndjson"), AggregateWriter::Format::NDJSON);
+    EXPECT_THROW(AggregateWriter::parseFormat("xml"), SummaryWriterException);
+    
+    std::ofstream(testOutputDir + "/file") << "x";
+    EXPECT_THROW(AggregateWriter(testOutputDir + "/file/table.csv", AggregateWriter::Format::CSV),
+                 SummaryWriterException);
+}
@@ -0,0 +1,166 @@
+/**
+ * @file test_batch_processor.cpp
+ * @brief Unit tests for batch directory processing
+ */
+
+#include <gtest/gtest.h>
+#include "BatchProcessor.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace DXFProcessor;
+
+class BatchProcessorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testDataDir = TEST_DATA_DIR;
+        inputDir = "batch_test_input";
+        outputDir = "batch_test_output";
+        std::filesystem::create_directories(inputDir);
+        
+        for (const char* name : {"single_triangle.dxf", "two_triangles.dxf", "two_layers.dxf", "empty.dxf"}) {
+            std::filesystem::copy_file(testDataDir + "/" + name, inputDir + "/" + name,
+                                       std::filesystem::copy_options::overwrite_existing);
+        }
+        std::ofstream(inputDir + "/notes.txt") << "not a drawing\n";
+        
+        options.outputDir = outputDir;
+        options.includeTimestamp = false;
+        options.threadCount = 3;
+    }
+    
+    void TearDown() override {
+        std::filesystem::remove_all(inputDir);
+        std::filesystem::remove_all(outputDir);
+    }
+    
+    static std::string readFile(const std::string& path) {
+        std::ifstream file(path);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+    
+    std::string testDataDir;
+    std::string inputDir;
+    std::string outputDir;
+    BatchOptions options;
+};
+
+TEST_F(BatchProcessorTest, ExpandsDirectoriesAndGlobs) {
+    auto all = BatchProcessor::expandInputs(inputDir);
+    ASSERT_EQ(all.size(), 4);  // notes.txt is skipped
+    EXPECT_EQ(std::filesystem::path(all[0]).filename(), "empty.dxf");
+    EXPECT_EQ(std::filesystem::path(all[3]).filename(), "two_triangles.dxf");
+    
+    auto twos = BatchProcessor::expandInputs(inputDir + "/two_*.dxf");
+    ASSERT_EQ(twos.size(), 2);
+    EXPECT_EQ(std::filesystem::path(twos[0]).filename(), "two_layers.dxf");
+    
+    EXPECT_EQ(BatchProcessor::expandInputs(inputDir + "/single_triangle.dx?").size(), 1);
+    EXPECT_THROW(BatchProcessor::expandInputs(inputDir + "/*.dwg"), BatchException);
+    EXPECT_THROW(BatchProcessor::expandInputs("no_such_directory/*.dxf"), BatchException);
+}
+
+TEST_F(BatchProcessorTest, FailuresAreRecordedWithoutAbortingTheBatch) {
+    BatchProcessor batch(options);
+    size_t callbacks = 0;
+    batch.setFileCallback([&callbacks](const BatchFileResult&) { ++callbacks; });
+    
+    BatchResult result = batch.run(inputDir);
+    
+    ASSERT_EQ(result.files.size(), 4);
+    EXPECT_EQ(callbacks, 4);
+    EXPECT_EQ(result.succeeded(), 3);
+    EXPECT_EQ(result.failed(), 1);
+    
+    // Results are in input order regardless of completion order
+    const BatchFileResult& empty = result.files[0];
+    EXPECT_FALSE(empty.success);
+    EXPECT_NE(empty.error.find("No 3D faces"), std::string::npos);
+    
+    const BatchFileResult& twoTriangles = result.files[3];
+    EXPECT_TRUE(twoTriangles.success);
+    EXPECT_EQ(twoTriangles.triangleCount, 2);
+    EXPECT_TRUE(std::filesystem::exists(twoTriangles.outputPath));
+    EXPECT_EQ(std::filesystem::path(twoTriangles.outputPath).filename(), "two_triangles.json");
+}
+
+TEST_F(BatchProcessorTest, WritesCombinedIndex) {
+    BatchProcessor batch(options);
+    BatchResult result = batch.run(inputDir + "/*.dxf");
+    
+    ASSERT_TRUE(std::filesystem::exists(result.indexPath));
+    EXPECT_EQ(std::filesystem::path(result.indexPath).filename(), "batch_index.json");
+    
+    std::string index = readFile(result.indexPath);
+    EXPECT_NE(index.find("\"file_count\": 4"), std::string::npos);
+    EXPECT_NE(index.find("\"succeeded\": 3"), std::string::npos);
+    EXPECT_NE(index.find("\"failed\": 1"), std::string::npos);
+    EXPECT_NE(index.find("\"status\": \"failed\", \"error\": \"DXF Reader Error: No 3D faces"), std::string::npos);
+    EXPECT_NE(index.find("\"triangle_count\": 2"), std::string::npos);
+}
+
+TEST_F(BatchProcessorTest, RepeatedStemsGetDistinctOutputs) {
+    std::filesystem::create_directories(inputDir + "/copy");
+    std::filesystem::copy_file(testDataDir + "/two_layers.dxf", inputDir + "/copy/two_layers.dxf");
+    
+    BatchProcessor batch(options);
+    BatchResult result = batch.run({inputDir + "/two_layers.dxf", inputDir + "/copy/two_layers.dxf"});
+    
+    ASSERT_EQ(result.succeeded(), 2);
+    EXPECT_EQ(std::filesystem::path(result.files[0].outputPath).filename(), "two_layers.json");
+    EXPECT_EQ(std::filesystem::path(result.files[1].outputPath).filename(), "two_layers_2.json");
+}
+
+TEST_F(BatchProcessorTest, AggregateModeWritesOneTable) {
+    options.aggregateFormat = "csv";
+    BatchProcessor batch(options);
+    BatchResult result = batch.run(inputDir);
+    
+    ASSERT_EQ(result.files.size(), 4);
+    EXPECT_EQ(std::filesystem::path(result.aggregatePath).filename(), "batch_summary.csv");
+    
+    // Only the table and the index; no per-file summaries
+    size_t outputs = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(outputDir)) {
+        (void)entry;
+        ++outputs;
+    }
+    EXPECT_EQ(outputs, 2);
+    
+    std::string table = readFile(result.aggregatePath);
+    EXPECT_EQ(std::count(table.begin(), table.end(), '\n'), 5);  // Header + one row per input
+    EXPECT_NE(table.find("empty.dxf,failed,DXF Reader Error: No 3D faces"), std::string::npos);
+    
+    options.aggregateFormat = "xml";
+    EXPECT_THROW(BatchProcessor(options).run(inputDir), BatchException);
+}
+
+TEST_F(BatchProcessorTest, RunsMeshPassesOnEveryFile) {
+    options.passes.checkFaces = true;
+    options.passes.orient = true;
+    options.passes.components = true;
+    BatchProcessor batch(options);
+    BatchResult result = batch.run({inputDir + "/two_triangles.dxf", inputDir + "/two_layers.dxf"});
+    
+    ASSERT_EQ(result.succeeded(), 2);
+    for (const auto& file : result.files) {
+        std::string summary = readFile(file.outputPath);
+        EXPECT_NE(summary.find("\"degenerate_triangles\": 0"), std::string::npos) << file.inputPath;
+        EXPECT_NE(summary.find("\"flipped_triangles\""), std::string::npos) << file.inputPath;
+        EXPECT_NE(summary.find("\"component_count\""), std::string::npos) << file.inputPath;
+        EXPECT_NE(summary.find("\"components\""), std::string::npos) << file.inputPath;
+    }
+    
+    // The aggregate table gains a column per pass count
+    options.aggregateFormat = "csv";
+    BatchResult aggregate = BatchProcessor(options).run({inputDir + "/two_triangles.dxf"});
+    std::string table = readFile(aggregate.aggregatePath);
+    std::string header = table.substr(0, table.find('\n'));
+    EXPECT_NE(header.find(",degenerate_triangles,duplicate_triangles,removed_triangles,flipped_triangles"),
+              std::string::npos);
+    EXPECT_NE(header.find(",component_count,dropped_components,dropped_triangles"), std::string::npos);
+}
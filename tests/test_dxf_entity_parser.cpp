@@ -0,0 +1,137 @@
+/**
+ * @file test_dxf_entity_parser.cpp
+ * @brief Unit tests for the table-driven DXF entity parsers
+ */
+
+#include <gtest/gtest.h>
+#include "DXFEntityParser.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace DXFProcessor;
+
+TEST(DXFEntityParserTest, GroupCodeTableLayout) {
+    using Layout = EntityParser<Face3DEntity>::Layout;
+    constexpr auto& table = EntityParser<Face3DEntity>::TABLE;
+    
+    static_assert(table[10] == Layout::coordinate(0, 0), "10 is vertex 0 X");
+    static_assert(table[23] == Layout::coordinate(3, 1), "23 is vertex 3 Y");
+    static_assert(table[32] == Layout::coordinate(2, 2), "32 is vertex 2 Z");
+    static_assert(table[14] == Layout::IGNORE, "3DFACE has four vertices");
+    static_assert(EntityParser<LineEntity>::TABLE[12] == EntityParser<LineEntity>::Layout::IGNORE,
+                  "LINE has two vertices");
+    
+    EXPECT_EQ(table[8], Layout::LAYER);
+    EXPECT_EQ(table[5], Layout::HANDLE);
+    EXPECT_EQ(table[62], Layout::COLOR);
+    EXPECT_EQ(table[70], Layout::FLAGS);
+    EXPECT_EQ(table[0], Layout::IGNORE);
+    EXPECT_EQ(table[MAX_GROUP_CODE], Layout::IGNORE);
+}
+
+TEST(DXFEntityParserTest, Parses3DFaceFields) {
+    std::string text =
+        "  5\n1F\n  8\nBench 1\n 62\n3\n 70\n1\n"
+        " 10\n1.0\n 20\n2.0\n 30\n3.0\n"
+        " 11\n4.0\n 21\n5.0\n 31\n6.0\n"
+        " 12\n7.0\n 22\n8.0\n 32\n9.0\n"
+        " 13\n7.0\n 23\n8.0\n 33\n9.0\n"
+        "1001\nAPP\n  0\n3DFACE\n";
+    DXFTokenizer tokenizer(text);
+    DXFGroup group;
+    EntityParser<Face3DEntity>::Record face;
+    
+    ASSERT_TRUE(EntityParser<Face3DEntity>::parse(tokenizer, group, face));
+    EXPECT_EQ(face.handle(), "1F");
+    EXPECT_EQ(face.layer(), "Bench 1");
+    EXPECT_EQ(face.color(), 3);
+    EXPECT_EQ(face.flags(), 1);
+    for (size_t vertex = 0; vertex < 4; ++vertex) {
+        EXPECT_TRUE(face.hasVertex(vertex));
+    }
+    EXPECT_DOUBLE_EQ(face.vertex(1).y, 5.0);
+    EXPECT_DOUBLE_EQ(face.vertex(2).z, 9.0);
+    
+    // The terminating pair is left for the caller
+    EXPECT_TRUE(group.valid);
+    EXPECT_EQ(group.code, 0);
+    EXPECT_EQ(group.value, "3DFACE");
+}
+
+TEST(DXFEntityParserTest, MissingVertexIsIncomplete) {
+    std::string text = " 10\n1\n 20\n1\n 30\n1\n 11\n2\n 21\n2\n 31\n2\n";
+    DXFTokenizer tokenizer(text);
+    DXFGroup group;
+    EntityParser<Face3DEntity>::Record face;
+    
+    EXPECT_FALSE(EntityParser<Face3DEntity>::parse(tokenizer, group, face));
+    EXPECT_FALSE(group.valid);  // End of buffer
+    EXPECT_EQ(face.layer(), "0");
+    EXPECT_EQ(face.color(), 256);
+}
+
+TEST(DXFEntityParserTest, ParsesLineWithSameLoop) {
+    std::string text = "  8\nEdges\n 10\n-1.5\n 20\n0\n 30\nbad\n 11\n2.5\n 21\n1\n 31\n4\n  0\nENDSEC\n";
+    DXFTokenizer tokenizer(text);
+    DXFGroup group;
+    EntityParser<LineEntity>::Record line;
+    
+    ASSERT_TRUE(EntityParser<LineEntity>::parse(tokenizer, group, line));
+    EXPECT_EQ(line.layer(), "Edges");
+    EXPECT_DOUBLE_EQ(line.vertex(0).x, -1.5);
+    EXPECT_DOUBLE_EQ(line.vertex(0).z, 0.0);  // Unparseable value leaves the default
+    EXPECT_DOUBLE_EQ(line.vertex(1).z, 4.0);
+    EXPECT_EQ(group.value, "ENDSEC");
+}
+
+TEST(DXFEntityParserTest, UnparseableVertexXIsIncomplete) {
+    std::string text =
+        " 10\nabc\n 20\n1\n 30\n1\n 11\n2\n 21\n2\n 31\n2\n 12\n3\n 22\n3\n 32\n3\n  0\nENDSEC\n";
+    DXFTokenizer tokenizer(text);
+    DXFGroup group;
+    EntityParser<Face3DEntity>::Record face;
+    
+    EXPECT_FALSE(EntityParser<Face3DEntity>::parse(tokenizer, group, face));
+    EXPECT_FALSE(face.hasVertex(0));
+    EXPECT_TRUE(face.hasVertex(1));
+    EXPECT_EQ(group.value, "ENDSEC");
+}
+
+TEST(DXFEntityParserTest, FaceRangeDropsFaceWithBadCoordinate) {
+    std::string text =
+        "  0\nSECTION\n  2\nENTITIES\n"
+        "  0\n3DFACE\n 10\n511683.0\n 20\n1\n 30\n1\n 11\n511684.0\n 21\n1\n 31\n1\n 12\n511683.0\n 22\n2\n 32\n1\n"
+        "  0\n3DFACE\n 10\nabc\n 20\n1\n 30\n1\n 11\n511684.0\n 21\n1\n 31\n1\n 12\n511683.0\n 22\n2\n 32\n1\n"
+        "  0\nENDSEC\n  0\nEOF\n";
+    bool inEntities = false;
+    MeshData meshData;
+    DXFIndex index;
+    
+    EXPECT_EQ(parseFaceRange(text, inEntities, meshData, &index), 1u);
+    EXPECT_EQ(meshData.getTriangleCount(), 1u);
+    EXPECT_EQ(index.faces.size(), 1u);
+    EXPECT_DOUBLE_EQ(meshData.getBoundingBox().min.x, 511683.0);
+    
+    // The scan-built index applies the same rule
+    const std::string path = "entity_parser_bad_coordinate.dxf";
+    std::ofstream(path, std::ios::binary) << text;
+    EXPECT_EQ(DXFIndex::build(path).faces.size(), 1u);
+    std::remove(path.c_str());
+}
+
+TEST(DXFEntityParserTest, KeepsCheckedXCoordinates) {
+    std::string text = " 10\n1.5\n 11\n2.5\n 12\n3.5\n 20\n4\n  0\nEOF\n";
+    DXFTokenizer tokenizer(text);
+    DXFGroup group;
+    EntityParser<Face3DEntity>::Record face;
+    
+    ASSERT_TRUE(EntityParser<Face3DEntity>::parse(tokenizer, group, face));
+    EXPECT_EQ(face.checked, 0x7);
+    EXPECT_DOUBLE_EQ(face.checkedX[2], 3.5);
+    
+    // vertex() reads the kept value rather than converting the text again
+    face.fields[EntityParser<Face3DEntity>::Layout::coordinate(0, 0)] = "9";
+    EXPECT_DOUBLE_EQ(face.vertex(0).x, 1.5);
+    EXPECT_DOUBLE_EQ(face.vertex(0).y, 4.0);
+}
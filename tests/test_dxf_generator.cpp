@@ -0,0 +1,124 @@
+/**
+ * @file test_dxf_generator.cpp
+ * @brief Unit tests for the synthetic pit-surface DXF generator
+ */
+
+#include <gtest/gtest.h>
+#include "DXFGenerator.h"
+#include "DXFReader.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+using namespace DXFProcessor;
+
+class DXFGeneratorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testOutputDir = "generator_test_output";
+        std::filesystem::create_directories(testOutputDir);
+    }
+    
+    void TearDown() override {
+        std::filesystem::remove_all(testOutputDir);
+    }
+    
+    std::unique_ptr<MeshData> readGenerated(const GeneratorOptions& options, const std::string& name) {
+        std::string path = testOutputDir + "/" + name;
+        DXFGenerator(options).write(path);
+        return DXFReaderFactory::createReader()->readFile(path);
+    }
+    
+    std::string testOutputDir;
+};
+
+TEST_F(DXFGeneratorTest, ReaderParsesEveryFace) {
+    GeneratorOptions options;
+    options.faceCount = 40001;  // Odd, and more than two blocks
+    options.layerCount = 4;
+    options.threadCount = 2;
+    
+    auto mesh = readGenerated(options, "pit.dxf");
+    ASSERT_EQ(mesh->getTriangleCount(), 40001u);
+    EXPECT_EQ(mesh->getLayerCount(), 5u);  // "0" plus PIT_01..PIT_04
+    EXPECT_EQ(mesh->getLayerName(1), "PIT_01");
+    EXPECT_GT(mesh->getTotalSurfaceArea(), 0.0);
+    
+    BoundingBox box = mesh->getBoundingBox();
+    EXPECT_NEAR(box.center().x, 512000.0, 10.0);
+    EXPECT_NEAR(box.center().y, 7004000.0, 10.0);
+    EXPECT_GT(box.size().z, 20.0);  // The pit is dug into the surface
+}
+
+TEST_F(DXFGeneratorTest, OutputDependsOnSeedNotThreads) {
+    GeneratorOptions options;
+    options.faceCount = 3 * DXFGenerator::FACES_PER_BLOCK + 17;
+    options.threadCount = 1;
+    std::string single = DXFGenerator(options).generate();
+    options.threadCount = 4;
+    EXPECT_EQ(DXFGenerator(options).generate(), single);
+    
+    options.seed = 2;
+    EXPECT_NE(DXFGenerator(options).generate(), single);
+    
+    options.noise = 0.0;
+    options.seed = 1;
+    std::string smooth = DXFGenerator(options).generate();
+    options.seed = 2;
+    EXPECT_EQ(DXFGenerator(options).generate(), smooth);
+}
+
+TEST_F(DXFGeneratorTest, QuadsAndLineEndings) {
+    GeneratorOptions options;
+    options.faceCount = 1000;
+    options.quads = true;
+    options.crlf = true;
+    
+    std::string text = DXFGenerator(options).generate();
+    EXPECT_EQ(text.rfind("  0\r\nSECTION\r\n", 0), 0u);
+    EXPECT_EQ(text.substr(text.size() - 10), "  0\r\nEOF\r\n");
+    EXPECT_EQ(std::count(text.begin(), text.end(), '\n'), std::count(text.begin(), text.end(), '\r'));
+    
+    auto mesh = readGenerated(options, "quads.dxf");
+    EXPECT_EQ(mesh->getTriangleCount(), 1000u);
+    
+    // A quad covers a whole 2 m cell, so its first three corners span half of it
+    EXPECT_NEAR(mesh->getTotalSurfaceArea() / 1000.0, 2.0, 0.5);
+}
+
+TEST_F(DXFGeneratorTest, WritesBinaryDXF) {
+    GeneratorOptions options;
+    options.faceCount = 10;
+    options.binary = true;
+    
+    std::string bytes = DXFGenerator(options).generate();
+    ASSERT_GT(bytes.size(), DXFGenerator::BINARY_SENTINEL_SIZE);
+    EXPECT_EQ(bytes.compare(0, DXFGenerator::BINARY_SENTINEL_SIZE,
+                            std::string(DXFGenerator::BINARY_SENTINEL, DXFGenerator::BINARY_SENTINEL_SIZE)), 0);
+    EXPECT_EQ(bytes.substr(DXFGenerator::BINARY_SENTINEL_SIZE, 10), std::string("\0\0SECTION\0", 10));
+    EXPECT_EQ(bytes.substr(bytes.size() - 6), std::string("\0\0EOF\0", 6));
+    
+    // Each face: 12 doubles of 2 + 8 bytes, one per corner coordinate
+    options.faceCount = 11;
+    EXPECT_GT(DXFGenerator(options).generate().size(), bytes.size() + 12 * 10);
+}
+
+TEST_F(DXFGeneratorTest, RejectsInvalidOptions) {
+    GeneratorOptions options;
+    options.layerCount = 0;
+    EXPECT_THROW(DXFGenerator{options}, GeneratorException);
+    
+    options = GeneratorOptions();
+    options.noise = -1.0;
+    EXPECT_THROW(DXFGenerator{options}, GeneratorException);
+    
+    options = GeneratorOptions();
+    options.binary = true;
+    options.crlf = true;
+    EXPECT_THROW(DXFGenerator{options}, GeneratorException);
+    
+    options = GeneratorOptions();
+    options.faceCount = 10;
+    std::ofstream(testOutputDir + "/file") << "x";
+    EXPECT_THROW(DXFGenerator(options).write(testOutputDir + "/file/pit.dxf"), GeneratorException);
+}
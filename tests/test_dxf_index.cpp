@@ -0,0 +1,264 @@
+/**
+ * @file test_dxf_index.cpp
+ * @brief Unit tests for the DXF sidecar index and indexed reads
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "DXFIndex.h"
+#include "DXFReader.h"
+#include "ThreadPool.h"
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using namespace DXFProcessor;
+
+class DXFIndexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testDataDir = TEST_DATA_DIR;
+        testOutputDir = "index_test_output";
+        std::filesystem::create_directories(testOutputDir);
+        
+        // Work on a copy so sidecar files never land in the source tree
+        layeredFile = testOutputDir + "/two_layers.dxf";
+        std::filesystem::copy_file(testDataDir + "/two_layers.dxf", layeredFile,
+                                   std::filesystem::copy_options::overwrite_existing);
+    }
+    
+    void TearDown() override {
+        if (std::filesystem::exists(testOutputDir)) {
+            std::filesystem::remove_all(testOutputDir);
+        }
+    }
+    
+    std::string testDataDir;
+    std::string testOutputDir;
+    std::string layeredFile;
+};
+
+TEST_F(DXFIndexTest, BuildRecordsSectionsAndFaces) {
+    DXFIndex index = DXFIndex::build(layeredFile);
+    
+    EXPECT_EQ(index.sourceSize, std::filesystem::file_size(layeredFile));
+    ASSERT_NE(index.findSection("HEADER"), nullptr);
+    ASSERT_NE(index.findSection("ENTITIES"), nullptr);
+    EXPECT_EQ(index.findSection("TABLES"), nullptr);
+    
+    const DXFSectionRange* entities = index.findSection("ENTITIES");
+    EXPECT_LT(entities->begin, entities->end);
+    
+    ASSERT_EQ(index.faces.size(), 2);
+    EXPECT_GT(index.faces[1].offset, index.faces[0].offset);
+    EXPECT_EQ(index.layerNames[index.faces[0].layer], "0");
+    EXPECT_EQ(index.layerNames[index.faces[1].layer], "Bench 1");
+    
+    EXPECT_FLOAT_EQ(index.faces[1].minX, 2.0f);
+    EXPECT_FLOAT_EQ(index.faces[1].maxX, 3.0f);
+    EXPECT_LE(index.faces[1].minY, 0.0f);
+    EXPECT_GE(index.faces[1].maxY, 0.866f);
+}
+
+TEST_F(DXFIndexTest, SaveAndLoadRoundTrip) {
+    DXFIndex built = DXFIndex::build(layeredFile);
+    std::string sidecar = DXFIndex::sidecarPath(layeredFile);
+    built.save(sidecar);
+    
+    DXFIndex loaded = DXFIndex::load(sidecar);
+    
+    EXPECT_EQ(loaded.sourceSize, built.sourceSize);
+    EXPECT_EQ(loaded.sections.size(), built.sections.size());
+    EXPECT_EQ(loaded.layerNames, built.layerNames);
+    ASSERT_EQ(loaded.faces.size(), built.faces.size());
+    EXPECT_EQ(loaded.faces[1].offset, built.faces[1].offset);
+    EXPECT_EQ(loaded.faces[1].length, built.faces[1].length);
+}
+
+TEST_F(DXFIndexTest, LoadRejectsForeignFile) {
+    EXPECT_THROW(DXFIndex::load(layeredFile), DXFIndexException);
+    EXPECT_THROW(DXFIndex::load(testOutputDir + "/missing.dxfidx"), DXFIndexException);
+}
+
+TEST_F(DXFIndexTest, LoadRejectsCorruptSidecar) {
+    std::string sidecar = DXFIndex::sidecarPath(layeredFile);
+    DXFIndex::build(layeredFile).save(sidecar);
+    std::string bytes;
+    {
+        std::ifstream in(sidecar, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    auto writeCorrupted = [&](size_t offset, const void* value, size_t size) {
+        std::string corrupted = bytes;
+        corrupted.replace(offset, size, static_cast<const char*>(value), size);
+        std::ofstream(sidecar, std::ios::binary | std::ios::trunc) << corrupted;
+    };
+    
+    // Face count in the header (after magic, version, size, time, hash, section and layer counts)
+    const std::uint64_t hugeCount = std::uint64_t{1} << 60;
+    writeCorrupted(44, &hugeCount, sizeof(hugeCount));
+    EXPECT_THROW(DXFIndex::load(sidecar), DXFIndexException);
+    
+    // Layer id of the last face
+    const LayerId unknownLayer = 999;
+    writeCorrupted(bytes.size() - sizeof(DXFIndexEntry) + offsetof(DXFIndexEntry, layer), &unknownLayer,
+                   sizeof(unknownLayer));
+    EXPECT_THROW(DXFIndex::load(sidecar), DXFIndexException);
+    
+    // Offset of the last face
+    const std::uint64_t farOffset = 1 << 20;
+    writeCorrupted(bytes.size() - sizeof(DXFIndexEntry), &farOffset, sizeof(farOffset));
+    EXPECT_THROW(DXFIndex::load(sidecar), DXFIndexException);
+    
+    // The reader rebuilds instead
+    DXFIndexedReader reader(layeredFile);
+    EXPECT_EQ(reader.read(DXFIndexQuery())->getTriangleCount(), 2);
+    EXPECT_NO_THROW(DXFIndex::load(sidecar));
+}
+
+TEST_F(DXFIndexTest, UnwritableSidecarKeepsIndexInMemory) {
+    // A directory in the sidecar's place can be neither loaded nor replaced, even by root
+    const std::string sidecar = DXFIndex::sidecarPath(layeredFile);
+    std::filesystem::create_directory(sidecar);
+    
+    DXFIndexedReader reader(layeredFile);
+    EXPECT_EQ(reader.read(DXFIndexQuery())->getTriangleCount(), 2);
+    EXPECT_EQ(reader.read(DXFIndexQuery::window(1.8, -1.0, 5.0, 1.0))->getTriangleCount(), 1);
+    EXPECT_TRUE(std::filesystem::is_directory(sidecar));
+}
+
+TEST_F(DXFIndexTest, SameSizeEditInvalidatesSidecar) {
+    DXFIndexedReader(layeredFile).index();
+    auto modified = std::filesystem::last_write_time(layeredFile);
+    
+    // Move the second face's vertex from x = 3.0 to x = 7.0 without changing the file size
+    std::string text;
+    {
+        std::ifstream in(layeredFile, std::ios::binary);
+        text.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    size_t vertex = text.find("3.0");
+    ASSERT_NE(vertex, std::string::npos);
+    text[vertex] = '7';
+    std::ofstream(layeredFile, std::ios::binary | std::ios::trunc) << text;
+    std::filesystem::last_write_time(layeredFile, modified);
+    
+    DXFIndexedReader reader(layeredFile);
+    auto window = reader.read(DXFIndexQuery::window(6.0, -1.0, 8.0, 1.0));
+    ASSERT_EQ(window->getTriangleCount(), 1);
+    EXPECT_DOUBLE_EQ(window->getTriangle(0).vertices[1].x, 7.0);
+}
+
+TEST_F(DXFIndexTest, WindowAndLayerQueries) {
+    DXFIndexedReader reader(layeredFile);
+    EXPECT_TRUE(std::filesystem::exists(DXFIndex::sidecarPath(layeredFile)));
+    
+    auto window = reader.read(DXFIndexQuery::window(1.8, -1.0, 5.0, 1.0));
+    ASSERT_EQ(window->getTriangleCount(), 1);
+    EXPECT_DOUBLE_EQ(window->getTriangles()[0].vertices[1].x, 3.0);
+    EXPECT_EQ(window->getLayerName(window->getTriangleLayer(0)), "Bench 1");
+    
+    DXFIndexQuery layerQuery;
+    layerQuery.layers = {"0"};
+    auto layer = reader.read(layerQuery);
+    ASSERT_EQ(layer->getTriangleCount(), 1);
+    EXPECT_DOUBLE_EQ(layer->getTriangles()[0].vertices[0].x, 0.0);
+    
+    auto nothing = reader.read(DXFIndexQuery::window(100.0, 100.0, 200.0, 200.0));
+    EXPECT_TRUE(nothing->isEmpty());
+}
+
+TEST_F(DXFIndexTest, ReaderWritesSidecarWhenEnabled) {
+    auto reader = DXFReaderFactory::createReader();
+    reader->setWriteIndex(true);
+    reader->readFile(layeredFile);
+    
+    DXFIndex index = DXFIndex::load(DXFIndex::sidecarPath(layeredFile));
+    EXPECT_EQ(index.faces.size(), 2);
+}
+
+TEST_F(DXFIndexTest, ReadTimeIndexMatchesScan) {
+    std::string designPit = testOutputDir + "/Design Pit.dxf";
+    std::filesystem::copy_file(std::string(MAIN_DATA_DIR) + "/Design Pit.dxf", designPit);
+    const DXFIndex scanned = DXFIndex::build(designPit);
+    
+    // Sequential chunks, then parallel ranges merged in file order
+    ThreadPool pool(4);
+    for (bool split : {false, true}) {
+        SCOPED_TRACE(split ? "split" : "sequential");
+        auto reader = DXFReaderFactory::createReader();
+        reader->setWriteIndex(true);
+        if (split) {
+            reader->setThreadPool(&pool, 64 * 1024);
+        }
+        reader->readFile(designPit);
+        DXFIndex recorded = DXFIndex::load(DXFIndex::sidecarPath(designPit));
+        
+        EXPECT_TRUE(recorded.matchesSource(MappedFile(designPit)));
+        EXPECT_EQ(recorded.layerNames, scanned.layerNames);
+        ASSERT_EQ(recorded.sections.size(), scanned.sections.size());
+        for (size_t i = 0; i < scanned.sections.size(); ++i) {
+            EXPECT_EQ(recorded.sections[i].name, scanned.sections[i].name);
+            EXPECT_EQ(recorded.sections[i].begin, scanned.sections[i].begin);
+            EXPECT_EQ(recorded.sections[i].end, scanned.sections[i].end);
+        }
+        ASSERT_EQ(recorded.faces.size(), scanned.faces.size());
+        for (size_t i = 0; i < scanned.faces.size(); ++i) {
+            const DXFIndexEntry& a = recorded.faces[i];
+            const DXFIndexEntry& b = scanned.faces[i];
+            ASSERT_TRUE(a.offset == b.offset && a.length == b.length && a.layer == b.layer &&
+                        a.minX == b.minX && a.minY == b.minY && a.maxX == b.maxX && a.maxY == b.maxY)
+                << "Face " << i;
+        }
+    }
+}
+
+TEST_F(DXFIndexTest, MissingYBoundsMatchParser) {
+    // One face without Y groups, one whose Y values are not numbers
+    std::string flat = testOutputDir + "/flat.dxf";
+    {
+        std::ofstream out(flat);
+        out << "0\nSECTION\n2\nENTITIES\n"
+            << "0\n3DFACE\n8\n0\n10\n1.0\n11\n2.0\n12\n1.5\n"
+            << "0\n3DFACE\n8\n0\n10\n4.0\n20\nabc\n11\n5.0\n21\n3.0\n12\n4.5\n22\nxyz\n"
+            << "0\nENDSEC\n0\nEOF\n";
+    }
+    const DXFIndex scanned = DXFIndex::build(flat);
+    ASSERT_EQ(scanned.faces.size(), 2);
+    EXPECT_EQ(scanned.faces[0].minY, 0.0f);
+    EXPECT_EQ(scanned.faces[0].maxY, 0.0f);
+    EXPECT_EQ(scanned.faces[1].minY, 0.0f);
+    EXPECT_EQ(scanned.faces[1].maxY, 3.0f);
+    
+    auto reader = DXFReaderFactory::createReader();
+    reader->setWriteIndex(true);
+    reader->readFile(flat);
+    DXFIndex recorded = DXFIndex::load(DXFIndex::sidecarPath(flat));
+    ASSERT_EQ(recorded.faces.size(), scanned.faces.size());
+    for (size_t i = 0; i < scanned.faces.size(); ++i) {
+        EXPECT_EQ(recorded.faces[i].minY, scanned.faces[i].minY) << "Face " << i;
+        EXPECT_EQ(recorded.faces[i].maxY, scanned.faces[i].maxY) << "Face " << i;
+    }
+    
+    DXFIndexedReader indexed(flat, false);
+    EXPECT_EQ(indexed.read(DXFIndexQuery::window(0.0, -0.5, 3.0, 0.5))->getTriangleCount(), 1);
+}
+
+TEST_F(DXFIndexTest, FullQueryMatchesSequentialRead) {
+    std::string designPit = testOutputDir + "/Design Pit.dxf";
+    std::filesystem::copy_file(std::string(MAIN_DATA_DIR) + "/Design Pit.dxf", designPit);
+    
+    auto sequential = DXFReaderFactory::createReader()->readFile(designPit);
+    DXFIndexedReader indexed(designPit, false);
+    auto all = indexed.read(DXFIndexQuery());
+    
+    EXPECT_EQ(indexed.index().faces.size(), 2929);
+    EXPECT_EQ(all->getTriangleCount(), sequential->getTriangleCount());
+    EXPECT_DOUBLE_EQ(all->getTotalSurfaceArea(), sequential->getTotalSurfaceArea());
+    
+    // A window over part of the pit selects a strict, non-empty subset
+    auto part = indexed.read(DXFIndexQuery::window(-773.0, 668.0, -600.0, 800.0));
+    EXPECT_GT(part->getTriangleCount(), 0);
+    EXPECT_LT(part->getTriangleCount(), all->getTriangleCount());
+}
@@ -0,0 +1,163 @@
+/**
+ * @file test_dxf_pipeline.cpp
+ * @brief Unit tests for the pipelined reader and its bounded SPSC queue
+ */
+
+#include <gtest/gtest.h>
+#include "DXFPipeline.h"
+#include "DXFReader.h"
+#include "SPSCQueue.h"
+#include <filesystem>
+#include <thread>
+
+using namespace DXFProcessor;
+
+class DXFPipelineTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testDataDir = TEST_DATA_DIR;
+        mainFile = std::string(MAIN_DATA_DIR) + "/Design Pit.dxf";
+    }
+    
+    static void expectSameSummary(const MeshSummary& actual, const MeshSummary& expected) {
+        EXPECT_EQ(actual.triangleCount, expected.triangleCount);
+        EXPECT_DOUBLE_EQ(actual.totalSurfaceArea, expected.totalSurfaceArea);
+        EXPECT_EQ(actual.boundingBox.min, expected.boundingBox.min);
+        EXPECT_EQ(actual.boundingBox.max, expected.boundingBox.max);
+        EXPECT_DOUBLE_EQ(actual.centroid.x, expected.centroid.x);
+        EXPECT_DOUBLE_EQ(actual.centroid.y, expected.centroid.y);
+        EXPECT_DOUBLE_EQ(actual.centroid.z, expected.centroid.z);
+        EXPECT_EQ(actual.customFields.size(), expected.customFields.size());
+        ASSERT_EQ(actual.layers.size(), expected.layers.size());
+        for (size_t i = 0; i < expected.layers.size(); ++i) {
+            EXPECT_EQ(actual.layers[i].name, expected.layers[i].name);
+            EXPECT_EQ(actual.layers[i].triangleCount, expected.layers[i].triangleCount);
+            EXPECT_DOUBLE_EQ(actual.layers[i].totalSurfaceArea, expected.layers[i].totalSurfaceArea);
+        }
+    }
+    
+    std::string testDataDir;
+    std::string mainFile;
+};
+
+TEST(SPSCQueueTest, DeliversInOrderAndCountsWaits) {
+    SPSCQueue<int> queue(2);
+    constexpr int COUNT = 10000;
+    
+    std::thread producer([&] {
+        for (int i = 0; i < COUNT; ++i) {
+            ASSERT_TRUE(queue.push(i));
+        }
+        queue.close();
+    });
+    
+    int expected = 0;
+    int value;
+    while (queue.pop(value)) {
+        ASSERT_EQ(value, expected++);
+    }
+    producer.join();
+    
+    EXPECT_EQ(expected, COUNT);
+    EXPECT_GT(queue.pushStats().waits + queue.popStats().waits, 0u);  // A 2-slot ring must stall
+}
+
+TEST(SPSCQueueTest, CancelReleasesBlockedEnds) {
+    SPSCQueue<int> queue(1);
+    ASSERT_TRUE(queue.push(1));
+    
+    std::thread producer([&] {
+        EXPECT_FALSE(queue.push(2));  // Blocks on the full ring until cancelled
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    queue.cancel();
+    producer.join();
+    
+    int value;
+    EXPECT_FALSE(queue.pop(value));
+}
+
+TEST_F(DXFPipelineTest, SmallChunksMatchSequentialSummary) {
+    if (!std::filesystem::exists(mainFile)) {
+        GTEST_SKIP() << "Main data file not available";
+    }
+    
+    auto reader = DXFReaderFactory::createReader();
+    auto meshData = reader->readFile(mainFile);
+    auto summarizer = MeshSummarizerFactory::create("basic");
+    summarizer->setGroupByLayer(true);
+    MeshSummary expected = summarizer->summarize(*meshData);
+    
+    // 4 KB chunks cut the 760 KB file into ~190 pieces; depth 2 forces back-pressure
+    PipelineOptions options;
+    options.chunkBytes = 4 * 1024;
+    options.queueDepth = 2;
+    PipelineResult result = DXFPipeline(options).run(mainFile, *summarizer);
+    
+    expectSameSummary(result.summary, expected);
+    EXPECT_EQ(result.entityCount, reader->getLastEntityCount());
+    EXPECT_EQ(result.bytesRead, std::filesystem::file_size(mainFile));
+    ASSERT_EQ(result.stages.size(), 3u);
+    EXPECT_EQ(result.stages[0].name, "read");
+    EXPECT_GT(result.stages[0].items, 100u);
+    EXPECT_EQ(result.stages[1].items, result.stages[0].items);
+    EXPECT_EQ(result.stages[2].items, result.stages[0].items);
+}
+
+TEST_F(DXFPipelineTest, DetailedSummarizerGetsWholeMesh) {
+    if (!std::filesystem::exists(mainFile)) {
+        GTEST_SKIP() << "Main data file not available";
+    }
+    
+    auto meshData = DXFReaderFactory::createReader()->readFile(mainFile);
+    auto summarizer = MeshSummarizerFactory::create("detailed");
+    MeshSummary expected = summarizer->summarize(*meshData);
+    
+    PipelineOptions options;
+    options.chunkBytes = 16 * 1024;
+    PipelineResult result = DXFPipeline(options).run(mainFile, *summarizer);
+    
+    expectSameSummary(result.summary, expected);
+    const MetricKey small = MetricKey::intern("small_triangles_count");
+    ASSERT_NE(result.summary.customFields.find(small), nullptr);
+    EXPECT_EQ(*result.summary.customFields.find(small), *expected.customFields.find(small));
+}
+
+TEST_F(DXFPipelineTest, CustomSummarizerKeepsItsMetrics) {
+    // Overrides a hook summarizeTotals never calls, without opting in to streaming
+    class CountingSummarizer : public MeshSummarizer {
+    protected:
+        void addCustomCalculations(const MeshData& meshData, MeshSummary& summary) override {
+            summary.addCustomField("layer_count", meshData.getLayerCount());
+        }
+    };
+    CountingSummarizer summarizer;
+    EXPECT_FALSE(summarizer.isStreamable());
+    EXPECT_TRUE(MeshSummarizerFactory::create("basic")->isStreamable());
+    
+    PipelineResult result = DXFPipeline().run(testDataDir + "/two_layers.dxf", summarizer);
+    
+    EXPECT_EQ(result.summary.triangleCount, 2);
+    EXPECT_EQ(result.summary.getCustomField("layer_count"), "2");
+}
+
+TEST_F(DXFPipelineTest, ChunkSmallerThanOneEntity) {
+    // Every 16-byte read ends mid-entity, so chunks only end once a later group is seen
+    auto summarizer = MeshSummarizerFactory::create("basic");
+    summarizer->setGroupByLayer(true);
+    PipelineOptions options;
+    options.chunkBytes = 16;
+    PipelineResult result = DXFPipeline(options).run(testDataDir + "/two_layers.dxf", *summarizer);
+    
+    EXPECT_EQ(result.summary.triangleCount, 2);
+    ASSERT_EQ(result.summary.layers.size(), 2);
+    EXPECT_EQ(result.summary.layers[1].name, "Bench 1");
+}
+
+TEST_F(DXFPipelineTest, ReportsReaderErrors) {
+    auto summarizer = MeshSummarizerFactory::create("basic");
+    DXFPipeline pipeline;
+    EXPECT_THROW(pipeline.run(testDataDir + "/does_not_exist.dxf", *summarizer), DXFReaderException);
+    EXPECT_THROW(pipeline.run(testDataDir + "/empty.dxf", *summarizer), DXFReaderException);
+    EXPECT_THROW(pipeline.run(testDataDir + "/malformed.dxf", *summarizer), DXFReaderException);
+}
@@ -5,7 +5,11 @@
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include "DXFGenerator.h"
 #include "DXFReader.h"
+#include "Profiler.h"
+#include "ThreadPool.h"
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 
@@ -99,7 +103,7 @@ TEST_F(DXFReaderTest, VerifyTriangleGeometry) {
     
     ASSERT_EQ(meshData->getTriangleCount(), 1);
     
-    const Triangle& triangle = meshData->triangles[0];
+    const Triangle& triangle = meshData->getTriangles()[0];
     
     // Verify vertices match what we put in the test file
     EXPECT_DOUBLE_EQ(triangle.vertices[0].x, 0.0);
@@ -209,4 +213,235 @@ TEST_F(DXFReaderTest, ProgressCallbackWithMock) {
     });
     
     reader->readFile(singleTriangleFile);
-}
\ No newline at end of file
+}
+
+TEST_F(DXFReaderTest, ReadLayerNames) {
+    std::string twoLayersFile = testDataDir + "/two_layers.dxf";
+    
+    auto meshData = reader->readFile(twoLayersFile);
+    
+    ASSERT_EQ(meshData->getTriangleCount(), 2);
+    EXPECT_EQ(meshData->getLayerCount(), 2);
+    EXPECT_EQ(meshData->getLayerName(meshData->getTriangleLayer(0)), "0");
+    EXPECT_EQ(meshData->getLayerName(meshData->getTriangleLayer(1)), "Bench 1");
+}
+
+TEST_F(DXFReaderTest, ReadHeaderOnly) {
+    std::string singleTriangleFile = testDataDir + "/single_triangle.dxf";
+    
+    DXFHeaderInfo header = reader->readHeader(singleTriangleFile);
+    
+    EXPECT_EQ(header.acadVersion, "AC1027");
+    EXPECT_FALSE(header.hasExtents);  // Fixture has no $EXTMIN/$EXTMAX
+    EXPECT_EQ(header.fileSize, std::filesystem::file_size(singleTriangleFile));
+    EXPECT_LT(header.headerBytes, header.fileSize);
+    EXPECT_EQ(reader->getLastEntityCount(), 0);
+}
+
+TEST_F(DXFReaderTest, ReadHeaderMissingSection) {
+    EXPECT_THROW(reader->readHeader(testDataDir + "/malformed.dxf"), DXFReaderException);
+    EXPECT_THROW(reader->readHeader(testDataDir + "/does_not_exist.dxf"), DXFReaderException);
+}
+
+TEST_F(DXFReaderTest, SplitParseMatchesSequentialRead) {
+    std::string mainFile = std::string(MAIN_DATA_DIR) + "/Design Pit.dxf";
+    if (!std::filesystem::exists(mainFile)) {
+        GTEST_SKIP() << "Main data file not available";
+    }
+    
+    auto sequential = reader->readFile(mainFile);
+    
+    // Small ranges so the 760 KB file is cut into a dozen pieces
+    ThreadPool pool(4);
+    auto splitReader = DXFReaderFactory::createReader();
+    splitReader->setThreadPool(&pool, 64 * 1024);
+    auto split = splitReader->readFile(mainFile);
+    
+    ASSERT_EQ(split->getTriangleCount(), sequential->getTriangleCount());
+    EXPECT_EQ(splitReader->getLastEntityCount(), reader->getLastEntityCount());
+    EXPECT_EQ(split->getLayerNames(), sequential->getLayerNames());
+    for (size_t i = 0; i < sequential->getTriangleCount(); ++i) {
+        ASSERT_EQ(split->getTriangleLayers()[i], sequential->getTriangleLayers()[i]) << "triangle " << i;
+        for (size_t v = 0; v < 3; ++v) {
+            ASSERT_EQ(split->getTriangles()[i].vertices[v], sequential->getTriangles()[i].vertices[v]) << "triangle " << i;
+        }
+    }
+}
+
+TEST_F(DXFReaderTest, CompactStorage) {
+    std::string mainFile = std::string(MAIN_DATA_DIR) + "/Design Pit.dxf";
+    if (!std::filesystem::exists(mainFile)) {
+        GTEST_SKIP() << "Main data file not available";
+    }
+    
+    auto full = reader->readFile(mainFile);
+    reader->setCompactStorage(true);
+    auto compact = reader->readFile(mainFile);
+    
+    ASSERT_TRUE(compact->isCompact());
+    EXPECT_EQ(compact->getTriangleCount(), full->getTriangleCount());
+    EXPECT_EQ(compact->getLayerNames(), full->getLayerNames());
+    EXPECT_NEAR(compact->getTotalSurfaceArea(), full->getTotalSurfaceArea(), 1e-6 * full->getTotalSurfaceArea());
+    EXPECT_NEAR(compact->getBoundingBox().min.x, full->getBoundingBox().min.x, MeshData::COMPACT_TOLERANCE);
+}
+
+class DXFReaderProgressTest : public DXFReaderTest {
+protected:
+    void SetUp() override {
+        DXFReaderTest::SetUp();
+        std::filesystem::create_directories("reader_progress_output");
+        
+        // About 7 MB, so the read takes several PROGRESS_CHUNK_BYTES chunks
+        GeneratorOptions options;
+        options.faceCount = 40000;
+        largeFile = "reader_progress_output/pit.dxf";
+        DXFGenerator(options).write(largeFile);
+        largeFileSize = std::filesystem::file_size(largeFile);
+        ASSERT_GT(largeFileSize, 4 * DXFReader::PROGRESS_CHUNK_BYTES);
+    }
+    
+    void TearDown() override {
+        DXFReaderTest::TearDown();
+        std::filesystem::remove_all("reader_progress_output");
+    }
+    
+    std::string largeFile;
+    std::uintmax_t largeFileSize = 0;
+};
+
+TEST_F(DXFReaderProgressTest, ByteProgressCoversWholeFile) {
+    ReadProgress progress;
+    reader->setProgress(&progress);
+    
+    auto mesh = reader->readFile(largeFile);
+    EXPECT_EQ(mesh->getTriangleCount(), 40000u);
+    EXPECT_EQ(progress.bytesTotal(), largeFileSize);
+    EXPECT_EQ(progress.bytesDone(), largeFileSize);
+    EXPECT_DOUBLE_EQ(progress.fraction(), 1.0);
+    
+    // One callback per chunk, then 1.0
+    EXPECT_GE(progressValues.size(), 4u);
+    EXPECT_TRUE(std::is_sorted(progressValues.begin(), progressValues.end()));
+    EXPECT_DOUBLE_EQ(progressValues.back(), 1.0);
+}
+
+TEST_F(DXFReaderProgressTest, CancelledTokenStopsRead) {
+    CancellationToken cancel;
+    cancel.cancel();
+    reader->setCancellationToken(&cancel);
+    EXPECT_THROW(reader->readFile(largeFile), DXFReadCancelledException);
+    
+    // Still a DXFReaderException for callers that don't distinguish
+    EXPECT_THROW(reader->readFile(largeFile), DXFReaderException);
+    
+    cancel.reset();
+    EXPECT_EQ(reader->readFile(largeFile)->getTriangleCount(), 40000u);
+}
+
+TEST_F(DXFReaderProgressTest, CancelDuringReadStopsAtNextChunk) {
+    ReadProgress progress;
+    CancellationToken cancel;
+    reader->setProgress(&progress);
+    reader->setCancellationToken(&cancel);
+    reader->setProgressCallback([&](double) { cancel.cancel(); });
+    
+    EXPECT_THROW(reader->readFile(largeFile), DXFReadCancelledException);
+    
+    // Only the first chunk was parsed: it ends at the first face after 1 MB
+    EXPECT_GE(progress.bytesDone(), DXFReader::PROGRESS_CHUNK_BYTES);
+    EXPECT_LT(progress.bytesDone(), 2 * DXFReader::PROGRESS_CHUNK_BYTES);
+    EXPECT_LT(progress.fraction(), 1.0);
+}
+
+TEST_F(DXFReaderProgressTest, SplitReadIsCancellable) {
+    ThreadPool pool(2);
+    ReadProgress progress;
+    CancellationToken cancel;
+    reader->setThreadPool(&pool, 256 * 1024);
+    reader->setProgress(&progress);
+    reader->setCancellationToken(&cancel);
+    
+    auto mesh = reader->readFile(largeFile);
+    EXPECT_EQ(mesh->getTriangleCount(), 40000u);
+    EXPECT_EQ(progress.bytesDone(), largeFileSize);
+    
+    cancel.cancel();
+    EXPECT_THROW(reader->readFile(largeFile), DXFReadCancelledException);
+    EXPECT_LT(progress.fraction(), 1.0);
+}
+
+class DXFReaderAllocationTest : public DXFReaderTest {
+protected:
+    void SetUp() override {
+        DXFReaderTest::SetUp();
+        if (!Profiler::compiledIn()) {
+            GTEST_SKIP() << "Allocation counting needs DXF_PROFILING";
+        }
+        std::filesystem::create_directories("reader_allocation_output");
+    }
+    
+    void TearDown() override {
+        Profiler::disable();
+        DXFReaderTest::TearDown();
+        std::filesystem::remove_all("reader_allocation_output");
+    }
+    
+    /// Faces alternating between two layer names too long for the small-string buffer
+    std::string writeFile(size_t faceCount) {
+        std::string path = "reader_allocation_output/faces_" + std::to_string(faceCount) + ".dxf";
+        std::ofstream out(path);
+        out << "0\nSECTION\n2\nENTITIES\n";
+        for (size_t i = 0; i < faceCount; ++i) {
+            double x = static_cast<double>(i);
+            out << "0\n3DFACE\n8\n" << (i % 2 ? "DESIGN_SURFACE_BENCH_NORTH" : "DESIGN_SURFACE_BENCH_SOUTH")
+                << "\n10\n" << x << "\n20\n0\n30\n0\n11\n" << x + 1 << "\n21\n0\n31\n0\n"
+                << "12\n" << x << "\n22\n1\n32\n0\n13\n" << x << "\n23\n1\n33\n0\n";
+        }
+        out << "0\nENDSEC\n0\nEOF\n";
+        return path;
+    }
+    
+    /// Heap allocations made by one read of the file with the fixture's reader
+    std::uint64_t allocationsFor(const std::string& path) {
+        Profiler::enable();
+        auto mesh = reader->readFile(path);
+        std::uint64_t allocations = Profiler::report().counter(ProfileCounter::Allocations);
+        Profiler::disable();
+        EXPECT_FALSE(mesh->isEmpty());
+        return allocations;
+    }
+};
+
+TEST_F(DXFReaderAllocationTest, AllocationsDoNotGrowWithEntities) {
+    std::string small = writeFile(1000);
+    std::string large = writeFile(40000);
+    
+    // The reader is reused, so both measured reads start with a warm arena
+    allocationsFor(small);
+    std::uint64_t smallCount = allocationsFor(small);
+    std::uint64_t largeCount = allocationsFor(large);
+    
+    // 40 times the entities: only a few more triangle and layer blocks, nothing per entity
+    EXPECT_LT(largeCount, smallCount + 16) << smallCount << " allocations for 1000 faces";
+}
+
+TEST_F(DXFReaderAllocationTest, ReusedSplitReaderGivesSameMesh) {
+    std::string path = writeFile(20000);
+    ThreadPool pool(2);
+    reader->setThreadPool(&pool, 64 * 1024);
+    
+    auto first = reader->readFile(path);
+    std::uint64_t allocations = allocationsFor(path);
+    auto second = reader->readFile(path);
+    
+    ASSERT_EQ(first->getTriangleCount(), 20000u);
+    ASSERT_EQ(second->getTriangleCount(), first->getTriangleCount());
+    EXPECT_EQ(second->getLayerNames(), first->getLayerNames());
+    for (size_t i = 0; i < first->getTriangleCount(); i += 997) {
+        EXPECT_EQ(second->getTriangleLayer(i), first->getTriangleLayer(i));
+        EXPECT_EQ(second->getTriangles()[i].vertices[1].x, first->getTriangles()[i].vertices[1].x);
+    }
+    
+    // Per range, not per entity: each range fills its own part mesh
+    EXPECT_LT(allocations, 20000u / 10);
+}
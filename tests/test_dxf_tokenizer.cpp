@@ -0,0 +1,153 @@
+/**
+ * @file test_dxf_tokenizer.cpp
+ * @brief Unit tests for the block-based DXF tokenizer
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "DXFTokenizer.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace DXFProcessor;
+
+namespace {
+
+    // Reference implementation: the original getline-and-trim approach
+    std::vector<std::string> referenceLines(const std::string& text) {
+        std::vector<std::string> lines;
+        std::istringstream stream(text);
+        std::string line;
+        while (std::getline(stream, line)) {
+            line.erase(line.find_last_not_of(" \t\r\n") + 1);
+            line.erase(0, line.find_first_not_of(" \t"));
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    std::vector<std::string> tokenizerLines(const std::string& text) {
+        std::vector<std::string> lines;
+        DXFTokenizer tokenizer(text);
+        std::string_view line;
+        while (tokenizer.nextLine(line)) {
+            lines.emplace_back(line);
+        }
+        return lines;
+    }
+
+}
+
+TEST(DXFTokenizerTest, ReadsPairsWithLF) {
+    std::string text = "  0\nSECTION\n  2\nENTITIES\n 10\n-773.5\n";
+    DXFTokenizer tokenizer(text);
+    DXFGroup group;
+    
+    ASSERT_TRUE(tokenizer.next(group));
+    EXPECT_TRUE(group.valid);
+    EXPECT_EQ(group.code, 0);
+    EXPECT_EQ(group.value, "SECTION");
+    EXPECT_EQ(group.offset, 0);
+    
+    ASSERT_TRUE(tokenizer.next(group));
+    EXPECT_EQ(group.code, 2);
+    EXPECT_EQ(group.value, "ENTITIES");
+    
+    ASSERT_TRUE(tokenizer.next(group));
+    EXPECT_EQ(group.code, 10);
+    EXPECT_EQ(text.substr(group.offset, 3), " 10");
+    double value = 0.0;
+    EXPECT_TRUE(DXFTokenizer::parseDouble(group.value, value));
+    EXPECT_DOUBLE_EQ(value, -773.5);
+    
+    EXPECT_FALSE(tokenizer.next(group));
+    EXPECT_EQ(tokenizer.lineCount(), 6);
+}
+
+TEST(DXFTokenizerTest, HandlesCRLFAndMissingFinalNewline) {
+    std::string text = "  8\r\nPit Layer  \r\n 30\r\n381";
+    DXFTokenizer tokenizer(text);
+    DXFGroup group;
+    
+    ASSERT_TRUE(tokenizer.next(group));
+    EXPECT_EQ(group.code, 8);
+    EXPECT_EQ(group.value, "Pit Layer");
+    
+    ASSERT_TRUE(tokenizer.next(group));
+    EXPECT_EQ(group.code, 30);
+    EXPECT_EQ(group.value, "381");
+    EXPECT_FALSE(tokenizer.next(group));
+}
+
+TEST(DXFTokenizerTest, InvalidCodeConsumesOneLine) {
+    std::string text = "garbage\n  0\n3DFACE\n";
+    DXFTokenizer tokenizer(text);
+    DXFGroup group;
+    
+    ASSERT_TRUE(tokenizer.next(group));
+    EXPECT_FALSE(group.valid);
+    EXPECT_EQ(group.value, "garbage");
+    
+    ASSERT_TRUE(tokenizer.next(group));
+    EXPECT_TRUE(group.valid);
+    EXPECT_EQ(group.code, 0);
+    EXPECT_EQ(group.value, "3DFACE");
+}
+
+TEST(DXFTokenizerTest, LinesSpanningBlockBoundaries) {
+    // Long values, long runs of blanks and empty lines all cross 64-byte blocks
+    std::string text;
+    text += std::string(70, ' ') + "1\n";
+    text += std::string(150, 'x') + "\n";
+    text += "\n\n \t \n";
+    text += "\t" + std::string(63, ' ') + "value with spaces\t \r\n";
+    for (int i = 0; i < 200; ++i) {
+        text += std::string(i % 7, ' ') + std::to_string(i) + (i % 3 == 0 ? "\r\n" : "\n");
+    }
+    
+    EXPECT_EQ(tokenizerLines(text), referenceLines(text));
+}
+
+TEST(DXFTokenizerTest, LinesSpanningChunkBoundaries) {
+    // Lines longer than a whole chunk and many short lines around chunk edges
+    std::string text;
+    for (int i = 0; i < 3000; ++i) {
+        text += " " + std::to_string(i % 100) + "\r\n";
+        if (i % 700 == 0) {
+            text += std::string(DXFTokenizer::CHUNK_SIZE + 17, 'y') + "\n";
+            text += std::string(DXFTokenizer::CHUNK_SIZE, ' ') + "z\n";
+        }
+    }
+    
+    EXPECT_EQ(tokenizerLines(text), referenceLines(text));
+}
+
+TEST(DXFTokenizerTest, StartsAtUnalignedOffset) {
+    std::string text = "  0\nSECTION\n  2\nHEADER\n";
+    DXFTokenizer tokenizer(text, 12);
+    DXFGroup group;
+    
+    ASSERT_TRUE(tokenizer.next(group));
+    EXPECT_EQ(group.code, 2);
+    EXPECT_EQ(group.value, "HEADER");
+}
+
+TEST(DXFTokenizerTest, EmptyBuffer) {
+    DXFTokenizer tokenizer(std::string_view{});
+    DXFGroup group;
+    EXPECT_FALSE(tokenizer.next(group));
+    EXPECT_EQ(tokenizer.position(), 0);
+}
+
+TEST(DXFTokenizerTest, MatchesReferenceOnDesignPit) {
+    std::ifstream file(std::string(MAIN_DATA_DIR) + "/Design Pit.dxf", std::ios::binary);
+    ASSERT_TRUE(file.is_open());
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    
+    EXPECT_EQ(tokenizerLines(text), referenceLines(text));
+    
+    std::string implementation = DXFTokenizer::implementationName();
+    EXPECT_THAT(implementation, ::testing::AnyOf("AVX2", "SSE2", "scalar"));
+}
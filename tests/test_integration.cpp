@@ -107,6 +107,31 @@ TEST_F(IntegrationTest, DesignPitDXFSpecificValidation) {
     EXPECT_NEAR(totalArea, 141519.89, 10.0);
 }
 
+TEST_F(IntegrationTest, HeaderOnlyExtents) {
+    auto reader = DXFReaderFactory::createReader();
+    DXFHeaderInfo header = reader->readHeader(designPitPath);
+    
+    EXPECT_EQ(header.acadVersion, "AC1027");
+    EXPECT_EQ(header.unitsName(), "inches");
+    ASSERT_TRUE(header.hasExtents);
+    
+    // Header extents agree with the recomputed bounding box
+    EXPECT_DOUBLE_EQ(header.extents.min.x, -773.0);
+    EXPECT_DOUBLE_EQ(header.extents.min.y, 668.71875);
+    EXPECT_DOUBLE_EQ(header.extents.max.x, -296.0);
+    EXPECT_DOUBLE_EQ(header.extents.max.z, 381.0);
+    
+    // Only the header is consumed; the estimate lands near the real 2929 faces
+    EXPECT_LT(header.headerBytes, header.fileSize / 10);
+    EXPECT_GT(header.estimatedEntityCount, 2000);
+    EXPECT_LT(header.estimatedEntityCount, 4000);
+    
+    auto writer = SummaryWriterFactory::create("json", testOutputDir);
+    writer->setIncludeTimestamp(false);
+    std::string outputPath = writer->writeHeaderToFile(header, "design_pit_header");
+    EXPECT_TRUE(std::filesystem::exists(outputPath));
+}
+
 TEST_F(IntegrationTest, ProgressReporting) {
     auto reader = DXFReaderFactory::createReader();
     
@@ -0,0 +1,141 @@
+/**
+ * @file test_mesh_cleanup.cpp
+ * @brief Unit tests for degenerate and duplicate triangle detection
+ */
+
+#include <gtest/gtest.h>
+#include "MeshCleanup.h"
+#include "MeshSummarizer.h"
+#include "test_meshes.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace DXFProcessor;
+
+TEST(MeshCleanupTest, FlagsZeroAreaAndSlivers) {
+    std::vector<Triangle> faces;
+    faces.emplace_back(Point3D(0, 0, 0), Point3D(1, 0, 0), Point3D(0, 1, 0));     // Fine, area 0.5
+    faces.emplace_back(Point3D(0, 0, 0), Point3D(1, 1, 1), Point3D(2, 2, 2));     // Collinear
+    faces.emplace_back(Point3D(5, 5, 5), Point3D(5, 5, 5), Point3D(6, 5, 5));     // Repeated vertex
+    faces.emplace_back(Point3D(0, 0, 0), Point3D(1e7, 0, 0), Point3D(5e6, 1, 0)); // Needle, quality ~2e-7
+    faces.emplace_back(Point3D(0, 0, 0), Point3D(0.1, 0, 0), Point3D(0, 0.1, 0)); // Small but well shaped
+    faces.emplace_back(Point3D(1, 1, 1), Point3D(1, 1, 1), Point3D(1, 1, 1));     // Collapsed to a point
+    const MeshData mesh = meshes::meshOf(faces);
+    
+    CleanupReport report = MeshCleaner().inspect(mesh);
+    
+    ASSERT_EQ(report.defects.size(), faces.size());
+    const std::vector<TriangleDefect> expected = {
+        TriangleDefect::None, TriangleDefect::Degenerate, TriangleDefect::Degenerate,
+        TriangleDefect::Degenerate, TriangleDefect::None, TriangleDefect::Degenerate};
+    EXPECT_EQ(report.defects, expected);
+    EXPECT_EQ(report.degenerateTriangles, 4u);
+    EXPECT_EQ(report.duplicateTriangles, 0u);
+    EXPECT_EQ(report.removedTriangles, 0u);
+    
+    CleanupOptions options;
+    options.minArea = 0.01;
+    EXPECT_EQ(MeshCleaner(options).inspect(mesh).defects[4], TriangleDefect::Degenerate);
+}
+
+TEST(MeshCleanupTest, FindsDuplicatesInAnyVertexOrder) {
+    const Point3D a(10, 20, 3), b(11, 20, 3), c(10, 21, 4);
+    std::vector<Triangle> faces;
+    faces.emplace_back(a, b, c);
+    faces.emplace_back(b, c, a);                                      // Rotated
+    faces.emplace_back(a, c, b);                                      // Opposite winding
+    faces.emplace_back(a, b, Point3D(10, 21, 4.5));                   // Shares an edge only
+    faces.emplace_back(a + Point3D(1e-8, 0, 0), b, c);                // Within the precision
+    faces.emplace_back(a, b, Point3D(10, 21, 4.5));                   // Copy of the edge neighbour
+    const MeshData mesh = meshes::meshOf(faces);
+    
+    CleanupReport report = MeshCleaner().inspect(mesh);
+    
+    const std::vector<TriangleDefect> expected = {
+        TriangleDefect::None, TriangleDefect::Duplicate, TriangleDefect::Duplicate,
+        TriangleDefect::None, TriangleDefect::Duplicate, TriangleDefect::Duplicate};
+    EXPECT_EQ(report.defects, expected);
+    EXPECT_EQ(report.duplicateTriangles, 4u);
+    EXPECT_EQ(report.degenerateTriangles, 0u);
+    
+    // A coarser grid makes near-identical faces copies, a finer one tells them apart
+    CleanupOptions options;
+    options.precision = 1e-9;
+    EXPECT_EQ(MeshCleaner(options).inspect(mesh).defects[4], TriangleDefect::None);
+    options.precision = 0.0;
+    EXPECT_THROW(MeshCleaner(options).inspect(mesh), std::invalid_argument);
+}
+
+TEST(MeshCleanupTest, CleanRemovesFlaggedFacesFromTheSummary) {
+    std::vector<Triangle> faces;
+    meshes::addGrid(faces, 4);
+    const MeshData reference = meshes::meshOf(faces);
+    faces.insert(faces.begin() + 5, faces[3]);
+    faces.emplace_back(Point3D(0, 0, 0), Point3D(2, 0, 0), Point3D(4, 0, 0));
+    faces.push_back(faces[20]);
+    MeshData mesh = meshes::meshOf(faces);
+    
+    DetailedMeshSummarizer summarizer;
+    EXPECT_EQ(summarizer.summarize(mesh).getCustomField("min_triangle_area"), "0");
+    
+    CleanupReport report = MeshCleaner().clean(mesh);
+    
+    EXPECT_EQ(report.degenerateTriangles, 1u);
+    EXPECT_EQ(report.duplicateTriangles, 2u);
+    EXPECT_EQ(report.removedTriangles, 3u);
+    EXPECT_TRUE(report.defects.empty());
+    ASSERT_EQ(mesh.getTriangleCount(), reference.getTriangleCount());
+    for (size_t t = 0; t < mesh.getTriangleCount(); ++t) {
+        EXPECT_EQ(mesh.getTriangle(t).vertices, reference.getTriangle(t).vertices) << "Triangle " << t;
+    }
+    MeshSummary summary = summarizer.summarize(mesh);
+    EXPECT_EQ(summary.getCustomField("min_triangle_area"), "0.5");
+    EXPECT_DOUBLE_EQ(summary.totalSurfaceArea, 16.0);
+    
+    // Nothing left to remove
+    EXPECT_EQ(MeshCleaner().clean(mesh).removedTriangles, 0u);
+}
+
+TEST(MeshCleanupTest, ThreadCountDoesNotChangeFlags) {
+    // Enough triangles for the parallel pass, with copies and slivers spread through them
+    std::vector<Triangle> faces;
+    meshes::addGrid(faces, 130);
+    const size_t unique = faces.size();
+    for (size_t i = 0; i < unique; i += 97) {
+        faces.push_back(faces[i]);
+        faces.emplace_back(faces[i].vertices[0], faces[i].vertices[0], faces[i].vertices[1]);
+    }
+    std::shuffle(faces.begin(), faces.end(), std::mt19937(5));
+    const MeshData mesh = meshes::meshOf(faces);
+    
+    CleanupOptions options;
+    options.threadCount = 1;
+    CleanupReport serial = MeshCleaner(options).inspect(mesh);
+    options.threadCount = 4;
+    CleanupReport parallel = MeshCleaner(options).inspect(mesh);
+    
+    const size_t copies = (unique + 96) / 97;
+    EXPECT_EQ(serial.duplicateTriangles, copies);
+    EXPECT_EQ(serial.degenerateTriangles, copies);
+    EXPECT_EQ(parallel.duplicateTriangles, serial.duplicateTriangles);
+    EXPECT_EQ(parallel.degenerateTriangles, serial.degenerateTriangles);
+    EXPECT_TRUE(parallel.defects == serial.defects);
+}
+
+TEST(MeshCleanupTest, HandlesEmptyAndCompactMeshes) {
+    MeshData empty;
+    EXPECT_EQ(MeshCleaner().clean(empty).removedTriangles, 0u);
+    
+    std::vector<Triangle> faces;
+    meshes::addGrid(faces, 3);
+    faces.push_back(faces[7]);
+    MeshData mesh = meshes::meshOf(faces);
+    ASSERT_TRUE(mesh.compact());
+    
+    CleanupReport report = MeshCleaner().clean(mesh);
+    
+    EXPECT_EQ(report.duplicateTriangles, 1u);
+    EXPECT_TRUE(mesh.isCompact());
+    EXPECT_EQ(mesh.getTriangleCount(), 18u);
+}
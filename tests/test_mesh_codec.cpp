@@ -0,0 +1,179 @@
+/**
+ * @file test_mesh_codec.cpp
+ * @brief Unit tests for the quantized block-compressed mesh format
+ */
+
+#include <gtest/gtest.h>
+#include "DXFGenerator.h"
+#include "DXFReader.h"
+#include "MeshCodec.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <tuple>
+#include <vector>
+
+using namespace DXFProcessor;
+
+namespace {
+
+    /// Triangles as sortable tuples of millimetre-rounded coordinates plus layer name
+    std::vector<std::tuple<std::vector<long long>, std::string>> canonical(const MeshData& mesh) {
+        std::vector<std::tuple<std::vector<long long>, std::string>> result;
+        for (size_t i = 0; i < mesh.getTriangleCount(); ++i) {
+            std::vector<long long> coordinates;
+            for (const auto& vertex : mesh.getTriangle(i).vertices) {
+                for (double value : {vertex.x, vertex.y, vertex.z}) {
+                    coordinates.push_back(std::llround(value * 1000.0));
+                }
+            }
+            result.emplace_back(std::move(coordinates), mesh.getLayerName(mesh.getTriangleLayer(i)));
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+}
+
+class MeshCodecTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testOutputDir = "mesh_codec_test_output";
+        std::filesystem::create_directories(testOutputDir);
+        
+        GeneratorOptions options;
+        options.faceCount = 30000;
+        options.layerCount = 3;
+        dxfPath = testOutputDir + "/pit.dxf";
+        DXFGenerator(options).write(dxfPath);
+        mesh = DXFReaderFactory::createReader()->readFile(dxfPath);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(testOutputDir);
+    }
+
+    std::string testOutputDir;
+    std::string dxfPath;
+    std::unique_ptr<MeshData> mesh;
+};
+
+TEST_F(MeshCodecTest, RoundTripWithinPrecision) {
+    MeshCodecOptions options;
+    options.trianglesPerBlock = 4096;  // Several blocks
+    MeshCodec codec(options);
+
+    auto decoded = codec.decode(codec.encode(*mesh));
+    ASSERT_EQ(decoded->getTriangleCount(), mesh->getTriangleCount());
+    EXPECT_EQ(decoded->getLayerNames(), mesh->getLayerNames());
+
+    // The generator writes millimetres, so 1 mm quantization is lossless
+    EXPECT_EQ(canonical(*decoded), canonical(*mesh));
+    EXPECT_NEAR(decoded->getTotalSurfaceArea(), mesh->getTotalSurfaceArea(), 1e-6 * mesh->getTotalSurfaceArea());
+}
+
+TEST_F(MeshCodecTest, CoarsePrecisionBoundsTheError) {
+    MeshCodecOptions options;
+    options.precision = 0.25;
+    MeshCodec codec(options);
+
+    auto decoded = codec.decode(codec.encode(*mesh));
+    BoundingBox expected = mesh->getBoundingBox();
+    BoundingBox actual = decoded->getBoundingBox();
+    EXPECT_NEAR(actual.min.x, expected.min.x, 0.125);
+    EXPECT_NEAR(actual.max.y, expected.max.y, 0.125);
+    EXPECT_NEAR(actual.max.z, expected.max.z, 0.125);
+    EXPECT_EQ(decoded->getTriangleCount(), mesh->getTriangleCount());
+}
+
+TEST_F(MeshCodecTest, FileIsMuchSmallerThanDXF) {
+    MeshCodec codec;
+    std::string meshPath = testOutputDir + "/pit.dxm";
+    codec.save(*mesh, meshPath);
+
+    auto dxfBytes = std::filesystem::file_size(dxfPath);
+    auto meshBytes = std::filesystem::file_size(meshPath);
+    EXPECT_LT(meshBytes * 10, dxfBytes) << meshBytes << " bytes against " << dxfBytes;
+    EXPECT_LT(meshBytes, 10 * mesh->getTriangleCount());
+
+    auto loaded = codec.load(meshPath);
+    EXPECT_EQ(canonical(*loaded), canonical(*mesh));
+    EXPECT_TRUE(MeshCodec::isMeshFile(meshPath));
+    EXPECT_TRUE(MeshCodec::isMeshFile("PIT.DXM"));
+    EXPECT_FALSE(MeshCodec::isMeshFile(dxfPath));
+}
+
+TEST_F(MeshCodecTest, ParallelDecodeMatchesSequential) {
+    MeshCodecOptions options;
+    options.trianglesPerBlock = 1000;
+    options.threadCount = 1;
+    std::string bytes = MeshCodec(options).encode(*mesh);
+    auto sequential = MeshCodec(options).decode(bytes);
+
+    options.threadCount = 4;
+    EXPECT_EQ(MeshCodec(options).encode(*mesh), bytes);
+    auto parallel = MeshCodec(options).decode(bytes);
+    ASSERT_EQ(parallel->getTriangleCount(), sequential->getTriangleCount());
+    for (size_t i = 0; i < sequential->getTriangleCount(); ++i) {
+        ASSERT_EQ(parallel->getTriangleLayers()[i], sequential->getTriangleLayers()[i]);
+        for (size_t v = 0; v < 3; ++v) {
+            ASSERT_EQ(parallel->getTriangles()[i].vertices[v], sequential->getTriangles()[i].vertices[v]);
+        }
+    }
+}
+
+TEST_F(MeshCodecTest, EncodesCompactAndEmptyMeshes) {
+    MeshCodec codec;
+    MeshData compact = *mesh;
+    ASSERT_TRUE(compact.compact());
+    EXPECT_EQ(canonical(*codec.decode(codec.encode(compact))), canonical(*mesh));
+
+    auto empty = codec.decode(codec.encode(MeshData()));
+    EXPECT_TRUE(empty->isEmpty());
+    EXPECT_EQ(empty->getLayerCount(), 1u);
+}
+
+TEST_F(MeshCodecTest, RejectsBadOptionsAndCorruptData) {
+    MeshCodecOptions options;
+    options.precision = 0.0;
+    EXPECT_THROW(MeshCodec{options}, MeshCodecException);
+    options = MeshCodecOptions();
+    options.trianglesPerBlock = 0;
+    EXPECT_THROW(MeshCodec{options}, MeshCodecException);
+
+    MeshCodec codec;
+    std::string bytes = codec.encode(*mesh);
+    EXPECT_THROW(codec.decode("not a mesh"), MeshCodecException);
+    EXPECT_THROW(codec.decode(std::string_view(bytes).substr(0, bytes.size() / 2)), MeshCodecException);
+
+    std::string wrongVersion = bytes;
+    wrongVersion[8] = 99;
+    EXPECT_THROW(codec.decode(wrongVersion), MeshCodecException);
+
+    // Flipping payload bytes must fail cleanly or decode garbage, never crash
+    std::string flipped = bytes;
+    for (size_t i = bytes.size() - 5000; i < bytes.size(); i += 7) {
+        flipped[i] = static_cast<char>(flipped[i] ^ 0x5A);
+    }
+    try {
+        codec.decode(flipped);
+    } catch (const MeshCodecException&) {
+    }
+
+    // Directory entries pointing at the same payload would let a small file claim a huge mesh
+    MeshData pair;
+    pair.addTriangle(Triangle(Point3D(0, 0, 0), Point3D(1, 0, 0), Point3D(0, 1, 0)));
+    pair.addTriangle(Triangle(Point3D(1, 0, 0), Point3D(1, 1, 0), Point3D(0, 1, 0)));
+    MeshCodecOptions perTriangle;
+    perTriangle.trianglesPerBlock = 1;
+    std::string overlapping = MeshCodec(perTriangle).encode(pair);
+    ASSERT_NO_THROW(codec.decode(overlapping));
+    // Header: magic, version, block count, precision, origin, triangle count, layer count, layer "0"
+    const size_t directoryOffset = 8 + 4 + 4 + 8 + 24 + 8 + 4 + 2 + 1;
+    std::memcpy(&overlapping[directoryOffset + 20], &overlapping[directoryOffset], sizeof(std::uint64_t));
+    EXPECT_THROW(codec.decode(overlapping), MeshCodecException);
+
+    EXPECT_THROW(codec.load(testOutputDir + "/missing.dxm"), MeshCodecException);
+    EXPECT_THROW(codec.save(*mesh, testOutputDir + "/no/such/dir.dxm"), MeshCodecException);
+}
@@ -0,0 +1,166 @@
+/**
+ * @file test_mesh_components.cpp
+ * @brief Unit tests for connected component labeling
+ */
+
+#include <gtest/gtest.h>
+#include "MeshComponents.h"
+#include "test_meshes.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace DXFProcessor;
+
+TEST(MeshComponentsTest, LabelsDisjointPiecesInFileOrder) {
+    std::vector<Triangle> faces;
+    meshes::addGrid(faces, 4, 0.0);
+    faces.emplace_back(Point3D(50, 50, 0), Point3D(51, 50, 0), Point3D(50, 51, 0));
+    meshes::addGrid(faces, 3, 10.0);
+    faces.push_back(faces.front());  // A face of the first grid after the others
+    const MeshData mesh = meshes::meshOf(faces);
+    
+    ComponentLabels labels = ComponentLabeler().label(mesh);
+    
+    ASSERT_EQ(labels.count, 3u);
+    ASSERT_EQ(labels.componentOf.size(), mesh.getTriangleCount());
+    for (size_t t = 0; t < 32; ++t) {
+        EXPECT_EQ(labels.componentOf[t], 0u) << "Triangle " << t;
+    }
+    EXPECT_EQ(labels.componentOf[32], 1u);
+    for (size_t t = 33; t < 51; ++t) {
+        EXPECT_EQ(labels.componentOf[t], 2u) << "Triangle " << t;
+    }
+    EXPECT_EQ(labels.componentOf.back(), 0u);
+}
+
+TEST(MeshComponentsTest, VertexAndEdgeConnectivity) {
+    // Two triangles touching at one corner
+    std::vector<Triangle> faces;
+    faces.emplace_back(Point3D(0, 0, 0), Point3D(1, 0, 0), Point3D(0, 1, 0));
+    faces.emplace_back(Point3D(1, 0, 0), Point3D(2, 0, 0), Point3D(2, 1, 0));
+    const MeshData mesh = meshes::meshOf(faces);
+    
+    EXPECT_EQ(ComponentLabeler().label(mesh).count, 1u);
+    
+    ComponentOptions options;
+    options.connectivity = ComponentConnectivity::Edge;
+    EXPECT_EQ(ComponentLabeler(options).label(mesh).count, 2u);
+}
+
+TEST(MeshComponentsTest, SummarizesEachComponent) {
+    std::vector<Triangle> faces;
+    meshes::addCube(faces, 0.0);
+    meshes::addGrid(faces, 2, 5.0, 3.0);
+    const MeshData mesh = meshes::meshOf(faces);
+    
+    std::vector<ComponentSummary> components = ComponentLabeler::summarize(mesh, ComponentLabeler().label(mesh));
+    
+    ASSERT_EQ(components.size(), 2u);
+    EXPECT_EQ(components[0].name, "Component 1");
+    EXPECT_EQ(components[0].triangleCount, 12u);
+    EXPECT_DOUBLE_EQ(components[0].totalSurfaceArea, 6.0);
+    EXPECT_NEAR(components[0].volume, 1.0, 1e-12);
+    EXPECT_NEAR((components[0].centroid - Point3D(0.5, 0.5, 0.5)).magnitude(), 0.0, 1e-12);
+    
+    EXPECT_EQ(components[1].name, "Component 2");
+    EXPECT_EQ(components[1].triangleCount, 8u);
+    EXPECT_DOUBLE_EQ(components[1].totalSurfaceArea, 4.0);
+    EXPECT_EQ(components[1].boundingBox.min, Point3D(5, 3, 0));
+    EXPECT_EQ(components[1].boundingBox.max, Point3D(7, 5, 0));
+    
+    ComponentLabels wrongMesh;
+    EXPECT_THROW(ComponentLabeler::summarize(mesh, wrongMesh), std::invalid_argument);
+}
+
+TEST(MeshComponentsTest, AnalyzeDropsComponentsUnderMinArea) {
+    std::vector<Triangle> faces;
+    faces.emplace_back(Point3D(-9, 0, 0), Point3D(-8, 0, 0), Point3D(-9, 1, 0));  // Stray face, area 0.5
+    meshes::addGrid(faces, 3, 0.0);
+    faces.emplace_back(Point3D(20, 0, 0), Point3D(20.1, 0, 0), Point3D(20, 0.1, 0));
+    meshes::addGrid(faces, 2, 30.0);
+    MeshData mesh = meshes::meshOf(faces);
+    
+    ComponentOptions options;
+    options.minArea = 1.0;
+    ComponentAnalysis analysis = ComponentLabeler(options).analyze(mesh);
+    
+    EXPECT_EQ(analysis.droppedComponents, 2u);
+    EXPECT_EQ(analysis.droppedTriangles, 2u);
+    ASSERT_EQ(analysis.components.size(), 2u);
+    EXPECT_EQ(analysis.components[0].name, "Component 1");
+    EXPECT_DOUBLE_EQ(analysis.components[0].totalSurfaceArea, 9.0);
+    EXPECT_EQ(analysis.components[1].name, "Component 2");
+    EXPECT_DOUBLE_EQ(analysis.components[1].totalSurfaceArea, 4.0);
+    
+    ASSERT_EQ(mesh.getTriangleCount(), 26u);
+    EXPECT_DOUBLE_EQ(mesh.getTotalSurfaceArea(), 13.0);
+    EXPECT_EQ(ComponentLabeler().label(mesh).count, 2u);
+}
+
+TEST(MeshComponentsTest, AnalyzeReusesTopologyAfterFlips) {
+    std::vector<Triangle> faces;
+    meshes::addGrid(faces, 3, 0.0);
+    meshes::addCube(faces, 10.0);
+    for (size_t t = 0; t < faces.size(); t += 3) {
+        std::swap(faces[t].vertices[1], faces[t].vertices[2]);  // Mixed winding
+    }
+    faces.emplace_back(Point3D(20, 0, 0), Point3D(20.1, 0, 0), Point3D(20, 0.1, 0));
+    MeshData shared = meshes::meshOf(faces);
+    MeshData fresh = meshes::meshOf(faces);
+    
+    // Flipping triangles after the topology was built must not change the components
+    const MeshTopology topology(shared);
+    for (size_t t = 0; t < shared.getTriangleCount(); t += 2) {
+        Triangle& triangle = shared.mutableTriangles()[t];
+        std::swap(triangle.vertices[0], triangle.vertices[1]);
+    }
+    ComponentOptions options;
+    options.minArea = 1.0;
+    ComponentAnalysis reused = ComponentLabeler(options).analyze(shared, topology);
+    ComponentAnalysis rebuilt = ComponentLabeler(options).analyze(fresh);
+    
+    ASSERT_EQ(reused.components.size(), 2u);
+    EXPECT_EQ(reused.components.size(), rebuilt.components.size());
+    EXPECT_EQ(reused.droppedTriangles, 1u);
+    EXPECT_EQ(shared.getTriangleCount(), fresh.getTriangleCount());
+    for (size_t c = 0; c < reused.components.size(); ++c) {
+        EXPECT_EQ(reused.components[c].triangleCount, rebuilt.components[c].triangleCount);
+        EXPECT_DOUBLE_EQ(reused.components[c].totalSurfaceArea, rebuilt.components[c].totalSurfaceArea);
+    }
+    
+    MeshData other = meshes::meshOf(faces);
+    EXPECT_THROW(ComponentLabeler().analyze(other, MeshTopology(meshes::meshOf({faces[0]}))), std::invalid_argument);
+}
+
+TEST(MeshComponentsTest, ThreadCountDoesNotChangeLabels) {
+    // Enough triangles for the parallel union-find, in shuffled order
+    std::vector<Triangle> faces;
+    for (int piece = 0; piece < 50; ++piece) {
+        meshes::addGrid(faces, 20, (piece % 10) * 30.0, (piece / 10) * 30.0);
+    }
+    std::shuffle(faces.begin(), faces.end(), std::mt19937(11));
+    const MeshData mesh = meshes::meshOf(faces);
+    
+    ComponentOptions options;
+    options.threadCount = 1;
+    ComponentLabels serial = ComponentLabeler(options).label(mesh);
+    options.threadCount = 4;
+    ComponentLabels parallel = ComponentLabeler(options).label(mesh);
+    
+    EXPECT_EQ(serial.count, 50u);
+    EXPECT_EQ(parallel.count, serial.count);
+    EXPECT_TRUE(serial.componentOf == parallel.componentOf);
+}
+
+TEST(MeshComponentsTest, HandlesEmptyMesh) {
+    MeshData empty;
+    ComponentOptions options;
+    options.minArea = 1.0;
+    
+    ComponentAnalysis analysis = ComponentLabeler(options).analyze(empty);
+    
+    EXPECT_TRUE(analysis.components.empty());
+    EXPECT_EQ(analysis.droppedComponents, 0u);
+    EXPECT_EQ(ComponentLabeler().label(empty).count, 0u);
+}
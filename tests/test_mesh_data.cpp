@@ -6,6 +6,7 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include "MeshData.h"
+#include <algorithm>
 #include <cmath>
 
 using namespace DXFProcessor;
@@ -304,4 +305,216 @@ TEST_F(MeshDataTest, Reserve) {
     // Should not crash and should be able to add triangles
     meshData->addTriangle(triangle1);
     EXPECT_EQ(meshData->getTriangleCount(), 1);
-}
\ No newline at end of file
+}
+
+TEST_F(MeshDataTest, DefaultLayer) {
+    meshData->addTriangle(triangle1);
+    
+    EXPECT_EQ(meshData->getLayerCount(), 1);
+    EXPECT_EQ(meshData->getTriangleLayer(0), MeshData::DEFAULT_LAYER);
+    EXPECT_EQ(meshData->getLayerName(MeshData::DEFAULT_LAYER), "0");
+}
+
+TEST_F(MeshDataTest, InternLayers) {
+    LayerId pit = meshData->internLayer("Pit");
+    LayerId ramp = meshData->internLayer("Ramp");
+    
+    EXPECT_NE(pit, ramp);
+    EXPECT_EQ(meshData->internLayer("Pit"), pit);
+    EXPECT_EQ(meshData->internLayer("0"), MeshData::DEFAULT_LAYER);
+    EXPECT_EQ(meshData->getLayerCount(), 3);
+    
+    meshData->addTriangle(triangle1, ramp);
+    meshData->addTriangle(triangle2, pit);
+    
+    EXPECT_EQ(meshData->getLayerName(meshData->getTriangleLayer(0)), "Ramp");
+    EXPECT_EQ(meshData->getLayerName(meshData->getTriangleLayer(1)), "Pit");
+    
+    meshData->clear();
+    EXPECT_EQ(meshData->getLayerCount(), 1);
+}
+
+TEST_F(MeshDataTest, CompactStorageKeepsGeometry) {
+    // Mine-grid magnitudes, millimetre-rounded, spread over a kilometre
+    const Point3D offset(512000.0, 7004000.0, 350.0);
+    LayerId bench = meshData->internLayer("Bench");
+    for (int i = 0; i < 100; ++i) {
+        Point3D a = offset + Point3D(i * 10.123, i * 7.457, i * 0.311);
+        meshData->addTriangle(Triangle(a, a + Point3D(2.0, 0.0, 0.5), a + Point3D(0.0, 2.0, 0.25)),
+                              i % 2 ? bench : MeshData::DEFAULT_LAYER);
+    }
+    MeshData reference = *meshData;
+    
+    ASSERT_TRUE(meshData->compact());
+    EXPECT_TRUE(meshData->isCompact());
+    EXPECT_TRUE(meshData->getTriangles().empty());
+    EXPECT_EQ(meshData->getTriangleCount(), 100u);
+    EXPECT_NEAR(meshData->getOrigin().x, reference.getBoundingBox().center().x, 1e-9);
+    EXPECT_EQ(sizeof(CompactTriangle) * 2, sizeof(Triangle));
+    
+    for (size_t i = 0; i < reference.getTriangleCount(); ++i) {
+        EXPECT_EQ(meshData->getTriangleLayer(i), reference.getTriangleLayer(i));
+        for (size_t v = 0; v < 3; ++v) {
+            Point3D error = meshData->getTriangle(i).vertices[v] - reference.getTriangles()[i].vertices[v];
+            EXPECT_LE(std::max({std::abs(error.x), std::abs(error.y), std::abs(error.z)}),
+                      MeshData::COMPACT_TOLERANCE);
+        }
+    }
+    
+    BoundingBox box = meshData->getBoundingBox();
+    BoundingBox expected = reference.getBoundingBox();
+    EXPECT_NEAR(box.min.x, expected.min.x, MeshData::COMPACT_TOLERANCE);
+    EXPECT_NEAR(box.max.y, expected.max.y, MeshData::COMPACT_TOLERANCE);
+    EXPECT_NEAR(meshData->getTotalSurfaceArea(), reference.getTotalSurfaceArea(), 1e-6);
+    
+    size_t visited = 0;
+    meshData->forEachTriangle([&](const Triangle& triangle) {
+        EXPECT_NEAR(triangle.vertices[0].y, reference.getTriangles()[visited++].vertices[0].y, MeshData::COMPACT_TOLERANCE);
+    });
+    EXPECT_EQ(visited, 100u);
+    
+    // Later triangles and appended meshes go to the compact storage
+    meshData->append(reference);
+    EXPECT_EQ(meshData->getTriangleCount(), 200u);
+    EXPECT_TRUE(meshData->getTriangles().empty());
+    EXPECT_NEAR(meshData->getTotalSurfaceArea(), 2.0 * reference.getTotalSurfaceArea(), 1e-6);
+    
+    meshData->clear();
+    EXPECT_FALSE(meshData->isCompact());
+    meshData->addTriangle(triangle1);
+    EXPECT_EQ(meshData->getTriangles().size(), 1u);
+}
+
+TEST_F(MeshDataTest, CompactFallsBackToDouble) {
+    // Empty meshes have nothing to compact
+    EXPECT_FALSE(meshData->compact());
+    
+    // 1e6 units from the centre, float32 steps are 1/16: too coarse for 0.1 mm
+    meshData->addTriangle(triangle1);
+    meshData->addTriangle(Point3D(2e6, 0.0, 0.0), Point3D(2e6 + 0.001, 1.0, 0.0), Point3D(2e6, 0.0, 1.0));
+    EXPECT_FALSE(meshData->compact());
+    EXPECT_FALSE(meshData->isCompact());
+    EXPECT_EQ(meshData->getTriangles().size(), 2u);
+    EXPECT_DOUBLE_EQ(meshData->getTriangles()[1].vertices[1].x, 2e6 + 0.001);
+    
+    // A looser tolerance accepts it
+    EXPECT_TRUE(meshData->compact(0.1));
+    EXPECT_EQ(meshData->getTriangleCount(), 2u);
+    
+    // A later far-away triangle is held to the same tolerance and switches the mesh back
+    meshData->clear();
+    meshData->addTriangle(triangle1);
+    ASSERT_TRUE(meshData->compact());
+    MeshData far;
+    far.addTriangle(Point3D(5e6, 0.0, 0.0), Point3D(5e6 + 0.001, 1.0, 0.0), Point3D(5e6, 0.0, 1.0));
+    meshData->append(far);
+    EXPECT_FALSE(meshData->isCompact());
+    ASSERT_EQ(meshData->getTriangles().size(), 2u);
+    EXPECT_DOUBLE_EQ(meshData->getTriangle(1).vertices[1].x, 5e6 + 0.001);
+    EXPECT_NEAR(meshData->getTriangle(0).vertices[1].x, triangle1.vertices[1].x, MeshData::COMPACT_TOLERANCE);
+}
+
+TEST_F(MeshDataTest, AggregatesFromOnePass) {
+    meshData->addTriangle(triangle1);
+    meshData->addTriangle(triangle2);
+    meshData->addTriangle(Point3D(0.0, 0.0, 1.0), Point3D(4.0, 0.0, 1.0), Point3D(0.0, 1.0, 1.0));
+    
+    const MeshAggregates& totals = meshData->getAggregates();
+    EXPECT_EQ(totals.triangleCount, 3u);
+    EXPECT_DOUBLE_EQ(totals.totalSurfaceArea, 3.0);
+    EXPECT_DOUBLE_EQ(totals.minTriangleArea, 0.5);
+    EXPECT_DOUBLE_EQ(totals.maxTriangleArea, 2.0);
+    EXPECT_DOUBLE_EQ(totals.boundingBox.max.x, 4.0);
+    EXPECT_DOUBLE_EQ(totals.boundingBox.max.z, 1.0);
+    // Weighted by area: (1/3, 1/3, 0) * 0.5 + (4/3, 4/3, 0) * 0.5 + (4/3, 1/3, 1) * 2, over 3
+    EXPECT_NEAR(totals.centroid.x, (0.5 / 3 + 2.0 / 3 + 8.0 / 3) / 3.0, 1e-12);
+    EXPECT_NEAR(totals.centroid.z, 2.0 / 3.0, 1e-12);
+    
+    // Cached: the same object until the mesh changes
+    EXPECT_EQ(&meshData->getAggregates(), &totals);
+    EXPECT_DOUBLE_EQ(meshData->getTotalSurfaceArea(), 3.0);
+}
+
+TEST_F(MeshDataTest, AggregatesFollowChanges) {
+    meshData->addTriangle(triangle1);
+    EXPECT_DOUBLE_EQ(meshData->getTotalSurfaceArea(), 0.5);
+    EXPECT_EQ(meshData->getTriangleAreas().size(), 1u);
+    
+    meshData->addTriangle(triangle2);
+    EXPECT_DOUBLE_EQ(meshData->getTotalSurfaceArea(), 1.0);
+    EXPECT_DOUBLE_EQ(meshData->getBoundingBox().max.x, 2.0);
+    EXPECT_EQ(meshData->getTriangleAreas().size(), 2u);
+    
+    MeshData part;
+    part.addTriangle(Point3D(0.0, 0.0, 0.0), Point3D(2.0, 0.0, 0.0), Point3D(0.0, 2.0, 0.0));
+    EXPECT_DOUBLE_EQ(part.getTotalSurfaceArea(), 2.0);
+    meshData->append(std::move(part));
+    EXPECT_DOUBLE_EQ(meshData->getTotalSurfaceArea(), 3.0);
+    EXPECT_DOUBLE_EQ(part.getTotalSurfaceArea(), 0.0);  // Moved-from parts don't keep stale figures
+    
+    // Writable access drops the cache itself
+    meshData->mutableTriangles()[2] = triangle1;
+    EXPECT_DOUBLE_EQ(meshData->getTotalSurfaceArea(), 1.5);
+    
+    meshData->clear();
+    EXPECT_DOUBLE_EQ(meshData->getTotalSurfaceArea(), 0.0);
+    EXPECT_TRUE(meshData->getBoundingBox().isEmpty());
+    EXPECT_TRUE(meshData->getTriangleNormals().empty());
+}
+
+TEST_F(MeshDataTest, TriangleColumns) {
+    meshData->addTriangle(triangle1);
+    meshData->addTriangle(Point3D(0.0, 0.0, 0.0), Point3D(0.0, 0.0, 3.0), Point3D(0.0, 2.0, 0.0));
+    meshData->addTriangle(Point3D(1.0, 1.0, 1.0), Point3D(2.0, 2.0, 2.0), Point3D(3.0, 3.0, 3.0));
+    
+    const auto& areas = meshData->getTriangleAreas();
+    ASSERT_EQ(areas.size(), 3u);
+    EXPECT_DOUBLE_EQ(areas[0], 0.5);
+    EXPECT_DOUBLE_EQ(areas[1], 3.0);
+    EXPECT_DOUBLE_EQ(areas[2], 0.0);
+    
+    const auto& normals = meshData->getTriangleNormals();
+    ASSERT_EQ(normals.size(), 3u);
+    EXPECT_EQ(normals[0], Point3D(0.0, 0.0, 1.0));
+    EXPECT_EQ(normals[1], Point3D(-1.0, 0.0, 0.0));  // Winding decides the side
+    EXPECT_EQ(normals[2], Point3D(0.0, 0.0, 0.0));   // Degenerate
+    
+    // Compact meshes give the same columns from their local coordinates
+    MeshData shifted;
+    Point3D offset(5000.0, 7000.0, 300.0);
+    meshData->forEachTriangle([&](const Triangle& triangle) {
+        shifted.addTriangle(triangle.vertices[0] + offset, triangle.vertices[1] + offset,
+                            triangle.vertices[2] + offset);
+    });
+    ASSERT_TRUE(shifted.compact());
+    EXPECT_NEAR(shifted.getTriangleAreas()[1], 3.0, 1e-6);
+    EXPECT_NEAR(shifted.getTriangleNormals()[1].x, -1.0, 1e-6);
+    EXPECT_NEAR(shifted.getAggregates().boundingBox.min.x, 5000.0, MeshData::COMPACT_TOLERANCE);
+}
+
+TEST_F(MeshDataTest, RemoveTrianglesInPlace) {
+    const LayerId pit = meshData->internLayer("Pit");
+    for (int i = 0; i < 5; ++i) {
+        meshData->addTriangle(Triangle(Point3D(i, 0, 0), Point3D(i + 1.0, 0, 0), Point3D(i, 1, 0)),
+                              i % 2 == 0 ? pit : MeshData::DEFAULT_LAYER);
+    }
+    EXPECT_DOUBLE_EQ(meshData->getTotalSurfaceArea(), 2.5);
+    
+    const std::vector<bool> remove = {true, false, true, false, false};
+    EXPECT_EQ(meshData->removeTriangles(remove), 2u);
+    
+    ASSERT_EQ(meshData->getTriangleCount(), 3u);
+    EXPECT_EQ(meshData->getTriangle(0).vertices[0], Point3D(1, 0, 0));
+    EXPECT_EQ(meshData->getTriangle(1).vertices[0], Point3D(3, 0, 0));
+    EXPECT_EQ(meshData->getTriangle(2).vertices[0], Point3D(4, 0, 0));
+    EXPECT_EQ(meshData->getTriangleLayer(2), pit);
+    EXPECT_DOUBLE_EQ(meshData->getTotalSurfaceArea(), 1.5);
+    
+    // Compact storage is compacted the same way
+    ASSERT_TRUE(meshData->compact());
+    EXPECT_EQ(meshData->removeTriangles(std::vector<bool>{false, true, false}), 1u);
+    ASSERT_EQ(meshData->getTriangleCount(), 2u);
+    EXPECT_NEAR(meshData->getTriangle(1).vertices[0].x, 4.0, MeshData::COMPACT_TOLERANCE);
+    
+    EXPECT_THROW(meshData->removeTriangles(std::vector<bool>(5, false)), std::invalid_argument);
+}
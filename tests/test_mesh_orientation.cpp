@@ -0,0 +1,147 @@
+/**
+ * @file test_mesh_orientation.cpp
+ * @brief Unit tests for consistent winding repair
+ */
+
+#include <gtest/gtest.h>
+#include "MeshOrientation.h"
+#include "test_meshes.h"
+#include <cmath>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace DXFProcessor;
+
+namespace {
+
+    bool sameWinding(const Triangle& a, const Triangle& b) {
+        return a.vertices[0] == b.vertices[0] && a.vertices[1] == b.vertices[1] && a.vertices[2] == b.vertices[2];
+    }
+
+}
+
+TEST(MeshOrientationTest, FlipsTheMinorityBack) {
+    const MeshData original = meshes::grid(6);
+    MeshData mesh = original;
+    const std::set<size_t> flipped = {3, 17, 40, 41, 70};
+    for (size_t t : flipped) {
+        mesh.flipTriangle(t);
+    }
+    ASSERT_EQ(MeshTopology(mesh).getInconsistentEdgeCount(), 13u);
+
+    OrientationReport report = MeshOrienter().orient(mesh);
+
+    EXPECT_EQ(report.flippedTriangles, flipped.size());
+    EXPECT_EQ(report.components, 1u);
+    EXPECT_EQ(report.conflictingEdges, 0u);
+    for (size_t t = 0; t < mesh.getTriangleCount(); ++t) {
+        EXPECT_TRUE(sameWinding(mesh.getTriangle(t), original.getTriangle(t))) << "Triangle " << t;
+    }
+    EXPECT_EQ(MeshTopology(mesh).getInconsistentEdgeCount(), 0u);
+}
+
+TEST(MeshOrientationTest, RepairsClosedShellVolume) {
+    MeshData mesh = meshes::cube();
+    mesh.flipTriangle(2);
+    mesh.flipTriangle(7);
+    EXPECT_NEAR(std::abs(mesh.getAggregates().signedVolume), 1.0 / 3.0, 1e-12);  // Silently wrong
+
+    OrientationReport report = MeshOrienter().orient(mesh);
+
+    EXPECT_EQ(report.flippedTriangles, 2u);
+    EXPECT_NEAR(mesh.getAggregates().signedVolume, 1.0, 1e-12);
+}
+
+TEST(MeshOrientationTest, UpwardFacesPositiveZ) {
+    MeshData mesh = meshes::grid(4);
+    for (size_t t = 0; t < mesh.getTriangleCount(); ++t) {
+        mesh.flipTriangle(t);
+    }
+
+    EXPECT_EQ(MeshOrienter().orient(mesh).flippedTriangles, 0u);  // Consistent, just facing down
+
+    OrientationOptions options;
+    options.upward = true;
+    OrientationReport report = MeshOrienter(options).orient(mesh);
+
+    EXPECT_EQ(report.flippedTriangles, mesh.getTriangleCount());
+    for (size_t t = 0; t < mesh.getTriangleCount(); ++t) {
+        EXPECT_GT(mesh.getTriangle(t).normal().z, 0.0);
+    }
+}
+
+TEST(MeshOrientationTest, ComponentsAreOrientedSeparately) {
+    MeshData mesh = meshes::grid(3);
+    MeshData second = meshes::grid(3, 10.0);
+    for (size_t t = 0; t < second.getTriangleCount(); ++t) {
+        second.flipTriangle(t);
+    }
+    mesh.append(second);
+    mesh.addTriangle(Point3D(20, 0, 0), Point3D(20, 1, 0), Point3D(21, 0, 0));  // Isolated, clockwise
+
+    OrientationOptions options;
+    options.upward = true;
+    OrientationReport report = MeshOrienter(options).orient(mesh);
+
+    EXPECT_EQ(report.components, 3u);
+    EXPECT_EQ(report.flippedTriangles, second.getTriangleCount() + 1);
+}
+
+TEST(MeshOrientationTest, ReportsNonOrientableStrip) {
+    // A ring of quads whose last quad joins the first one with a half twist
+    const int segments = 8;
+    MeshData mesh;
+    auto inner = [&](int i) {
+        double angle = 2.0 * 3.14159265358979323846 * (i % segments) / segments;
+        return Point3D(std::cos(angle) * 5, std::sin(angle) * 5, 0);
+    };
+    auto outer = [&](int i) {
+        double angle = 2.0 * 3.14159265358979323846 * (i % segments) / segments;
+        return Point3D(std::cos(angle) * 6, std::sin(angle) * 6, 0);
+    };
+    for (int i = 0; i < segments; ++i) {
+        Point3D a = inner(i), b = outer(i);
+        Point3D c = i + 1 < segments ? inner(i + 1) : outer(0);
+        Point3D d = i + 1 < segments ? outer(i + 1) : inner(0);
+        mesh.addTriangle(a, b, d);
+        mesh.addTriangle(a, d, c);
+    }
+
+    OrientationReport report = MeshOrienter().orient(mesh);
+
+    EXPECT_EQ(report.components, 1u);
+    EXPECT_EQ(report.conflictingEdges, 1u);
+}
+
+TEST(MeshOrientationTest, ThreadCountDoesNotChangeResult) {
+    // Large enough for the parallel search
+    MeshData serial = meshes::grid(150);
+    std::mt19937 random(5);
+    for (size_t t = 0; t < serial.getTriangleCount(); ++t) {
+        if (random() % 7 == 0) {
+            serial.flipTriangle(t);
+        }
+    }
+    MeshData parallel = serial;
+
+    OrientationOptions options;
+    options.threadCount = 1;
+    OrientationReport serialReport = MeshOrienter(options).orient(serial);
+    options.threadCount = 4;
+    OrientationReport parallelReport = MeshOrienter(options).orient(parallel);
+
+    EXPECT_EQ(serialReport.flippedTriangles, parallelReport.flippedTriangles);
+    EXPECT_EQ(parallelReport.components, 1u);
+    EXPECT_EQ(parallelReport.conflictingEdges, 0u);
+    for (size_t t = 0; t < serial.getTriangleCount(); ++t) {
+        ASSERT_TRUE(sameWinding(serial.getTriangle(t), parallel.getTriangle(t))) << "Triangle " << t;
+    }
+    EXPECT_EQ(MeshTopology(parallel).getInconsistentEdgeCount(), 0u);
+}
+
+TEST(MeshOrientationTest, RejectsTopologyOfAnotherMesh) {
+    MeshData mesh = meshes::grid(2);
+    MeshTopology topology(meshes::grid(3));
+    EXPECT_THROW(MeshOrienter().orient(mesh, topology), std::invalid_argument);
+}
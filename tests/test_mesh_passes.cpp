@@ -0,0 +1,115 @@
+/**
+ * @file test_mesh_passes.cpp
+ * @brief Unit tests for the pass sequence shared by the CLI and batch mode
+ */
+
+#include <gtest/gtest.h>
+#include "MeshPasses.h"
+#include "test_meshes.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace DXFProcessor;
+
+TEST(MeshPassesTest, RunsEnabledPassesInOrder) {
+    std::vector<Triangle> faces;
+    meshes::addGrid(faces, 4);
+    faces.push_back(faces[5]);  // Duplicate, removed before orienting
+    std::swap(faces[9].vertices[1], faces[9].vertices[2]);
+    faces.emplace_back(Point3D(20, 0, 0), Point3D(20.1, 0, 0), Point3D(20, 0.1, 0));  // Stray piece
+    MeshData mesh = meshes::meshOf(faces);
+    
+    MeshPassOptions options;
+    options.clean = true;
+    options.spatialOrder = true;
+    options.orient = true;
+    options.components = true;
+    options.minComponentArea = 1.0;
+    MeshPassReport report = MeshPasses(options).run(mesh);
+    
+    ASSERT_TRUE(report.cleanup.has_value());
+    EXPECT_EQ(report.cleanup->duplicateTriangles, 1u);
+    EXPECT_EQ(report.cleanup->removedTriangles, 1u);
+    EXPECT_TRUE(report.cleanup->defects.empty());
+    ASSERT_TRUE(report.orientation.has_value());
+    EXPECT_EQ(report.orientation->flippedTriangles, 1u);
+    ASSERT_TRUE(report.components.has_value());
+    EXPECT_EQ(report.components->droppedComponents, 1u);
+    EXPECT_EQ(mesh.getTriangleCount(), 32u);
+    EXPECT_EQ(MeshTopology(mesh).getInconsistentEdgeCount(), 0u);
+    
+    MeshSummary summary = BasicMeshSummarizer().summarize(mesh);
+    report.addTo(summary);
+    EXPECT_EQ(summary.getCustomField("removed_triangles"), "1");
+    EXPECT_EQ(summary.getCustomField("flipped_triangles"), "1");
+    EXPECT_EQ(summary.getCustomField("component_count"), "1");
+    EXPECT_EQ(summary.getCustomField("dropped_triangles"), "1");
+    ASSERT_EQ(summary.components.size(), 1u);
+    EXPECT_DOUBLE_EQ(summary.components[0].totalSurfaceArea, 16.0);
+    
+    const std::vector<std::string> expected = {
+        "degenerate_triangles", "duplicate_triangles", "removed_triangles", "flipped_triangles",
+        "non_orientable_edges", "component_count", "dropped_components", "dropped_triangles"};
+    EXPECT_EQ(MeshPasses(options).metricNames(), expected);
+}
+
+TEST(MeshPassesTest, DisabledPassesLeaveMeshAndSummaryAlone) {
+    MeshData mesh = meshes::grid(3);
+    const MeshData original = mesh;
+    
+    EXPECT_FALSE(MeshPassOptions().any());
+    MeshPassReport report = MeshPasses().run(mesh);
+    
+    EXPECT_FALSE(report.cleanup || report.orientation || report.components);
+    ASSERT_EQ(mesh.getTriangleCount(), original.getTriangleCount());
+    for (size_t t = 0; t < mesh.getTriangleCount(); ++t) {
+        EXPECT_EQ(mesh.getTriangle(t).vertices, original.getTriangle(t).vertices);
+    }
+    MeshSummary summary = BasicMeshSummarizer().summarize(mesh);
+    const size_t fields = summary.customFields.size();
+    report.addTo(summary);
+    EXPECT_EQ(summary.customFields.size(), fields);
+    EXPECT_TRUE(MeshPasses().metricNames().empty());
+}
+
+TEST(MeshPassesTest, SharedPoolMatchesSingleThread) {
+    // Enough triangles for every pass to split its work, in shuffled order
+    std::vector<Triangle> faces;
+    for (int piece = 0; piece < 50; ++piece) {
+        meshes::addGrid(faces, 20, (piece % 10) * 30.0, (piece / 10) * 30.0);
+    }
+    faces.push_back(faces[7]);
+    std::swap(faces[100].vertices[1], faces[100].vertices[2]);
+    std::shuffle(faces.begin(), faces.end(), std::mt19937(5));
+    MeshData serialMesh = meshes::meshOf(faces);
+    MeshData sharedMesh = serialMesh;
+    
+    MeshPassOptions options;
+    options.clean = true;
+    options.spatialOrder = true;
+    options.orient = true;
+    options.components = true;
+    options.threadCount = 1;
+    MeshPassReport serial = MeshPasses(options).run(serialMesh);
+    
+    // Run from inside a pool task, as a batch worker does
+    ThreadPool pool(4);
+    options.threadPool = &pool;
+    MeshPassReport shared;
+    TaskGroup group(pool);
+    group.run([&] { shared = MeshPasses(options).run(sharedMesh); });
+    group.wait();
+    
+    EXPECT_EQ(shared.cleanup->removedTriangles, serial.cleanup->removedTriangles);
+    EXPECT_EQ(shared.orientation->flippedTriangles, serial.orientation->flippedTriangles);
+    EXPECT_EQ(shared.components->components.size(), 50u);
+    EXPECT_EQ(serial.components->components.size(), 50u);
+    ASSERT_EQ(sharedMesh.getTriangleCount(), serialMesh.getTriangleCount());
+    for (size_t t = 0; t < sharedMesh.getTriangleCount(); ++t) {
+        ASSERT_EQ(sharedMesh.getTriangle(t).vertices, serialMesh.getTriangle(t).vertices);
+    }
+}
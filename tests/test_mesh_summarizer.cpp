@@ -176,6 +176,26 @@ TEST_F(MeshSummarizerTest, CustomFieldRetrieval) {
     EXPECT_EQ(nonExistent, "");
 }
 
+TEST_F(MeshSummarizerTest, CustomFieldsAreTypedAndOrdered) {
+    auto summary = detailedSummarizer->summarize(*meshData);
+    
+    // Insertion order: basic metrics first, then the detailed ones
+    auto it = summary.customFields.begin();
+    ASSERT_NE(it, summary.customFields.end());
+    EXPECT_EQ(it->key.name(), "mesh_density");
+    
+    const MetricValue* count = summary.customFields.find("small_triangles_count");
+    ASSERT_NE(count, nullptr);
+    EXPECT_TRUE(std::holds_alternative<std::int64_t>(*count));
+    
+    // Doubles keep full precision instead of std::to_string's six decimals
+    const MetricValue* area = summary.customFields.find("average_triangle_area");
+    ASSERT_NE(area, nullptr);
+    ASSERT_TRUE(std::holds_alternative<double>(*area));
+    EXPECT_EQ(std::get<double>(*area), summary.totalSurfaceArea / summary.triangleCount);
+    EXPECT_EQ(std::stod(summary.getCustomField("average_triangle_area")), std::get<double>(*area));
+}
+
 TEST_F(MeshSummarizerTest, DetailedVolumeEstimate) {
     // Create a tetrahedron for volume testing
     auto tetrahedronMesh = std::make_unique<MeshData>();
@@ -230,4 +250,86 @@ TEST_F(MeshSummarizerTest, DetailedTriangleAreaStatistics) {
     
     EXPECT_NEAR(minArea, 0.5, 0.001);
     EXPECT_NEAR(maxArea, 2.0, 0.001);
-}
\ No newline at end of file
+}
+
+TEST_F(MeshSummarizerTest, SummarizeByLayer) {
+    auto layeredMesh = std::make_unique<MeshData>();
+    layeredMesh->addTriangle(triangle1, layeredMesh->internLayer("Pit"));
+    layeredMesh->addTriangle(triangle2, layeredMesh->internLayer("Ramp"));
+    layeredMesh->addTriangle(triangle2, layeredMesh->internLayer("Ramp"));
+    
+    basicSummarizer->setGroupByLayer(true);
+    auto summary = basicSummarizer->summarize(*layeredMesh);
+    
+    // Default layer "0" owns no triangles and is omitted
+    ASSERT_EQ(summary.layers.size(), 2);
+    
+    EXPECT_EQ(summary.layers[0].name, "Pit");
+    EXPECT_EQ(summary.layers[0].triangleCount, 1);
+    EXPECT_DOUBLE_EQ(summary.layers[0].totalSurfaceArea, 0.5);
+    EXPECT_NEAR(summary.layers[0].centroid.x, 1.0/3.0, 1e-9);
+    
+    EXPECT_EQ(summary.layers[1].name, "Ramp");
+    EXPECT_EQ(summary.layers[1].triangleCount, 2);
+    EXPECT_DOUBLE_EQ(summary.layers[1].totalSurfaceArea, 1.0);
+    EXPECT_DOUBLE_EQ(summary.layers[1].boundingBox.min.x, 2.0);
+    EXPECT_DOUBLE_EQ(summary.layers[1].boundingBox.max.x, 3.0);
+}
+
+TEST_F(MeshSummarizerTest, NoLayersUnlessRequested) {
+    auto summary = basicSummarizer->summarize(*meshData);
+    
+    EXPECT_TRUE(summary.layers.empty());
+}
+
+TEST_F(MeshSummarizerTest, CompactMeshGivesSameSummary) {
+    MeshData mesh;
+    const Point3D offset(-773.0, 4200.0, 120.0);
+    for (int row = 0; row < 20; ++row) {
+        for (int col = 0; col < 20; ++col) {
+            auto height = [](int x, int y) { return 0.05 * x * y - 0.3 * x; };
+            Point3D a = offset + Point3D(col * 2.5, row * 2.5, height(col, row));
+            Point3D b = offset + Point3D(col * 2.5 + 2.5, row * 2.5, height(col + 1, row));
+            Point3D c = offset + Point3D(col * 2.5, row * 2.5 + 2.5, height(col, row + 1));
+            mesh.addTriangle(Triangle(a, b, c), mesh.internLayer(row < 10 ? "North" : "South"));
+        }
+    }
+    MeshData compact = mesh;
+    ASSERT_TRUE(compact.compact());
+    
+    detailedSummarizer->setGroupByLayer(true);
+    MeshSummary expected = detailedSummarizer->summarize(mesh);
+    MeshSummary actual = detailedSummarizer->summarize(compact);
+    
+    EXPECT_EQ(actual.triangleCount, expected.triangleCount);
+    EXPECT_NEAR(actual.totalSurfaceArea, expected.totalSurfaceArea, 1e-6);
+    EXPECT_NEAR(actual.centroid.x, expected.centroid.x, MeshData::COMPACT_TOLERANCE);
+    EXPECT_NEAR(actual.centroid.y, expected.centroid.y, MeshData::COMPACT_TOLERANCE);
+    EXPECT_NEAR(actual.boundingBox.min.z, expected.boundingBox.min.z, MeshData::COMPACT_TOLERANCE);
+    EXPECT_NEAR(std::stod(actual.getCustomField("volume_estimate")),
+                std::stod(expected.getCustomField("volume_estimate")),
+                1e-6 * std::stod(expected.getCustomField("volume_estimate")));
+    EXPECT_EQ(actual.getCustomField("small_triangles_count"), expected.getCustomField("small_triangles_count"));
+    
+    ASSERT_EQ(actual.layers.size(), 2u);
+    EXPECT_EQ(actual.layers[1].name, "South");
+    EXPECT_EQ(actual.layers[1].triangleCount, 200u);
+    EXPECT_NEAR(actual.layers[1].totalSurfaceArea, expected.layers[1].totalSurfaceArea, 1e-6);
+}
+
+TEST_F(MeshSummarizerTest, RepeatedSummariesShareOnePass) {
+    MeshSummary basic = basicSummarizer->summarize(*meshData);
+    MeshSummary detailed = detailedSummarizer->summarize(*meshData);
+    
+    EXPECT_EQ(detailed.triangleCount, basic.triangleCount);
+    EXPECT_DOUBLE_EQ(detailed.totalSurfaceArea, basic.totalSurfaceArea);
+    EXPECT_EQ(detailed.centroid, basic.centroid);
+    
+    // A change after the first summaries is picked up by the next one
+    meshData->addTriangle(Point3D(0.0, 0.0, 0.0), Point3D(4.0, 0.0, 0.0), Point3D(0.0, 4.0, 0.0));
+    MeshSummary changed = detailedSummarizer->summarize(*meshData);
+    EXPECT_EQ(changed.triangleCount, 3u);
+    EXPECT_DOUBLE_EQ(changed.totalSurfaceArea, 9.0);
+    EXPECT_EQ(changed.getCustomField("max_triangle_area"), "8");
+    EXPECT_EQ(changed.getCustomField("large_triangles_count"), "1");
+}
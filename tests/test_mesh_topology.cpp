@@ -0,0 +1,177 @@
+/**
+ * @file test_mesh_topology.cpp
+ * @brief Unit tests for the corner table built from MeshData
+ */
+
+#include <gtest/gtest.h>
+#include "MeshTopology.h"
+#include "SpatialOrder.h"
+#include "test_meshes.h"
+#include <algorithm>
+#include <set>
+#include <vector>
+
+using namespace DXFProcessor;
+
+namespace {
+
+    /// Vertex at grid position (i, j), found through the corners of the topology
+    MeshTopology::Index vertexAt(const MeshTopology& topology, double i, double j) {
+        for (MeshTopology::Index v = 0; v < topology.getVertexCount(); ++v) {
+            if (topology.position(v) == Point3D(i, j, 0)) {
+                return v;
+            }
+        }
+        return MeshTopology::NONE;
+    }
+
+}
+
+TEST(MeshTopologyTest, TwoTrianglesShareAnEdge) {
+    MeshData mesh;
+    mesh.addTriangle(Point3D(0, 0, 0), Point3D(1, 0, 0), Point3D(0, 1, 0));
+    mesh.addTriangle(Point3D(1, 0, 0), Point3D(1, 1, 0), Point3D(0, 1, 0));
+
+    MeshTopology topology(mesh);
+
+    EXPECT_EQ(topology.getTriangleCount(), 2u);
+    EXPECT_EQ(topology.getVertexCount(), 4u);
+    EXPECT_EQ(topology.getBoundaryEdgeCount(), 4u);
+    EXPECT_EQ(topology.getNonManifoldEdgeCount(), 0u);
+    EXPECT_EQ(topology.getInconsistentEdgeCount(), 0u);
+
+    // Corner 0 sits on (0, 0, 0) and faces the shared diagonal; corner 4 faces it from the other side
+    EXPECT_EQ(topology.opposite(0), 4u);
+    EXPECT_EQ(topology.opposite(4), 0u);
+    EXPECT_EQ(topology.neighbour(0), 1u);
+    EXPECT_TRUE(topology.isConsistent(0));
+    EXPECT_EQ(topology.vertex(1), topology.vertex(3));
+    EXPECT_EQ(topology.vertex(2), topology.vertex(5));
+    for (MeshTopology::Index c : {1u, 2u, 3u, 5u}) {
+        EXPECT_TRUE(topology.isBoundary(c));
+        EXPECT_EQ(topology.neighbour(c), MeshTopology::NONE);
+    }
+}
+
+TEST(MeshTopologyTest, CornerNavigation) {
+    EXPECT_EQ(MeshTopology::next(0), 1u);
+    EXPECT_EQ(MeshTopology::next(2), 0u);
+    EXPECT_EQ(MeshTopology::prev(3), 5u);
+    EXPECT_EQ(MeshTopology::prev(4), 3u);
+    EXPECT_EQ(MeshTopology::triangleOf(5), 1u);
+    EXPECT_EQ(MeshTopology::cornerOf(2, 1), 7u);
+}
+
+TEST(MeshTopologyTest, GridIsAClosedDisc) {
+    const size_t size = 12;
+    MeshTopology topology(meshes::grid(size));
+
+    const size_t vertices = (size + 1) * (size + 1);
+    const size_t faces = 2 * size * size;
+    EXPECT_EQ(topology.getVertexCount(), vertices);
+    EXPECT_EQ(topology.getBoundaryEdgeCount(), 4 * size);
+    EXPECT_EQ(topology.getInconsistentEdgeCount(), 0u);
+
+    size_t linkedCorners = 0;
+    for (MeshTopology::Index c = 0; c < topology.getCornerCount(); ++c) {
+        if (!topology.isBoundary(c)) {
+            ++linkedCorners;
+            EXPECT_EQ(topology.opposite(topology.opposite(c)), c);
+            EXPECT_TRUE(topology.isConsistent(c));
+        }
+    }
+    // Euler characteristic of a disc: V - E + F = 1
+    const size_t edges = linkedCorners / 2 + topology.getBoundaryEdgeCount();
+    EXPECT_EQ(vertices + faces - edges, 1u);
+}
+
+TEST(MeshTopologyTest, OneRingOfInteriorAndBoundaryVertices) {
+    MeshTopology topology(meshes::grid(4));
+
+    // Interior vertices of this grid have six neighbours
+    MeshTopology::Index centre = vertexAt(topology, 2, 2);
+    ASSERT_NE(centre, MeshTopology::NONE);
+    EXPECT_EQ(topology.cornersAround(centre).size(), 6u);
+    std::vector<MeshTopology::Index> ring;
+    topology.forEachRingVertex(centre, [&](MeshTopology::Index v) { ring.push_back(v); });
+    EXPECT_EQ(ring.size(), 6u);
+    EXPECT_EQ(std::set<MeshTopology::Index>(ring.begin(), ring.end()).size(), 6u);
+    for (MeshTopology::Index v : ring) {
+        Point3D offset = topology.position(v) - topology.position(centre);
+        EXPECT_LE(std::abs(offset.x) + std::abs(offset.y), 2.0);
+    }
+
+    // The corner (0, 0) belongs to one triangle and touches two vertices
+    MeshTopology::Index corner = vertexAt(topology, 0, 0);
+    ring.clear();
+    topology.forEachRingVertex(corner, [&](MeshTopology::Index v) { ring.push_back(v); });
+    EXPECT_EQ(topology.cornersAround(corner).size(), 1u);
+    EXPECT_EQ(ring.size(), 2u);
+
+    for (MeshTopology::Index v = 0; v < topology.getVertexCount(); ++v) {
+        for (MeshTopology::Index c : topology.cornersAround(v)) {
+            EXPECT_EQ(topology.vertex(c), v);
+        }
+    }
+}
+
+TEST(MeshTopologyTest, FlippedTriangleIsLinkedButInconsistent) {
+    MeshData mesh;
+    mesh.addTriangle(Point3D(0, 0, 0), Point3D(1, 0, 0), Point3D(0, 1, 0));
+    mesh.addTriangle(Point3D(1, 0, 0), Point3D(0, 1, 0), Point3D(1, 1, 0));  // Clockwise
+
+    MeshTopology topology(mesh);
+
+    EXPECT_EQ(topology.getInconsistentEdgeCount(), 1u);
+    EXPECT_EQ(topology.neighbour(0), 1u);
+    EXPECT_FALSE(topology.isConsistent(0));
+}
+
+TEST(MeshTopologyTest, NonManifoldAndDegenerateEdgesStayUnlinked) {
+    MeshData fin;
+    fin.addTriangle(Point3D(0, 0, 0), Point3D(1, 0, 0), Point3D(0, 1, 0));
+    fin.addTriangle(Point3D(1, 0, 0), Point3D(1, 1, 0), Point3D(0, 1, 0));
+    fin.addTriangle(Point3D(1, 0, 0), Point3D(0, 1, 0), Point3D(0.5, 0.5, 1));
+
+    MeshTopology finTopology(fin);
+    EXPECT_EQ(finTopology.getNonManifoldEdgeCount(), 1u);
+    EXPECT_TRUE(finTopology.isBoundary(0));
+
+    MeshData sliver;
+    sliver.addTriangle(Point3D(0, 0, 0), Point3D(1, 0, 0), Point3D(1, 0, 0));
+    MeshTopology sliverTopology(sliver);
+    EXPECT_EQ(sliverTopology.getVertexCount(), 2u);
+    for (MeshTopology::Index c = 0; c < 3; ++c) {
+        EXPECT_TRUE(sliverTopology.isBoundary(c));
+    }
+}
+
+TEST(MeshTopologyTest, SameTopologyForAnyThreadCountAndStorage) {
+    // Large enough for the parallel build
+    MeshData mesh = meshes::grid(130);
+    SpatialOrder().reorder(mesh);
+
+    MeshTopologyOptions options;
+    options.threadCount = 1;
+    MeshTopology serial(mesh, options);
+    options.threadCount = 4;
+    MeshTopology parallel(mesh, options);
+    ASSERT_TRUE(mesh.compact());
+    MeshTopology compact(mesh, options);
+
+    ASSERT_EQ(serial.getVertexCount(), parallel.getVertexCount());
+    ASSERT_EQ(serial.getVertexCount(), compact.getVertexCount());
+    EXPECT_EQ(serial.getBoundaryEdgeCount(), 4u * 130);
+    EXPECT_EQ(parallel.getBoundaryEdgeCount(), serial.getBoundaryEdgeCount());
+    for (MeshTopology::Index c = 0; c < serial.getCornerCount(); ++c) {
+        ASSERT_EQ(serial.vertex(c), parallel.vertex(c));
+        ASSERT_EQ(serial.opposite(c), parallel.opposite(c));
+        ASSERT_EQ(serial.opposite(c), compact.opposite(c));
+    }
+}
+
+TEST(MeshTopologyTest, EmptyMesh) {
+    MeshTopology topology{MeshData()};
+    EXPECT_EQ(topology.getTriangleCount(), 0u);
+    EXPECT_EQ(topology.getVertexCount(), 0u);
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+/**
+ * @file test_meshes.h
+ * @brief Small hand-built meshes shared by the mesh pass tests
+ *
+ * Grids lie in the z = 0 plane with every triangle counter-clockwise from
+ * above; cubes have outward-facing triangles. Faces are built as vectors
+ * first so tests can insert copies, slivers or flips before meshOf().
+ */
+
+#include "MeshData.h"
+#include <cstddef>
+#include <vector>
+
+namespace DXFProcessor {
+namespace meshes {
+
+    /// Appends a size x size grid of unit cells at (x0, y0), two triangles per cell
+    inline void addGrid(std::vector<Triangle>& faces, size_t size, double x0 = 0.0, double y0 = 0.0) {
+        for (size_t j = 0; j < size; ++j) {
+            for (size_t i = 0; i < size; ++i) {
+                Point3D a(x0 + i, y0 + j, 0), b(x0 + i + 1.0, y0 + j, 0);
+                Point3D c(x0 + i, y0 + j + 1.0, 0), d(x0 + i + 1.0, y0 + j + 1.0, 0);
+                faces.emplace_back(a, b, c);
+                faces.emplace_back(b, d, c);
+            }
+        }
+    }
+
+    /// Appends a unit cube at (x0, 0, 0), two triangles per side
+    inline void addCube(std::vector<Triangle>& faces, double x0 = 0.0) {
+        const Point3D p[8] = {{x0, 0, 0}, {x0 + 1, 0, 0}, {x0 + 1, 1, 0}, {x0, 1, 0},
+                              {x0, 0, 1}, {x0 + 1, 0, 1}, {x0 + 1, 1, 1}, {x0, 1, 1}};
+        const int quads[6][4] = {{0, 3, 2, 1}, {4, 5, 6, 7}, {0, 1, 5, 4}, {1, 2, 6, 5}, {2, 3, 7, 6}, {3, 0, 4, 7}};
+        for (const auto& quad : quads) {
+            faces.emplace_back(p[quad[0]], p[quad[1]], p[quad[2]]);
+            faces.emplace_back(p[quad[0]], p[quad[2]], p[quad[3]]);
+        }
+    }
+
+    inline MeshData meshOf(const std::vector<Triangle>& faces) {
+        MeshData mesh;
+        for (const Triangle& face : faces) {
+            mesh.addTriangle(face);
+        }
+        return mesh;
+    }
+
+    /// Mesh of addGrid(size, x0)
+    inline MeshData grid(size_t size, double x0 = 0.0) {
+        std::vector<Triangle> faces;
+        addGrid(faces, size, x0);
+        return meshOf(faces);
+    }
+
+    /// Mesh of a unit cube at the origin
+    inline MeshData cube() {
+        std::vector<Triangle> faces;
+        addCube(faces);
+        return meshOf(faces);
+    }
+
+} // namespace meshes
+} // namespace DXFProcessor
@@ -0,0 +1,63 @@
+/**
+ * @file test_metric_store.cpp
+ * @brief Unit tests for typed summary metrics
+ */
+
+#include <gtest/gtest.h>
+#include "MetricStore.h"
+#include <string>
+#include <vector>
+
+using namespace DXFProcessor;
+
+TEST(MetricStoreTest, InternedKeysCompareByIdentity) {
+    MetricKey a = MetricKey::intern("width");
+    MetricKey b = MetricKey::intern(std::string("wid") + "th");
+    MetricKey c = MetricKey::intern("height");
+    
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+    EXPECT_EQ(a.name(), "width");
+    EXPECT_EQ(a.name().data(), b.name().data());
+}
+
+TEST(MetricStoreTest, KeepsInsertionOrderAndReplacesInPlace) {
+    MetricStore store;
+    store.set("zeta", 1.5);
+    store.set("alpha", 7);
+    store.set("mid", std::string("text"));
+    store.set("zeta", 2.5);
+    
+    std::vector<std::string> names;
+    for (const auto& [key, value] : store) {
+        names.emplace_back(key.name());
+    }
+    EXPECT_EQ(names, (std::vector<std::string>{"zeta", "alpha", "mid"}));
+    EXPECT_EQ(store.size(), 3);
+    EXPECT_DOUBLE_EQ(std::get<double>(*store.find("zeta")), 2.5);
+}
+
+TEST(MetricStoreTest, StoresTypedValues) {
+    MetricStore store;
+    store.set("area", 0.1 + 0.2);
+    store.set("count", size_t{2929});
+    store.set("note", "header");
+    
+    EXPECT_TRUE(std::holds_alternative<double>(*store.find("area")));
+    EXPECT_EQ(std::get<std::int64_t>(*store.find("count")), 2929);
+    EXPECT_EQ(std::get<std::string>(*store.find("note")), "header");
+    EXPECT_EQ(store.find("missing"), nullptr);
+    
+    EXPECT_DOUBLE_EQ(store.getNumber("count"), 2929.0);
+    EXPECT_DOUBLE_EQ(store.getNumber("note", -1.0), -1.0);
+    EXPECT_DOUBLE_EQ(store.getNumber("missing", -2.0), -2.0);
+}
+
+TEST(MetricStoreTest, ToStringRoundTrips) {
+    EXPECT_EQ(metricToString(MetricValue(0.1 + 0.2)), "0.30000000000000004");
+    EXPECT_EQ(metricToString(MetricValue(std::int64_t{-42})), "-42");
+    EXPECT_EQ(metricToString(MetricValue(std::string("Bench 1"))), "Bench 1");
+    
+    double value = 141519.88587813257;
+    EXPECT_EQ(std::stod(metricToString(MetricValue(value))), value);
+}
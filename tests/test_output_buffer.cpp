@@ -0,0 +1,108 @@
+/**
+ * @file test_output_buffer.cpp
+ * @brief Unit tests for the reusable output buffer used by SummaryWriter
+ */
+
+#include <gtest/gtest.h>
+#include "OutputBuffer.h"
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+
+using namespace DXFProcessor;
+
+TEST(OutputBufferTest, ShortestRoundTripNumbers) {
+    OutputBuffer out;
+    out.appendNumber(0.1 + 0.2);
+    out.append(' ');
+    out.appendNumber(-773.0);
+    out.append(' ');
+    out.appendNumber(196.739013671875);
+    out.append(' ');
+    out.appendInteger(size_t{2929});
+    
+    EXPECT_EQ(out.view(), "0.30000000000000004 -773 196.739013671875 2929");
+    
+    double parsed = 0.0;
+    std::istringstream(out.str().substr(0, 19)) >> parsed;
+    EXPECT_EQ(parsed, 0.1 + 0.2);
+}
+
+TEST(OutputBufferTest, JSONAndCSVEscaping) {
+    OutputBuffer out;
+    out.appendJSONString("Bench \"1\"\\\n\x01");
+    EXPECT_EQ(out.view(), "\"Bench \\\"1\\\"\\\\\\n\\u0001\"");
+    
+    out.clear();
+    out.appendJSONNumber(std::numeric_limits<double>::infinity());
+    EXPECT_EQ(out.view(), "null");
+    
+    out.clear();
+    out.appendCSVField("plain");
+    out.append(',');
+    out.appendCSVField("a,\"b\"");
+    EXPECT_EQ(out.view(), "plain,\"a,\"\"b\"\"\"");
+}
+
+TEST(OutputBufferTest, PaddingMatchesStreamManipulators) {
+    OutputBuffer out;
+    out.appendPadded("Layer", 8, true);
+    out.appendPaddedInteger(42, 6);
+    out.appendPaddedNumber(1.5, 6);
+    out.appendPadded("too long for width", 4, false);
+    
+    EXPECT_EQ(out.view(), "Layer       42   1.5too long for width");
+}
+
+TEST(OutputBufferTest, GrowsAndKeepsCapacityOnClear) {
+    OutputBuffer out(4);
+    std::string expected;
+    for (int i = 0; i < 1000; ++i) {
+        out.appendInteger(i);
+        expected += std::to_string(i);
+    }
+    EXPECT_EQ(out.view(), expected);
+    
+    size_t capacity = out.capacity();
+    out.clear();
+    EXPECT_TRUE(out.empty());
+    EXPECT_EQ(out.capacity(), capacity);
+}
+
+TEST(OutputBufferTest, RecognisesJSONNumbers) {
+    EXPECT_TRUE(isJSONNumber("42"));
+    EXPECT_TRUE(isJSONNumber("-0.5"));
+    EXPECT_TRUE(isJSONNumber("3.141592653589793"));
+    EXPECT_TRUE(isJSONNumber("1e-7"));
+    EXPECT_TRUE(isJSONNumber("2.5E+10"));
+    
+    EXPECT_FALSE(isJSONNumber(""));
+    EXPECT_FALSE(isJSONNumber("-"));
+    EXPECT_FALSE(isJSONNumber("+1"));
+    EXPECT_FALSE(isJSONNumber("012"));
+    EXPECT_FALSE(isJSONNumber("1."));
+    EXPECT_FALSE(isJSONNumber(".5"));
+    EXPECT_FALSE(isJSONNumber("12abc"));
+    EXPECT_FALSE(isJSONNumber("inf"));
+    EXPECT_FALSE(isJSONNumber("nan"));
+    EXPECT_FALSE(isJSONNumber("0x1A"));
+    EXPECT_FALSE(isJSONNumber(" 1"));
+}
+
+TEST(OutputBufferTest, WritesFileInOneCall) {
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "output_buffer_test.txt";
+    OutputBuffer out;
+    out.append("first line\nsecond line\n");
+    
+    ASSERT_TRUE(out.writeTo(path));
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    EXPECT_EQ(contents.str(), "first line\nsecond line\n");
+    
+    file.close();
+    std::filesystem::remove(path);
+    EXPECT_FALSE(out.writeTo(path / "missing_directory" / "file.txt"));
+}
@@ -0,0 +1,438 @@
+/**
+ * @file test_performance.cpp
+ * @brief Throughput and memory regression gate (ctest label "perf")
+ *
+ * Each test reads or summarizes the generated fixture perf_pit.dxf, written
+ * by dxf_generate in the perf.generate_fixture ctest fixture, and compares
+ * the result with tests/perf/perf_baseline.json:
+ * - throughput (MB/s or triangles/s, best of several runs) must not fall
+ *   more than "tolerance" below the baseline; checked in optimized
+ *   (NDEBUG) builds only, as the baseline is for release code;
+ * - memory growth per triangle must not exceed the baseline by more than
+ *   "tolerance" plus "memory_slack_bytes"; checked in every build.
+ *
+ * Memory growth is the larger of the peak RSS delta, which sees mapped
+ * files, and the peak live heap delta, tracked by this file's operator
+ * new. The summarizer cases read the fixture first, which already raises
+ * the RSS high-water mark above anything summarizing needs, so for them
+ * only the heap figure can move. Measurements are printed, attached as
+ * gtest properties and appended to perf_results.ndjson.
+ *
+ * After an intended change, or on a new machine, refresh the baseline with
+ *     DXF_PERF_UPDATE_BASELINE=1 ctest -L perf
+ * from a Release build.
+ */
+
+#include <gtest/gtest.h>
+#include "DXFPipeline.h"
+#include "DXFReader.h"
+#include "MeshSummarizer.h"
+#include "OutputBuffer.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace DXFProcessor;
+
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define DXF_TRACK_HEAP 0
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer)
+#define DXF_TRACK_HEAP 0
+#endif
+#endif
+
+#ifndef DXF_TRACK_HEAP
+#define DXF_TRACK_HEAP 1
+#endif
+
+namespace {
+
+    /// Live and peak heap bytes allocated through operator new
+    struct HeapUsage {
+        std::atomic<std::int64_t> live{0};
+        std::atomic<std::int64_t> peak{0};
+        
+        /// Restarts the peak from the current live size, returning that size
+        std::int64_t resetPeak() {
+            std::int64_t current = live.load();
+            peak.store(current);
+            return current;
+        }
+    };
+    
+    HeapUsage heapUsage;
+
+#if DXF_TRACK_HEAP
+    /// Each block is prefixed with its size so delete can subtract it
+    constexpr std::size_t HEADER = alignof(std::max_align_t);
+    
+    void* trackedAllocate(std::size_t size) {
+        while (true) {
+            if (void* raw = std::malloc(size + HEADER)) {
+                *static_cast<std::size_t*>(raw) = size;
+                std::int64_t live = heapUsage.live.fetch_add(static_cast<std::int64_t>(size)) +
+                                    static_cast<std::int64_t>(size);
+                std::int64_t peak = heapUsage.peak.load(std::memory_order_relaxed);
+                while (live > peak && !heapUsage.peak.compare_exchange_weak(peak, live)) {
+                }
+                return static_cast<char*>(raw) + HEADER;
+            }
+            std::new_handler handler = std::get_new_handler();
+            if (handler == nullptr) {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+    
+    void trackedFree(void* block) noexcept {
+        if (block != nullptr) {
+            void* raw = static_cast<char*>(block) - HEADER;
+            heapUsage.live.fetch_sub(static_cast<std::int64_t>(*static_cast<std::size_t*>(raw)));
+            std::free(raw);
+        }
+    }
+#endif
+
+    using Metrics = std::map<std::string, double>;
+
+    /// perf_baseline.json: numeric settings at the top level, one object of metrics per case
+    struct Baseline {
+        Metrics settings;
+        std::map<std::string, Metrics> cases;
+    };
+
+    /// Reader for the two-level subset of JSON the baseline file uses
+    class BaselineParser {
+    public:
+        explicit BaselineParser(std::string text) : text_(std::move(text)) {}
+        
+        Baseline parse() {
+            Baseline baseline;
+            expect('{');
+            while (!consume('}')) {
+                std::string key = parseString();
+                expect(':');
+                if (peek() == '{') {
+                    Metrics& metrics = baseline.cases[key];
+                    expect('{');
+                    while (!consume('}')) {
+                        std::string metric = parseString();
+                        expect(':');
+                        metrics[metric] = parseNumber();
+                        consume(',');
+                    }
+                } else {
+                    baseline.settings[key] = parseNumber();
+                }
+                consume(',');
+            }
+            return baseline;
+        }
+
+    private:
+        char peek() {
+            while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+                ++pos_;
+            }
+            return pos_ < text_.size() ? text_[pos_] : '\0';
+        }
+        
+        bool consume(char c) {
+            if (peek() == c) {
+                ++pos_;
+                return true;
+            }
+            return false;
+        }
+        
+        void expect(char c) {
+            if (!consume(c)) {
+                throw std::runtime_error(std::string("perf baseline: expected '") + c + "' at offset " +
+                                         std::to_string(pos_));
+            }
+        }
+        
+        std::string parseString() {
+            expect('"');
+            size_t end = text_.find('"', pos_);
+            if (end == std::string::npos) {
+                throw std::runtime_error("perf baseline: unterminated string");
+            }
+            std::string value = text_.substr(pos_, end - pos_);
+            pos_ = end + 1;
+            return value;
+        }
+        
+        double parseNumber() {
+            peek();
+            char* end = nullptr;
+            double value = std::strtod(text_.c_str() + pos_, &end);
+            if (end == text_.c_str() + pos_) {
+                throw std::runtime_error("perf baseline: expected a number at offset " + std::to_string(pos_));
+            }
+            pos_ = static_cast<size_t>(end - text_.c_str());
+            return value;
+        }
+        
+        std::string text_;
+        size_t pos_ = 0;
+    };
+
+    Baseline loadBaseline() {
+        std::ifstream in(PERF_BASELINE_FILE);
+        if (!in.is_open()) {
+            return Baseline();
+        }
+        std::stringstream content;
+        content << in.rdbuf();
+        return BaselineParser(content.str()).parse();
+    }
+
+    void saveBaseline(const Baseline& baseline) {
+        OutputBuffer out;
+        out.append("{\n");
+        for (const auto& [name, value] : baseline.settings) {
+            out.append("  ");
+            out.appendJSONString(name);
+            out.append(": ");
+            out.appendJSONNumber(value);
+            out.append(",\n");
+        }
+        size_t remaining = baseline.cases.size();
+        for (const auto& [name, metrics] : baseline.cases) {
+            out.append("  ");
+            out.appendJSONString(name);
+            out.append(": {");
+            size_t metric = 0;
+            for (const auto& [key, value] : metrics) {
+                out.append(metric++ > 0 ? ", " : "");
+                out.appendJSONString(key);
+                out.append(": ");
+                out.appendJSONNumber(value);
+            }
+            out.append(--remaining > 0 ? "},\n" : "}\n");
+        }
+        out.append("}\n");
+        if (!out.writeTo(PERF_BASELINE_FILE)) {
+            throw std::runtime_error("Cannot write " + std::string(PERF_BASELINE_FILE));
+        }
+    }
+
+    bool updatingBaseline() {
+        const char* value = std::getenv("DXF_PERF_UPDATE_BASELINE");
+        return value != nullptr && std::string(value) == "1";
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+}
+
+#if DXF_TRACK_HEAP
+void* operator new(std::size_t size) {
+    return trackedAllocate(size);
+}
+
+void* operator new[](std::size_t size) {
+    return trackedAllocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return trackedAllocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return trackedAllocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* block) noexcept {
+    trackedFree(block);
+}
+
+void operator delete[](void* block) noexcept {
+    trackedFree(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept {
+    trackedFree(block);
+}
+
+void operator delete[](void* block, std::size_t) noexcept {
+    trackedFree(block);
+}
+
+void operator delete(void* block, const std::nothrow_t&) noexcept {
+    trackedFree(block);
+}
+
+void operator delete[](void* block, const std::nothrow_t&) noexcept {
+    trackedFree(block);
+}
+#endif
+
+class PerfTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        fixturePath = PERF_FIXTURE_FILE;
+        if (!std::filesystem::exists(fixturePath)) {
+            GTEST_SKIP() << "Fixture " << fixturePath << " missing; run through ctest -L perf, "
+                         << "which generates it with dxf_generate";
+        }
+        fixtureBytes = static_cast<double>(std::filesystem::file_size(fixturePath));
+    }
+
+    /**
+     * @brief Times 'run' RUNS times and tracks the memory it adds
+     *
+     * 'run' returns the triangles it processed. Throughput is taken from
+     * the fastest run; memory is the larger growth of the process RSS
+     * high-water mark and of the peak live heap, over their values before
+     * the first run.
+     */
+    Metrics measure(const std::function<size_t()>& run) {
+        const std::uint64_t peakBefore = Profiler::peakResidentBytes();
+        const std::int64_t heapBefore = heapUsage.resetPeak();
+        double bestSeconds = 0.0;
+        size_t triangles = 0;
+        for (int i = 0; i < RUNS; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            triangles = run();
+            double seconds = secondsSince(start);
+            bestSeconds = (i == 0) ? seconds : std::min(bestSeconds, seconds);
+        }
+        const std::uint64_t peakAfter = Profiler::peakResidentBytes();
+        const std::int64_t heapGrowth = heapUsage.peak.load() - heapBefore;
+        EXPECT_GT(triangles, 0u);
+        
+        const double rssGrowth = static_cast<double>(peakAfter - std::min(peakBefore, peakAfter));
+        Metrics metrics;
+        metrics["triangles_per_second"] = triangles / bestSeconds;
+        metrics["mb_per_second"] = fixtureBytes / (1024.0 * 1024.0) / bestSeconds;
+        metrics["bytes_per_triangle"] = std::max(rssGrowth, static_cast<double>(heapGrowth)) /
+                                        std::max<size_t>(triangles, 1);
+        metrics["peak_heap_growth_bytes"] = static_cast<double>(heapGrowth);
+        metrics["peak_rss_bytes"] = static_cast<double>(peakAfter);
+        return metrics;
+    }
+
+    /**
+     * @brief Reports a case and checks it against the baseline
+     * @param throughputMetric "mb_per_second" or "triangles_per_second", the figure gated for this case
+     */
+    void checkAgainstBaseline(const std::string& name, const Metrics& measured, const std::string& throughputMetric) {
+        const double throughput = measured.at(throughputMetric);
+        const double bytesPerTriangle = measured.at("bytes_per_triangle");
+        std::cout << "  " << name << ": " << throughput << " " << throughputMetric << ", "
+                  << bytesPerTriangle << " bytes/triangle, peak RSS "
+                  << measured.at("peak_rss_bytes") / (1024.0 * 1024.0) << " MB" << std::endl;
+        for (const auto& [key, value] : measured) {
+            RecordProperty(key, std::to_string(value));
+        }
+        appendResult(name, measured);
+        
+        Baseline baseline = loadBaseline();
+        if (updatingBaseline()) {
+            baseline.settings.emplace("tolerance", 0.25);
+            baseline.settings.emplace("memory_slack_bytes", 16.0);
+            baseline.cases[name] = Metrics{{throughputMetric, throughput}, {"bytes_per_triangle", bytesPerTriangle}};
+            saveBaseline(baseline);
+            return;
+        }
+        
+        auto entry = baseline.cases.find(name);
+        ASSERT_NE(entry, baseline.cases.end()) << "No baseline for " << name << " in " << PERF_BASELINE_FILE;
+        const Metrics& expected = entry->second;
+        const double tolerance = baseline.settings.count("tolerance") ? baseline.settings.at("tolerance") : 0.25;
+        const double slack = baseline.settings.count("memory_slack_bytes") ? baseline.settings.at("memory_slack_bytes") : 16.0;
+        
+        double memoryLimit = expected.at("bytes_per_triangle") * (1.0 + tolerance) + slack;
+        EXPECT_LE(bytesPerTriangle, memoryLimit)
+            << name << ": peak memory per triangle grew beyond the baseline of "
+            << expected.at("bytes_per_triangle");
+
+#ifdef NDEBUG
+        double throughputLimit = expected.at(throughputMetric) * (1.0 - tolerance);
+        EXPECT_GE(throughput, throughputLimit)
+            << name << ": " << throughputMetric << " dropped below the baseline of " << expected.at(throughputMetric);
+#else
+        std::cout << "  (throughput not gated: baseline is for optimized builds)" << std::endl;
+#endif
+    }
+
+    static void appendResult(const std::string& name, const Metrics& measured) {
+        OutputBuffer out;
+        out.append("{\"case\":");
+        out.appendJSONString(name);
+        for (const auto& [key, value] : measured) {
+            out.append(',');
+            out.appendJSONString(key);
+            out.append(':');
+            out.appendJSONNumber(value);
+        }
+        out.append("}\n");
+        std::ofstream("perf_results.ndjson", std::ios::app) << out.view();
+    }
+
+    static constexpr int RUNS = 3;
+
+    std::string fixturePath;
+    double fixtureBytes = 0.0;
+};
+
+TEST_F(PerfTest, ReadSequential) {
+    auto reader = DXFReaderFactory::createReader();
+    Metrics metrics = measure([&] { return reader->readFile(fixturePath)->getTriangleCount(); });
+    checkAgainstBaseline("read_sequential", metrics, "mb_per_second");
+}
+
+TEST_F(PerfTest, ReadPipeline) {
+    auto summarizer = MeshSummarizerFactory::create("basic");
+    DXFPipeline pipeline;
+    Metrics metrics = measure([&] { return pipeline.run(fixturePath, *summarizer).entityCount; });
+    checkAgainstBaseline("read_pipeline", metrics, "mb_per_second");
+}
+
+TEST_F(PerfTest, SummarizeBasic) {
+    auto meshData = DXFReaderFactory::createReader()->readFile(fixturePath);
+    auto summarizer = MeshSummarizerFactory::create("basic");
+    Metrics metrics = measure([&] {
+        meshData->invalidateAggregates();  // Time the full pass, not the cache
+        return summarizer->summarize(*meshData).triangleCount;
+    });
+    checkAgainstBaseline("summarize_basic", metrics, "triangles_per_second");
+}
+
+TEST_F(PerfTest, SummarizeDetailed) {
+    auto meshData = DXFReaderFactory::createReader()->readFile(fixturePath);
+    auto summarizer = MeshSummarizerFactory::create("detailed");
+    Metrics metrics = measure([&] {
+        meshData->invalidateAggregates();  // Time the full pass, not the cache
+        return summarizer->summarize(*meshData).triangleCount;
+    });
+    checkAgainstBaseline("summarize_detailed", metrics, "triangles_per_second");
+}
@@ -0,0 +1,160 @@
+/**
+ * @file test_profiler.cpp
+ * @brief Unit tests for the phase profiler (scoped timers, counters, trace output)
+ */
+
+#include <gtest/gtest.h>
+#include "Profiler.h"
+#include "DXFIndex.h"
+#include "DXFReader.h"
+#include "MeshSummarizer.h"
+#include "OutputBuffer.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace DXFProcessor;
+
+class ProfilerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testDataDir = TEST_DATA_DIR;
+        testOutputDir = "profiler_test_output";
+        std::filesystem::create_directories(testOutputDir);
+    }
+    
+    void TearDown() override {
+        Profiler::disable();
+        std::filesystem::remove_all(testOutputDir);
+    }
+    
+    static const ProfileScopeStats* findScope(const ProfileReport& report, const std::string& name) {
+        for (const auto& scope : report.scopes) {
+            if (scope.name == name) {
+                return &scope;
+            }
+        }
+        return nullptr;
+    }
+    
+    std::string testDataDir;
+    std::string testOutputDir;
+};
+
+TEST_F(ProfilerTest, RecordsNothingWhileDisabled) {
+    Profiler::enable();
+    Profiler::disable();
+    {
+        ProfileScope scope("disabled");
+        Profiler::count(ProfileCounter::Entities, 5);
+    }
+    
+    ProfileReport report = Profiler::report();
+    EXPECT_TRUE(report.scopes.empty());
+    EXPECT_EQ(report.counter(ProfileCounter::Entities), 0u);
+}
+
+TEST_F(ProfilerTest, AggregatesScopesAcrossThreads) {
+    Profiler::enable();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < 10; ++i) {
+                ProfileScope scope("worker");
+                Profiler::count(ProfileCounter::Lines, 2);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    {
+        ProfileScope scope("after");
+    }
+    
+    ProfileReport report = Profiler::report();
+    ASSERT_EQ(report.scopes.size(), 2u);
+    EXPECT_EQ(report.scopes[0].name, "worker");  // First-execution order
+    EXPECT_EQ(report.scopes[0].calls, 40u);
+    EXPECT_LE(report.scopes[0].maxSeconds, report.scopes[0].totalSeconds);
+    EXPECT_EQ(report.counter(ProfileCounter::Lines), 80u);
+    
+    Profiler::enable();  // Restarting clears everything
+    EXPECT_TRUE(Profiler::report().scopes.empty());
+}
+
+TEST_F(ProfilerTest, ReaderReportsPhasesAndCounters) {
+    if (!Profiler::compiledIn()) {
+        GTEST_SKIP() << "Built with DXF_PROFILING=0";
+    }
+    std::string file = testDataDir + "/two_triangles.dxf";
+    
+    Profiler::enable();
+    auto meshData = DXFReaderFactory::createReader()->readFile(file);
+    MeshSummarizerFactory::create("basic")->summarize(*meshData);
+    ProfileReport report = Profiler::report();
+    
+    ASSERT_NE(findScope(report, "open"), nullptr);
+    ASSERT_NE(findScope(report, "parse"), nullptr);
+    ASSERT_NE(findScope(report, "summarize"), nullptr);
+    EXPECT_EQ(report.counter(ProfileCounter::BytesRead), std::filesystem::file_size(file));
+    EXPECT_EQ(report.counter(ProfileCounter::Entities), 2u);
+    EXPECT_GT(report.counter(ProfileCounter::Lines), 0u);
+    // Every group code, plus three coordinates of three vertices per face
+    EXPECT_EQ(report.counter(ProfileCounter::NumericConversions), report.counter(ProfileCounter::Lines) / 2 + 18);
+    EXPECT_GT(report.peakResidentBytes, 0u);
+    
+    OutputBuffer table;
+    Profiler::formatTable(report, table);
+    std::string text = table.str();
+    EXPECT_NE(text.find("parse"), std::string::npos);
+    EXPECT_NE(text.find("numeric conversions"), std::string::npos);
+    EXPECT_NE(text.find("peak RSS (KB)"), std::string::npos);
+}
+
+TEST_F(ProfilerTest, IndexAndHeaderReadsCountConversions) {
+    if (!Profiler::compiledIn()) {
+        GTEST_SKIP() << "Built with DXF_PROFILING=0";
+    }
+    std::string file = testDataDir + "/two_triangles.dxf";
+    
+    Profiler::enable();
+    DXFIndex::build(file);
+    ProfileReport report = Profiler::report();
+    // Every group code, plus the X and Y of three vertices per face
+    EXPECT_EQ(report.counter(ProfileCounter::NumericConversions), report.counter(ProfileCounter::Lines) / 2 + 12);
+    
+    Profiler::enable();
+    DXFReaderFactory::createReader()->readHeader(file);
+    report = Profiler::report();
+    EXPECT_GT(report.counter(ProfileCounter::Lines), 0u);
+    EXPECT_EQ(report.counter(ProfileCounter::NumericConversions), report.counter(ProfileCounter::Lines) / 2);
+}
+
+TEST_F(ProfilerTest, WritesChromeTraceEvents) {
+    Profiler::enable(true);
+    {
+        ProfileScope outer("outer \"phase\"");
+        ProfileScope inner("inner");
+    }
+    Profiler::count(ProfileCounter::Entities, 3);
+    
+    std::string path = testOutputDir + "/trace.json";
+    Profiler::writeChromeTrace(path);
+    
+    std::ifstream in(path);
+    std::stringstream content;
+    content << in.rdbuf();
+    std::string json = content.str();
+    
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(json.find("{\"name\":\"inner\",\"cat\":\"dxf\",\"ph\":\"X\",\"pid\":1,\"tid\":"), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"outer \\\"phase\\\"\""), std::string::npos);
+    EXPECT_NE(json.find("\"ph\":\"C\""), std::string::npos);
+    EXPECT_NE(json.find("\"entities\":3,"), std::string::npos);
+    EXPECT_EQ(json.substr(json.size() - 4), "\n]}\n");
+    
+    std::ofstream(testOutputDir + "/file") << "x";
+    EXPECT_THROW(Profiler::writeChromeTrace(testOutputDir + "/file/trace.json"), ProfilerException);
+}
@@ -0,0 +1,93 @@
+/**
+ * @file test_radix_sort.cpp
+ * @brief Unit tests for the parallel radix sort of packed keys
+ */
+
+#include <gtest/gtest.h>
+#include "RadixSort.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace DXFProcessor;
+
+namespace {
+
+    /// count keys with random codes above a 20-bit index
+    std::vector<std::uint64_t> packedKeys(size_t count, std::uint64_t codeRange) {
+        std::mt19937_64 random(3);
+        std::vector<std::uint64_t> keys(count);
+        for (size_t i = 0; i < count; ++i) {
+            keys[i] = ((random() % codeRange) << 20) | i;
+        }
+        return keys;
+    }
+
+}
+
+TEST(RadixSortTest, SortsLikeStdSort) {
+    std::vector<std::uint64_t> keys = packedKeys(50000, std::uint64_t{1} << 44);
+    std::vector<std::uint64_t> expected = keys;
+    std::sort(expected.begin(), expected.end());
+
+    radixSortKeys(keys, 20);
+
+    EXPECT_EQ(keys, expected);
+}
+
+TEST(RadixSortTest, EqualCodesKeepInputOrder) {
+    // Indices in descending order: a stable sort on the codes alone must keep them so
+    std::vector<std::uint64_t> keys;
+    for (std::uint64_t i = 0; i < 1000; ++i) {
+        keys.push_back(((i % 3) << 20) | (999 - i));
+    }
+
+    radixSortKeys(keys, 20);
+
+    for (size_t i = 1; i < keys.size(); ++i) {
+        if ((keys[i] >> 20) == (keys[i - 1] >> 20)) {
+            EXPECT_LT(keys[i] & 0xFFFFF, keys[i - 1] & 0xFFFFF);
+        } else {
+            EXPECT_GT(keys[i] >> 20, keys[i - 1] >> 20);
+        }
+    }
+}
+
+TEST(RadixSortTest, PoolGivesSameResult) {
+    std::vector<std::uint64_t> serial = packedKeys(200000, 1000);
+    std::vector<std::uint64_t> parallel = serial;
+    ThreadPool pool(4);
+
+    radixSortKeys(serial, 20);
+    radixSortKeys(parallel, 20, &pool);
+
+    EXPECT_EQ(serial, parallel);
+    EXPECT_TRUE(std::is_sorted(serial.begin(), serial.end()));
+}
+
+TEST(RadixSortTest, RunBoundsKeepEqualCodesTogether) {
+    std::vector<std::uint64_t> keys = packedKeys(10000, 40);
+    radixSortKeys(keys, 20);
+
+    std::vector<size_t> bounds = sortedRunBounds(keys, 20, 7);
+
+    ASSERT_EQ(bounds.size(), 8u);
+    EXPECT_EQ(bounds.front(), 0u);
+    EXPECT_EQ(bounds.back(), keys.size());
+    for (size_t c = 1; c < 7; ++c) {
+        EXPECT_LE(bounds[c - 1], bounds[c]);
+        if (bounds[c] > 0 && bounds[c] < keys.size()) {
+            EXPECT_NE(keys[bounds[c]] >> 20, keys[bounds[c] - 1] >> 20) << "Bound " << c << " splits a run";
+        }
+    }
+}
+
+TEST(RadixSortTest, BitWidthCoversLargestValue) {
+    EXPECT_EQ(bitWidth(0), 1);
+    EXPECT_EQ(bitWidth(1), 1);
+    EXPECT_EQ(bitWidth(2), 2);
+    EXPECT_EQ(bitWidth(255), 8);
+    EXPECT_EQ(bitWidth(256), 9);
+    EXPECT_EQ(bitWidth(~size_t{0}), 64);
+}
@@ -0,0 +1,177 @@
+/**
+ * @file test_segmented_vector.cpp
+ * @brief Unit tests for the block-segmented sequence behind MeshData
+ */
+
+#include <gtest/gtest.h>
+#include "SegmentedVector.h"
+#include "MeshData.h"
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <string>
+
+using namespace DXFProcessor;
+
+// Small blocks so a few dozen elements span several of them
+using SmallVector = SegmentedVector<int, 8>;
+
+TEST(SegmentedVectorTest, PushIndexAndIterate) {
+    SmallVector values;
+    EXPECT_TRUE(values.empty());
+    for (int i = 0; i < 30; ++i) {
+        values.push_back(i);
+    }
+    
+    ASSERT_EQ(values.size(), 30u);
+    EXPECT_EQ(values.blockCount(), 4u);
+    EXPECT_EQ(values.capacity(), 32u);
+    EXPECT_EQ(values[17], 17);
+    EXPECT_EQ(values.front(), 0);
+    EXPECT_EQ(values.back(), 29);
+    EXPECT_THROW(values.at(30), std::out_of_range);
+    
+    int expected = 0;
+    for (int value : values) {
+        EXPECT_EQ(value, expected++);
+    }
+    EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0), 435);
+    EXPECT_EQ(values.end() - values.begin(), 30);
+    EXPECT_EQ(*(values.begin() + 9), 9);
+    
+    // Blocks: all full but the last
+    EXPECT_EQ(values.block(0).size, 8u);
+    EXPECT_EQ(values.block(3).size, 6u);
+    EXPECT_EQ(values.block(3).begin()[0], 24);
+}
+
+TEST(SegmentedVectorTest, AddressesStayStable) {
+    SmallVector values;
+    values.push_back(42);
+    const int* first = &values[0];
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back(i);
+    }
+    EXPECT_EQ(first, &values[0]);
+    EXPECT_EQ(*first, 42);
+}
+
+TEST(SegmentedVectorTest, ReserveResizeClear) {
+    SmallVector values;
+    values.reserve(20);
+    EXPECT_EQ(values.capacity(), 24u);
+    EXPECT_TRUE(values.empty());
+    
+    values.resize(19);
+    EXPECT_EQ(values.size(), 19u);
+    EXPECT_EQ(values[18], 0);
+    values.resize(5);
+    EXPECT_EQ(values.size(), 5u);
+    
+    values.clear();
+    EXPECT_TRUE(values.empty());
+    EXPECT_EQ(values.capacity(), 24u);  // Blocks kept for reuse
+    values.shrink_to_fit();
+    EXPECT_EQ(values.capacity(), 0u);
+    
+    std::fill_n(values.begin(), 0, 1);
+    values.resize(10);
+    std::fill_n(values.begin() + 3, 6, 7);
+    EXPECT_EQ(std::count(values.begin(), values.end(), 7), 6);
+}
+
+TEST(SegmentedVectorTest, CopyMoveAndSwap) {
+    SmallVector values;
+    for (int i = 0; i < 20; ++i) {
+        values.push_back(i);
+    }
+    
+    SmallVector copy = values;
+    copy[0] = 100;
+    EXPECT_EQ(values[0], 0);
+    EXPECT_EQ(copy.size(), 20u);
+    
+    SmallVector moved = std::move(copy);
+    EXPECT_EQ(moved[0], 100);
+    EXPECT_TRUE(copy.empty());
+    
+    moved.swap(values);
+    EXPECT_EQ(values[0], 100);
+    EXPECT_EQ(moved[0], 0);
+}
+
+TEST(SegmentedVectorTest, AppendSplicesWholeBlocks) {
+    SmallVector head;
+    for (int i = 0; i < 16; ++i) {
+        head.push_back(i);
+    }
+    SmallVector tail;
+    for (int i = 16; i < 21; ++i) {
+        tail.push_back(i);
+    }
+    const int* tailFirst = &tail[0];
+    
+    // Block-aligned: the tail's blocks are taken over, nothing moves
+    head.append(std::move(tail));
+    EXPECT_TRUE(tail.empty());
+    ASSERT_EQ(head.size(), 21u);
+    EXPECT_EQ(&head[16], tailFirst);
+    
+    // Not aligned: elements are moved over
+    SmallVector more;
+    for (int i = 21; i < 40; ++i) {
+        more.push_back(i);
+    }
+    head.append(std::move(more));
+    ASSERT_EQ(head.size(), 40u);
+    for (int i = 0; i < 40; ++i) {
+        ASSERT_EQ(head[i], i);
+    }
+    
+    SmallVector copy;
+    copy.append(head);
+    EXPECT_EQ(copy.size(), 40u);
+    EXPECT_EQ(head.size(), 40u);
+}
+
+TEST(SegmentedVectorTest, DestroysNonTrivialElements) {
+    auto counter = std::make_shared<int>(0);
+    {
+        SegmentedVector<std::shared_ptr<int>, 4> owners;
+        for (int i = 0; i < 10; ++i) {
+            owners.push_back(counter);
+        }
+        EXPECT_EQ(counter.use_count(), 11);
+        owners.pop_back();
+        EXPECT_EQ(counter.use_count(), 10);
+        owners.resize(3);
+        EXPECT_EQ(counter.use_count(), 4);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+    
+    SegmentedVector<std::string, 4> names;
+    names.emplace_back(64, 'x');
+    names.clear();
+    names.emplace_back("after clear");
+    EXPECT_EQ(names[0], "after clear");
+}
+
+TEST(SegmentedVectorTest, MeshAppendMovesAndRemapsLayers) {
+    MeshData mesh;
+    mesh.internLayer("Pit");
+    Triangle triangle(Point3D(0, 0, 0), Point3D(1, 0, 0), Point3D(0, 1, 0));
+    
+    MeshData part;
+    LayerId ramp = part.internLayer("Ramp");
+    LayerId pit = part.internLayer("Pit");
+    for (size_t i = 0; i < 3 * SegmentedVector<Triangle>::BLOCK_SIZE + 5; ++i) {
+        part.addTriangle(triangle, i % 2 ? ramp : pit);
+    }
+    
+    mesh.append(std::move(part));
+    EXPECT_TRUE(part.isEmpty());
+    ASSERT_EQ(mesh.getTriangleCount(), 3 * SegmentedVector<Triangle>::BLOCK_SIZE + 5);
+    EXPECT_EQ(mesh.getLayerName(mesh.getTriangleLayer(0)), "Pit");
+    EXPECT_EQ(mesh.getLayerName(mesh.getTriangleLayer(1)), "Ramp");
+    EXPECT_EQ(mesh.getLayerCount(), 3u);
+}
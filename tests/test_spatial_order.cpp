@@ -0,0 +1,185 @@
+/**
+ * @file test_spatial_order.cpp
+ * @brief Unit tests for space-filling-curve triangle reordering
+ */
+
+#include <gtest/gtest.h>
+#include "SpatialOrder.h"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace DXFProcessor;
+
+namespace {
+
+    /// A size x size grid surface (two triangles per cell, one layer per row band), in shuffled order
+    MeshData shuffledGrid(size_t size, unsigned seed = 7) {
+        MeshData mesh;
+        std::vector<LayerId> bands;
+        for (int band = 0; band < 4; ++band) {
+            bands.push_back(mesh.internLayer("Band " + std::to_string(band)));
+        }
+        std::vector<std::pair<Triangle, LayerId>> faces;
+        for (size_t j = 0; j < size; ++j) {
+            for (size_t i = 0; i < size; ++i) {
+                Point3D a(i, j, 0.1 * i), b(i + 1.0, j, 0.1 * (i + 1)), c(i, j + 1.0, 0.1 * i);
+                Point3D d(i + 1.0, j + 1.0, 0.1 * (i + 1));
+                LayerId layer = bands[j * bands.size() / size];
+                faces.emplace_back(Triangle(a, b, c), layer);
+                faces.emplace_back(Triangle(b, d, c), layer);
+            }
+        }
+        std::shuffle(faces.begin(), faces.end(), std::mt19937(seed));
+        
+        for (const auto& [triangle, layer] : faces) {
+            mesh.addTriangle(triangle, layer);
+        }
+        return mesh;
+    }
+
+    /// Summed distance between the centroids of consecutive triangles
+    double pathLength(const MeshData& mesh) {
+        double length = 0.0;
+        for (size_t i = 1; i < mesh.getTriangleCount(); ++i) {
+            length += (mesh.getTriangle(i).center() - mesh.getTriangle(i - 1).center()).magnitude();
+        }
+        return length;
+    }
+
+    bool sameTriangle(const Triangle& a, const Triangle& b) {
+        return a.vertices[0] == b.vertices[0] && a.vertices[1] == b.vertices[1] && a.vertices[2] == b.vertices[2];
+    }
+
+}
+
+TEST(SpatialOrderTest, MortonInterleavesAxes) {
+    EXPECT_EQ(SpatialOrder::mortonCode(1, 0, 0), 1u);
+    EXPECT_EQ(SpatialOrder::mortonCode(0, 1, 0), 2u);
+    EXPECT_EQ(SpatialOrder::mortonCode(0, 0, 1), 4u);
+    EXPECT_EQ(SpatialOrder::mortonCode(2, 0, 0), 8u);
+    EXPECT_EQ(SpatialOrder::mortonCode(0x1FFFFF, 0x1FFFFF, 0x1FFFFF), (std::uint64_t{1} << 63) - 1);
+}
+
+TEST(SpatialOrderTest, HilbertVisitsEveryCellThroughNeighbours) {
+    const int bits = 3;
+    const std::uint32_t side = 1u << bits;
+    std::vector<std::array<int, 3>> cells(side * side * side, {-1, -1, -1});
+    for (std::uint32_t z = 0; z < side; ++z) {
+        for (std::uint32_t y = 0; y < side; ++y) {
+            for (std::uint32_t x = 0; x < side; ++x) {
+                std::uint64_t code = SpatialOrder::hilbertCode(x, y, z, bits);
+                ASSERT_LT(code, cells.size());
+                ASSERT_EQ(cells[code][0], -1) << "Two cells share code " << code;
+                cells[code] = {static_cast<int>(x), static_cast<int>(y), static_cast<int>(z)};
+            }
+        }
+    }
+
+    EXPECT_EQ(cells.front(), (std::array<int, 3>{0, 0, 0}));
+    for (size_t i = 1; i < cells.size(); ++i) {
+        int steps = std::abs(cells[i][0] - cells[i - 1][0]) + std::abs(cells[i][1] - cells[i - 1][1]) +
+                    std::abs(cells[i][2] - cells[i - 1][2]);
+        EXPECT_EQ(steps, 1) << "Cells " << i - 1 << " and " << i << " are not face neighbours";
+    }
+}
+
+TEST(SpatialOrderTest, ReorderKeepsTrianglesAndLayers) {
+    const MeshData original = shuffledGrid(40);
+    MeshData mesh = original;
+
+    TrianglePermutation fileOrder = SpatialOrder().reorder(mesh);
+
+    ASSERT_EQ(fileOrder.size(), original.getTriangleCount());
+    ASSERT_EQ(mesh.getTriangleCount(), original.getTriangleCount());
+    std::vector<bool> seen(fileOrder.size(), false);
+    for (size_t i = 0; i < fileOrder.size(); ++i) {
+        ASSERT_FALSE(seen.at(fileOrder[i]));
+        seen[fileOrder[i]] = true;
+        EXPECT_TRUE(sameTriangle(mesh.getTriangle(i), original.getTriangle(fileOrder[i])));
+        EXPECT_EQ(mesh.getTriangleLayer(i), original.getTriangleLayer(fileOrder[i]));
+    }
+    EXPECT_NEAR(mesh.getTotalSurfaceArea(), original.getTotalSurfaceArea(), 1e-9);
+}
+
+TEST(SpatialOrderTest, ReorderShortensPathBetweenNeighbours) {
+    MeshData hilbert = shuffledGrid(64);
+    MeshData morton = hilbert;
+    const double shuffled = pathLength(hilbert);
+
+    SpatialOrder().reorder(hilbert);
+    SpatialOrderOptions options;
+    options.curve = SpaceFillingCurve::Morton;
+    SpatialOrder(options).reorder(morton);
+
+    // A 64 x 64 grid walked cell by cell is about 2 units per triangle pair
+    EXPECT_LT(pathLength(hilbert), shuffled / 20.0);
+    EXPECT_LT(pathLength(morton), shuffled / 10.0);
+    EXPECT_LT(pathLength(hilbert), pathLength(morton));
+}
+
+TEST(SpatialOrderTest, RestoreGivesFileOrder) {
+    const MeshData original = shuffledGrid(20);
+    MeshData mesh = original;
+
+    TrianglePermutation fileOrder = SpatialOrder().reorder(mesh);
+    SpatialOrder::restore(mesh, fileOrder);
+
+    for (size_t i = 0; i < original.getTriangleCount(); ++i) {
+        EXPECT_TRUE(sameTriangle(mesh.getTriangle(i), original.getTriangle(i)));
+        EXPECT_EQ(mesh.getTriangleLayer(i), original.getTriangleLayer(i));
+    }
+
+    TrianglePermutation tooShort;
+    tooShort.push_back(0);
+    EXPECT_THROW(SpatialOrder::restore(mesh, tooShort), std::invalid_argument);
+}
+
+TEST(SpatialOrderTest, ThreadCountDoesNotChangeOrder) {
+    // Large enough for the parallel sort
+    MeshData serial = shuffledGrid(200);
+    MeshData parallel = serial;
+
+    SpatialOrderOptions options;
+    options.threadCount = 1;
+    TrianglePermutation serialOrder = SpatialOrder(options).reorder(serial);
+    options.threadCount = 4;
+    TrianglePermutation parallelOrder = SpatialOrder(options).reorder(parallel);
+
+    ASSERT_EQ(serialOrder.size(), parallelOrder.size());
+    EXPECT_TRUE(std::equal(serialOrder.begin(), serialOrder.end(), parallelOrder.begin()));
+}
+
+TEST(SpatialOrderTest, ReordersCompactMeshes) {
+    const MeshData original = shuffledGrid(30);
+    MeshData mesh = original;
+    ASSERT_TRUE(mesh.compact());
+
+    TrianglePermutation fileOrder = SpatialOrder().reorder(mesh);
+
+    EXPECT_TRUE(mesh.isCompact());
+    for (size_t i = 0; i < fileOrder.size(); ++i) {
+        const Triangle expected = original.getTriangle(fileOrder[i]);
+        Triangle actual = mesh.getTriangle(i);
+        for (size_t v = 0; v < 3; ++v) {
+            EXPECT_LT((actual.vertices[v] - expected.vertices[v]).magnitude(), 1e-4);
+        }
+    }
+}
+
+TEST(SpatialOrderTest, HandlesEmptyAndFlatMeshes) {
+    MeshData empty;
+    EXPECT_EQ(SpatialOrder().reorder(empty).size(), 0u);
+
+    // Every centroid in one grid cell: file order is kept
+    MeshData stacked;
+    for (int i = 0; i < 5; ++i) {
+        stacked.addTriangle(Point3D(0, 0, 0), Point3D(0, 0, 0), Point3D(0, 0, 0));
+    }
+    TrianglePermutation fileOrder = SpatialOrder().reorder(stacked);
+    for (size_t i = 0; i < fileOrder.size(); ++i) {
+        EXPECT_EQ(fileOrder[i], i);
+    }
+}
@@ -290,7 +290,107 @@ TEST_F(SummaryWriterTest, NumericFieldFormatting) {
     std::string outputPath = writer->writeToFile(testSummary, "numeric");
     std::string content = readFileContents(outputPath);
     
-    // Numeric fields should be formatted as numbers, not strings
-    EXPECT_NE(content.find("\"pi\": 3.141593"), std::string::npos);
+    // Numeric fields should be written as numbers, not strings, at full precision
+    EXPECT_NE(content.find("\"pi\": 3.141592653589793"), std::string::npos);
     EXPECT_NE(content.find("\"integer\": 42"), std::string::npos);
-}
\ No newline at end of file
+}
+
+TEST_F(SummaryWriterTest, TypedFieldsWrittenDirectly) {
+    testSummary.customFields.set("ratio", 0.1 + 0.2);
+    testSummary.customFields.set("faces", 7);
+    testSummary.customFields.set("label", std::string("Pit, \"A\""));
+    
+    auto writer = SummaryWriterFactory::create("json", testOutputDir);
+    writer->setIncludeTimestamp(false);
+    std::string json = readFileContents(writer->writeToFile(testSummary, "typed"));
+    EXPECT_NE(json.find("\"ratio\": 0.30000000000000004"), std::string::npos);
+    EXPECT_NE(json.find("\"faces\": 7,"), std::string::npos);
+    EXPECT_NE(json.find("\"label\": \"Pit, \\\"A\\\"\""), std::string::npos);
+    
+    writer->setFormat(SummaryWriter::OutputFormat::CSV);
+    std::string csv = readFileContents(writer->writeToFile(testSummary, "typed"));
+    EXPECT_NE(csv.find("faces,7\n"), std::string::npos);
+    EXPECT_NE(csv.find("label,\"Pit, \"\"A\"\"\"\n"), std::string::npos);
+}
+
+TEST_F(SummaryWriterTest, LayerTableInAllFormats) {
+    GroupSummary layer;
+    layer.name = "Bench, \"North\"";
+    layer.triangleCount = 7;
+    layer.totalSurfaceArea = 12.5;
+    testSummary.layers.push_back(layer);
+    
+    auto writer = SummaryWriterFactory::create("json", testOutputDir);
+    writer->setIncludeTimestamp(false);
+    
+    std::string json = readFileContents(writer->writeToFile(testSummary, "layers"));
+    EXPECT_NE(json.find("\"layers\": ["), std::string::npos);
+    EXPECT_NE(json.find("\"name\": \"Bench, \\\"North\\\"\""), std::string::npos);
+    
+    writer->setFormat(SummaryWriter::OutputFormat::CSV);
+    std::string csv = readFileContents(writer->writeToFile(testSummary, "layers"));
+    EXPECT_NE(csv.find("layer,triangle_count,total_surface_area"), std::string::npos);
+    EXPECT_NE(csv.find("\"Bench, \"\"North\"\"\",7,"), std::string::npos);
+    
+    writer->setFormat(SummaryWriter::OutputFormat::TEXT);
+    std::string text = readFileContents(writer->writeToFile(testSummary, "layers"));
+    EXPECT_NE(text.find("Layers:"), std::string::npos);
+    EXPECT_NE(text.find("Bench, \"North\""), std::string::npos);
+}
+
+TEST_F(SummaryWriterTest, ComponentTableInAllFormats) {
+    ComponentSummary component;
+    component.name = "Component 1";
+    component.triangleCount = 12;
+    component.totalSurfaceArea = 6.0;
+    component.volume = 1.5;
+    testSummary.components.push_back(component);
+    
+    auto writer = SummaryWriterFactory::create("json", testOutputDir);
+    writer->setIncludeTimestamp(false);
+    
+    std::string json = readFileContents(writer->writeToFile(testSummary, "components"));
+    EXPECT_NE(json.find("\"components\": ["), std::string::npos);
+    EXPECT_NE(json.find("\"name\": \"Component 1\", \"triangle_count\": 12, \"total_surface_area\": 6, \"volume\": 1.5"),
+              std::string::npos);
+    
+    writer->setPrettyPrint(false);
+    json = readFileContents(writer->writeToFile(testSummary, "components"));
+    EXPECT_NE(json.find(",\"components\":[{\"name\":\"Component 1\""), std::string::npos);
+    
+    writer->setFormat(SummaryWriter::OutputFormat::CSV);
+    std::string csv = readFileContents(writer->writeToFile(testSummary, "components"));
+    EXPECT_NE(csv.find("component,triangle_count,total_surface_area,volume"), std::string::npos);
+    EXPECT_NE(csv.find("Component 1,12,6,1.5,"), std::string::npos);
+    
+    writer->setFormat(SummaryWriter::OutputFormat::TEXT);
+    std::string text = readFileContents(writer->writeToFile(testSummary, "components"));
+    EXPECT_NE(text.find("Components:"), std::string::npos);
+    EXPECT_NE(text.find("Component 1"), std::string::npos);
+}
+
+TEST_F(SummaryWriterTest, HeaderOnlyOutputIsLabelled) {
+    DXFHeaderInfo header;
+    header.acadVersion = "AC1027";
+    header.insUnits = 6;
+    header.hasExtents = true;
+    header.extents.expand(Point3D(-773.0, 668.71875, 196.739013671875));
+    header.extents.expand(Point3D(-296.0, 1001.21875, 381.0));
+    
+    auto writer = SummaryWriterFactory::create("json", testOutputDir);
+    writer->setIncludeTimestamp(false);
+    
+    std::string json = readFileContents(writer->writeHeaderToFile(header, "header"));
+    EXPECT_NE(json.find("\"source\": \"header\""), std::string::npos);
+    EXPECT_NE(json.find("\"recomputed\": false"), std::string::npos);
+    EXPECT_NE(json.find("\"units\": \"meters\""), std::string::npos);
+    EXPECT_NE(json.find("196.739013671875"), std::string::npos);
+    
+    writer->setFormat(SummaryWriter::OutputFormat::TEXT);
+    std::string text = readFileContents(writer->writeHeaderToFile(header, "header"));
+    EXPECT_NE(text.find("not recomputed"), std::string::npos);
+    
+    writer->setFormat(SummaryWriter::OutputFormat::CSV);
+    std::string csv = readFileContents(writer->writeHeaderToFile(header, "header"));
+    EXPECT_NE(csv.find("recomputed,false"), std::string::npos);
+}
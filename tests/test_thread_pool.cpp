@@ -0,0 +1,177 @@
+/**
+ * @file test_thread_pool.cpp
+ * @brief Unit tests for the work-stealing thread pool and task groups
+ */
+
+#include <gtest/gtest.h>
+#include "ThreadPool.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace DXFProcessor;
+
+TEST(ThreadPoolTest, RunsEveryTaskOfAGroup) {
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.size(), 4);
+    EXPECT_EQ(pool.currentWorker(), pool.size());
+    
+    std::vector<int> values(1000, 0);
+    TaskGroup group(pool);
+    for (size_t i = 0; i < values.size(); ++i) {
+        group.run([&values, i] { values[i] = static_cast<int>(i); });
+    }
+    group.wait();
+    
+    std::vector<int> expected(values.size());
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(values, expected);
+}
+
+TEST(ThreadPoolTest, NestedGroupsDoNotDeadlock) {
+    // Every worker blocks on sub-tasks; wait() must run them instead of sleeping
+    ThreadPool pool(2);
+    std::atomic<int> leaves{0};
+    
+    TaskGroup outer(pool);
+    for (int i = 0; i < 8; ++i) {
+        outer.run([&pool, &leaves] {
+            TaskGroup inner(pool);
+            for (int j = 0; j < 16; ++j) {
+                inner.run([&leaves] { leaves.fetch_add(1); });
+            }
+            inner.wait();
+        });
+    }
+    outer.wait();
+    
+    EXPECT_EQ(leaves.load(), 8 * 16);
+}
+
+TEST(ThreadPoolTest, WaitRunsOnlyItsOwnGroup) {
+    // A worker waiting on its parts must not start another job meanwhile, or
+    // whole jobs (and their memory) stack up on one thread
+    std::atomic<size_t> firstWorker{0};
+    std::atomic<bool> stolen{false};
+    std::atomic<bool> release{false};
+    std::atomic<bool> firstDone{false};
+    std::atomic<bool> stacked{false};
+    {
+        ThreadPool pool(2);
+        pool.submit([&] {
+            firstWorker = pool.currentWorker();
+            TaskGroup parts(pool);
+            for (int part = 0; part < 2; ++part) {
+                parts.run([&] {
+                    if (pool.currentWorker() != firstWorker) {
+                        // Stolen: stay busy so the first worker has nothing of its own left to run
+                        stolen = true;
+                        while (!release) {
+                            std::this_thread::yield();
+                        }
+                    } else {
+                        while (!stolen) {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+            }
+            parts.wait();
+            firstDone = true;
+        });
+        
+        while (!stolen) {
+            std::this_thread::yield();
+        }
+        pool.submit([&] {
+            if (pool.currentWorker() == firstWorker && !firstDone) {
+                stacked = true;
+            }
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        release = true;
+    }
+    
+    EXPECT_TRUE(firstDone.load());
+    EXPECT_FALSE(stacked.load());
+}
+
+TEST(ThreadPoolTest, WorkIsSpreadAcrossWorkers) {
+    ThreadPool pool(4);
+    std::mutex mutex;
+    std::set<size_t> workers;
+    std::atomic<int> started{0};
+    
+    TaskGroup group(pool);
+    for (int i = 0; i < 4; ++i) {
+        group.run([&] {
+            started.fetch_add(1);
+            // Hold each worker until all four tasks are running
+            while (started.load() < 4) {
+                std::this_thread::yield();
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            workers.insert(pool.currentWorker());
+        });
+    }
+    group.wait();
+    
+    EXPECT_EQ(workers.size(), 4);
+}
+
+TEST(ThreadPoolTest, OutsideTasksStartInSubmissionOrder) {
+    // Batch mode queues its largest files first and relies on them starting first
+    std::vector<int> started;
+    {
+        ThreadPool pool(1);
+        std::atomic<bool> release{false};
+        pool.submit([&release] {
+            while (!release.load()) {
+                std::this_thread::yield();
+            }
+        });
+        for (int i = 0; i < 6; ++i) {
+            pool.submit([&started, i] { started.push_back(i); });
+        }
+        release = true;
+    }  // The destructor runs the queued tasks
+    
+    EXPECT_EQ(started, std::vector<int>({0, 1, 2, 3, 4, 5}));
+}
+
+TEST(ThreadPoolTest, GroupRethrowsFirstException) {
+    ThreadPool pool(3);
+    std::atomic<int> completed{0};
+    
+    TaskGroup group(pool);
+    for (int i = 0; i < 10; ++i) {
+        group.run([&completed, i] {
+            if (i == 5) {
+                throw std::runtime_error("task 5 failed");
+            }
+            completed.fetch_add(1);
+        });
+    }
+    EXPECT_THROW(group.wait(), std::runtime_error);
+    EXPECT_EQ(completed.load(), 9);
+    
+    // The error is reported once; the group can be reused
+    group.run([&completed] { completed.fetch_add(1); });
+    EXPECT_NO_THROW(group.wait());
+    EXPECT_EQ(completed.load(), 10);
+}
+
+TEST(ThreadPoolTest, MakePoolForSkipsSmallOrSerialWork) {
+    EXPECT_EQ(makePoolFor(100, MIN_PARALLEL_TRIANGLES, 4), nullptr);
+    EXPECT_EQ(makePoolFor(MIN_PARALLEL_TRIANGLES, MIN_PARALLEL_TRIANGLES, 1), nullptr);
+    
+    std::unique_ptr<ThreadPool> pool = makePoolFor(MIN_PARALLEL_TRIANGLES, MIN_PARALLEL_TRIANGLES, 3);
+    ASSERT_NE(pool, nullptr);
+    EXPECT_EQ(pool->size(), 3u);
+}
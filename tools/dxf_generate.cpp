@@ -0,0 +1,109 @@
+/**
+ * @file dxf_generate.cpp
+ * @brief Command-line front end of DXFGenerator: writes synthetic pit surfaces for scale tests
+ */
+
+#include "DXFGenerator.h"
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace DXFProcessor;
+
+void printUsage(const char* programName) {
+    std::cout << "DXF Generate - Synthetic open-pit TIN surfaces for scale testing\n\n";
+    std::cout << "Usage: " << programName << " [options] <output.dxf>\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  -n, --faces <count>    3DFACE entities to write (default: 100000)\n";
+    std::cout << "  --layers <count>       Depth-band layers PIT_01.. (default: 6)\n";
+    std::cout << "  --quads                One four-corner face per grid cell instead of two triangles\n";
+    std::cout << "  --noise <amount>       Peak vertical roughness in metres (default: 0.25)\n";
+    std::cout << "  --cell <size>          Grid spacing in metres (default: 2)\n";
+    std::cout << "  --crlf                 Windows line endings\n";
+    std::cout << "  --binary               Binary DXF instead of ASCII\n";
+    std::cout << "  --seed <n>             Noise seed; same options and seed give identical files (default: 1)\n";
+    std::cout << "  -j, --threads <n>      Formatting threads (default: one per hardware thread)\n";
+    std::cout << "  -h, --help             Show this help message\n\n";
+    std::cout << "Example:\n";
+    std::cout << "  " << programName << " --faces 100000000 --seed 42 pit_100m.dxf\n";
+}
+
+unsigned long long parseCount(const std::string& option, const char* text) {
+    char* end = nullptr;
+    unsigned long long value = std::strtoull(text, &end, 10);
+    if (end == text || *end != '\0' || text[0] == '-') {
+        throw std::invalid_argument(option + " expects a non-negative integer");
+    }
+    return value;
+}
+
+double parseNumber(const std::string& option, const char* text) {
+    char* end = nullptr;
+    double value = std::strtod(text, &end);
+    if (end == text || *end != '\0') {
+        throw std::invalid_argument(option + " expects a number");
+    }
+    return value;
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        GeneratorOptions options;
+        std::string outputFile;
+        
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            
+            if (arg == "-h" || arg == "--help") {
+                printUsage(argv[0]);
+                return 0;
+            } else if ((arg == "-n" || arg == "--faces") && i + 1 < argc) {
+                options.faceCount = static_cast<size_t>(parseCount(arg, argv[++i]));
+            } else if (arg == "--layers" && i + 1 < argc) {
+                options.layerCount = static_cast<size_t>(parseCount(arg, argv[++i]));
+            } else if (arg == "--quads") {
+                options.quads = true;
+            } else if (arg == "--noise" && i + 1 < argc) {
+                options.noise = parseNumber(arg, argv[++i]);
+            } else if (arg == "--cell" && i + 1 < argc) {
+                options.cellSize = parseNumber(arg, argv[++i]);
+            } else if (arg == "--crlf") {
+                options.crlf = true;
+            } else if (arg == "--binary") {
+                options.binary = true;
+            } else if (arg == "--seed" && i + 1 < argc) {
+                options.seed = parseCount(arg, argv[++i]);
+            } else if ((arg == "-j" || arg == "--threads") && i + 1 < argc) {
+                options.threadCount = static_cast<size_t>(parseCount(arg, argv[++i]));
+            } else if (arg[0] != '-') {
+                outputFile = arg;
+            } else {
+                std::cerr << "Unknown option: " << arg << "\n";
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        
+        if (outputFile.empty()) {
+            std::cerr << "Error: No output file specified\n\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+        
+        GeneratorResult result = DXFGenerator(options).write(outputFile);
+        
+        double megabytes = result.bytesWritten / (1024.0 * 1024.0);
+        std::cout << "Wrote " << result.faceCount << " faces to " << outputFile << "\n";
+        std::cout << std::fixed << std::setprecision(1)
+                  << "  " << megabytes << " MB in " << std::setprecision(2) << result.seconds << " s ("
+                  << std::setprecision(1) << (result.seconds > 0.0 ? megabytes / result.seconds : 0.0)
+                  << " MB/s)\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}